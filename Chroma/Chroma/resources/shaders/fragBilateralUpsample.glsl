@@ -0,0 +1,56 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// reduced resolution effect and the depth it was traced with
+uniform sampler2D u_LowResInput;
+uniform sampler2D u_LowResDepth;
+// full resolution depth
+uniform sampler2D u_Depth;
+
+// low res texels either side of the pixel, 1 is a 2x2 footprint, 2 a 4x4
+uniform int u_Radius;
+
+// Camera
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
+
+// depth difference in view space units that halves a sample's weight
+const float depthSharpness = 0.1;
+
+void main()
+{
+    vec2 lowResSize = vec2(textureSize(u_LowResInput, 0));
+    vec2 lowResTexelSize = 1.0 / lowResSize;
+    // texel centre below and left of the pixel
+    vec2 baseTexel = floor(TexCoords * lowResSize - 0.5) + 0.5;
+
+    float depth = texture(u_Depth, TexCoords).r;
+    if (depth >= 1.0)
+    {
+        FragColor = texture(u_LowResInput, TexCoords);
+        return;
+    }
+    float viewDepth = ViewPositionFromDepth(depth, TexCoords).z;
+
+    // weight low res texels by bilinear footprint and depth similarity, so
+    // results don't bleed across silhouettes
+    vec4 result = vec4(0.0);
+    float totalWeight = 0.0;
+    for (int x = 1 - u_Radius; x <= u_Radius; ++x)
+    {
+        for (int y = 1 - u_Radius; y <= u_Radius; ++y)
+        {
+            vec2 texel = baseTexel + vec2(float(x), float(y));
+            vec2 sampleUV = texel * lowResTexelSize;
+            vec2 bilinear = max(vec2(1.0) - abs(TexCoords * lowResSize - texel) / float(u_Radius), vec2(0.0));
+            float sampleViewDepth = ViewPositionFromDepth(texture(u_LowResDepth, sampleUV).r, sampleUV).z;
+            float depthWeight = 1.0 / (1.0 + abs(viewDepth - sampleViewDepth) / depthSharpness);
+            float weight = (bilinear.x * bilinear.y + 1e-3) * depthWeight;
+            result += texture(u_LowResInput, sampleUV) * weight;
+            totalWeight += weight;
+        }
+    }
+    FragColor = result / max(totalWeight, 1e-5);
+}
@@ -0,0 +1,36 @@
+#version 330 core
+layout (location = 0) out float DownsampledDepth;
+layout (location = 1) out vec2 DownsampledNormal;
+
+in vec2 TexCoords;
+
+uniform sampler2D gDepth;
+uniform sampler2D gNormal;
+
+// screen texels per downsampled texel along each axis
+uniform int u_Divisor;
+
+void main()
+{
+    // keep the closest depth of the footprint and its normal, so thin foreground
+    // geometry survives and depth and normal always come from the same surface
+    ivec2 screenSize = textureSize(gDepth, 0);
+    ivec2 origin = ivec2(gl_FragCoord.xy) * u_Divisor;
+    float closestDepth = 1.0;
+    vec2 closestNormal = texelFetch(gNormal, min(origin, screenSize - 1), 0).rg;
+    for (int x = 0; x < u_Divisor; ++x)
+    {
+        for (int y = 0; y < u_Divisor; ++y)
+        {
+            ivec2 texel = min(origin + ivec2(x, y), screenSize - 1);
+            float depth = texelFetch(gDepth, texel, 0).r;
+            if (depth < closestDepth)
+            {
+                closestDepth = depth;
+                closestNormal = texelFetch(gNormal, texel, 0).rg;
+            }
+        }
+    }
+    DownsampledDepth = closestDepth;
+    DownsampledNormal = closestNormal;
+}
@@ -1,31 +1,24 @@
 #version 450 core
-layout (location = 0) out vec3 gPosition;
-layout (location = 1) out vec3 gViewPosition;
-layout (location = 2) out vec4 gFragPosLightSpace;
-layout (location = 3) out vec3 gAlbedo;
-layout (location = 4) out vec3 gNormal;
-layout (location = 5) out vec3 gViewNormal;
-layout (location = 6) out vec3 gMetRoughAO;
+// positions are reconstructed from depth, light space in the lighting pass
+layout (location = 0) out vec3 gAlbedo;
+layout (location = 1) out vec2 gNormal;
+layout (location = 2) out vec3 gMetRoughAO;
 
 in VS_OUT {
-	vec3 FragWorldPos;
-	vec3 FragViewPos;
 	vec2 TexCoords;
-	vec4 FragPosLightSpace;
 	vec3 WorldNormal;
-	vec3 ViewNormal;
 	mat3 WorldTBN;
-	mat3 ViewTBN;
 } fs_in;
 
+// world space normal, octahedral encoded
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
+
 // MATERIALS
 #include "util/materialStruct.glsl"
 uniform Material material;
 
-// Texture Checks
-uniform bool UseAlbedoMap;
-uniform bool UseNormalMap;
-uniform bool UseMetRoughAOMap;
+// Texture Checks are compiled in, ALBEDO_MAP, NORMAL_MAP and METROUGHAO_MAP
 // Material overrides if no maps provided
 uniform vec3 color;
 uniform float roughness;
@@ -35,32 +28,28 @@ uniform vec2 UVMultiply;
 
 void main()
 {             
-    // position
-    gPosition = fs_in.FragWorldPos;
-	gViewPosition = fs_in.FragViewPos;
     // albedo
-    gAlbedo = UseAlbedoMap? vec3(texture(material.texture_albedo1, fs_in.TexCoords * UVMultiply).rgb) : color;
+#ifdef ALBEDO_MAP
+    gAlbedo = vec3(texture(material.texture_albedo1, fs_in.TexCoords * UVMultiply).rgb);
+#else
+    gAlbedo = color;
+#endif
 	// normals
-	if (UseNormalMap)
+#ifdef NORMAL_MAP
 	{
-		vec3 normalMap = vec3(texture(material.texture_normal1, fs_in.TexCoords * UVMultiply).rgb);
-		normalMap = 2.0 * normalMap - 1.0;
-		gNormal = normalize(fs_in.WorldTBN * normalMap);
-		gViewNormal = normalize(fs_in.ViewTBN * normalMap);
+		vec3 normalMap = SampleNormalMap(material.texture_normal1, fs_in.TexCoords * UVMultiply);
+		gNormal = EncodeOctNormal(normalize(fs_in.WorldTBN * normalMap));
 	}
-	else
+#else
 	{
-		gNormal = fs_in.WorldNormal;
-		gViewNormal = fs_in.ViewNormal;
+		gNormal = EncodeOctNormal(normalize(fs_in.WorldNormal));
 	}
+#endif
 
 	// metalness roughness ao
-	if(UseMetRoughAOMap){
-		gMetRoughAO = texture(material.texture_MetRoughAO1, fs_in.TexCoords * UVMultiply).rgb;
-	}
-	else{
-		gMetRoughAO = vec3(metalness, roughness, 1.0);
-	}
-	// shadowmap
-	gFragPosLightSpace = fs_in.FragPosLightSpace;
+#ifdef METROUGHAO_MAP
+	gMetRoughAO = texture(material.texture_MetRoughAO1, fs_in.TexCoords * UVMultiply).rgb;
+#else
+	gMetRoughAO = vec3(metalness, roughness, 1.0);
+#endif
 }
\ No newline at end of file
@@ -7,39 +7,48 @@ layout (location = 1) out vec3 gIndirectLighting;
 in vec2 TexCoords;
 
 // BUFFERS
-uniform sampler2D gPosition;
 uniform sampler2D gNormal;
 uniform sampler2D gAlbedo;
 uniform sampler2D gMetRoughAO;
-uniform sampler2D gFragPosLightSpace;
 uniform sampler2DArray gShadowmap;
 uniform sampler2D SSAO;
+uniform sampler2D gDepth;
 
 // UNIFORMS
 //IBL
-uniform samplerCube irradianceMap;
+#include "util/uniformBufferIBL.glsl"
 uniform samplerCube prefilterMap;
 uniform sampler2D   brdfLUT;
+// shadows
+uniform mat4 lightSpaceMatrix;
 
 // LIGHTING
 #include "util/lightingStructs.glsl"
 // ubos
 #include "util/uniformBufferLighting.glsl"
 #include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
 // Lighting Functions
 #include "util/PBRLightingFuncsDeclaration.glsl"
 
 void main()
 {         
-    // retrieve data from G-buffer
-    vec3 FragPos = texture(gPosition, TexCoords).rgb;
-    vec3 Normal = texture(gNormal, TexCoords).rgb;
+    // retrieve data from G-buffer, nothing was drawn where depth is cleared
+	float Depth = texture(gDepth, TexCoords).r;
+	if (Depth >= 1.0)
+	{
+		gDirectLightingShadows = vec4(0.0);
+		gIndirectLighting = vec3(0.0);
+		return;
+	}
+    vec3 FragPos = WorldPositionFromDepth(Depth, TexCoords);
+    vec3 Normal = DecodeOctNormal(texture(gNormal, TexCoords).rg);
     vec3 Albedo = texture(gAlbedo, TexCoords).rgb;
 	vec3 MetRoughAO = texture(gMetRoughAO, TexCoords).rgb;
 	float Metalness = MetRoughAO.r;
     float Roughness = MetRoughAO.g;
 	float AO = MetRoughAO.b;
-	vec4 FragPosLightSpace = texture(gFragPosLightSpace, TexCoords).rgba;
+	vec4 FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
 	float SSAO = texture(SSAO, TexCoords).r;
 
 	// Attrs
@@ -61,7 +70,7 @@ void main()
 
 	// AMBIENT
 	//------------------------------------------------------------------------
-	vec3 Ambient = CalcAmbientLight(irradianceMap, prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a);
+	vec3 Ambient = CalcAmbientLight(prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a);
 
 	// COMBINE
 	//------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+#version 450 core
+// alpha tested instanced vegetation, written to the gbuffer
+layout (location = 0) out vec3 gAlbedo;
+layout (location = 1) out vec2 gNormal;
+layout (location = 2) out vec3 gMetRoughAO;
+
+in VS_OUT {
+	vec2 TexCoords;
+	vec3 WorldNormal;
+	mat3 WorldTBN;
+	float Variation;
+} fs_in;
+
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
+
+// MATERIALS
+#include "util/materialStruct.glsl"
+uniform Material material;
+
+// Texture Checks are compiled in, ALBEDO_MAP, NORMAL_MAP and METROUGHAO_MAP
+// Material overrides if no maps provided
+uniform vec3 color;
+uniform float roughness;
+uniform float metalness;
+uniform vec2 UVMultiply;
+// brightness jitter from the instance seed
+uniform float colorVariation;
+
+
+void main()
+{
+	// albedo, cutout matches the forward vegetation shader
+#ifdef ALBEDO_MAP
+	vec4 albedo = texture(material.texture_albedo1, fs_in.TexCoords * UVMultiply);
+	if (albedo.a < 0.65)
+		discard;
+	gAlbedo = albedo.rgb;
+#else
+	gAlbedo = color;
+#endif
+	gAlbedo *= 1.0 + (fs_in.Variation * 2.0 - 1.0) * colorVariation;
+
+	// double sided, back faces flip the normal
+	float facing = gl_FrontFacing ? 1.0 : -1.0;
+#ifdef NORMAL_MAP
+	{
+		vec3 normalMap = SampleNormalMap(material.texture_normal1, fs_in.TexCoords * UVMultiply);
+		gNormal = EncodeOctNormal(normalize(fs_in.WorldTBN * normalMap) * facing);
+	}
+#else
+	{
+		gNormal = EncodeOctNormal(normalize(fs_in.WorldNormal) * facing);
+	}
+#endif
+
+	// metalness roughness ao
+#ifdef METROUGHAO_MAP
+	gMetRoughAO = texture(material.texture_MetRoughAO1, fs_in.TexCoords * UVMultiply).rgb;
+#else
+	gMetRoughAO = vec3(metalness, roughness, 1.0);
+#endif
+}
@@ -52,8 +52,7 @@ void main()
 	// normals
 	vec3 normals;
 	if (UseNormalMap && length(fs_in.TBN[1]) >= 0.5 ){
-		normals = vec3(texture(material.texture_normal1, fs_in.TexCoords));
-		normals = normalize(normals * 2.0 - 1.0);
+		normals = SampleNormalMap(material.texture_normal1, fs_in.TexCoords);
 		normals = normalize(fs_in.TBN * normals);
 	}
 	else{
@@ -26,7 +26,7 @@ uniform float roughness;
 uniform float metalness;
 
 //IBL
-uniform samplerCube irradianceMap;
+#include "util/uniformBufferIBL.glsl"
 uniform samplerCube prefilterMap;
 uniform sampler2D   brdfLUT; 
 
@@ -48,8 +48,7 @@ void main()
 	Albedo = UseAlbedoMap? vec3(texture(material.texture_albedo1, fs_in.TexCoords)) : color;
 	// normals
 	if (UseNormalMap){
-		Normal = vec3(texture(material.texture_normal1, fs_in.TexCoords));
-		Normal = normalize(Normal * 2.0 - 1.0);
+		Normal = SampleNormalMap(material.texture_normal1, fs_in.TexCoords);
 		Normal = normalize(fs_in.TBN * Normal);
 	}
 	else{
@@ -88,7 +87,7 @@ void main()
 	// AMBIENT
 	//------------------------------------------------------------------------
 	// Adding ambient and SSAO
-	vec3 Ambient = CalcAmbientLight(irradianceMap, prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a) * SSAO;
+	vec3 Ambient = CalcAmbientLight(prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a) * SSAO;
 
 	// COMBINE
 	//------------------------------------------------------------------------
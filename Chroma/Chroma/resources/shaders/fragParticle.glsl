@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec4 BrightColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D particleTexture;
+uniform bool UseTexture;
+uniform vec3 colorTint;
+
+void main()
+{
+	// soft round sprite without a texture
+	vec4 color = UseTexture ? texture(particleTexture, TexCoords) : vec4(1.0, 1.0, 1.0, 1.0 - smoothstep(0.5, 1.0, length(TexCoords * 2.0 - 1.0)));
+	if (color.a <= 0.0)
+		discard;
+	FragColor = vec4(color.rgb * colorTint, color.a);
+
+	float brightness = dot(FragColor.rgb, vec3(0.2126, 0.7152, 0.0722));
+	if(brightness > 1.0)
+		BrightColor = vec4(FragColor.rgb, 1.0);
+	else
+		BrightColor = vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -3,13 +3,15 @@ out float FragColor;
   
 in vec2 TexCoords;
 
-uniform sampler2D gViewPosition;
-uniform sampler2D gViewNormal;
+uniform sampler2D gDepth;
+uniform sampler2D gNormal;
 uniform sampler2D texNoise;
 
 uniform vec3 samples[64];
-uniform mat4 projection;
-uniform mat4 view;
+
+// Camera
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
 
 
 uniform int kernelSize;
@@ -21,9 +23,15 @@ uniform vec2 noiseScale;
 
 void main()
 {
-    // get input for SSAO algorithm
-    vec3 fragPos = texture(gViewPosition, TexCoords).xyz;
-    vec3 normal = normalize(texture(gViewNormal, TexCoords).rgb);
+    // get input for SSAO algorithm, view space from depth and world normals
+    float depth = texture(gDepth, TexCoords).r;
+    if (depth >= 1.0)
+    {
+        FragColor = 1.0;
+        return;
+    }
+    vec3 fragPos = ViewPositionFromDepth(depth, TexCoords);
+    vec3 normal = normalize(mat3(view) * DecodeOctNormal(texture(gNormal, TexCoords).rg));
     vec3 randomVec = normalize(texture(texNoise, TexCoords * noiseScale).xyz);
     // create TBN change-of-basis matrix: from tangent-space to view-space
     vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
@@ -45,7 +53,7 @@ void main()
         offset.xyz = offset.xyz * 0.5 + 0.5; // transform to range 0.0 - 1.0
         
         // get sample depth
-        float sampleDepth = texture(gViewPosition, offset.xy).z; // get depth value of kernel sample
+        float sampleDepth = ViewPositionFromDepth(texture(gDepth, offset.xy).r, offset.xy).z; // get depth value of kernel sample
         
         // range check & accumulate
         float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragPos.z - sampleDepth));
@@ -14,12 +14,16 @@ out vec4 FragColor;
 in vec2 TexCoords;
 
 // uniforms
-uniform sampler2D vsNormals;
-uniform sampler2D vsPositions;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
 uniform sampler2D vAlbedo;
 
 uniform mat4 vProjection;
 
+// Camera
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
+
 // consts
 const float step = 0.1;
 const float minRayStep = 0.1;
@@ -35,12 +39,24 @@ vec4 RayCast(vec3 dir, inout vec3 hitCoord, out float dDepth);
 
 vec4 RayMarch(vec3 dir, inout vec3 hitCoord, out float dDepth);
 
+// view space depth of the scene at uv
+float SceneViewDepth(vec2 uv)
+{
+	return ViewPositionFromDepth(texture(gDepth, uv).r, uv).z;
+}
+
 
 void main()
 {
 
-    vec3 viewNormal = texture2D(vsNormals, TexCoords).xyz;
-    vec3 viewPos = texture2D(vsPositions, TexCoords).xyz;
+    float depth = texture(gDepth, TexCoords).r;
+    if (depth >= 1.0)
+    {
+        FragColor = vec4(0.0);
+        return;
+    }
+    vec3 viewNormal = mat3(view) * DecodeOctNormal(texture(gNormal, TexCoords).rg);
+    vec3 viewPos = ViewPositionFromDepth(depth, TexCoords);
     vec3 reflected = normalize(reflect(normalize(viewPos), normalize(viewNormal)));
 
     vec3 hitPos = viewPos;
@@ -80,7 +96,7 @@ vec3 BinarySearch(inout vec3 dir, inout vec3 hitCoord, inout float dDepth)
         projectedCoord.xy /= projectedCoord.w;
         projectedCoord.xy = projectedCoord.xy * 0.5 + 0.5;
  
-        depth = textureLod(vsPositions, projectedCoord.xy, 2).z;
+        depth = SceneViewDepth(projectedCoord.xy);
 
  
         dDepth = hitCoord.z - depth;
@@ -118,7 +134,7 @@ vec4 RayMarch(vec3 dir, inout vec3 hitCoord, out float dDepth)
         projectedCoord.xy /= projectedCoord.w;
         projectedCoord.xy = projectedCoord.xy * 0.5 + 0.5;
  
-        depth = texture2D(vsPositions, projectedCoord.xy, 2).z;
+        depth = SceneViewDepth(projectedCoord.xy);
         if(depth > maxDistance)
             continue;
  
@@ -26,7 +26,7 @@ uniform float roughness;
 uniform float metalness;
 
 //IBL
-uniform samplerCube irradianceMap;
+#include "util/uniformBufferIBL.glsl"
 uniform samplerCube prefilterMap;
 uniform sampler2D   brdfLUT; 
 
@@ -52,8 +52,7 @@ void main()
 	float Alpha = Albedo.a;
 	// normals
 	if (UseNormalMap){
-		Normal = vec3(texture(material.texture_normal1, fs_in.TexCoords));
-		Normal = normalize(Normal * 2.0 - 1.0);
+		Normal = SampleNormalMap(material.texture_normal1, fs_in.TexCoords);
 		Normal = normalize(fs_in.TBN * Normal);
 	}
 	else{
@@ -93,7 +92,7 @@ void main()
 	// AMBIENT
 	//------------------------------------------------------------------------
 	// Adding ambient and SSAO
-	vec3 Ambient = CalcAmbientLight(irradianceMap, prefilterMap, brdfLUT, Normal, viewDir, Albedo.rgb, Roughness, Metalness, AO, Lo.a) * SSAO;
+	vec3 Ambient = CalcAmbientLight(prefilterMap, brdfLUT, Normal, viewDir, Albedo.rgb, Roughness, Metalness, AO, Lo.a) * SSAO;
 
 	// COMBINE
 	//------------------------------------------------------------------------
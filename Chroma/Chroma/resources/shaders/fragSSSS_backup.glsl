@@ -32,7 +32,7 @@ uniform vec2 UVMultiply;
 // UNIFORMS
 uniform vec3 viewPos;
 //IBL
-uniform samplerCube irradianceMap;
+#include "util/uniformBufferIBL.glsl"
 uniform samplerCube prefilterMap;
 uniform sampler2D   brdfLUT;
 
@@ -57,8 +57,7 @@ void main()
 
 	// normals
 	if (UseNormalMap){
-		Normal = vec3(texture(material.texture_normal1, fs_in.TexCoords));
-		Normal = normalize(Normal * 2.0 - 1.0);
+		Normal = SampleNormalMap(material.texture_normal1, fs_in.TexCoords);
 		Normal = normalize(fs_in.TBN * Normal);
 	}
 	else{
@@ -97,7 +96,7 @@ void main()
 	// AMBIENT
 	//------------------------------------------------------------------------
 	// Adding ambient and SSAO
-	vec3 Ambient = CalcAmbientLight(irradianceMap, prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a) * SSAO;
+	vec3 Ambient = CalcAmbientLight(prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a) * SSAO;
 
 	// COMBINE
 	//------------------------------------------------------------------------
@@ -0,0 +1,37 @@
+#version 450 core
+layout (location = 0) out vec3 gAlbedo;
+layout (location = 1) out vec2 gNormal;
+layout (location = 2) out vec3 gMetRoughAO;
+
+in vec2 WorldXZ;
+
+#include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
+#include "util/terrainFuncs.glsl"
+
+// splat channels weight layers 0 to 3
+uniform sampler2D splatMap;
+uniform sampler2D layerAlbedo[4];
+uniform bool layerHasAlbedo[4];
+uniform vec3 layerColor[4];
+uniform float layerRoughness[4];
+uniform float layerTiling[4];
+
+void main()
+{
+	vec4 weights = texture(splatMap, TerrainUV(WorldXZ));
+	weights /= max(dot(weights, vec4(1.0)), 0.0001);
+
+	vec3 albedo = vec3(0.0);
+	float roughness = 0.0;
+	for (int i = 0; i < 4; i++)
+	{
+		vec3 layer = layerHasAlbedo[i] ? texture(layerAlbedo[i], WorldXZ / layerTiling[i]).rgb : layerColor[i];
+		albedo += layer * weights[i];
+		roughness += layerRoughness[i] * weights[i];
+	}
+
+	gAlbedo = albedo;
+	gNormal = EncodeOctNormal(SampleTerrainNormal(WorldXZ));
+	gMetRoughAO = vec3(0.0, roughness, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// composited frame at render resolution
+uniform sampler2D u_Input;
+uniform float u_Sharpness;
+
+void main()
+{
+    // bilinear upscale, sharpened at the source texel spacing to restore
+    // edges the filter softens, clamped to the neighbourhood so it can't ring
+    vec2 texelSize = 1.0 / vec2(textureSize(u_Input, 0));
+    vec4 center = texture(u_Input, TexCoords);
+    vec3 left = texture(u_Input, TexCoords - vec2(texelSize.x, 0.0)).rgb;
+    vec3 right = texture(u_Input, TexCoords + vec2(texelSize.x, 0.0)).rgb;
+    vec3 down = texture(u_Input, TexCoords - vec2(0.0, texelSize.y)).rgb;
+    vec3 up = texture(u_Input, TexCoords + vec2(0.0, texelSize.y)).rgb;
+
+    vec3 minColor = min(center.rgb, min(min(left, right), min(down, up)));
+    vec3 maxColor = max(center.rgb, max(max(left, right), max(down, up)));
+    vec3 sharpened = center.rgb + (center.rgb - (left + right + down + up) * 0.25) * u_Sharpness;
+
+    FragColor = vec4(clamp(sharpened, minColor, maxColor), center.a);
+}
@@ -39,7 +39,7 @@ const float bckScttrPow        = 0.695;
 const float bckScttrDistortion = 0.695;
 
 //IBL
-uniform samplerCube irradianceMap;
+#include "util/uniformBufferIBL.glsl"
 uniform samplerCube prefilterMap;
 uniform sampler2D   brdfLUT;
 
@@ -73,8 +73,7 @@ void main()
 
 	// normals
 	if (UseNormalMap){
-		Normal = vec3(texture(material.texture_normal1, fs_in.TexCoords * UVMultiply));
-		Normal = normalize(Normal * 2.0 - 1.0);
+		Normal = SampleNormalMap(material.texture_normal1, fs_in.TexCoords * UVMultiply);
 		Normal = normalize(fs_in.TBN * Normal);
 	}
 	else{
@@ -125,7 +124,7 @@ void main()
 	// AMBIENT
 	//------------------------------------------------------------------------
 	// Adding ambient and SSAO
-	vec3 Ambient = CalcAmbientLight(irradianceMap, prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a);
+	vec3 Ambient = CalcAmbientLight(prefilterMap, brdfLUT, Normal, viewDir, Albedo, Roughness, Metalness, AO, Lo.a);
 
 	// COMBINE
 	//------------------------------------------------------------------------
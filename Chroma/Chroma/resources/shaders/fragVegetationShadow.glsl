@@ -0,0 +1,17 @@
+#version 450 core
+// alpha tested instanced vegetation, depth only
+in vec2 TexCoords;
+
+// MATERIALS
+#include "util/materialStruct.glsl"
+uniform Material material;
+uniform vec2 UVMultiply;
+
+void main()
+{
+	// cutout matches the gbuffer vegetation shader
+#ifdef ALBEDO_MAP
+	if (texture(material.texture_albedo1, TexCoords * UVMultiply).a < 0.65)
+		discard;
+#endif
+}
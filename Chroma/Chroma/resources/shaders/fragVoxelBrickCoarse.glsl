@@ -0,0 +1,22 @@
+#version 450 core
+
+// VOXELS
+#include "util/voxelUniforms.glsl"
+#include "util/voxelFuncs.glsl"
+
+// one texel per brick for lods past the brick size
+layout(rgba16f) uniform image3D u_VoxelCoarseTexture;
+
+void main()
+{
+	// a row of bricks along z per fragment, the brick's last pool mip is one texel
+	int numBricks = u_VoxelGridResolution / VOXEL_BRICK_SIZE;
+	ivec2 brickXY = ivec2(gl_FragCoord.xy);
+	for (int z = 0; z < numBricks; ++z)
+	{
+		ivec3 brick = ivec3(brickXY, z);
+		uint brickEntry = texelFetch(u_VoxelIndirection, brick, 0).r;
+		vec4 coarse = brickEntry == VOXEL_BRICK_EMPTY ? vec4(0.0) : texelFetch(u_VoxelTexture, ivec3(UnpackBrickSlot(brickEntry)), VOXEL_BRICK_MIPS - 1);
+		imageStore(u_VoxelCoarseTexture, brick, coarse);
+	}
+}
@@ -56,6 +56,11 @@ void main()
 	// Voxel Grid Space -> Clip Space (-1 : 1) -> Texture Space (0 : 1) 
 	voxelUVW = remap1101(voxelUVW);
 
+	// Grid Space -> Voxel, only the region being voxelized is written
+	vec3 voxelCoord = floor(voxelUVW * u_VoxelGridResolution);
+	if(any(lessThan(voxelCoord, u_VoxelRegionMin)) || any(greaterThanEqual(voxelCoord, u_VoxelRegionMax)))
+		return;
+
 	// Check within 3D Texture bounds
 	if(inVoxelGrid(voxelUVW, 0.0))
 	{
@@ -102,8 +107,12 @@ void main()
 		// OUTPUT TO 3D TEXTURE
 		//------------------------------------------------------------------------
 		vec4 writeData =  vec4(radiance.rgb, alpha);
-		// Clip Space -> Voxel Grid Space
-		ivec3 writeCoord = ivec3(floor(voxelUVW * u_VoxelGridResolution));
+		// Voxel Grid Space -> Toroidal Texel -> Brick Pool Texel
+		ivec3 toroidalCoord = (ivec3(voxelCoord) + ivec3(u_VoxelGridOffset)) % u_VoxelGridResolution;
+		uint brickEntry = texelFetch(u_VoxelIndirection, toroidalCoord / VOXEL_BRICK_SIZE, 0).r;
+		if (brickEntry == VOXEL_BRICK_EMPTY)
+			return;
+		ivec3 writeCoord = ivec3(UnpackBrickSlot(brickEntry)) * VOXEL_BRICK_SIZE + toroidalCoord % VOXEL_BRICK_SIZE;
 		imageStore(u_VoxelWriteTexture, writeCoord, writeData);
 
 		// Attempting atomic operation
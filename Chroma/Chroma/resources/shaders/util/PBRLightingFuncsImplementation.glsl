@@ -223,8 +223,24 @@ vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(1.0 - cosTheta, 5.0);
 }   
 // ----------------------------------------------------------------------------
+// IRRADIANCE
+// SH projected irradiance from the IBL uniform buffer, already divided by pi
+vec3 IrradianceSH(vec3 n)
+{
+	vec3 irradiance = irradianceSH[0].rgb * 0.282095
+		+ irradianceSH[1].rgb * 0.488603 * n.y
+		+ irradianceSH[2].rgb * 0.488603 * n.z
+		+ irradianceSH[3].rgb * 0.488603 * n.x
+		+ irradianceSH[4].rgb * 1.092548 * n.x * n.y
+		+ irradianceSH[5].rgb * 1.092548 * n.y * n.z
+		+ irradianceSH[6].rgb * 0.315392 * (3.0 * n.z * n.z - 1.0)
+		+ irradianceSH[7].rgb * 1.092548 * n.x * n.z
+		+ irradianceSH[8].rgb * 0.546274 * (n.x * n.x - n.y * n.y);
+	return max(irradiance, vec3(0.0));
+}
+// ----------------------------------------------------------------------------
 // AMBIENT LIGHT
-vec3  CalcAmbientLight(samplerCube irradianceMap, samplerCube prefilterMap, sampler2D brdfLUT, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metalness, float ao, float shadows)
+vec3  CalcAmbientLight(samplerCube prefilterMap, sampler2D brdfLUT, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metalness, float ao, float shadows)
 {
     // ambient lighting (we now use IBL as the ambient term)
 	// DIFFUSE
@@ -233,7 +249,7 @@ vec3  CalcAmbientLight(samplerCube irradianceMap, samplerCube prefilterMap, samp
 	vec3 F = fresnelSchlickRoughness(max(dot(normal, viewDir), 0.0), F0, roughness);
     vec3 kD   = 1.0 - F;
     kD       *= 1.0 - metalness;	  
-    vec3 irradiance  = texture(irradianceMap, normal).rgb;
+    vec3 irradiance  = IrradianceSH(normal);
     vec3 diffuse     = irradiance * albedo;
 	// SPECULAR
     vec3 R                = reflect(-viewDir, normal); 
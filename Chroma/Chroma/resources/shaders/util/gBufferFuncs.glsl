@@ -0,0 +1,36 @@
+// G-BUFFER
+// normals are octahedral encoded into two channels, positions are reconstructed from depth
+// requires uniformBufferCamera.glsl
+
+vec2 OctWrap(vec2 v)
+{
+	return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 EncodeOctNormal(vec3 normal)
+{
+	normal /= (abs(normal.x) + abs(normal.y) + abs(normal.z));
+	return normal.z >= 0.0 ? normal.xy : OctWrap(normal.xy);
+}
+
+vec3 DecodeOctNormal(vec2 encoded)
+{
+	vec3 normal = vec3(encoded.x, encoded.y, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float t = clamp(-normal.z, 0.0, 1.0);
+	normal.x += normal.x >= 0.0 ? -t : t;
+	normal.y += normal.y >= 0.0 ? -t : t;
+	return normalize(normal);
+}
+
+// depth in [0,1] as stored in the depth buffer, uv in [0,1]
+vec3 WorldPositionFromDepth(float depth, vec2 uv)
+{
+	vec4 position = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+vec3 ViewPositionFromDepth(float depth, vec2 uv)
+{
+	vec4 position = inverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
@@ -13,4 +13,11 @@ struct Material {
 	sampler2D texture_ao1;
 	// translucency
 	sampler2D texture_translucency1;
-};
\ No newline at end of file
+};
+
+// tangent space normal from a two channel BC5 map, z is rebuilt from the unit length
+vec3 SampleNormalMap(sampler2D normalMap, vec2 uv)
+{
+	vec2 xy = texture(normalMap, uv).rg * 2.0 - 1.0;
+	return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+}
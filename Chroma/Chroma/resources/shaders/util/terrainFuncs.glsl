@@ -0,0 +1,34 @@
+// TERRAIN
+// chunk heightmaps share their border samples with neighbouring chunks
+uniform sampler2D heightMap;
+uniform vec2 chunkMin;
+uniform float chunkSize;
+uniform float heightResolution;
+
+// 0-1 over the chunk
+vec2 TerrainUV(vec2 worldXZ)
+{
+	return (worldXZ - chunkMin) / chunkSize;
+}
+
+// texel centres at the chunk edges
+vec2 HeightTexCoords(vec2 uv)
+{
+	return (uv * (heightResolution - 1.0) + 0.5) / heightResolution;
+}
+
+float SampleTerrainHeight(vec2 worldXZ)
+{
+	return textureLod(heightMap, HeightTexCoords(TerrainUV(worldXZ)), 0.0).r;
+}
+
+vec3 SampleTerrainNormal(vec2 worldXZ)
+{
+	// central differences one height sample apart
+	float spacing = chunkSize / (heightResolution - 1.0);
+	float left = SampleTerrainHeight(worldXZ - vec2(spacing, 0.0));
+	float right = SampleTerrainHeight(worldXZ + vec2(spacing, 0.0));
+	float back = SampleTerrainHeight(worldXZ - vec2(0.0, spacing));
+	float front = SampleTerrainHeight(worldXZ + vec2(0.0, spacing));
+	return normalize(vec3(left - right, 2.0 * spacing, back - front));
+}
@@ -3,7 +3,6 @@ layout (std140) uniform CameraUBO
 	mat4 projection;
 	mat4 view;
 	vec3 cameraPosition;
+	mat4 inverseProjection;
+	mat4 inverseViewProjection;
 };
-
-
-
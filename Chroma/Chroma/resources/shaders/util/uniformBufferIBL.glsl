@@ -0,0 +1,5 @@
+layout (std140) uniform IBLUBO
+{
+	// diffuse irradiance, 3 bands of SH
+	vec4 irradianceSH[9];
+};
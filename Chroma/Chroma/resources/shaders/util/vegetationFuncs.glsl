@@ -0,0 +1,29 @@
+// VEGETATION
+// per instance rotation 8 bits, scale 8 bits, seed 16 bits
+uniform vec2 scaleRange;
+uniform float gameTime;
+uniform vec3 windDirection;
+uniform float windStrength;
+
+const float TWO_PI = 6.28318530718;
+
+float InstanceSeed(uint packed)
+{
+	return float(packed >> 16) / 65535.0;
+}
+
+mat3 InstanceRotation(uint packed)
+{
+	float rotation = float(packed & 0xFFu) / 255.0 * TWO_PI;
+	float s = sin(rotation);
+	float c = cos(rotation);
+	return mat3(c, 0.0, -s, 0.0, 1.0, 0.0, s, 0.0, c);
+}
+
+// sway with a phase per instance, weighted by vertex color red
+vec3 InstanceWorldPosition(vec3 position, vec4 color, vec3 instancePosition, uint packed)
+{
+	float scale = mix(scaleRange.x, scaleRange.y, float((packed >> 8) & 0xFFu) / 255.0);
+	float sway = sin(gameTime * 2.0 + InstanceSeed(packed) * TWO_PI) * windStrength * pow(color.r, 3.0);
+	return instancePosition + InstanceRotation(packed) * (position * scale) + normalize(windDirection) * sway;
+}
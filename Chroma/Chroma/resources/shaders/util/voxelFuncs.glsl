@@ -18,6 +18,72 @@ ivec3 unflatten3D(int idx, int resolution)
 vec3 remap1101(vec3 p) { return p * vec3(0.5f, 0.5f, 0.5f) + vec3(0.5f); }
 // Check whether coordinate is in unit cube
 bool inVoxelGrid(const vec3 p, float e) { return abs(p.x) < 1 + e && abs(p.y) < 1 + e && abs(p.z) < 1 + e; }
+// Check whether texture space coordinate is within the grid's window
+bool inVoxelWindow(const vec3 tc) { return all(greaterThanEqual(tc, vec3(0.0))) && all(lessThan(tc, vec3(1.0))); }
+
+// Window -> toroidal texture space, textures repeat
+vec3 VoxelToroidalUVW(vec3 tc, vec3 offset) { return tc + offset * (1.0 / u_VoxelGridResolution); }
+
+// World Position -> Texture Space (0 : 1) of a clipmap level's window
+vec3 VoxelClipmapUVW(vec3 P, int level)
+{
+	float gridSize = u_VoxelGridSize * exp2(float(level));
+	// World Position -> Voxel Grid Space -> Clip Space (-1 : 1) -> Texture Space (0 : 1)
+	return remap1101((P - u_VoxelClipmapCentroids[level]) * (1.0 / u_VoxelGridResolution) * (1.0 / gridSize));
+}
+
+// Pool slot of an indirection entry, 10 bits per axis
+uvec3 UnpackBrickSlot(uint entry) { return uvec3(entry & 0x3FFu, (entry >> 10) & 0x3FFu, (entry >> 20) & 0x3FFu); }
+
+// Samples a brick map at toroidal texture space uvw, lods past the brick size come from the coarse texture
+vec4 SampleBrickMap(usampler3D indirection, sampler3D pool, sampler3D coarse, vec3 poolSize, vec3 uvw, float lod)
+{
+	float coarseLod = lod - float(VOXEL_BRICK_MIPS - 1);
+	if (coarseLod >= 0.0)
+		return textureLod(coarse, uvw, coarseLod);
+
+	vec3 texel = fract(uvw) * u_VoxelGridResolution;
+	ivec3 brick = ivec3(texel) / VOXEL_BRICK_SIZE;
+	uint entry = texelFetch(indirection, brick, 0).r;
+	if (entry == VOXEL_BRICK_EMPTY)
+		return vec4(0.0);
+
+	// neighbouring bricks aren't neighbours in the pool, clamp to this brick's texels at the lod
+	float border = 0.5 * exp2(ceil(lod));
+	vec3 local = clamp(texel - vec3(brick * VOXEL_BRICK_SIZE), vec3(border), vec3(float(VOXEL_BRICK_SIZE) - border));
+	return textureLod(pool, (vec3(UnpackBrickSlot(entry) * uint(VOXEL_BRICK_SIZE)) + local) / poolSize, lod);
+}
+
+// Samples the finest clipmap level containing P that is coarse enough for the mip,
+// mip is relative to level 0, dynamic voxels are composited over level 0's window
+bool SampleVoxelClipmaps(vec3 P, float mip, out vec4 sam)
+{
+	sam = vec4(0.0);
+	bool inClipmap = false;
+	int minLevel = clamp(int(floor(mip)), 0, VOXEL_CLIPMAP_LEVELS - 1);
+	for (int level = 0; level < VOXEL_CLIPMAP_LEVELS; ++level)
+	{
+		if (level < minLevel)
+			continue;
+		vec3 tc = VoxelClipmapUVW(P, level);
+		if (!inVoxelWindow(tc))
+			continue;
+		sam = SampleBrickMap(u_VoxelClipmapIndirection[level], u_VoxelClipmapPool[level], u_VoxelClipmapCoarse[level], u_VoxelClipmapPoolSize[level],
+			VoxelToroidalUVW(tc, u_VoxelClipmapOffsets[level]), max(mip - float(level), 0.0));
+		inClipmap = true;
+		break;
+	}
+
+	vec3 tc = VoxelClipmapUVW(P, 0);
+	if (inVoxelWindow(tc))
+	{
+		vec4 dynamicSam = SampleBrickMap(u_VoxelDynamicIndirection, u_VoxelDynamicPool, u_VoxelDynamicCoarse, u_VoxelDynamicPoolSize,
+			VoxelToroidalUVW(tc, u_VoxelClipmapOffsets[0]), mip);
+		sam.rgb = dynamicSam.rgb + (1.0 - dynamicSam.a) * sam.rgb;
+		sam.a = dynamicSam.a + (1.0 - dynamicSam.a) * sam.a;
+	}
+	return inClipmap;
+}
 
 
 const vec3 CONES[] = 
@@ -43,12 +109,12 @@ const vec3 CONES[] =
 // Implementation in Wicked Engine originally written in HLSL by Turnszki Jnos
 // https://github.com/turanszkij/WickedEngine/blob/master/WickedEngine/voxelConeTracingHF.hlsli
 
-// voxels:			3D Texture containing voxel scene with direct diffuse lighting (or direct + secondary indirect bounce)
+// voxels:			clipmaps containing voxel scene with direct diffuse lighting (or direct + secondary indirect bounce)
 // P:				world-space position of receiving surface
 // N:				world-space normal vector of receiving surface
 // coneDirection:	world-space cone direction in the direction to perform the trace
 // coneAperture:	tan(coneHalfAngle)
-vec4 ConeTrace(sampler3D voxels, vec3 P, vec3 N, vec3 coneDirection, float coneAperture)
+vec4 ConeTrace(vec3 P, vec3 N, vec3 coneDirection, float coneAperture)
 {
 	vec3 color;
 	float alpha;
@@ -62,24 +128,13 @@ vec4 ConeTrace(sampler3D voxels, vec3 P, vec3 N, vec3 coneDirection, float coneA
 	while (dist < u_VoxelRayMaxDistance && alpha < 1.0f)
 	{
 		float diameter = max(u_VoxelGridSize, 2.0 * coneAperture * dist);
-		float mip = log2(diameter * (1.0 / u_VoxelGridSize));
-
-		// Because we do the ray-marching in world space, we need to remap into 3d texture space before sampling:
-		//	todo: optimization could be doing ray-marching in texture space
-		vec3 tc = startPos + coneDirection * dist;
-		// World Position -> Voxel Grid Space
-		tc = (tc - u_VoxelGridCentroid) * (1.0 / u_VoxelGridResolution) * (1.0 / u_VoxelGridSize);
-		// Voxel Grid Space -> Clip Space (-1 : 1) -> Texture Space (0 : 1) 
-		tc = remap1101(tc);
-
-		// break if the ray exits the voxel grid, or we sample from the last mip:
-//		if (!inVoxelGrid(tc) || mip >= (float)g_xFrame_VoxelRadianceDataMIPs)
-//			break;
-		if (!inVoxelGrid(tc, 0.0))
-			break;
+		// a voxel spans two grid sizes
+		float mip = max(log2(diameter * (0.5 / u_VoxelGridSize)), 0.0);
 
-		// sample voxel grid
-		vec4 sam = textureLod(voxels, tc, mip);
+		// break if the ray exits the coarsest clipmap
+		vec4 sam;
+		if (!SampleVoxelClipmaps(startPos + coneDirection * dist, mip, sam))
+			break;
 
 		// this is the correct blending to avoid black-staircase artifact (ray stepped front-to back, so blend front to back):
 		float a = 1.0 - alpha;
@@ -96,7 +151,7 @@ vec4 ConeTrace(sampler3D voxels, vec3 P, vec3 N, vec3 coneDirection, float coneA
 // voxels:			3D Texture containing voxel scene with direct diffuse lighting (or direct + secondary indirect bounce)
 // P:				world-space position of receiving surface
 // N:				world-space normal vector of receiving surface
-vec4 ConeTraceRadiance(sampler3D voxels, vec3 P, vec3 N)
+vec4 ConeTraceRadiance(vec3 P, vec3 N)
 {
 	vec4 radiance;
 
@@ -108,7 +163,7 @@ vec4 ConeTraceRadiance(sampler3D voxels, vec3 P, vec3 N)
 		// if point on sphere is facing below normal (so it's located on bottom hemisphere), put it on the opposite hemisphere instead:
 		coneDirection *= dot(coneDirection, N) < 0 ? -1 : 1;
 
-		radiance += ConeTrace(voxels, P, N, coneDirection, tan(PI * 0.5f * 0.33f));
+		radiance += ConeTrace(P, N, coneDirection, tan(PI * 0.5f * 0.33f));
 	}
 
 	// final radiance is average of all the cones radiances
@@ -122,12 +177,12 @@ vec4 ConeTraceRadiance(sampler3D voxels, vec3 P, vec3 N)
 // P:				world-space position of receiving surface
 // N:				world-space normal vector of receiving surface
 // V:				world-space view-vector (cameraPosition - P)
-vec4 ConeTraceReflection(sampler3D voxels, vec3 P, vec3 N, vec3 ViewDir, float roughness)
+vec4 ConeTraceReflection(vec3 P, vec3 N, vec3 ViewDir, float roughness)
 {
 	float aperture = tan(roughness * PI * 0.5f * 0.1f);
 	vec3 coneDirection = reflect(-ViewDir, N);
 
-	vec4 reflection = ConeTrace(voxels, P, N, coneDirection, aperture);
+	vec4 reflection = ConeTrace(P, N, coneDirection, aperture);
 
 	return vec4(max(vec3(0.0), reflection.rgb), clamp(reflection.a, 0.0, 1.0));
 }
\ No newline at end of file
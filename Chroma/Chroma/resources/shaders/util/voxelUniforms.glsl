@@ -1,11 +1,39 @@
 // VOXEL GRID
-layout(rgba32f) uniform image3D u_VoxelWriteTexture;
+// brick pool being written or read directly
+layout(rgba16f) uniform image3D u_VoxelWriteTexture;
 uniform sampler3D u_VoxelTexture;
 
 uniform int u_VoxelGridResolution;
 uniform float u_VoxelGridSize;
 
 uniform vec3 u_VoxelGridCentroid;
+// toroidal addressing, texel the grid's minimum corner wraps to
+uniform vec3 u_VoxelGridOffset;
+// voxelization is limited to this range of grid voxels
+uniform vec3 u_VoxelRegionMin;
+uniform vec3 u_VoxelRegionMax;
+
+// BRICKS
+// the indirection table maps a brick to its pool slot, or empty
+const int VOXEL_BRICK_SIZE = #VXGI_BRICK_SIZE;
+const int VOXEL_BRICK_MIPS = findMSB(VOXEL_BRICK_SIZE) + 1;
+const uint VOXEL_BRICK_EMPTY = 0xFFFFFFFFu;
+uniform usampler3D u_VoxelIndirection;
+
+// CLIPMAPS
+// each level doubles the grid size of the last, the dynamic layer shares level 0
+// brick maps are an indirection table, a brick pool and a texel per brick for coarse lods
+const int VOXEL_CLIPMAP_LEVELS = #VXGI_CLIPMAP_LEVELS;
+uniform usampler3D u_VoxelClipmapIndirection[VOXEL_CLIPMAP_LEVELS];
+uniform sampler3D u_VoxelClipmapPool[VOXEL_CLIPMAP_LEVELS];
+uniform sampler3D u_VoxelClipmapCoarse[VOXEL_CLIPMAP_LEVELS];
+uniform vec3 u_VoxelClipmapPoolSize[VOXEL_CLIPMAP_LEVELS];
+uniform vec3 u_VoxelClipmapCentroids[VOXEL_CLIPMAP_LEVELS];
+uniform vec3 u_VoxelClipmapOffsets[VOXEL_CLIPMAP_LEVELS];
+uniform usampler3D u_VoxelDynamicIndirection;
+uniform sampler3D u_VoxelDynamicPool;
+uniform sampler3D u_VoxelDynamicCoarse;
+uniform vec3 u_VoxelDynamicPoolSize;
 
 // CONE TRACING
 uniform float u_VoxelRayMaxDistance;
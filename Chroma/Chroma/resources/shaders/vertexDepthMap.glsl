@@ -1,13 +1,18 @@
 #version 330 core
 
 layout (location = 0 ) in vec3 aPos;
-layout (location = 5) in int[#MAX_VERT_INFLUENCES] aJointIDs;
-layout (location = 6) in float[#MAX_VERT_INFLUENCES] aJointWeights;
+layout (location = 5) in ivec4 aJointIDs;
+layout (location = 6) in vec4 aJointWeights;
+layout (location = 9) in uint aDrawID;
 
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
 
+// indirect draws fetch the model matrix per draw
+uniform bool isIndirect;
+uniform samplerBuffer drawData;
+
 // CONSTS
 const int MAX_JOINTS = #MAX_JOINTS;
 
@@ -31,6 +36,13 @@ void main()
 		LocalPosition = BoneTransform * LocalPosition;
 	}
 
-	gl_Position = lightSpaceMatrix * model * LocalPosition;
+	mat4 Model = model;
+	if (isIndirect)
+	{
+		int DrawOffset = int(aDrawID) * 4;
+		Model = mat4(texelFetch(drawData, DrawOffset), texelFetch(drawData, DrawOffset + 1), texelFetch(drawData, DrawOffset + 2), texelFetch(drawData, DrawOffset + 3));
+	}
+
+	gl_Position = lightSpaceMatrix * Model * LocalPosition;
 
 }
\ No newline at end of file
@@ -2,21 +2,15 @@
 layout (location = 0 ) in vec3 aPos;
 layout (location = 1 ) in vec3 aNormal;
 layout (location = 2 ) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;  
-layout (location = 5) in int[#MAX_VERT_INFLUENCES] aJointIDs;
-layout (location = 6) in float[#MAX_VERT_INFLUENCES] aJointWeights;
+layout (location = 3) in vec4 aTangent; // w : bitangent sign
+layout (location = 5) in ivec4 aJointIDs;
+layout (location = 6) in vec4 aJointWeights;
 
 
 out VS_OUT{
-	vec3 FragWorldPos;
-	vec3 FragViewPos;
 	vec2 TexCoords;
-	vec4 FragPosLightSpace;
 	vec3 WorldNormal;
-	vec3 ViewNormal;
 	mat3 WorldTBN;
-	mat3 ViewTBN;
 } vs_out;
 
 // CONSTS
@@ -26,10 +20,10 @@ const int MAX_JOINTS = #MAX_JOINTS;
 // ubos
 #include "util/uniformBufferCamera.glsl"
 uniform mat4 model;
-uniform mat4 lightSpaceMatrix;
 // skinning
-uniform bool isSkinned;
+#ifdef SKINNED
 uniform mat4 aJoints[MAX_JOINTS];
+#endif
 
 
 void main()
@@ -37,7 +31,7 @@ void main()
 	vec4 LocalPosition = vec4(aPos , 1.0);
 	vec3 LocalNormal = aNormal;
 
-	if (isSkinned)
+#ifdef SKINNED
 	{
 		mat4 BoneTransform = mat4(0.0);
 		vec4 JointWeights = normalize(vec4(aJointWeights[0],aJointWeights[1],aJointWeights[2],aJointWeights[3] ));
@@ -47,34 +41,27 @@ void main()
 		}
 //		// Local Position
 		LocalPosition = BoneTransform * LocalPosition;
-//		// world and view, normals 
+//		// world normals 
 		vs_out.WorldNormal =  transpose(  inverse(mat3(model * BoneTransform))) * aNormal;
-		vs_out.ViewNormal =  transpose(inverse(mat3( view * model * BoneTransform))) * aNormal;
 		LocalNormal = transpose(  inverse(mat3(BoneTransform))) * aNormal;
 	}
-	else
+#else
 	{
-		// world and view, normals 
+		// world normals 
 		vs_out.WorldNormal =  transpose(  inverse(mat3(model))) * aNormal;
-		vs_out.ViewNormal =  transpose(inverse(mat3( view * model))) * aNormal;
 	}
+#endif
 
-	// world and view, positions
-	vs_out.FragWorldPos = vec3(model * LocalPosition) ;
-	vs_out.FragViewPos = vec3(view * vec4(vs_out.FragWorldPos, 1.0));
-
-	// uvs and shadowmapping lightspace
+	// uvs
     vs_out.TexCoords = aTexCoords;
-    vs_out.FragPosLightSpace = lightSpaceMatrix * vec4(vs_out.FragWorldPos , 1.0);
 	
 	// tbn
-	vec3 T = normalize(vec3( model * vec4(aTangent,    0.0)));
-    vec3 B = normalize(vec3( model * vec4(aBitangent,  0.0)));
-    vec3 N = normalize(vec3( model * vec4(LocalNormal, 0.0)));
+	vec3 T = normalize(vec3( model * vec4(aTangent.xyz, 0.0)));
+    vec3 N = normalize(vec3( model * vec4(LocalNormal,  0.0)));
+    vec3 B = cross(N, T) * aTangent.w;
 
-	// world and view tbn
+	// world tbn
 	vs_out.WorldTBN = mat3(T, B, N);
-	vs_out.ViewTBN = mat3(view) * vs_out.WorldTBN;
 	
     gl_Position = projection * view * model * LocalPosition;
 }
\ No newline at end of file
@@ -2,10 +2,9 @@
 layout (location = 0 ) in vec3 aPos;
 layout (location = 1 ) in vec3 aNormal;
 layout (location = 2 ) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;  
-layout (location = 5) in int[#MAX_VERT_INFLUENCES] aJointIDs;
-layout (location = 6) in float[#MAX_VERT_INFLUENCES] aJointWeights;
+layout (location = 3) in vec4 aTangent; // w : bitangent sign
+layout (location = 5) in ivec4 aJointIDs;
+layout (location = 6) in vec4 aJointWeights;
 layout (location = 7) in vec4 aColor;
 
 out VS_OUT{
@@ -46,9 +45,9 @@ void main()
     vs_out.Normal = transpose(inverse(mat3(model))) * aNormal;
     vs_out.TexCoords = aTexCoords;
     vs_out.FragPosLightSpace = lightSpaceMatrix * vec4( vs_out.FragPos , 1.0);
-	vec3 T = normalize(vec3(model * vec4(aTangent,   0.0)));
-    vec3 B = normalize(vec3(model * vec4(aBitangent, 0.0)));
-    vec3 N = normalize(vec3(model * vec4(aNormal,    0.0)));
+	vec3 T = normalize(vec3(model * vec4(aTangent.xyz, 0.0)));
+    vec3 N = normalize(vec3(model * vec4(aNormal,      0.0)));
+    vec3 B = cross(N, T) * aTangent.w;
 
 	vs_out.TBN = mat3(T, B, N);
 
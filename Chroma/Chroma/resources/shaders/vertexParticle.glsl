@@ -0,0 +1,20 @@
+#version 330 core
+// per particle, each stream from its own structure of arrays range
+layout (location = 0) in float aPositionX;
+layout (location = 1) in float aPositionY;
+layout (location = 2) in float aPositionZ;
+layout (location = 3) in float aScale;
+
+out vec2 TexCoords;
+
+#include "util/uniformBufferCamera.glsl"
+
+void main()
+{
+	// triangle strip quad from the vertex index, facing the camera
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+	TexCoords = corner;
+	vec4 viewPos = view * vec4(aPositionX, aPositionY, aPositionZ, 1.0);
+	viewPos.xy += (corner - 0.5) * aScale;
+	gl_Position = projection * viewPos;
+}
@@ -0,0 +1,30 @@
+#version 450 core
+// CDLOD node, grid vertices in 0-1 over the node
+layout (location = 0) in vec2 aGridPos;
+
+out vec2 WorldXZ;
+
+#include "util/uniformBufferCamera.glsl"
+#include "util/terrainFuncs.glsl"
+
+uniform vec2 nodeMin;
+uniform float nodeSize;
+uniform float gridResolution;
+// distances the node morphs to the next level over
+uniform vec2 morphRange;
+
+void main()
+{
+	vec2 gridPos = aGridPos;
+	vec2 worldXZ = nodeMin + gridPos * nodeSize;
+	float height = SampleTerrainHeight(worldXZ);
+
+	// odd vertices slide onto their even neighbours, matching the coarser level at the end of the range
+	float morph = clamp((distance(cameraPosition, vec3(worldXZ.x, height, worldXZ.y)) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+	gridPos -= fract(gridPos * gridResolution * 0.5) * 2.0 / gridResolution * morph;
+	worldXZ = nodeMin + gridPos * nodeSize;
+	height = SampleTerrainHeight(worldXZ);
+
+	WorldXZ = worldXZ;
+	gl_Position = projection * view * vec4(worldXZ.x, height, worldXZ.y, 1.0);
+}
@@ -0,0 +1,37 @@
+#version 450 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec4 aTangent; // w : bitangent sign
+layout (location = 7) in vec4 aColor;
+// per instance
+layout (location = 10) in vec3 aInstancePosition;
+layout (location = 11) in uint aInstancePacked;
+
+out VS_OUT{
+	vec2 TexCoords;
+	vec3 WorldNormal;
+	mat3 WorldTBN;
+	float Variation;
+} vs_out;
+
+// UNIFORMS
+#include "util/uniformBufferCamera.glsl"
+#include "util/vegetationFuncs.glsl"
+
+void main()
+{
+	vec3 worldPosition = InstanceWorldPosition(aPos, aColor, aInstancePosition, aInstancePacked);
+
+	// uniform scale, rotation alone transforms normals
+	mat3 rotationMatrix = InstanceRotation(aInstancePacked);
+	vec3 N = normalize(rotationMatrix * aNormal);
+	vec3 T = normalize(rotationMatrix * aTangent.xyz);
+	vec3 B = cross(N, T) * aTangent.w;
+	vs_out.WorldNormal = N;
+	vs_out.WorldTBN = mat3(T, B, N);
+	vs_out.TexCoords = aTexCoords;
+	vs_out.Variation = InstanceSeed(aInstancePacked);
+
+	gl_Position = projection * view * vec4(worldPosition, 1.0);
+}
@@ -0,0 +1,19 @@
+#version 450 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in vec4 aColor;
+// per instance
+layout (location = 10) in vec3 aInstancePosition;
+layout (location = 11) in uint aInstancePacked;
+
+out vec2 TexCoords;
+
+// UNIFORMS
+uniform mat4 lightSpaceMatrix;
+#include "util/vegetationFuncs.glsl"
+
+void main()
+{
+	TexCoords = aTexCoords;
+	gl_Position = lightSpaceMatrix * vec4(InstanceWorldPosition(aPos, aColor, aInstancePosition, aInstancePacked), 1.0);
+}
@@ -7,24 +7,31 @@ in vec2 TexCoords;
 #include "util/voxelFuncs.glsl"
 
 // textures
-uniform sampler2D u_PositionsWS;
-uniform sampler2D u_NormalsWS;
+uniform sampler2D u_Depth;
+uniform sampler2D u_Normals;
 uniform sampler2D u_MetRoughAO;
 
 // Camera
 #include "util/uniformBufferCamera.glsl"
+#include "util/gBufferFuncs.glsl"
 
 void main()
 {	
-	vec3 PosWS = texture(u_PositionsWS, TexCoords.st).xyz;
-	vec3 NormWS = normalize(texture(u_NormalsWS, TexCoords.st).xyz);
+	float Depth = texture(u_Depth, TexCoords.st).r;
+	if (Depth >= 1.0)
+	{
+		FragColor = vec4(0.0);
+		return;
+	}
+	vec3 PosWS = WorldPositionFromDepth(Depth, TexCoords.st);
+	vec3 NormWS = DecodeOctNormal(texture(u_Normals, TexCoords.st).rg);
 	vec4 MetRoughAO = texture(u_MetRoughAO, TexCoords.st);
 
 	// Radiance
-	vec4 radiance = ConeTraceRadiance(u_VoxelTexture, PosWS, NormWS);
+	vec4 radiance = ConeTraceRadiance(PosWS, NormWS);
 	// Reflection
 	vec3 viewDir = (cameraPosition - PosWS);
-	vec4 reflection = ConeTraceReflection(u_VoxelTexture, PosWS, NormWS, viewDir, MetRoughAO.g);
+	vec4 reflection = ConeTraceReflection(PosWS, NormWS, viewDir, MetRoughAO.g);
 
 	// OUT
 	FragColor = radiance;
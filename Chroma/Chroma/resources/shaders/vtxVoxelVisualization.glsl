@@ -1,5 +1,6 @@
 #version 450 core
-layout(location = 0) in vec3 aPos;
+// brick within the grid, per instance
+layout(location = 0) in vec3 aBrick;
 
 // VOXELS
 #include "util/voxelUniforms.glsl"
@@ -16,8 +17,13 @@ out VS_OUT{
 
 
 void main(){
-	ivec3 voxelSampleUVW = unflatten3D(gl_VertexID, u_VoxelGridResolution);
-	vs_out.voxelColorGeom = texelFetch(u_VoxelTexture, voxelSampleUVW, 0);
+	// a point per voxel of the brick
+	ivec3 voxelSampleUVW = ivec3(aBrick) * VOXEL_BRICK_SIZE + unflatten3D(gl_VertexID, VOXEL_BRICK_SIZE);
+	// toroidal texel -> brick pool texel
+	ivec3 voxelTexel = (voxelSampleUVW + ivec3(u_VoxelGridOffset)) % u_VoxelGridResolution;
+	uint brickEntry = texelFetch(u_VoxelIndirection, voxelTexel / VOXEL_BRICK_SIZE, 0).r;
+	vs_out.voxelColorGeom = brickEntry == VOXEL_BRICK_EMPTY ? vec4(0.0)
+		: texelFetch(u_VoxelTexture, ivec3(UnpackBrickSlot(brickEntry)) * VOXEL_BRICK_SIZE + voxelTexel % VOXEL_BRICK_SIZE, 0);
 	
 	vs_out.VPMatGeom = projection * view;
 	gl_Position =  vec4(voxelSampleUVW, 1.0);  
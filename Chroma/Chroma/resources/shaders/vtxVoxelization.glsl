@@ -3,8 +3,8 @@
 layout (location = 0 ) in vec3 aPos;
 layout (location = 1 ) in vec3 aNormal;
 layout (location = 2 ) in vec2 aTexCoords;
-layout (location = 5) in int[#MAX_VERT_INFLUENCES] aJointIDs;
-layout (location = 6) in float[#MAX_VERT_INFLUENCES] aJointWeights;
+layout (location = 5) in ivec4 aJointIDs;
+layout (location = 6) in vec4 aJointWeights;
 
 out VS_OUT{
 	out vec3 worldPositionGeom;
@@ -59,9 +59,6 @@ namespace Chroma
 		// ____________________________________________________
 		// SHADERS
 		// ____________________________________________________
-		Shader UnlitShader("resources/shaders/fragBasic.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
-		UnlitShader.Use();
-		UnlitShader.SetUniform("color", glm::vec3(1, 1, 0));
 		Shader SemiTransparentShader("resources/shaders/fragPBRAlpha.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
 		Shader PBRShader("resources/shaders/fragPBR.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
 
@@ -220,6 +217,7 @@ namespace Chroma
 		TerrainMeshComponent->AddTexture(woodBoardsNormal);
 		TerrainMeshComponent->AddTexture(woodBoardsMetRoughAO);
 		TerrainMeshComponent->GetMaterial().SetUVMultiply(8.0);
+		TerrainMeshComponent->SetIsStatic(true);
 		TerrainEntity->AddComponent(TerrainMeshComponent);
 
 		// rigid
@@ -238,6 +236,7 @@ namespace Chroma
 		TerrainMesh2Component->AddTexture(woodBoardsNormal);
 		TerrainMesh2Component->AddTexture(woodBoardsMetRoughAO);
 		TerrainMesh2Component->GetMaterial().SetUVMultiply(8.0);
+		TerrainMesh2Component->SetIsStatic(true);
 		TerrainEntity2->AddComponent(TerrainMesh2Component);
 
 		// rigid
@@ -257,6 +256,7 @@ namespace Chroma
 		TerrainMesh3Component->AddTexture(woodBoardsNormal);
 		TerrainMesh3Component->AddTexture(woodBoardsMetRoughAO);
 		TerrainMesh3Component->GetMaterial().SetUVMultiply(8.0);
+		TerrainMesh3Component->SetIsStatic(true);
 		TerrainEntity3->AddComponent(TerrainMesh3Component);
 
 		// rigid
@@ -275,6 +275,7 @@ namespace Chroma
 		TerrainMesh4Component->AddTexture(woodBoardsNormal);
 		TerrainMesh4Component->AddTexture(woodBoardsMetRoughAO);
 		TerrainMesh4Component->GetMaterial().SetUVMultiply(8.0);
+		TerrainMesh4Component->SetIsStatic(true);
 		TerrainEntity4->AddComponent(TerrainMesh4Component);
 
 		// rigid
@@ -733,18 +734,28 @@ namespace Chroma
 		// walls
 		MeshComponent* wallBackMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereBackWall.fbx");
 		wallBackMeshComponent->SetMaterial(wallMat);
+		wallBackMeshComponent->SetIsStatic(true);
+		wallBackMeshComponent->SetIsOccluder(true);
 		CornellBoxEntity->AddComponent(wallBackMeshComponent);
 		MeshComponent* wallLeftMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereLeftWall.fbx");
 		wallLeftMeshComponent->SetMaterial(wallMat);
+		wallLeftMeshComponent->SetIsStatic(true);
+		wallLeftMeshComponent->SetIsOccluder(true);
 		CornellBoxEntity->AddComponent(wallLeftMeshComponent);
 		MeshComponent* wallRightMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereRightWall.fbx");
 		wallRightMeshComponent->SetMaterial(wallMat);
+		wallRightMeshComponent->SetIsStatic(true);
+		wallRightMeshComponent->SetIsOccluder(true);
 		CornellBoxEntity->AddComponent(wallRightMeshComponent);
 		MeshComponent* wallCeilingMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereCeiling.fbx");
 		wallCeilingMeshComponent->SetMaterial(wallMat);
+		wallCeilingMeshComponent->SetIsStatic(true);
+		wallCeilingMeshComponent->SetIsOccluder(true);
 		CornellBoxEntity->AddComponent(wallCeilingMeshComponent);
 		MeshComponent* wallFloorMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereFloor.fbx");
 		wallFloorMeshComponent->SetMaterial(wallMat);
+		wallFloorMeshComponent->SetIsStatic(true);
+		wallFloorMeshComponent->SetIsOccluder(true);
 		CornellBoxEntity->AddComponent(wallFloorMeshComponent);
 		// balls
 		MeshComponent* leftBallMeshComponent = new StaticMesh("resources/lookdev/CornellBox/sphereLeft.fbx");
@@ -839,6 +850,7 @@ namespace Chroma
 
 		MeshComponent* SponzaMaterialMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_cloth_red.fbx");
 		SponzaMaterialMeshComponent->SetMaterial(RedClothMaterial);
+		SponzaMaterialMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(SponzaMaterialMeshComponent);
 
 
@@ -852,6 +864,7 @@ namespace Chroma
 
 		MeshComponent* SponzaGreenMaterialMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_cloth_green.fbx");
 		SponzaGreenMaterialMeshComponent->SetMaterial(GreenClothMaterial);
+		SponzaGreenMaterialMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(SponzaGreenMaterialMeshComponent);
 
 
@@ -865,6 +878,7 @@ namespace Chroma
 
 		MeshComponent* SponzaBlueMaterialMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_cloth_blue.fbx");
 		SponzaBlueMaterialMeshComponent->SetMaterial(BlueClothMaterial);
+		SponzaBlueMaterialMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(SponzaBlueMaterialMeshComponent);
 
 
@@ -891,6 +905,7 @@ namespace Chroma
 		VaseFlowerMeshComponent->SetIsLit(false);
 		//VaseFlowerMeshComponent->SetIsTransparent(true);
 		VaseFlowerMeshComponent->SetIsForwardLit(true);
+		VaseFlowerMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(VaseFlowerMeshComponent);
 
 		// vase
@@ -907,6 +922,7 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* SponzaVaseComponent = new StaticMesh("resources/lookdev/Sponza/sponza_vase_ground_base.obj");
 		SponzaVaseComponent->SetMaterial(vaseGroundMat);
+		SponzaVaseComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(SponzaVaseComponent);
 
 		// GROUND
@@ -923,6 +939,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* GroundMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_ground.fbx");
 		GroundMeshComponent->SetMaterial(groundMat);
+		GroundMeshComponent->SetIsStatic(true);
+		GroundMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(GroundMeshComponent);
 
 		// ARCHES
@@ -939,6 +957,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* ArchMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_arches.fbx");
 		ArchMeshComponent->SetMaterial(archMat);
+		ArchMeshComponent->SetIsStatic(true);
+		ArchMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(ArchMeshComponent);
 
 		// ROOF
@@ -955,6 +975,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* roofMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_roof.fbx");
 		roofMeshComponent->SetMaterial(roofMat);
+		roofMeshComponent->SetIsStatic(true);
+		roofMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(roofMeshComponent);
 
 		// WALLS
@@ -971,6 +993,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* WallsMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_walls.fbx");
 		WallsMeshComponent->SetMaterial(wallsMat);
+		WallsMeshComponent->SetIsStatic(true);
+		WallsMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(WallsMeshComponent);
 
 		// LION
@@ -987,6 +1011,7 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* lionMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_LionHead.fbx");
 		lionMeshComponent->SetMaterial(lionMat);
+		lionMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(lionMeshComponent);
 
 		// COLUMNS
@@ -1003,11 +1028,15 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* columnAMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_columns_ground.fbx");
 		columnAMeshComponent->SetMaterial(columnAMat);
+		columnAMeshComponent->SetIsStatic(true);
+		columnAMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(columnAMeshComponent);
 
 		// Mesh component
 		MeshComponent* columnsTopFloorBAMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_columnsB_firstFloor.fbx");
 		columnsTopFloorBAMeshComponent->SetMaterial(columnAMat);
+		columnsTopFloorBAMeshComponent->SetIsStatic(true);
+		columnsTopFloorBAMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(columnsTopFloorBAMeshComponent);
 
 
@@ -1028,6 +1057,7 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* curtainRedMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_curtain_red.fbx");
 		curtainRedMeshComponent->SetMaterial(curtainRedMaterial);
+		curtainRedMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(curtainRedMeshComponent);
 
 
@@ -1044,6 +1074,7 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* curtainBlueMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_curtain_blue.fbx");
 		curtainBlueMeshComponent->SetMaterial(curtainBlueMaterial);
+		curtainBlueMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(curtainBlueMeshComponent);
 
 
@@ -1060,6 +1091,7 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* curtainGreenMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_curtain_green.fbx");
 		curtainGreenMeshComponent->SetMaterial(curtainGreenMaterial);
+		curtainGreenMeshComponent->SetIsStatic(true);
 		SponzaEntity->AddComponent(curtainGreenMeshComponent);
 
 		// COLUMNS Top floor
@@ -1075,6 +1107,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* ColumnsTopFloorMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_columns_firstFloor.fbx");
 		ColumnsTopFloorMeshComponent->SetMaterial(columnAMat);
+		ColumnsTopFloorMeshComponent->SetIsStatic(true);
+		ColumnsTopFloorMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(ColumnsTopFloorMeshComponent);
 
 
@@ -1091,6 +1125,8 @@ namespace Chroma
 		// Mesh component
 		MeshComponent* CeilingsMeshComponent = new StaticMesh("resources/lookdev/Sponza/sponza_ceilings.fbx");
 		CeilingsMeshComponent->SetMaterial(CeilingsMaterial);
+		CeilingsMeshComponent->SetIsStatic(true);
+		CeilingsMeshComponent->SetIsOccluder(true);
 		SponzaEntity->AddComponent(CeilingsMeshComponent);
 
 
@@ -4,6 +4,10 @@
 #include <physics/PhysicsEngine.h>
 #include <render/Render.h>
 #include <buffer/GBuffer.h>
+#include <buffer/VXGIBuffer.h>
+#include <quality/RenderQuality.h>
+#include <quality/DynamicResolution.h>
+#include <quality/QualityGovernor.h>
 #include <entity/Entity.h>
 
 #include <ui/uicomponents/TransformGizmo.h>
@@ -123,13 +127,13 @@ namespace Chroma
 		m_ViewportWindowFlags |= ImGuiWindowFlags_NoTitleBar;
 		m_ViewportWindowFlags |= ImGuiWindowFlags_NoScrollbar;
 
-		// ICONS
-		m_LightsIcon = Texture( "resources/icons/lights_icon.png" );
-		m_LightSunIcon = Texture("resources/icons/light_sun.png"); 
-		m_LightPointIcon = Texture("resources/icons/light_point.png");
+		// ICONS, no draw requests their mips so they load fully resident
+		m_LightsIcon = Texture( "resources/icons/lights_icon.png", false );
+		m_LightSunIcon = Texture("resources/icons/light_sun.png", false); 
+		m_LightPointIcon = Texture("resources/icons/light_point.png", false);
 		
-		m_ImportIcon = Texture("resources/icons/import_icon.png"); 
-		m_TextureIcon = Texture("resources/icons/texture_icon.png"); 
+		m_ImportIcon = Texture("resources/icons/import_icon.png", false); 
+		m_TextureIcon = Texture("resources/icons/texture_icon.png", false); 
 
 		// GIZMOS
 		m_TransformGizmo = new TransformGizmo();
@@ -615,6 +619,25 @@ namespace Chroma
 		}
 
 
+		// RENDER FLAGS
+		ImGui::Text("Render Flags");
+		ImGui::Separator();
+		for (auto& boolProperty : objectSerializer->m_BoolProperties)
+		{
+			if (boolProperty.first.m_EditorProperty.m_Type == Chroma::Type::EditorProperty::kRenderFlagProperty)
+			{
+				if (ImGui::Checkbox(boolProperty.first.m_Name, boolProperty.second) && component != nullptr && Type::IsMeshComponent(component->GetType()))
+				{
+					// scene flag sets and baked static voxels follow the new flags
+					Scene::ProcessMeshComponentRenderFlags(component);
+					if (Render::GetVXGIBuffer() != nullptr)
+						static_cast<VXGIBuffer*>(Render::GetVXGIBuffer())->InvalidateVoxels();
+				}
+				ImGui::Separator();
+			}
+		}
+
+
 		// MATERIALS
 		ImGui::Text("Materials");
 		ImGui::Separator();
@@ -744,6 +767,19 @@ namespace Chroma
 	void EditorUI::DrawRenderSettingsTab()
 	{
 		ImGui::Begin("Render Settings");
+		// the governor steps below the chosen tier when over budget
+		int qualityTier = (int)QualityGovernor::GetMaxTier();
+		if (ImGui::Combo("Quality", &qualityTier, "Low\0Medium\0High\0Ultra\0"))
+			QualityGovernor::SetMaxTier((QualityTier)qualityTier);
+		bool qualityGovernor = QualityGovernor::GetIsEnabled();
+		if (ImGui::Checkbox("Quality Governor", &qualityGovernor))
+			QualityGovernor::SetEnabled(qualityGovernor);
+		bool dynamicResolution = DynamicResolution::GetIsEnabled();
+		if (ImGui::Checkbox("Dynamic Resolution", &dynamicResolution))
+			DynamicResolution::SetEnabled(dynamicResolution);
+		float targetFrameTime = DynamicResolution::GetTargetFrameTime();
+		if (ImGui::SliderFloat("Target GPU Frame Time (ms)", &targetFrameTime, 4.0f, 50.0f))
+			DynamicResolution::SetTargetFrameTime(targetFrameTime);
 		ImGui::SliderFloat("Exposure", &static_cast<PostFXBuffer*>(Render::GetPostFXBuffer())->m_Exposure, 0.0f, 5.0f);
 		ImGui::SliderFloat("Gamma", &static_cast<PostFXBuffer*>(Render::GetPostFXBuffer())->m_Gamma, 0.0f, 5.0f);
 		ImGui::SliderFloat("Bloom Amount", &static_cast<PostFXBuffer*>(Render::GetPostFXBuffer())->m_BloomAmount, 0.0f, 5.0f);
@@ -916,7 +952,7 @@ namespace Chroma
 		// Normals
 		ImGui::BeginChild("Normals", ImVec2((float)m_ViewportWidth * debugScale, (float)m_ViewportHeight * debugScale), true);
 		p = ImGui::GetCursorScreenPos();
-		ImGui::Image((void*)(intptr_t)Chroma::Render::GetWSNormals(),
+		ImGui::Image((void*)(intptr_t)Chroma::Render::GetNormals(),
 			ImGui::GetWindowSize(),
 			ImVec2(0, 1), ImVec2(1, 0));
 		ImGui::EndChild();
@@ -946,15 +982,15 @@ namespace Chroma
 		ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(p.x + 10, p.y + 10), IM_COL32(255, 255, 255, 255), "SSAO", NULL, 0.0f);
 		ImGui::EndChild();
 
-		// Positions
-		ImGui::BeginChild("Positions", ImVec2((float)m_ViewportWidth * debugScale, (float)m_ViewportHeight * debugScale), true);
+		// Depth
+		ImGui::BeginChild("Depth", ImVec2((float)m_ViewportWidth * debugScale, (float)m_ViewportHeight * debugScale), true);
 		p = ImGui::GetCursorScreenPos();
-		ImGui::Image((void*)(intptr_t)Chroma::Render::GetWSPositions(),
+		ImGui::Image((void*)(intptr_t)Chroma::Render::GetDepth(),
 			ImGui::GetWindowSize(),
 			ImVec2(0, 1), ImVec2(1, 0));
 		ImGui::EndChild();
-		ImGui::BeginChild("Positions");
-		ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(p.x + 10, p.y + 10), IM_COL32(255, 255, 255, 255), "WS Positions", NULL, 0.0f);
+		ImGui::BeginChild("Depth");
+		ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(p.x + 10, p.y + 10), IM_COL32(255, 255, 255, 255), "Depth", NULL, 0.0f);
 		ImGui::EndChild();
 
 		// Direct Lighting Shadows
@@ -1079,6 +1115,19 @@ namespace Chroma
 				std::string GameTime("Game Time : ");
 				GameTime.append(std::to_string(GAMETIME));
 				debugStrings.push_back(GameTime);
+				// GPU Time
+				std::string GPUTime("GPU Time : ");
+				GPUTime.append(std::to_string(DynamicResolution::GetGPUFrameTime()));
+				debugStrings.push_back(GPUTime);
+				// Render Resolution
+				std::string RenderResolution("Render Resolution : ");
+				RenderResolution.append(std::to_string(Render::GetRenderWidth()) + " x " + std::to_string(Render::GetRenderHeight()));
+				RenderResolution.append(" (" + std::to_string(DynamicResolution::GetRenderScale()) + ")");
+				debugStrings.push_back(RenderResolution);
+				// Quality Tier
+				std::string Quality("Quality : ");
+				Quality.append(RenderQuality::GetTierName(RenderQuality::GetTier()));
+				debugStrings.push_back(Quality);
 				
 				for (unsigned int i =0 ; i < debugStrings.size() ; i ++)
 				{
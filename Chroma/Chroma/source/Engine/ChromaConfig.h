@@ -27,6 +27,141 @@
 // SHADOWS
 #define SHADOW_NUMCASCADES 3
 
+// CULLING
+#define OCCLUSION_BUFFER_WIDTH 256
+#define OCCLUSION_BUFFER_HEIGHT 128
+#define OCCLUSION_TILE_WIDTH 64
+#define OCCLUSION_TILE_HEIGHT 32
+
+// LOD
+#define MESH_LOD_COUNT 4
+#define MESH_LOD_REDUCTION 0.5f
+#define MESH_LOD_MIN_TRIANGLES 64
+#define MESH_LOD_MAX_ERROR 0.01f
+#define MESH_LOD_SCREEN_SIZE 0.5f
+#define MESH_LOD_HYSTERESIS 0.1f
+
+// MESHLETS
+#define MESHLET_MAX_VERTICES 64
+#define MESHLET_MAX_TRIANGLES 124
+#define MESHLET_MIN_MESH_TRIANGLES 8192
+
+// MESH OPTIMIZER
+#define MESH_OPTIMIZER_CACHE_SIZE 32
+#define MESH_OPTIMIZER_ACMR_CACHE_SIZE 16
+#define MESH_OPTIMIZER_MIN_CLUSTER_TRIANGLES 32
+
+// GEOMETRY POOL
+#define GEOMETRY_POOL_INITIAL_VERTICES 262144
+#define GEOMETRY_POOL_INITIAL_INDICES 1048576
+#define GEOMETRY_POOL_MAX_DRAWS 16384
+#define GEOMETRY_POOL_DRAW_DATA_UNIT 15
+
+// STATIC BATCHING
+#define STATIC_BATCH_CHUNK_SIZE 16.0f
+#define STATIC_BATCH_MAX_VERTICES 65536
+
+// SHADERS
+#define SHADER_BINARY_CACHE_ENABLED true
+#define SHADER_BINARY_CACHE_DIR "resources/shadercache"
+#define SHADER_PARALLEL_COMPILE_ENABLED true
+
+// IBL
+// baked maps are cached on disk, keyed by the source HDR and these settings
+#define IBL_CACHE_ENABLED true
+#define IBL_CACHE_DIR "resources/iblcache"
+#define IBL_ENV_CUBEMAP_SIZE 512
+#define IBL_PREFILTER_SIZE 128
+#define IBL_PREFILTER_MIPS 5
+#define IBL_BRDF_LUT_SIZE 512
+
+// TEXTURE STREAMING
+// images are decoded and compressed once into a mip cache, mips this size and smaller are always resident,
+// finer mips are streamed in as projected size requests them while the budget allows
+// without streaming every mip stays resident
+#define TEXTURE_STREAMING_ENABLED true
+#define TEXTURE_STREAMING_CACHE_DIR "resources/texturecache"
+#define TEXTURE_STREAMING_RESIDENT_SIZE 128
+#define TEXTURE_STREAMING_BUDGET_MB 512
+#define TEXTURE_STREAMING_MAX_PENDING 4
+
+// TEXTURE COMPRESSION
+// cached mips are encoded to BC1, BC4 or BC5 by channel count, alpha uses BC7 or BC3, normal maps BC5
+#define TEXTURE_COMPRESSION_ENABLED true
+#define TEXTURE_COMPRESSION_BC7 true
+
+// PARTICLES
+// particles integrated per job, a multiple of 4 for the SIMD kernel
+#define PARTICLE_JOB_SIZE 16384
+
+// TERRAIN
+// the world is a grid of square chunks, each with its own heightmap and splat map on disk,
+// neighbouring chunks share their border samples
+#define TERRAIN_DATA_DIR "resources/terrain"
+#define TERRAIN_CHUNK_SIZE 256.0f
+#define TERRAIN_HEIGHT_RESOLUTION 257
+#define TERRAIN_SPLAT_RESOLUTION 256
+#define TERRAIN_HEIGHT_SCALE 128.0f
+// CDLOD, each level doubles the node size and the distance it covers, nodes share one
+// grid mesh and vertices morph to the coarser level over the end of each range
+#define TERRAIN_LOD_LEVELS 5
+#define TERRAIN_LOD_RANGE 48.0f
+#define TERRAIN_LOD_MORPH_START 0.7f
+#define TERRAIN_GRID_RESOLUTION 16
+// chunks within the radius around the camera are streamed in, unloaded one chunk further out
+#define TERRAIN_STREAM_RADIUS 2
+#define TERRAIN_MAX_UPLOADS_PER_FRAME 2
+#define TERRAIN_FRICTION 10.0f
+
+// VEGETATION
+// instances are sorted into square cells, the unit of culling and LOD selection
+#define VEGETATION_CELL_SIZE 16.0f
+
+// DEBUG
+// line vertices the debug buffer starts with, grows by doubling
+#define DEBUG_BUFFER_INITIAL_VERTICES 65536
+
+// RENDER GRAPH
+// pooled transient targets no pass used for this many frames are freed
+#define RENDER_GRAPH_POOL_FRAMES 8
+
+// QUALITY
+// 0 low, 1 medium, 2 high, 3 ultra
+#define RENDER_QUALITY_DEFAULT_TIER 3
+
+// DYNAMIC RESOLUTION
+// render scale steps between min and max, down when the GPU frame time passes
+// target * downscale threshold, up when it falls under target * upscale threshold
+#define DYNAMIC_RESOLUTION_ENABLED true
+#define DYNAMIC_RESOLUTION_TARGET_FRAME_TIME (1000.0f / CHROMA_MAX_FRAME_RATE)
+#define DYNAMIC_RESOLUTION_MIN_SCALE 0.5f
+#define DYNAMIC_RESOLUTION_MAX_SCALE 1.0f
+#define DYNAMIC_RESOLUTION_STEP 0.05f
+#define DYNAMIC_RESOLUTION_DOWNSCALE_THRESHOLD 0.95f
+#define DYNAMIC_RESOLUTION_UPSCALE_THRESHOLD 0.75f
+#define DYNAMIC_RESOLUTION_COOLDOWN_FRAMES 15
+#define DYNAMIC_RESOLUTION_SHARPNESS 0.25f
+#define GPU_TIMER_QUERY_LATENCY 4
+
+// QUALITY GOVERNOR
+// steps the quality tier once dynamic resolution is at its bounds, thresholds are shared
+#define QUALITY_GOVERNOR_ENABLED true
+#define QUALITY_GOVERNOR_COOLDOWN_FRAMES 90
+#define QUALITY_GOVERNOR_MAX_DECISIONS 16
+
+// VXGI
+// clipmap levels double in size, each scrolls in steps of the granularity (in voxels)
+// so mips stay aligned, only newly exposed slabs are voxelized
+#define VXGI_CLIPMAP_LEVELS 2
+#define VXGI_CLIPMAP_RESOLUTION 128
+#define VXGI_SCROLL_GRANULARITY 8
+// voxels are stored sparsely in bricks, only bricks the occupancy pass finds geometry in
+// are allocated from a pool atlas of width x width x depth bricks, depth doubles when full
+#define VXGI_BRICK_SIZE 8
+#define VXGI_BRICK_POOL_WIDTH 8
+#define VXGI_BRICK_POOL_INITIAL_DEPTH 4
+#define VXGI_BRICK_POOL_MAX_DEPTH 256
+
 // LIGHTING
 #define MAX_POINT_LIGHTS 20
 #define MAX_DIRECTIONAL_LIGHTS 2
@@ -2,6 +2,7 @@
 #include <entity/IEntity.h>
 #include <scene/Scene.h>
 #include <resources/ModelLoader.h>
+#include <resources/TextureStreamer.h>
 
 
 namespace Chroma
@@ -55,6 +56,192 @@ namespace Chroma
 	}
 
 
+	std::vector<unsigned int> MeshComponent::BuildIndexData()
+	{
+		// culled ranges never outlive a rebuild
+		m_MeshletsCulled = false;
+
+		// LOD0 followed by each simplified LOD in a single element buffer
+		unsigned int indexCount = (unsigned int)m_MeshData.indices.size();
+		for (MeshLOD& lod : m_MeshData.lods)
+		{
+			lod.indexOffset = indexCount;
+			lod.indexCount = (unsigned int)lod.indices.size();
+			indexCount += lod.indexCount;
+		}
+
+		// 16 bit indices whenever every vertex can be addressed
+		size_t vertexCount = m_MeshData.isSkinned ? m_MeshData.skinnedVerts.size() : m_MeshData.verts.size();
+		m_IndexType = vertexCount <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+		std::vector<unsigned int> allIndices;
+		allIndices.reserve(indexCount);
+		allIndices.insert(allIndices.end(), m_MeshData.indices.begin(), m_MeshData.indices.end());
+		for (MeshLOD& lod : m_MeshData.lods)
+		{
+			allIndices.insert(allIndices.end(), lod.indices.begin(), lod.indices.end());
+			// lod indices are only needed on the GPU
+			lod.indices.clear();
+			lod.indices.shrink_to_fit();
+		}
+		return allIndices;
+	}
+
+	void MeshComponent::SetupIndexBuffer()
+	{
+		std::vector<unsigned int> allIndices = BuildIndexData();
+		if (m_IndexType == GL_UNSIGNED_SHORT)
+		{
+			std::vector<unsigned short> shortIndices(allIndices.begin(), allIndices.end());
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(unsigned short), shortIndices.data(), GL_STATIC_DRAW);
+		}
+		else
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, allIndices.size() * sizeof(unsigned int), allIndices.data(), GL_STATIC_DRAW);
+	}
+
+	void MeshComponent::DrawPooled(Shader& shader)
+	{
+		m_Material.SetMaterialUniforms(shader);
+		m_Material.SetTextureUniforms(shader);
+		DrawElements();
+	}
+
+	void MeshComponent::GetLODIndexRange(unsigned int& firstIndex, unsigned int& indexCount)
+	{
+		firstIndex = m_GeometryAllocation.firstIndex;
+		indexCount = (unsigned int)m_MeshData.indices.size();
+		if (m_LOD > 0 && m_LOD <= m_MeshData.lods.size())
+		{
+			firstIndex += m_MeshData.lods[m_LOD - 1].indexOffset;
+			indexCount = m_MeshData.lods[m_LOD - 1].indexCount;
+		}
+	}
+
+	void MeshComponent::DrawElements()
+	{
+		// visible meshlet ranges
+		if (m_MeshletsCulled)
+		{
+			m_MeshletsCulled = false;
+			if (!m_VisibleIndexCounts.empty())
+				glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_VisibleIndexCounts.data(), m_IndexType, m_VisibleIndexOffsets.data(), (GLsizei)m_VisibleIndexCounts.size(), m_VisibleBaseVertices.data());
+			return;
+		}
+
+		unsigned int firstIndex, indexCount;
+		GetLODIndexRange(firstIndex, indexCount);
+		glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, m_IndexType, (void*)((size_t)firstIndex * GetIndexSize()), (GLint)m_GeometryAllocation.baseVertex);
+	}
+
+	void MeshComponent::UpdateLOD(Camera& renderCam)
+	{
+		// bounding sphere in world space
+		glm::mat4 worldTransform = GetWorldTransform();
+		glm::vec3 center = glm::vec3(worldTransform * glm::vec4((m_MeshData.bboxMin + m_MeshData.bboxMax) * 0.5f, 1.0f));
+		float scale = glm::max(glm::length(glm::vec3(worldTransform[0])), glm::max(glm::length(glm::vec3(worldTransform[1])), glm::length(glm::vec3(worldTransform[2]))));
+		float radius = glm::length(m_MeshData.bboxMax - m_MeshData.bboxMin) * 0.5f * scale;
+
+		// projected height as a fraction of the screen, also picks the texture mips to stream
+		float screenSize = TextureStreamer::GetScreenSize(renderCam, center, radius);
+		TextureStreamer::RequestMaterial(m_Material, screenSize);
+
+		if (m_MeshData.lods.empty() || screenSize == FLT_MAX)
+		{
+			m_LOD = 0;
+			return;
+		}
+
+		// hysteresis, only switch once past the threshold by a margin
+		unsigned int numLODs = GetNumLODs();
+		m_LOD = glm::min(m_LOD, numLODs - 1);
+		while (m_LOD + 1 < numLODs && screenSize < m_MeshData.lods[m_LOD].screenSize * (1.0f - MESH_LOD_HYSTERESIS))
+			m_LOD++;
+		while (m_LOD > 0 && screenSize > m_MeshData.lods[m_LOD - 1].screenSize * (1.0f + MESH_LOD_HYSTERESIS))
+			m_LOD--;
+	}
+
+	void MeshComponent::CullMeshlets(Camera& renderCam)
+	{
+		m_MeshletsCulled = false;
+		m_NumVisibleMeshlets = 0;
+		m_VisibleIndexCounts.clear();
+		m_VisibleIndexOffsets.clear();
+		m_VisibleBaseVertices.clear();
+		if (m_MeshData.meshlets.empty() || m_LOD != 0)
+			return;
+
+		// frustum planes in mesh space
+		glm::mat4 worldTransform = GetWorldTransform();
+		glm::mat4 modelViewProjection = renderCam.GetViewProjMatrix() * worldTransform;
+		glm::vec4 planes[6];
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			glm::vec4 row(modelViewProjection[0][i], modelViewProjection[1][i], modelViewProjection[2][i], modelViewProjection[3][i]);
+			glm::vec4 rowW(modelViewProjection[0][3], modelViewProjection[1][3], modelViewProjection[2][3], modelViewProjection[3][3]);
+			planes[i * 2] = rowW + row;
+			planes[i * 2 + 1] = rowW - row;
+		}
+		for (glm::vec4& plane : planes)
+			plane /= glm::length(glm::vec3(plane));
+
+		// backface cones are tested in mesh space, which only holds for rotation, translation and
+		// uniform scale. non-uniform scale distorts the cone angle, and a mirroring transform flips
+		// the winding so the cones would cull the faces that are drawn
+		glm::vec3 cameraPosition = glm::vec3(glm::inverse(worldTransform) * glm::vec4(renderCam.GetPosition(), 1.0f));
+		glm::mat3 linearTransform(worldTransform);
+		glm::vec3 axisScale(glm::length(linearTransform[0]), glm::length(linearTransform[1]), glm::length(linearTransform[2]));
+		float scaleTolerance = axisScale.x * 1e-3f;
+		bool isUniformScale = glm::abs(axisScale.y - axisScale.x) <= scaleTolerance && glm::abs(axisScale.z - axisScale.x) <= scaleTolerance;
+		bool coneCulling = !GetIsDoubleSided() && isUniformScale && glm::determinant(linearTransform) > 0.0f;
+
+		unsigned int rangeEnd{ 0 };
+		for (Meshlet const& meshlet : m_MeshData.meshlets)
+		{
+			bool visible{ true };
+			for (glm::vec4 const& plane : planes)
+			{
+				if (glm::dot(glm::vec3(plane), meshlet.center) + plane.w < -meshlet.radius)
+				{
+					visible = false;
+					break;
+				}
+			}
+			if (visible && coneCulling)
+			{
+				glm::vec3 toMeshlet = meshlet.center - cameraPosition;
+				if (glm::dot(toMeshlet, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length(toMeshlet) + meshlet.radius)
+					visible = false;
+			}
+			if (!visible)
+				continue;
+
+			// merge neighbouring ranges
+			m_NumVisibleMeshlets++;
+			if (!m_VisibleIndexCounts.empty() && rangeEnd == meshlet.indexOffset)
+				m_VisibleIndexCounts.back() += meshlet.indexCount;
+			else
+			{
+				m_VisibleIndexCounts.push_back(meshlet.indexCount);
+				m_VisibleIndexOffsets.push_back((const void*)((size_t)(m_GeometryAllocation.firstIndex + meshlet.indexOffset) * GetIndexSize()));
+				m_VisibleBaseVertices.push_back((GLint)m_GeometryAllocation.baseVertex);
+			}
+			rangeEnd = meshlet.indexOffset + meshlet.indexCount;
+		}
+
+		m_MeshletsCulled = true;
+	}
+
+	void MeshComponent::SetIsStaticBatched(bool const& check)
+	{
+		m_IsStaticBatched = check;
+		// drawn through its batch from now on, the shared pool VAO is no longer ours
+		if (check && GetIsGeometryPooled())
+		{
+			GeometryPool::Free(m_GeometryAllocation);
+			m_MeshData.VAO = 0;
+		}
+	}
+
 	void MeshComponent::ProcessRenderFlags()
 	{
 		Chroma::Scene::ProcessMeshComponentRenderFlags(this);
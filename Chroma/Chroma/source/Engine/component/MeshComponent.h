@@ -8,6 +8,7 @@
 #include <shader/Shader.h>
 #include <material/Material.h>
 #include <resources/ResourceManager.h>
+#include <geometry/GeometryPool.h>
 
 namespace Chroma
 {
@@ -26,8 +27,15 @@ namespace Chroma
 
 		// Mesh Attrs
 		virtual bool GetMeshLoaded() { return m_MeshData.isLoaded; };
+		virtual bool GetMeshLoadFailed() { return m_MeshData.isLoadFailed; };
+		virtual bool GetRenderBuffersInitialized() { return m_MeshData.isRenderBuffersInitialized; };
 		virtual void SetIsSkinned(bool const& check) { m_MeshData.isSkinned = check; };
 		inline bool GetIsSkinned() { return  m_MeshData.isSkinned; }
+		// Static meshes keep their vertices until merged by the StaticBatcher
+		virtual void SetIsStatic(bool const& check) { m_IsStatic = check; };
+		inline bool GetIsStatic() { return m_IsStatic; }
+		void SetIsStaticBatched(bool const& check);
+		inline bool GetIsStaticBatched() { return m_IsStaticBatched; }
 
 		// RenderFlags
 		virtual void SetIsRenderable(bool const& check) { m_Material.SetIsRenderable(check);  ProcessRenderFlags(); };
@@ -46,6 +54,8 @@ namespace Chroma
 		inline bool GetCastsShadows() { return m_Material.GetCastsShadows(); }
 		virtual void SetReceivesShadows(bool const& check) { m_Material.SetReceivesShadows(check);  ProcessRenderFlags();};
 		inline bool GetReceivesShadows() { return m_Material.GetReceivesShadows(); }
+		virtual void SetIsOccluder(bool const& check) { m_Material.SetIsOccluder(check);  ProcessRenderFlags(); };
+		inline bool GetIsOccluder() { return m_Material.GetIsOccluder(); }
 
 		// Transforms
 		virtual glm::mat4 GetWorldTransform();
@@ -60,8 +70,30 @@ namespace Chroma
 		virtual std::pair<glm::vec3, glm::vec3> GetBBox();
 		virtual glm::vec3 GetCentroid();
 		virtual glm::mat4 GetTransform() { return m_Transform; };
+		virtual std::pair<glm::vec3, glm::vec3> GetLocalBBox() { return std::make_pair(m_MeshData.bboxMin, m_MeshData.bboxMax); }
 		virtual std::vector<ChromaVertex> GetVertices() = 0;
 
+		// Level Of Detail
+		virtual void UpdateLOD(Camera& renderCam);
+		inline unsigned int GetLOD() { return m_LOD; }
+		inline unsigned int GetNumLODs() { return (unsigned int)m_MeshData.lods.size() + 1; }
+
+		// Meshlets, culled ranges are used by the next draw only
+		virtual void CullMeshlets(Camera& renderCam);
+		inline unsigned int GetNumMeshlets() { return (unsigned int)m_MeshData.meshlets.size(); }
+		inline unsigned int GetNumVisibleMeshlets() { return m_NumVisibleMeshlets; }
+
+		// Geometry Pool
+		inline bool GetIsGeometryPooled() { return m_GeometryAllocation.isValid; }
+		inline GeometryAllocation const& GetGeometryAllocation() { return m_GeometryAllocation; }
+		void GetLODIndexRange(unsigned int& firstIndex, unsigned int& indexCount);
+		// draws with the pool VAO already bound, so meshes of one pool are drawn back to back
+		void DrawPooled(Shader& shader);
+
+		// CPU geometry, occlusion culling and voxel occupancy
+		virtual std::vector<glm::vec3>& GetOccluderPositions() { return m_OccluderPositions; }
+		virtual std::vector<unsigned int>& GetIndices() { return m_MeshData.indices; }
+
 		// Filepaths
 		virtual std::string& GetSourcePath() { return m_MeshData.sourcePath; }
 		virtual void SetSourcePath(const std::string& newSourcePath) { m_MeshData.sourcePath = newSourcePath; }
@@ -82,6 +114,7 @@ namespace Chroma
 		// Materials
 		virtual void SetMaterial(const Material& newMaterial);
 		virtual Material& GetMaterial() { return m_Material; };
+		virtual unsigned int GetShaderKeywords() { return m_Material.GetShaderKeywords() | (GetIsSkinned() ? ShaderKeyword::kSkinned : ShaderKeyword::kNone); }
 
 		virtual void SetShader(Shader& shader) { m_Material.SetShader(shader); };
 		virtual Shader& GetShader() { return m_Material.GetShader(); };
@@ -99,6 +132,31 @@ namespace Chroma
 		// MeshData
 		MeshData m_MeshData;
 
+		// Static Batching
+		bool m_IsStatic{ false };
+		bool m_IsStaticBatched{ false };
+
+		// Occluder positions, kept on the CPU after render buffers are built
+		std::vector<glm::vec3> m_OccluderPositions;
+
+		// Level Of Detail
+		unsigned int m_LOD{ 0 };
+		GLenum m_IndexType{ GL_UNSIGNED_INT };
+		unsigned int GetIndexSize() { return m_IndexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int); }
+		std::vector<unsigned int> BuildIndexData();
+		void SetupIndexBuffer();
+		void DrawElements();
+
+		// Geometry Pool, offsets are zero when the mesh owns its buffers
+		GeometryAllocation m_GeometryAllocation;
+
+		// Meshlets
+		bool m_MeshletsCulled{ false };
+		unsigned int m_NumVisibleMeshlets{ 0 };
+		std::vector<GLsizei> m_VisibleIndexCounts;
+		std::vector<const void*> m_VisibleIndexOffsets;
+		std::vector<GLint> m_VisibleBaseVertices;
+
 		//Material
 		Material m_Material;
 		void ProcessRenderFlags();
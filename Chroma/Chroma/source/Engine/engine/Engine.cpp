@@ -1,5 +1,7 @@
 #include "Engine.h"
 #include "particles/ParticleSystem.h"
+#include "terrain/Terrain.h"
+#include "vegetation/Vegetation.h"
 
 namespace Chroma
 {
@@ -89,6 +91,9 @@ namespace Chroma
 		// Particle System
 		ParticleSystem::OnUpdate();
 
+		// Terrain
+		Terrain::OnUpdate();
+
 		// Resources 
 		ResourceManager::OnUpdate();
 
@@ -115,6 +120,15 @@ namespace Chroma
 		// renderer
 		Render::Init();
 
+		// particles
+		ParticleSystem::Init();
+
+		// terrain
+		Terrain::Init();
+
+		// vegetation
+		Vegetation::Init();
+
 		// ui
 		JobSystem::Execute(UI::Init);
 		CHROMA_INFO("UI Initialized.");
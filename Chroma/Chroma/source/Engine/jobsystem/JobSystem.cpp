@@ -142,6 +142,27 @@ namespace Chroma
 			while (IsBusy()) { poll(); }
 		}
 
+		void Wait(JobCounter const& counter)
+		{
+			while (counter.pending.load() > 0) { poll(); }
+		}
+
+		void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job, JobCounter& counter)
+		{
+			if (jobCount == 0 || groupSize == 0)
+			{
+				return;
+			}
+
+			// every job counts itself off once done
+			counter.pending.fetch_add(jobCount);
+			JobCounter* jobCounter = &counter;
+			Dispatch(jobCount, groupSize, [job, jobCounter](JobDispatchArgs args) {
+				job(args);
+				jobCounter->pending.fetch_sub(1);
+			});
+		}
+
 		void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
 		{
 			if (jobCount == 0 || groupSize == 0)
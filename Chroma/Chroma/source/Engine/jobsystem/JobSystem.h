@@ -11,6 +11,12 @@ struct JobDispatchArgs
 	uint32_t groupIndex;
 };
 
+// Jobs still outstanding from the dispatches it was passed to
+struct JobCounter
+{
+	std::atomic<uint32_t> pending{ 0 };
+};
+
 namespace Chroma
 {
 	namespace JobSystem
@@ -27,6 +33,9 @@ namespace Chroma
 		//	func		: receives a JobDispatchArgs as parameter
 		void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
 
+		// Same as above, tracking the jobs in counter so they can be waited on alone
+		void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job, JobCounter& counter);
+
 		// Check if any threads are working currently or not
 		bool IsBusy();
 
@@ -35,6 +44,9 @@ namespace Chroma
 
 		// Wait until all threads become idle
 		void Wait();
+
+		// Wait until the jobs tracked by counter are done, other jobs may still be running
+		void Wait(JobCounter const& counter);
 	}
 }
 
@@ -1,77 +1,228 @@
 #include "ParticleSystem.h"
-#include "common/PrecompiledHeader.h"
 #include "jobsystem/JobSystem.h"
 #include "time/Time.h"
-#include "render/Render.h"
-
+#include "math/Math.h"
+#include <xmmintrin.h>
 
 namespace Chroma
 {
+	std::vector<ParticleEmitter*> ParticleSystem::s_Emitters;
+	Shader* ParticleSystem::s_BillboardShader{ nullptr };
 
-	std::vector<ParticleEmitter> ParticleSystem::s_Emitters;
+	void ParticlePool::Resize(uint32_t const& capacity)
+	{
+		for (std::vector<float>* stream : { &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ, &age, &lifeSpan, &scale })
+			stream->resize(capacity, 0.0f);
+		numAlive = std::min(numAlive, capacity);
+	}
+
+	void ParticlePool::Kill(uint32_t const& index)
+	{
+		// swap with the last live particle
+		uint32_t const last = --numAlive;
+		for (std::vector<float>* stream : { &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ, &age, &lifeSpan, &scale })
+			(*stream)[index] = (*stream)[last];
+	}
+
+	void ParticleSystem::Init()
+	{
+		s_BillboardShader = new Shader("resources/shaders/fragParticle.glsl", "resources/shaders/vertexParticle.glsl");
+	}
 
 	void ParticleSystem::OnUpdate()
 	{
-		for (ParticleEmitter& emitter : s_Emitters)
+		float const deltaTime = (float)Time::GetDeltaTime();
+
+		// integrate every emitter in parallel, in chunks of PARTICLE_JOB_SIZE
+		JobCounter integrateCounter;
+		for (ParticleEmitter* emitter : s_Emitters)
+		{
+			uint32_t const numAlive = emitter->particles.numAlive;
+			uint32_t const numJobs = (numAlive + PARTICLE_JOB_SIZE - 1) / PARTICLE_JOB_SIZE;
+			Chroma::JobSystem::Dispatch(numJobs, 1, [emitter, deltaTime, numAlive](JobDispatchArgs args) {
+				uint32_t const begin = args.jobIndex * PARTICLE_JOB_SIZE;
+				Integrate(emitter->particles, emitter->settings.gravity, deltaTime, begin, std::min(begin + PARTICLE_JOB_SIZE, numAlive));
+			}, integrateCounter);
+		}
+		// only the particle jobs, other systems' jobs may still be in flight
+		Chroma::JobSystem::Wait(integrateCounter);
+
+		// kill and spawn change the pool size, so they run once integration is done
+		for (ParticleEmitter* emitter : s_Emitters)
+		{
+			KillExpired(*emitter);
+			Spawn(*emitter, deltaTime);
+		}
+	}
+
+	void ParticleSystem::Draw()
+	{
+		if (!s_BillboardShader || GetNumAlive() == 0)
+			return;
+
+		// additive, depth tested without writing
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+		glDepthMask(GL_FALSE);
+		glDisable(GL_CULL_FACE);
+
+		s_BillboardShader->Use();
+		for (ParticleEmitter* emitter : s_Emitters)
 		{
-			emitter.transform = glm::translate(glm::mat4(1.0), glm::vec3(glm::sin(Time::GetGameTime()), 0.0, glm::sin(Time::GetGameTime())));
-			for (Particle* particle : emitter.particles)
-			{
-				float deltaTime = Time::GetDeltaTime();
-				// reset if particle reached lifespan
-				if (particle->timeAlive + deltaTime > particle->lifeSpan)
-				{
-					particle->position = Math::GetTranslation(emitter.transform);
-					particle->timeAlive = 0.0f;
-					particle->velocity = emitter.settings.initialVelocity;
-				}
-
-				particle->timeAlive += deltaTime;
-				// gravity
-				//particle.velocity = glm::max(particle.velocity - glm::vec3(0.0f, -9.8f * deltaTime, 0.0f), glm::vec3(0.0f, -9.8f, 0.0f));
-				particle->velocity = glm::vec3(0.0f, -9.8f * deltaTime, 0.0f);
-				particle->position += particle->velocity;
-
-				glm::mat4 pos;
-				Render::GetDebugBuffer()->DrawCross(particle->position, 0.1f, glm::vec3(1.0));
-			}
-
-			/*JobSystem::Execute(
-				[&emitter]() {
-					for (Particle& particle : emitter)
-					{
-						particle.velocity.y += 9.8f * Time::GetDeltaTime();
-						glm::mat4 pos;
-						Render::GetDebugBuffer()->DrawOverlayCoordinates(pos, 3.0f);
-					}
-				}
-			);*/
+			if (emitter->particles.numAlive == 0)
+				continue;
+			Upload(*emitter);
+
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, emitter->texture.texture);
+			s_BillboardShader->SetUniform("particleTexture", 0);
+			s_BillboardShader->SetUniform("UseTexture", emitter->texture.texture != 0);
+			s_BillboardShader->SetUniform("colorTint", emitter->texture.colorTint);
+
+			glBindVertexArray(emitter->VAO);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, emitter->particles.numAlive);
 		}
+		glBindVertexArray(0);
+
+		// set to default blending
+		glBlendFunc(GL_ONE, GL_ZERO);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_CULL_FACE);
 	}
 
 	ParticleEmitter* ParticleSystem::CreateEmitter(const glm::mat4& transform, const ParticleSettings& settings,
 		const ParticleTexture& texture)
 	{
-		srand((unsigned)time(NULL));
-
 		// create and apply new emitter
-		ParticleEmitter emitter;
-		emitter.transform = transform;
-		emitter.settings = settings;
-		emitter.texture = texture;
-		for (unsigned int i = 0; i < settings.numParticles; ++i)
+		ParticleEmitter* emitter = new ParticleEmitter();
+		emitter->transform = transform;
+		emitter->settings = settings;
+		emitter->texture = texture;
+		emitter->particles.Resize(settings.numParticles);
+
+		// instance streams, one float per particle each
+		unsigned int const capacity = settings.numParticles;
+		glGenVertexArrays(1, &emitter->VAO);
+		glGenBuffers(1, &emitter->instanceVBO);
+		glBindVertexArray(emitter->VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, emitter->instanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, 4 * capacity * sizeof(float), NULL, GL_STREAM_DRAW);
+		for (unsigned int stream = 0; stream < 4; stream++)
 		{
-			Particle* particle = new Particle(); 
-			particle->lifeSpan = particle->lifeSpan * ((float)rand()/RAND_MAX);
-			particle->velocity = settings.initialVelocity;
-			particle->position = Math::GetTranslation(emitter.transform);
-			emitter.particles.push_back(particle);
+			glEnableVertexAttribArray(stream);
+			glVertexAttribPointer(stream, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(stream * capacity * sizeof(float)));
+			glVertexAttribDivisor(stream, 1);
 		}
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 		// add to global emitters
 		s_Emitters.push_back(emitter);
+		return emitter;
+	}
 
-		// return instance
-		return &emitter;
+	void ParticleSystem::DestroyEmitter(ParticleEmitter* emitter)
+	{
+		std::vector<ParticleEmitter*>::iterator it = std::find(s_Emitters.begin(), s_Emitters.end(), emitter);
+		if (it == s_Emitters.end())
+			return;
+		s_Emitters.erase(it);
+		glDeleteBuffers(1, &emitter->instanceVBO);
+		glDeleteVertexArrays(1, &emitter->VAO);
+		delete emitter;
+	}
+
+	uint32_t ParticleSystem::GetNumAlive()
+	{
+		uint32_t numAlive{ 0 };
+		for (ParticleEmitter const* emitter : s_Emitters)
+			numAlive += emitter->particles.numAlive;
+		return numAlive;
+	}
+
+	void ParticleSystem::Integrate(ParticlePool& particles, glm::vec3 const& gravity, float const& deltaTime, uint32_t const& begin, uint32_t const& end)
+	{
+		// 4 particles at a time, job chunks are multiples of 4 so only the last chunk has a tail
+		__m128 const dt = _mm_set1_ps(deltaTime);
+		__m128 const gravityX = _mm_set1_ps(gravity.x * deltaTime);
+		__m128 const gravityY = _mm_set1_ps(gravity.y * deltaTime);
+		__m128 const gravityZ = _mm_set1_ps(gravity.z * deltaTime);
+		uint32_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 velocityX = _mm_add_ps(_mm_loadu_ps(&particles.velocityX[i]), gravityX);
+			__m128 velocityY = _mm_add_ps(_mm_loadu_ps(&particles.velocityY[i]), gravityY);
+			__m128 velocityZ = _mm_add_ps(_mm_loadu_ps(&particles.velocityZ[i]), gravityZ);
+			_mm_storeu_ps(&particles.velocityX[i], velocityX);
+			_mm_storeu_ps(&particles.velocityY[i], velocityY);
+			_mm_storeu_ps(&particles.velocityZ[i], velocityZ);
+			_mm_storeu_ps(&particles.positionX[i], _mm_add_ps(_mm_loadu_ps(&particles.positionX[i]), _mm_mul_ps(velocityX, dt)));
+			_mm_storeu_ps(&particles.positionY[i], _mm_add_ps(_mm_loadu_ps(&particles.positionY[i]), _mm_mul_ps(velocityY, dt)));
+			_mm_storeu_ps(&particles.positionZ[i], _mm_add_ps(_mm_loadu_ps(&particles.positionZ[i]), _mm_mul_ps(velocityZ, dt)));
+			_mm_storeu_ps(&particles.age[i], _mm_add_ps(_mm_loadu_ps(&particles.age[i]), dt));
+		}
+		for (; i < end; i++)
+		{
+			particles.velocityX[i] += gravity.x * deltaTime;
+			particles.velocityY[i] += gravity.y * deltaTime;
+			particles.velocityZ[i] += gravity.z * deltaTime;
+			particles.positionX[i] += particles.velocityX[i] * deltaTime;
+			particles.positionY[i] += particles.velocityY[i] * deltaTime;
+			particles.positionZ[i] += particles.velocityZ[i] * deltaTime;
+			particles.age[i] += deltaTime;
+		}
+	}
+
+	void ParticleSystem::KillExpired(ParticleEmitter& emitter)
+	{
+		// walked backwards so swapped in particles have already been tested
+		ParticlePool& particles = emitter.particles;
+		for (uint32_t i = particles.numAlive; i-- > 0;)
+		{
+			if (particles.age[i] >= particles.lifeSpan[i])
+				particles.Kill(i);
+		}
+	}
+
+	void ParticleSystem::Spawn(ParticleEmitter& emitter, float const& deltaTime)
+	{
+		static std::mt19937 generator(std::random_device{}());
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f);
+
+		ParticlePool& particles = emitter.particles;
+		ParticleSettings const& settings = emitter.settings;
+		emitter.spawnAccumulator += settings.rate * deltaTime;
+		uint32_t const numSpawned = std::min((uint32_t)emitter.spawnAccumulator, particles.GetCapacity() - particles.numAlive);
+		emitter.spawnAccumulator -= (float)(uint32_t)emitter.spawnAccumulator;
+
+		glm::vec3 const origin = Math::GetTranslation(emitter.transform);
+		for (uint32_t i = particles.numAlive; i < particles.numAlive + numSpawned; i++)
+		{
+			particles.positionX[i] = origin.x;
+			particles.positionY[i] = origin.y;
+			particles.positionZ[i] = origin.z;
+			particles.velocityX[i] = settings.initialVelocity.x + settings.velocityVariance.x * signedUnit(generator);
+			particles.velocityY[i] = settings.initialVelocity.y + settings.velocityVariance.y * signedUnit(generator);
+			particles.velocityZ[i] = settings.initialVelocity.z + settings.velocityVariance.z * signedUnit(generator);
+			particles.age[i] = 0.0f;
+			particles.lifeSpan[i] = settings.lifeSpan * unit(generator);
+			particles.scale[i] = settings.scale;
+		}
+		particles.numAlive += numSpawned;
+	}
+
+	void ParticleSystem::Upload(ParticleEmitter& emitter)
+	{
+		// live particles of each stream go straight to their range, no repacking
+		ParticlePool const& particles = emitter.particles;
+		size_t const streamSize = particles.GetCapacity() * sizeof(float);
+		size_t const liveSize = particles.numAlive * sizeof(float);
+		glBindBuffer(GL_ARRAY_BUFFER, emitter.instanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, 4 * streamSize, NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, liveSize, particles.positionX.data());
+		glBufferSubData(GL_ARRAY_BUFFER, streamSize, liveSize, particles.positionY.data());
+		glBufferSubData(GL_ARRAY_BUFFER, 2 * streamSize, liveSize, particles.positionZ.data());
+		glBufferSubData(GL_ARRAY_BUFFER, 3 * streamSize, liveSize, particles.scale.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
-}
\ No newline at end of file
+}
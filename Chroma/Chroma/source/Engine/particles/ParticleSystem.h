@@ -1,89 +1,84 @@
 #ifndef CHROMA_PARTICLE_SYSTEM_H
 #define CHROMA_PARTICLE_SYSTEM_H
 
-#include <vector>
-#include "glm/glm.hpp"
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <shader/Shader.h>
 
 namespace Chroma
 {
-
-	struct Particle
-	{
-		glm::vec3 position;
-		glm::vec3 velocity;
-		float lifeSpan{ 3.5f };
-		float scale{ 1.0f };
-		float timeAlive{ 0.0f };
-	};
-
-	template<size_t capacity>
-	class ParticleBuffer 
+	// Live particles packed at the front of structure of arrays pools,
+	// killed particles are swapped with the last live one
+	struct ParticlePool
 	{
-		inline bool push_back(const Particle& particle)
-		{
-			size_t next = (head + 1) % capacity;
-			if (next != tail)
-			{
-				particles[head] = particle;
-				head = next;
-				return true;
-			}
-			return false;
-		}
+		std::vector<float> positionX, positionY, positionZ;
+		std::vector<float> velocityX, velocityY, velocityZ;
+		std::vector<float> age, lifeSpan, scale;
+		uint32_t numAlive{ 0 };
 
-		inline bool pop_front(Particle& particle)
-		{
-			if (tail != head)
-			{
-				particle = particles[tail];
-				tail = (tail + 1) % capacity;
-				return true;
-			}
-			return false;
-		}
-
-		size_t size() const { return sizeof(particles) / sizeof(Particle); }
-		Particle& operator[](int index) { return particles[index]; }
-
-	private:
-		Particle particles[capacity];
-		size_t head = 0;
-		size_t tail = 0;
+		void Resize(uint32_t const& capacity);
+		inline uint32_t GetCapacity() const { return (uint32_t)age.size(); }
+		void Kill(uint32_t const& index);
 	};
 
 	struct ParticleTexture
 	{
-		unsigned int texture;
+		// 0 draws a soft round sprite
+		unsigned int texture{ 0 };
 		glm::vec3 colorTint{ 1.0f };
 	};
 
 	struct ParticleSettings
 	{
-		float rate{ 1.0f };
-		glm::vec3 initialVelocity{0.0f, 150.0f, 0.0f};
+		// particles spawned per second while the pool has room
+		float rate{ 150.0f };
+		glm::vec3 initialVelocity{ 0.0f, 5.0f, 0.0f };
+		// random offset per axis added to the initial velocity
+		glm::vec3 velocityVariance{ 1.0f };
+		glm::vec3 gravity{ 0.0f, -9.8f, 0.0f };
+		// particles live a random fraction of the lifespan
+		float lifeSpan{ 3.5f };
+		float scale{ 0.1f };
+		// pool capacity
 		uint32_t numParticles{ 500 };
 	};
 
 	struct ParticleEmitter
 	{
-		glm::mat4 transform;
+		glm::mat4 transform{ 1.0f };
 		ParticleSettings settings;
 		ParticleTexture texture;
-		std::vector<Particle*> particles;
-		std::vector<Particle*>::iterator begin() { return particles.begin(); }
-		std::vector<Particle*>::iterator end() { return particles.end(); }
+		ParticlePool particles;
+		// fraction of a particle carried over between updates
+		float spawnAccumulator{ 0.0f };
+		// instance streams, each SoA array is uploaded to its own range
+		unsigned int VAO{ 0 }, instanceVBO{ 0 };
 	};
 
 	class ParticleSystem
 	{
 	public:
+		static void Init();
 		static void OnUpdate();
+		// one instanced billboard draw per emitter
+		static void Draw();
+
+		// emitters are owned by the particle system
 		static ParticleEmitter* CreateEmitter(const glm::mat4& transform, const ParticleSettings& settings, const ParticleTexture& texture);
+		static void DestroyEmitter(ParticleEmitter* emitter);
+		static uint32_t GetNumAlive();
 
 	private:
-		static std::vector<ParticleEmitter> s_Emitters;
+		static std::vector<ParticleEmitter*> s_Emitters;
+		static Shader* s_BillboardShader;
 
+		static void Integrate(ParticlePool& particles, glm::vec3 const& gravity, float const& deltaTime, uint32_t const& begin, uint32_t const& end);
+		static void KillExpired(ParticleEmitter& emitter);
+		static void Spawn(ParticleEmitter& emitter, float const& deltaTime);
+		static void Upload(ParticleEmitter& emitter);
 	};
 }
 
-#endif //CHROMA_PARTICLE_SYSTEM_H
\ No newline at end of file
+#endif //CHROMA_PARTICLE_SYSTEM_H
@@ -0,0 +1,389 @@
+#include "MeshOptimizer.h"
+
+
+namespace Chroma
+{
+	namespace
+	{
+		// Forsyth vertex scoring
+		const int kCacheSize{ MESH_OPTIMIZER_CACHE_SIZE };
+
+		float VertexScore(int const& cachePosition, unsigned int const& remainingTriangles)
+		{
+			if (remainingTriangles == 0)
+				return -1.0f;
+
+			float score{ 0.0f };
+			if (cachePosition >= 0)
+			{
+				// the last triangle's vertices score the same, so strips are not favoured over fans
+				if (cachePosition < 3)
+					score = 0.75f;
+				else
+					score = glm::pow(1.0f - float(cachePosition - 3) / float(kCacheSize - 3), 1.5f);
+			}
+			// boost vertices with few triangles left, so they are finished and leave the cache
+			score += 2.0f * glm::pow(float(remainingTriangles), -0.5f);
+			return score;
+		}
+
+		// bitwise vertex equality for welding
+		template<typename VertexType>
+		struct VertexHash
+		{
+			size_t operator()(VertexType const& vertex) const
+			{
+				uint32_t const* words = reinterpret_cast<uint32_t const*>(&vertex);
+				size_t hash{ 2166136261u };
+				for (size_t i = 0; i < sizeof(VertexType) / sizeof(uint32_t); i++)
+					hash = (hash ^ words[i]) * 16777619u;
+				return hash;
+			}
+		};
+
+		template<typename VertexType>
+		struct VertexEqual
+		{
+			bool operator()(VertexType const& a, VertexType const& b) const
+			{
+				return std::memcmp(&a, &b, sizeof(VertexType)) == 0;
+			}
+		};
+
+		template<typename VertexType>
+		void WeldVertexList(std::vector<VertexType>& vertices, std::vector<unsigned int>& indices)
+		{
+			std::unordered_map<VertexType, unsigned int, VertexHash<VertexType>, VertexEqual<VertexType>> uniqueVertices;
+			uniqueVertices.reserve(vertices.size());
+			std::vector<unsigned int> remap(vertices.size());
+			std::vector<VertexType> welded;
+			welded.reserve(vertices.size());
+			for (size_t i = 0; i < vertices.size(); i++)
+			{
+				auto inserted = uniqueVertices.emplace(vertices[i], (unsigned int)welded.size());
+				if (inserted.second)
+					welded.push_back(vertices[i]);
+				remap[i] = inserted.first->second;
+			}
+			for (unsigned int& index : indices)
+				index = remap[index];
+			vertices = std::move(welded);
+		}
+
+		template<typename VertexType>
+		void RemapVertexList(std::vector<VertexType>& vertices, std::vector<unsigned int> const& remap, unsigned int const& newVertexCount)
+		{
+			std::vector<VertexType> remapped(newVertexCount);
+			for (size_t i = 0; i < vertices.size(); i++)
+				if (remap[i] != UINT_MAX)
+					remapped[remap[i]] = vertices[i];
+			vertices = std::move(remapped);
+		}
+
+		std::vector<glm::vec3> GetPositions(MeshData const& meshData)
+		{
+			std::vector<glm::vec3> positions;
+			if (meshData.isSkinned)
+				for (ChromaSkinnedVertex const& vert : meshData.skinnedVerts)
+					positions.push_back(vert.m_position);
+			else
+				for (ChromaVertex const& vert : meshData.verts)
+					positions.push_back(vert.m_position);
+			return positions;
+		}
+	}
+
+
+	void MeshOptimizer::WeldVertices(MeshData& meshData)
+	{
+		size_t vertexCount = meshData.isSkinned ? meshData.skinnedVerts.size() : meshData.verts.size();
+		if (meshData.isSkinned)
+			WeldVertexList(meshData.skinnedVerts, meshData.indices);
+		else
+			WeldVertexList(meshData.verts, meshData.indices);
+
+		CHROMA_TRACE("MESH OPTIMIZER :: Welded {0} vertices to {1}.", vertexCount, meshData.isSkinned ? meshData.skinnedVerts.size() : meshData.verts.size());
+	}
+
+	void MeshOptimizer::OptimizeMesh(MeshData& meshData)
+	{
+		if (meshData.indices.empty())
+			return;
+
+		float acmrBefore = CalculateACMR(meshData.indices);
+		std::vector<glm::vec3> positions = GetPositions(meshData);
+
+		// LOD0, meshlets keep their ranges and are ordered as a whole
+		if (meshData.meshlets.empty())
+		{
+			OptimizeVertexCache(meshData.indices.data(), (unsigned int)meshData.indices.size());
+			OptimizeOverdraw(meshData.indices, positions);
+		}
+		else
+		{
+			for (Meshlet const& meshlet : meshData.meshlets)
+				OptimizeVertexCache(meshData.indices.data() + meshlet.indexOffset, meshlet.indexCount);
+			OptimizeMeshletOrder(meshData, positions);
+		}
+
+		// LODs are seen from afar, cache order is enough
+		for (MeshLOD& lod : meshData.lods)
+			OptimizeVertexCache(lod.indices.data(), (unsigned int)lod.indices.size());
+
+		// vertices in order of first use
+		OptimizeVertexFetch(meshData);
+
+		CHROMA_TRACE("MESH OPTIMIZER :: ACMR {0} -> {1}.", acmrBefore, CalculateACMR(meshData.indices));
+	}
+
+	float MeshOptimizer::CalculateACMR(std::vector<unsigned int> const& indices, unsigned int const& cacheSize)
+	{
+		if (indices.empty())
+			return 0.0f;
+
+		std::deque<unsigned int> cache;
+		unsigned int misses{ 0 };
+		for (unsigned int const& index : indices)
+		{
+			if (std::find(cache.begin(), cache.end(), index) != cache.end())
+				continue;
+			misses++;
+			cache.push_back(index);
+			if (cache.size() > cacheSize)
+				cache.pop_front();
+		}
+		return float(misses) / float(indices.size() / 3);
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(unsigned int* indices, unsigned int const& indexCount)
+	{
+		const unsigned int triangleCount = indexCount / 3;
+		if (triangleCount < 2)
+			return;
+
+		// compact vertex ids local to this range
+		std::unordered_map<unsigned int, unsigned int> localIDs;
+		std::vector<unsigned int> localIndices(indexCount);
+		std::vector<unsigned int> globalIDs;
+		for (unsigned int i = 0; i < indexCount; i++)
+		{
+			auto inserted = localIDs.emplace(indices[i], (unsigned int)globalIDs.size());
+			if (inserted.second)
+				globalIDs.push_back(indices[i]);
+			localIndices[i] = inserted.first->second;
+		}
+		const unsigned int vertexCount = (unsigned int)globalIDs.size();
+
+		// vertex to triangle adjacency
+		std::vector<unsigned int> remainingTriangles(vertexCount, 0);
+		for (unsigned int const& index : localIndices)
+			remainingTriangles[index]++;
+		std::vector<unsigned int> triangleOffsets(vertexCount + 1, 0);
+		for (unsigned int i = 0; i < vertexCount; i++)
+			triangleOffsets[i + 1] = triangleOffsets[i] + remainingTriangles[i];
+		std::vector<unsigned int> vertexTriangles(indexCount);
+		{
+			std::vector<unsigned int> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (unsigned int i = 0; i < indexCount; i++)
+				vertexTriangles[fill[localIndices[i]]++] = i / 3;
+		}
+
+		// scores
+		std::vector<int> cachePositions(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; i++)
+			vertexScores[i] = VertexScore(-1, remainingTriangles[i]);
+
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<unsigned int> cache, newCache;
+		std::vector<unsigned int> output;
+		output.reserve(indexCount);
+		unsigned int cursor{ 0 };
+		int bestTriangle{ 0 };
+		for (unsigned int i = 0; i < triangleCount; i++)
+		{
+			// no candidate in cache, continue from the next triangle in input order
+			if (bestTriangle < 0)
+			{
+				while (emitted[cursor])
+					cursor++;
+				bestTriangle = (int)cursor;
+			}
+
+			// emit
+			unsigned int const* triangle = &localIndices[bestTriangle * 3];
+			emitted[bestTriangle] = true;
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				unsigned int vertex = triangle[c];
+				output.push_back(globalIDs[vertex]);
+				// remove triangle from the vertex adjacency
+				unsigned int* begin = &vertexTriangles[triangleOffsets[vertex]];
+				unsigned int* end = begin + remainingTriangles[vertex];
+				unsigned int* found = std::find(begin, end, (unsigned int)bestTriangle);
+				std::swap(*found, *(end - 1));
+				remainingTriangles[vertex]--;
+			}
+
+			// lru cache update, triangle vertices move to the front
+			newCache.assign(triangle, triangle + 3);
+			for (unsigned int const& vertex : cache)
+				if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+					newCache.push_back(vertex);
+			for (size_t c = 0; c < newCache.size(); c++)
+				cachePositions[newCache[c]] = c < (size_t)kCacheSize ? (int)c : -1;
+			std::swap(cache, newCache);
+
+			// rescore affected vertices and their triangles, picking the best
+			float bestScore{ -1.0f };
+			bestTriangle = -1;
+			for (unsigned int const& vertex : cache)
+				vertexScores[vertex] = VertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+			for (unsigned int const& vertex : cache)
+			{
+				for (unsigned int t = triangleOffsets[vertex]; t < triangleOffsets[vertex] + remainingTriangles[vertex]; t++)
+				{
+					unsigned int candidate = vertexTriangles[t];
+					float score = vertexScores[localIndices[candidate * 3]] + vertexScores[localIndices[candidate * 3 + 1]] + vertexScores[localIndices[candidate * 3 + 2]];
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTriangle = (int)candidate;
+					}
+				}
+			}
+
+			// drop vertices that fell out of the cache
+			if (cache.size() > (size_t)kCacheSize)
+				cache.resize(kCacheSize);
+		}
+
+		std::copy(output.begin(), output.end(), indices);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, std::vector<glm::vec3> const& positions)
+	{
+		// split the cache ordered triangles into clusters wherever the cache restarts
+		std::vector<unsigned int> clusterStarts;
+		{
+			std::deque<unsigned int> cache;
+			for (unsigned int i = 0; i < (unsigned int)indices.size(); i += 3)
+			{
+				unsigned int misses{ 0 };
+				for (unsigned int c = 0; c < 3; c++)
+				{
+					if (std::find(cache.begin(), cache.end(), indices[i + c]) != cache.end())
+						continue;
+					misses++;
+					cache.push_back(indices[i + c]);
+					if (cache.size() > MESH_OPTIMIZER_ACMR_CACHE_SIZE)
+						cache.pop_front();
+				}
+				if (misses == 3 && (clusterStarts.empty() || i - clusterStarts.back() >= MESH_OPTIMIZER_MIN_CLUSTER_TRIANGLES * 3))
+					clusterStarts.push_back(i);
+			}
+		}
+		if (clusterStarts.size() < 2)
+			return;
+		clusterStarts.push_back((unsigned int)indices.size());
+
+		// mesh centroid
+		glm::vec3 meshCentroid{ 0.0f };
+		float meshArea{ 0.0f };
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			glm::vec3 p0 = positions[indices[i]], p1 = positions[indices[i + 1]], p2 = positions[indices[i + 2]];
+			float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+			meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+			meshArea += area;
+		}
+		if (meshArea <= 0.0f)
+			return;
+		meshCentroid /= meshArea;
+
+		// clusters facing away from the centre are likely occluders, draw them first
+		std::vector<std::pair<float, unsigned int>> clusterKeys;
+		for (unsigned int c = 0; c + 1 < (unsigned int)clusterStarts.size(); c++)
+		{
+			glm::vec3 centroid{ 0.0f }, normal{ 0.0f };
+			float area{ 0.0f };
+			for (unsigned int i = clusterStarts[c]; i < clusterStarts[c + 1]; i += 3)
+			{
+				glm::vec3 p0 = positions[indices[i]], p1 = positions[indices[i + 1]], p2 = positions[indices[i + 2]];
+				glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+				float faceArea = glm::length(faceNormal);
+				centroid += (p0 + p1 + p2) * (faceArea / 3.0f);
+				normal += faceNormal;
+				area += faceArea;
+			}
+			float key{ 0.0f };
+			if (area > 0.0f && glm::length(normal) > 0.0f)
+				key = glm::dot(centroid / area - meshCentroid, glm::normalize(normal));
+			clusterKeys.push_back(std::make_pair(-key, c));
+		}
+		std::stable_sort(clusterKeys.begin(), clusterKeys.end());
+
+		std::vector<unsigned int> sorted;
+		sorted.reserve(indices.size());
+		for (std::pair<float, unsigned int> const& clusterKey : clusterKeys)
+			sorted.insert(sorted.end(), indices.begin() + clusterStarts[clusterKey.second], indices.begin() + clusterStarts[clusterKey.second + 1]);
+		indices = std::move(sorted);
+	}
+
+	void MeshOptimizer::OptimizeMeshletOrder(MeshData& meshData, std::vector<glm::vec3> const& positions)
+	{
+		// same outside in ordering at meshlet granularity
+		glm::vec3 meshCentroid{ 0.0f };
+		for (glm::vec3 const& position : positions)
+			meshCentroid += position;
+		meshCentroid /= (float)glm::max<size_t>(positions.size(), 1);
+
+		std::vector<std::pair<float, unsigned int>> meshletKeys;
+		for (unsigned int m = 0; m < (unsigned int)meshData.meshlets.size(); m++)
+		{
+			Meshlet const& meshlet = meshData.meshlets[m];
+			meshletKeys.push_back(std::make_pair(-glm::dot(meshlet.center - meshCentroid, meshlet.coneAxis), m));
+		}
+		std::stable_sort(meshletKeys.begin(), meshletKeys.end());
+
+		std::vector<unsigned int> sorted;
+		sorted.reserve(meshData.indices.size());
+		std::vector<Meshlet> sortedMeshlets;
+		sortedMeshlets.reserve(meshData.meshlets.size());
+		for (std::pair<float, unsigned int> const& meshletKey : meshletKeys)
+		{
+			Meshlet meshlet = meshData.meshlets[meshletKey.second];
+			sorted.insert(sorted.end(), meshData.indices.begin() + meshlet.indexOffset, meshData.indices.begin() + meshlet.indexOffset + meshlet.indexCount);
+			meshlet.indexOffset = (unsigned int)sorted.size() - meshlet.indexCount;
+			sortedMeshlets.push_back(meshlet);
+		}
+		meshData.indices = std::move(sorted);
+		meshData.meshlets = std::move(sortedMeshlets);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(MeshData& meshData)
+	{
+		const size_t vertexCount = meshData.isSkinned ? meshData.skinnedVerts.size() : meshData.verts.size();
+		std::vector<unsigned int> remap(vertexCount, UINT_MAX);
+		unsigned int newVertexCount{ 0 };
+
+		// first use across LOD0 then the simplified LODs, unreferenced vertices are dropped
+		auto remapIndices = [&remap, &newVertexCount](std::vector<unsigned int>& indices)
+		{
+			for (unsigned int& index : indices)
+			{
+				if (remap[index] == UINT_MAX)
+					remap[index] = newVertexCount++;
+				index = remap[index];
+			}
+		};
+		remapIndices(meshData.indices);
+		for (MeshLOD& lod : meshData.lods)
+			remapIndices(lod.indices);
+
+		if (meshData.isSkinned)
+			RemapVertexList(meshData.skinnedVerts, remap, newVertexCount);
+		else
+			RemapVertexList(meshData.verts, remap, newVertexCount);
+	}
+}
@@ -0,0 +1,34 @@
+#ifndef _CHROMA_MESH_OPTIMIZER_
+#define _CHROMA_MESH_OPTIMIZER_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <model/MeshData.h>
+
+namespace Chroma
+{
+	// Import time index and vertex reordering.
+	// Triangles are reordered for post-transform vertex cache hits (Forsyth) and then
+	// clustered and sorted outside-in to reduce overdraw, vertices are reordered by first use.
+	class MeshOptimizer
+	{
+	public:
+		// Merge vertices whose attributes are identical
+		static void WeldVertices(MeshData& meshData);
+		// Reorder LOD0, LODs and meshlets, then vertices
+		static void OptimizeMesh(MeshData& meshData);
+
+		// Average cache miss ratio, transformed vertices per triangle for a FIFO cache
+		static float CalculateACMR(std::vector<unsigned int> const& indices, unsigned int const& cacheSize = MESH_OPTIMIZER_ACMR_CACHE_SIZE);
+
+	private:
+		static void OptimizeVertexCache(unsigned int* indices, unsigned int const& indexCount);
+		static void OptimizeOverdraw(std::vector<unsigned int>& indices, std::vector<glm::vec3> const& positions);
+		static void OptimizeMeshletOrder(MeshData& meshData, std::vector<glm::vec3> const& positions);
+		static void OptimizeVertexFetch(MeshData& meshData);
+	};
+}
+
+#endif
@@ -0,0 +1,329 @@
+#include "MeshSimplification.h"
+
+
+namespace Chroma
+{
+	namespace
+	{
+		// symmetric 4x4 error quadric, stored as its upper triangle
+		struct Quadric
+		{
+			double a2{ 0.0 }, ab{ 0.0 }, ac{ 0.0 }, ad{ 0.0 };
+			double b2{ 0.0 }, bc{ 0.0 }, bd{ 0.0 };
+			double c2{ 0.0 }, cd{ 0.0 };
+			double d2{ 0.0 };
+
+			void AddPlane(glm::vec3 const& normal, float const& distance, float const& weight)
+			{
+				double a = normal.x, b = normal.y, c = normal.z, d = distance;
+				a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+				b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+				c2 += weight * c * c; cd += weight * c * d;
+				d2 += weight * d * d;
+			}
+
+			void Add(Quadric const& other)
+			{
+				a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+				b2 += other.b2; bc += other.bc; bd += other.bd;
+				c2 += other.c2; cd += other.cd;
+				d2 += other.d2;
+			}
+
+			double Evaluate(glm::vec3 const& p) const
+			{
+				double x = p.x, y = p.y, z = p.z;
+				double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+					+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+					+ c2 * z * z + 2.0 * cd * z
+					+ d2;
+				return glm::abs(error);
+			}
+		};
+
+		struct Collapse
+		{
+			unsigned int from;
+			unsigned int to;
+			double error;
+
+			bool operator<(Collapse const& other) const
+			{
+				if (error != other.error)
+					return error < other.error;
+				if (from != other.from)
+					return from < other.from;
+				return to < other.to;
+			}
+		};
+
+		// boundary edges are kept in place by planes perpendicular to the face
+		const float kBoundaryWeight{ 10.0f };
+
+		inline uint64_t EdgeKey(unsigned int a, unsigned int b)
+		{
+			if (a > b)
+				std::swap(a, b);
+			return (uint64_t(a) << 32) | uint64_t(b);
+		}
+
+		struct PositionHash
+		{
+			size_t operator()(glm::vec3 const& p) const
+			{
+				uint32_t bits[3];
+				std::memcpy(bits, &p[0], sizeof(bits));
+				return size_t(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+			}
+		};
+	}
+
+
+	std::vector<unsigned int> MeshSimplification::Simplify(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, unsigned int const& targetIndexCount, float const& maxError)
+	{
+		std::vector<unsigned int> result(indices);
+		const unsigned int vertexCount = (unsigned int)positions.size();
+		if (result.size() <= targetIndexCount || vertexCount == 0)
+			return result;
+
+		// weld referenced vertices sharing a position, several of them at one position are a split
+		// in attributes (uv seams, hard normals) that must not tear apart, so those are locked.
+		// indices are expected to reference each distinct vertex once, see GenerateLODs
+		std::vector<unsigned int> canonical(vertexCount);
+		std::vector<bool> locked(vertexCount, false);
+		{
+			for (unsigned int i = 0; i < vertexCount; i++)
+				canonical[i] = i;
+			std::vector<bool> visited(vertexCount, false);
+			std::unordered_map<glm::vec3, unsigned int, PositionHash> firstVertex;
+			for (unsigned int const& index : result)
+			{
+				if (visited[index])
+					continue;
+				visited[index] = true;
+				auto inserted = firstVertex.emplace(positions[index], index);
+				canonical[index] = inserted.first->second;
+				if (!inserted.second)
+				{
+					locked[index] = true;
+					locked[canonical[index]] = true;
+				}
+			}
+		}
+
+		// edge usage on the welded topology
+		std::unordered_map<uint64_t, unsigned int> edgeCount;
+		for (size_t i = 0; i < result.size(); i += 3)
+			for (unsigned int e = 0; e < 3; e++)
+				edgeCount[EdgeKey(canonical[result[i + e]], canonical[result[i + (e + 1) % 3]])]++;
+
+		// initial quadrics from face planes and boundary edges
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			unsigned int tri[3] = { canonical[result[i]], canonical[result[i + 1]], canonical[result[i + 2]] };
+			glm::vec3 faceNormal = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+			float length = glm::length(faceNormal);
+			if (length <= 0.0f)
+				continue;
+			faceNormal /= length;
+			float distance = -glm::dot(faceNormal, positions[tri[0]]);
+			for (unsigned int e = 0; e < 3; e++)
+				quadrics[tri[e]].AddPlane(faceNormal, distance, 1.0f);
+
+			for (unsigned int e = 0; e < 3; e++)
+			{
+				unsigned int a = tri[e], b = tri[(e + 1) % 3];
+				unsigned int count = edgeCount[EdgeKey(a, b)];
+				// non manifold edges are left untouched
+				if (count > 2)
+				{
+					locked[a] = true;
+					locked[b] = true;
+				}
+				if (count != 1)
+					continue;
+				glm::vec3 edge = positions[b] - positions[a];
+				glm::vec3 boundaryNormal = glm::cross(edge, faceNormal);
+				float boundaryLength = glm::length(boundaryNormal);
+				if (boundaryLength <= 0.0f)
+					continue;
+				boundaryNormal /= boundaryLength;
+				float boundaryDistance = -glm::dot(boundaryNormal, positions[a]);
+				float weight = kBoundaryWeight * glm::dot(edge, edge);
+				quadrics[a].AddPlane(boundaryNormal, boundaryDistance, weight);
+				quadrics[b].AddPlane(boundaryNormal, boundaryDistance, weight);
+			}
+		}
+
+		// locked vertices lock every vertex welded to them
+		for (unsigned int i = 0; i < vertexCount; i++)
+			if (locked[canonical[i]])
+				locked[i] = true;
+
+		// collapse in passes, each pass collapses an independent set of edges
+		std::vector<unsigned int> remap(vertexCount);
+		std::vector<bool> touched(vertexCount);
+		std::vector<unsigned int> triangleOffsets(vertexCount + 1);
+		std::vector<unsigned int> vertexTriangles;
+		std::vector<Collapse> collapses;
+		while (result.size() > targetIndexCount)
+		{
+			// vertex to triangle adjacency
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+			for (unsigned int const& index : result)
+				triangleOffsets[index + 1]++;
+			for (unsigned int i = 0; i < vertexCount; i++)
+				triangleOffsets[i + 1] += triangleOffsets[i];
+			vertexTriangles.resize(result.size());
+			{
+				std::vector<unsigned int> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+				for (unsigned int i = 0; i < (unsigned int)result.size(); i++)
+					vertexTriangles[fill[result[i]]++] = i / 3;
+			}
+
+			// rank candidate collapses by error
+			collapses.clear();
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (unsigned int e = 0; e < 3; e++)
+				{
+					unsigned int a = result[i + e], b = result[i + (e + 1) % 3];
+					if (canonical[a] == canonical[b])
+						continue;
+					Quadric combined = quadrics[canonical[a]];
+					combined.Add(quadrics[canonical[b]]);
+					if (!locked[a])
+						collapses.push_back({ a, b, combined.Evaluate(positions[b]) });
+					if (!locked[b])
+						collapses.push_back({ b, a, combined.Evaluate(positions[a]) });
+				}
+			}
+			std::sort(collapses.begin(), collapses.end());
+
+			// pick collapses that keep triangle orientation
+			for (unsigned int i = 0; i < vertexCount; i++)
+				remap[i] = i;
+			std::fill(touched.begin(), touched.end(), false);
+			size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+			size_t trianglesRemoved{ 0 };
+			unsigned int numCollapses{ 0 };
+			for (Collapse const& collapse : collapses)
+			{
+				if (collapse.error > maxError || trianglesRemoved >= trianglesToRemove)
+					break;
+				unsigned int from = collapse.from, to = collapse.to;
+				if (touched[canonical[from]] || touched[canonical[to]])
+					continue;
+
+				bool valid{ true };
+				unsigned int removed{ 0 };
+				for (unsigned int t = triangleOffsets[from]; t < triangleOffsets[from + 1] && valid; t++)
+				{
+					unsigned int const* tri = &result[vertexTriangles[t] * 3];
+					if (canonical[tri[0]] == canonical[to] || canonical[tri[1]] == canonical[to] || canonical[tri[2]] == canonical[to])
+					{
+						removed++;
+						continue;
+					}
+					glm::vec3 p[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+					glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+					for (unsigned int c = 0; c < 3; c++)
+						if (tri[c] == from)
+							p[c] = positions[to];
+					glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+					// reject flipped, strongly rotated or collapsed to a sliver
+					float beforeLength = glm::length(before), afterLength = glm::length(after);
+					if (afterLength <= 1e-3f * beforeLength || glm::dot(before, after) <= 0.25f * beforeLength * afterLength)
+						valid = false;
+				}
+				if (!valid)
+					continue;
+
+				// apply and lock the neighbourhood of this collapse for the rest of the pass
+				remap[from] = to;
+				quadrics[canonical[to]].Add(quadrics[canonical[from]]);
+				for (unsigned int t = triangleOffsets[from]; t < triangleOffsets[from + 1]; t++)
+					for (unsigned int c = 0; c < 3; c++)
+						touched[canonical[result[vertexTriangles[t] * 3 + c]]] = true;
+				trianglesRemoved += removed;
+				numCollapses++;
+			}
+
+			if (numCollapses == 0)
+				break;
+
+			// remap and drop degenerate triangles
+			size_t writeIndex{ 0 };
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+				if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c])
+					continue;
+				result[writeIndex++] = a;
+				result[writeIndex++] = b;
+				result[writeIndex++] = c;
+			}
+			result.resize(writeIndex);
+		}
+
+		return result;
+	}
+
+
+	void MeshSimplification::GenerateLODs(MeshData& meshData)
+	{
+		meshData.lods.clear();
+		if (meshData.indices.size() / 3 < MESH_LOD_MIN_TRIANGLES * 2)
+			return;
+
+		// positions
+		std::vector<glm::vec3> positions;
+		if (meshData.isSkinned)
+			for (ChromaSkinnedVertex const& vert : meshData.skinnedVerts)
+				positions.push_back(vert.m_position);
+		else
+			for (ChromaVertex const& vert : meshData.verts)
+				positions.push_back(vert.m_position);
+		if (positions.empty())
+			return;
+
+		// error is relative to the size of the mesh
+		glm::vec3 bboxMin{ positions[0] }, bboxMax{ positions[0] };
+		for (glm::vec3 const& position : positions)
+		{
+			bboxMin = glm::min(bboxMin, position);
+			bboxMax = glm::max(bboxMax, position);
+		}
+		float extent = glm::length(bboxMax - bboxMin);
+		float maxError = MESH_LOD_MAX_ERROR * extent;
+
+		// each LOD is simplified from the last, allowing twice the error
+		meshData.lods.reserve(MESH_LOD_COUNT);
+		std::vector<unsigned int> const* previous = &meshData.indices;
+		for (unsigned int lod = 1; lod < MESH_LOD_COUNT; lod++)
+		{
+			unsigned int targetIndexCount = (unsigned int)(previous->size() / 3 * MESH_LOD_REDUCTION) * 3;
+			if (targetIndexCount / 3 < MESH_LOD_MIN_TRIANGLES)
+				break;
+
+			std::vector<unsigned int> simplified = Simplify(positions, *previous, targetIndexCount, maxError * maxError);
+			// stop once the error bound prevents further meaningful reduction
+			if (simplified.empty() || simplified.size() > previous->size() * 0.9f)
+				break;
+
+			MeshLOD newLOD;
+			newLOD.indices = std::move(simplified);
+			// triangle density on screen stays constant when projected size scales with sqrt of triangle count
+			newLOD.screenSize = MESH_LOD_SCREEN_SIZE * glm::sqrt((float)newLOD.indices.size() / (float)meshData.indices.size());
+			meshData.lods.push_back(std::move(newLOD));
+
+			previous = &meshData.lods.back().indices;
+			maxError *= 2.0f;
+		}
+
+		CHROMA_TRACE("MESH SIMPLIFICATION :: Generated {0} LODs from {1} triangles.", meshData.lods.size(), meshData.indices.size() / 3);
+		for (unsigned int i = 0; i < meshData.lods.size(); i++)
+			CHROMA_TRACE("MESH SIMPLIFICATION :: LOD{0} : {1} triangles, screen size {2}.", i + 1, meshData.lods[i].indices.size() / 3, meshData.lods[i].screenSize);
+	}
+}
@@ -0,0 +1,28 @@
+#ifndef _CHROMA_MESH_SIMPLIFICATION_
+#define _CHROMA_MESH_SIMPLIFICATION_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <model/MeshData.h>
+
+namespace Chroma
+{
+	// Import time mesh simplification using quadric error metrics (Garland & Heckbert).
+	// Vertices are collapsed onto a neighbouring vertex rather than an optimal position,
+	// so simplified LODs index into the original vertex buffer and keep its attributes.
+	class MeshSimplification
+	{
+	public:
+		// Builds the LOD chain for the meshData, LOD0 remains meshData.indices.
+		// Expects welded vertices (MeshOptimizer::WeldVertices), duplicate corners would be locked as seams.
+		static void GenerateLODs(MeshData& meshData);
+
+		// Returns a simplified index list with at most targetIndexCount indices where reachable.
+		// maxError is the largest quadric error accepted for a single collapse.
+		static std::vector<unsigned int> Simplify(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, unsigned int const& targetIndexCount, float const& maxError);
+	};
+}
+
+#endif
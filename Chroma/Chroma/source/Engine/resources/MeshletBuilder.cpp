@@ -0,0 +1,155 @@
+#include "MeshletBuilder.h"
+
+
+namespace Chroma
+{
+	void MeshletBuilder::BuildMeshlets(MeshData& meshData)
+	{
+		meshData.meshlets.clear();
+
+		// skinned bounds change every frame, only dense static meshes are clustered
+		const unsigned int triangleCount = (unsigned int)meshData.indices.size() / 3;
+		if (meshData.isSkinned || triangleCount < MESHLET_MIN_MESH_TRIANGLES || meshData.verts.empty())
+			return;
+
+		// vertex to triangle adjacency
+		const unsigned int vertexCount = (unsigned int)meshData.verts.size();
+		std::vector<unsigned int> triangleOffsets(vertexCount + 1, 0);
+		for (unsigned int const& index : meshData.indices)
+			triangleOffsets[index + 1]++;
+		for (unsigned int i = 0; i < vertexCount; i++)
+			triangleOffsets[i + 1] += triangleOffsets[i];
+		std::vector<unsigned int> vertexTriangles(meshData.indices.size());
+		{
+			std::vector<unsigned int> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (unsigned int i = 0; i < (unsigned int)meshData.indices.size(); i++)
+				vertexTriangles[fill[meshData.indices[i]]++] = i / 3;
+		}
+
+		// grow meshlets greedily from a seed, preferring triangles that add the fewest new vertices
+		std::vector<unsigned int> meshletIndices;
+		meshletIndices.reserve(meshData.indices.size());
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<unsigned int> vertexMeshlet(vertexCount, 0);
+		std::vector<unsigned int> candidates;
+		unsigned int numEmitted{ 0 };
+		unsigned int seed{ 0 };
+		unsigned int meshletID{ 0 };
+		while (numEmitted < triangleCount)
+		{
+			while (emitted[seed])
+				seed++;
+
+			meshletID++;
+			Meshlet meshlet;
+			meshlet.indexOffset = (unsigned int)meshletIndices.size();
+			unsigned int numVertices{ 0 };
+			unsigned int numTriangles{ 0 };
+			candidates.clear();
+			candidates.push_back(seed);
+
+			while (numTriangles < MESHLET_MAX_TRIANGLES)
+			{
+				// find best candidate, dropping those emitted since they were added
+				int best{ -1 };
+				unsigned int bestNewVertices{ 4 };
+				for (size_t c = 0; c < candidates.size();)
+				{
+					unsigned int triangle = candidates[c];
+					if (emitted[triangle])
+					{
+						candidates[c] = candidates.back();
+						candidates.pop_back();
+						continue;
+					}
+					unsigned int newVertices{ 0 };
+					for (unsigned int corner = 0; corner < 3; corner++)
+						if (vertexMeshlet[meshData.indices[triangle * 3 + corner]] != meshletID)
+							newVertices++;
+					if (newVertices < bestNewVertices)
+					{
+						bestNewVertices = newVertices;
+						best = (int)c;
+						if (newVertices == 0)
+							break;
+					}
+					c++;
+				}
+				if (best < 0 || numVertices + bestNewVertices > MESHLET_MAX_VERTICES)
+					break;
+
+				// emit triangle
+				unsigned int triangle = candidates[best];
+				emitted[triangle] = true;
+				numEmitted++;
+				numTriangles++;
+				for (unsigned int corner = 0; corner < 3; corner++)
+				{
+					unsigned int vertex = meshData.indices[triangle * 3 + corner];
+					meshletIndices.push_back(vertex);
+					if (vertexMeshlet[vertex] == meshletID)
+						continue;
+					vertexMeshlet[vertex] = meshletID;
+					numVertices++;
+					// neighbouring triangles become candidates
+					for (unsigned int t = triangleOffsets[vertex]; t < triangleOffsets[vertex + 1]; t++)
+						if (!emitted[vertexTriangles[t]])
+							candidates.push_back(vertexTriangles[t]);
+				}
+			}
+
+			meshlet.indexCount = (unsigned int)meshletIndices.size() - meshlet.indexOffset;
+			CalculateMeshletBounds(meshlet, meshletIndices, meshData.verts);
+			meshData.meshlets.push_back(meshlet);
+		}
+
+		meshData.indices = std::move(meshletIndices);
+
+		CHROMA_TRACE("MESHLET BUILDER :: Built {0} meshlets from {1} triangles.", meshData.meshlets.size(), triangleCount);
+	}
+
+	void MeshletBuilder::CalculateMeshletBounds(Meshlet& meshlet, std::vector<unsigned int> const& indices, std::vector<ChromaVertex> const& verts)
+	{
+		// bounding sphere around the bbox center
+		glm::vec3 bboxMin{ verts[indices[meshlet.indexOffset]].m_position };
+		glm::vec3 bboxMax{ bboxMin };
+		for (unsigned int i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i++)
+		{
+			bboxMin = glm::min(bboxMin, verts[indices[i]].m_position);
+			bboxMax = glm::max(bboxMax, verts[indices[i]].m_position);
+		}
+		meshlet.center = (bboxMin + bboxMax) * 0.5f;
+		meshlet.radius = 0.0f;
+		for (unsigned int i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i++)
+			meshlet.radius = glm::max(meshlet.radius, glm::length(verts[indices[i]].m_position - meshlet.center));
+
+		// normal cone from the face normals
+		std::vector<glm::vec3> normals;
+		glm::vec3 axis{ 0.0f };
+		for (unsigned int i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; i += 3)
+		{
+			glm::vec3 p0 = verts[indices[i]].m_position;
+			glm::vec3 normal = glm::cross(verts[indices[i + 1]].m_position - p0, verts[indices[i + 2]].m_position - p0);
+			float length = glm::length(normal);
+			if (length <= 0.0f)
+				continue;
+			normals.push_back(normal / length);
+			axis += normals.back();
+		}
+		meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+		meshlet.coneCutoff = 1.0f;
+		float axisLength = glm::length(axis);
+		if (axisLength <= 0.0f)
+			return;
+		axis /= axisLength;
+
+		float minDot{ 1.0f };
+		for (glm::vec3 const& normal : normals)
+			minDot = glm::min(minDot, glm::dot(normal, axis));
+
+		// wide cones can never be culled
+		meshlet.coneAxis = axis;
+		if (minDot > 0.1f)
+			meshlet.coneCutoff = glm::sqrt(1.0f - minDot * minDot);
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef _CHROMA_MESHLET_BUILDER_
+#define _CHROMA_MESHLET_BUILDER_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <model/MeshData.h>
+
+namespace Chroma
+{
+	// Splits dense meshes into small clusters of connected triangles.
+	// LOD0 indices are reordered so each meshlet is a contiguous index range,
+	// with a bounding sphere and normal cone for frustum and backface culling.
+	class MeshletBuilder
+	{
+	public:
+		static void BuildMeshlets(MeshData& meshData);
+
+	private:
+		static void CalculateMeshletBounds(Meshlet& meshlet, std::vector<unsigned int> const& indices, std::vector<ChromaVertex> const& verts);
+	};
+}
+
+#endif
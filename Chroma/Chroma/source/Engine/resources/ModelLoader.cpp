@@ -1,5 +1,8 @@
 #include "ModelLoader.h"
 #include <resources/TextureLoader.h>
+#include <resources/MeshSimplification.h>
+#include <resources/MeshletBuilder.h>
+#include <resources/MeshOptimizer.h>
 
 namespace Chroma 
 {
@@ -239,6 +242,18 @@ namespace Chroma
 			CHROMA_TRACE("MODEL LOADER :: Skeleton Processed.");
 		}
 
+		// merge identical vertices, assimp emits one per face corner
+		MeshOptimizer::WeldVertices(newMeshData);
+
+		// generate level of detail chain
+		MeshSimplification::GenerateLODs(newMeshData);
+
+		// cluster dense meshes for finer culling, reorders LOD0 indices
+		MeshletBuilder::BuildMeshlets(newMeshData);
+
+		// reorder triangles for vertex cache and overdraw, vertices for fetch
+		MeshOptimizer::OptimizeMesh(newMeshData);
+
 		return newMeshData;
 	}
 
@@ -261,8 +276,7 @@ namespace Chroma
 			}
 			if (!skip)
 			{
-				Texture texture = Chroma::TextureLoader::Create2DTexture(textureName.C_Str(), m_SourceDir);
-				texture.SetType(typeName);
+				Texture texture = Chroma::TextureLoader::Create2DTexture(textureName.C_Str(), m_SourceDir, typeName);
 				meshData.textures.push_back(texture);
 				meshData.textures.push_back(texture);
 			}
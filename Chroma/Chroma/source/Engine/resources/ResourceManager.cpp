@@ -1,4 +1,5 @@
 #include "ResourceManager.h"
+#include <resources/TextureStreamer.h>
 
 
 namespace Chroma
@@ -19,6 +20,7 @@ namespace Chroma
 	void ResourceManager::OnUpdate()
 	{
 		Chroma::TextureLoader::OnUpdate();
+		Chroma::TextureStreamer::OnUpdate();
 	}
 
 
@@ -126,6 +128,7 @@ namespace Chroma
 		}
 		else
 		{
+			meshdata->isLoadFailed = true;
 			CHROMA_ERROR("RESOURCE MANAGER :: LoadModel :: Cannot find model at : {}", sourcePath);
 		}
 	}
@@ -3,6 +3,7 @@
 #include <texture/stb_image.h>
 #endif
 #include "TextureLoader.h"
+#include "TextureStreamer.h"
 
 
 
@@ -25,7 +26,7 @@ namespace Chroma
 		return Texture(newTex);
 	}
 
-	Texture TextureLoader::Create2DTexture(std::string sourcePath, std::string dir)
+	Texture TextureLoader::Create2DTexture(std::string sourcePath, std::string dir, Chroma::Type::Texture type)
 	{
 		TEXTURELOADER_LOAD 
 
@@ -33,6 +34,7 @@ namespace Chroma
 
 		std::shared_ptr<TextureData> newTex = std::make_shared<TextureData>();
 		newTex->sourcePath = srcPath;
+		newTex->type = type;
 		Load2DTexture(newTex);
 		Initialize2DTexture(newTex);
 
@@ -80,15 +82,9 @@ namespace Chroma
 		textureData->isInitialized = false;
 		textureData->isLoaded = false;
 
-		// Load
-		textureData->imageData = stbi_load(sourcePath.c_str(), &textureData->width, &textureData->height, &textureData->nrComponents, 0);
-
-		if (textureData->imageData)
-		{
-			textureData->isLoaded = true;
-			// Send to initialization queue in order to be initialized on Main Thread
-			//m_2DInitalizationQueue.Push(textureData);
-		}
+		// Load, block compressed mips from the cache, only the resident tail when streaming
+		textureData->sourcePath = sourcePath;
+		textureData->isLoaded = TextureStreamer::LoadResidentMips(textureData);
 	}
 
 	HDRTexture TextureLoader::LoadHDRTexture(std::string sourcePath)
@@ -237,52 +233,10 @@ namespace Chroma
 		// Mark uninitialized
 		textureData->isInitialized = false;
 
-		// OpenGL init if loaded
+		// OpenGL init if loaded, the cached mips are uploaded as they are
 		if (textureData->isLoaded)
 		{
-			// ID
-			glGenTextures(1, &textureData->ID);
-
-			GLenum format;
-			if (textureData->nrComponents == 1)
-				format = GL_RED;
-			else if (textureData->nrComponents == 3)
-				format = GL_RGB;
-			else if (textureData->nrComponents == 4)
-				format = GL_RGBA;
-			GLenum wrapping;
-			if (textureData->nrComponents == 1)
-				wrapping = GL_REPEAT;
-			else if (textureData->nrComponents == 3)
-				wrapping = GL_REPEAT;
-			else if (textureData->nrComponents == 4)
-				wrapping = GL_REPEAT;
-
-			glBindTexture(GL_TEXTURE_2D, textureData->ID);
-			glTexImage2D(GL_TEXTURE_2D, 0, format, textureData->width, textureData->height, 0, format, GL_UNSIGNED_BYTE, textureData->imageData);
-
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapping);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapping);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-			// Antisotropic filtering
-			GLfloat value, max_anisotropy = 4.0f; /* don't exceed this value...*/
-			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value);
-			value = glm::min(value, max_anisotropy);
-			glTexParameterf(GL_TEXTURE_2D, GL_MAX_TEXTURE_MAX_ANISOTROPY, value);
-
-			//Generate mipmap
-			glGenerateMipmap(GL_TEXTURE_2D);
-
-			// Mark initialized
-			textureData->isInitialized = true;
-
-			// Cleanup
-			stbi_image_free(textureData->imageData);
-			textureData->imageData = nullptr;
-			textureData->isLoaded = false;
-
+			TextureStreamer::InitializeTexture(textureData);
 			CHROMA_INFO("TEXTURE LOADER : 2D Texture Initialized successfully. ");
 		}
 		else
@@ -338,15 +292,12 @@ namespace Chroma
 		textureData->isInitialized = false;
 		textureData->isLoaded = false;
 
-		// Load
-		textureData->imageData = stbi_load(textureData->sourcePath.c_str(), &textureData->width, &textureData->height, &textureData->nrComponents, 0);
+		// Load, block compressed mips from the cache, built from the source on a miss
+		textureData->isLoaded = TextureStreamer::LoadResidentMips(textureData);
 
 		// Send to initialization queue for initialization
-		if (textureData->imageData)
-		{
+		if (textureData->isLoaded)
 			CHROMA_INFO("TEXTURE LOADER :: Texture : {0} : Loaded successfully.", textureData->sourcePath);
-			textureData->isLoaded = true;
-		}
 		else
 			CHROMA_ERROR("TEXTURE LOADER :: Unable to load : {0}", textureData->sourcePath);
 
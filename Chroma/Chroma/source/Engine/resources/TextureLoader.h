@@ -20,7 +20,8 @@ namespace Chroma
 		static void OnUpdate();
 
 		static Texture Create2DTexture(std::string sourcePath);
-		static Texture Create2DTexture(std::string sourcePath, std::string dir);
+		// type is set before loading, normal maps are compressed differently
+		static Texture Create2DTexture(std::string sourcePath, std::string dir, Chroma::Type::Texture type);
 		static std::shared_ptr<TextureData> Create2DTextureData(std::string sourcePath);
 		// async
 		//static void Create2DTextureThreadSafe(std::string sourcePath, TextureData& textureData);
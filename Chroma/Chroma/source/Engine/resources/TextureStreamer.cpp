@@ -0,0 +1,442 @@
+#include "TextureStreamer.h"
+#include <texture/stb_image.h>
+#include <shader/ShaderCache.h>
+#include <render/Render.h>
+
+#define TEXTURE_MIP_CACHE_MAGIC 0x5049434D // "MCIP"
+#define TEXTURE_MIP_CACHE_VERSION 3
+
+namespace Chroma
+{
+	std::vector<TextureStreamer::StreamedTexture*> TextureStreamer::s_Textures;
+	std::map<TextureData*, TextureStreamer::StreamedTexture*> TextureStreamer::s_Lookup;
+	uint64_t TextureStreamer::s_Frame{ 0 };
+	uint64_t TextureStreamer::s_ResidentBytes{ 0 };
+	unsigned int TextureStreamer::s_NumPending{ 0 };
+
+	void TextureStreamer::OnUpdate()
+	{
+		s_Frame++;
+
+		// textures only the streamer still references are released
+		for (size_t i = s_Textures.size(); i-- > 0;)
+		{
+			StreamedTexture* texture = s_Textures[i];
+			if (texture->textureData.use_count() > 1 || texture->loading.valid())
+				continue;
+			glDeleteTextures(1, &texture->textureData->ID);
+			s_Lookup.erase(texture->textureData.get());
+			s_Textures.erase(s_Textures.begin() + i);
+			delete texture;
+		}
+
+		// finished I/O jobs
+		s_NumPending = 0;
+		for (StreamedTexture* texture : s_Textures)
+		{
+			if (!texture->loading.valid())
+				continue;
+			if (texture->loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				s_NumPending++;
+				continue;
+			}
+			if (texture->loading.get())
+				Reallocate(*texture, texture->loadingMip, texture->loadedLevels);
+			else
+			{
+				CHROMA_WARN("TEXTURE STREAMER :: Could not read mips from : {0}", texture->textureData->cachePath);
+				texture->minMip = texture->textureData->residentMip;
+			}
+			std::vector<std::vector<unsigned char>>().swap(texture->loadedLevels);
+		}
+
+		// this frame's requests become the target, textures not drawn keep their last request
+		for (StreamedTexture* texture : s_Textures)
+		{
+			if (texture->frameRequest != INT_MAX)
+			{
+				texture->requestedMip = texture->frameRequest;
+				texture->frameRequest = INT_MAX;
+			}
+			texture->wantedMip = glm::clamp(texture->requestedMip, texture->minMip, GetTailMip(*texture->textureData));
+		}
+		ApplyBudget();
+
+		// evict right away, stream in on I/O jobs
+		for (StreamedTexture* texture : s_Textures)
+		{
+			if (texture->loading.valid())
+				continue;
+			if (texture->wantedMip > texture->textureData->residentMip)
+				Reallocate(*texture, texture->wantedMip, {});
+			else if (texture->wantedMip < texture->textureData->residentMip && s_NumPending < TEXTURE_STREAMING_MAX_PENDING)
+			{
+				StartLoading(*texture);
+				s_NumPending++;
+			}
+		}
+
+		s_ResidentBytes = 0;
+		for (StreamedTexture const* texture : s_Textures)
+			s_ResidentBytes += GetResidentBytes(*texture->textureData, texture->textureData->residentMip);
+	}
+
+	bool TextureStreamer::LoadResidentMips(std::shared_ptr<TextureData> textureData)
+	{
+		// the source is only read for its hash unless the cache is missing or stale
+		std::ifstream sourceFile(textureData->sourcePath, std::ios::binary);
+		if (!sourceFile)
+			return false;
+		std::stringstream sourceStream;
+		sourceStream << sourceFile.rdbuf();
+		std::string const source = sourceStream.str();
+		// formats chosen depend on the compression settings and whether the image is a normal map
+		uint64_t const isNormal = textureData->type == Chroma::Type::Texture::kNormal ? 1u : 0u;
+		uint64_t const settings = TEXTURE_MIP_CACHE_VERSION | (TEXTURE_COMPRESSION_ENABLED ? 1u : 0u) << 8 | (TEXTURE_COMPRESSION_BC7 ? 1u : 0u) << 9 | isNormal << 10;
+		uint64_t const key = ShaderCache::HashCombine(ShaderCache::HashSource(source), settings);
+		textureData->cachePath = GetCachePath(key);
+
+		MipCacheHeader header;
+		std::vector<std::vector<unsigned char>> levels;
+		if (!ReadMipCache(textureData->cachePath, -1, -1, header, levels) || header.key != key)
+		{
+			// decode, build and compress the full chain once
+			int width{ 0 }, height{ 0 }, components{ 0 };
+			unsigned char* image = stbi_load_from_memory(reinterpret_cast<stbi_uc const*>(source.data()), (int)source.size(), &width, &height, &components, 0);
+			if (!image)
+				return false;
+			GLenum const format = BlockCompression::GetFormat(image, width, height, components, textureData->type);
+			BuildMipChain(image, width, height, components, levels);
+			stbi_image_free(image);
+			CompressMipChain(width, height, components, format, levels);
+			CHROMA_INFO("TEXTURE STREAMER :: Built mip cache for : {0}", textureData->sourcePath);
+
+			header.magic = TEXTURE_MIP_CACHE_MAGIC;
+			header.version = TEXTURE_MIP_CACHE_VERSION;
+			header.key = key;
+			header.width = width;
+			header.height = height;
+			header.components = components;
+			header.numMips = (int32_t)levels.size();
+			header.format = format;
+			WriteMipCache(textureData->cachePath, header, levels);
+		}
+
+		textureData->width = header.width;
+		textureData->height = header.height;
+		textureData->nrComponents = header.components;
+		textureData->numMips = header.numMips;
+		textureData->format = header.format;
+		textureData->isStreamed = textureData->isStreamable;
+		textureData->residentMip = GetTailMip(*textureData);
+
+		// keep only the resident tail
+		if (levels.empty())
+			return ReadMipCache(textureData->cachePath, textureData->residentMip, textureData->numMips, header, textureData->mipData);
+		textureData->mipData.assign(std::make_move_iterator(levels.begin() + textureData->residentMip), std::make_move_iterator(levels.end()));
+		return true;
+	}
+
+	void TextureStreamer::InitializeTexture(std::shared_ptr<TextureData> textureData)
+	{
+		// immutable storage for the resident mips only
+		glGenTextures(1, &textureData->ID);
+		glBindTexture(GL_TEXTURE_2D, textureData->ID);
+		int const residentMip = textureData->residentMip;
+		glTexStorage2D(GL_TEXTURE_2D, textureData->numMips - residentMip, textureData->format,
+			glm::max(textureData->width >> residentMip, 1), glm::max(textureData->height >> residentMip, 1));
+		for (int mip = residentMip; mip < textureData->numMips; mip++)
+			UploadLevel(*textureData, mip - residentMip, mip, textureData->mipData[mip - residentMip]);
+		SetSamplerParameters();
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		std::vector<std::vector<unsigned char>>().swap(textureData->mipData);
+		textureData->isInitialized = true;
+		textureData->isLoaded = false;
+
+		if (!textureData->isStreamed)
+			return;
+
+		// textures register while binding, after this frame's requests, so only the tail until a draw asks for more
+		StreamedTexture* texture = new StreamedTexture();
+		texture->textureData = textureData;
+		texture->requestedMip = GetTailMip(*textureData);
+		texture->lastUsedFrame = s_Frame;
+		s_Textures.push_back(texture);
+		s_Lookup[textureData.get()] = texture;
+	}
+
+	void TextureStreamer::Release(TextureData& textureData)
+	{
+		auto const found = s_Lookup.find(&textureData);
+		if (found != s_Lookup.end())
+		{
+			// a pending I/O job still writes into the streamed texture
+			StreamedTexture* texture = found->second;
+			if (texture->loading.valid())
+				texture->loading.wait();
+			s_Textures.erase(std::find(s_Textures.begin(), s_Textures.end(), texture));
+			s_Lookup.erase(found);
+			delete texture;
+		}
+
+		// every Texture sharing the data sees the release
+		glDeleteTextures(1, &textureData.ID);
+		textureData.ID = 0;
+		textureData.isInitialized = false;
+		textureData.isStreamed = false;
+	}
+
+	void TextureStreamer::RequestMaterial(Material& material, float const& screenSize)
+	{
+		glm::vec2 const uvMultiply = material.GetUVMultiply();
+		float const screenPixels = glm::max(screenSize * (float)Render::GetRenderHeight(), 1.0f);
+		for (Texture& texture : material.GetTextureSet())
+		{
+			std::shared_ptr<TextureData> const& textureData = texture.GetTextureData();
+			if (!textureData->isStreamed)
+				continue;
+
+			// texels spread over the projected size, assuming the UV range covers the mesh once
+			float const texels = (float)glm::max(textureData->width, textureData->height) * glm::max(uvMultiply.x, uvMultiply.y);
+			RequestMip(textureData, (int)glm::floor(glm::log2(glm::max(texels / screenPixels, 1.0f))));
+		}
+	}
+
+	void TextureStreamer::RequestMip(std::shared_ptr<TextureData> const& textureData, int const& mip)
+	{
+		std::map<TextureData*, StreamedTexture*>::iterator it = s_Lookup.find(textureData.get());
+		if (it == s_Lookup.end())
+			return;
+		it->second->frameRequest = glm::min(it->second->frameRequest, mip);
+		it->second->lastUsedFrame = s_Frame;
+	}
+
+	float TextureStreamer::GetScreenSize(Camera& renderCam, glm::vec3 const& center, float const& radius)
+	{
+		// inside the bounds counts as unbounded
+		float const distance = glm::length(center - renderCam.GetPosition());
+		if (!(radius > 0.0f) || distance <= radius)
+			return FLT_MAX;
+		return radius / (distance * glm::tan(glm::radians(renderCam.GetFOV()) * 0.5f));
+	}
+
+	std::string TextureStreamer::GetCachePath(uint64_t const& key)
+	{
+		char fileName[17];
+		snprintf(fileName, sizeof(fileName), "%016llx", (unsigned long long)key);
+		return std::string(TEXTURE_STREAMING_CACHE_DIR) + "/" + fileName + ".mips";
+	}
+
+	bool TextureStreamer::ReadMipCache(std::string const& cachePath, int const& firstMip, int const& endMip, MipCacheHeader& header, std::vector<std::vector<unsigned char>>& levels)
+	{
+		std::ifstream cacheFile(cachePath, std::ios::binary);
+		if (!cacheFile)
+			return false;
+		cacheFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!cacheFile || header.magic != TEXTURE_MIP_CACHE_MAGIC || header.version != TEXTURE_MIP_CACHE_VERSION)
+			return false;
+
+		// header only
+		if (firstMip < 0)
+			return true;
+
+		// levels are stored finest first
+		std::streamoff offset = sizeof(header);
+		for (int mip = 0; mip < firstMip; mip++)
+			offset += (std::streamoff)GetLevelBytes(header.width, header.height, header.components, header.format, mip);
+		cacheFile.seekg(offset);
+
+		levels.resize(endMip - firstMip);
+		for (int mip = firstMip; mip < endMip; mip++)
+		{
+			std::vector<unsigned char>& level = levels[mip - firstMip];
+			level.resize(GetLevelBytes(header.width, header.height, header.components, header.format, mip));
+			cacheFile.read(reinterpret_cast<char*>(level.data()), level.size());
+		}
+		return (bool)cacheFile;
+	}
+
+	void TextureStreamer::WriteMipCache(std::string const& cachePath, MipCacheHeader const& header, std::vector<std::vector<unsigned char>> const& levels)
+	{
+		CreateDirectoryA(TEXTURE_STREAMING_CACHE_DIR, NULL);
+		std::ofstream cacheFile(cachePath, std::ios::binary | std::ios::trunc);
+		if (!cacheFile)
+		{
+			CHROMA_WARN("TEXTURE STREAMER :: Could not write mip cache to : {0}", cachePath);
+			return;
+		}
+		cacheFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		for (std::vector<unsigned char> const& level : levels)
+			cacheFile.write(reinterpret_cast<char const*>(level.data()), level.size());
+	}
+
+	void TextureStreamer::BuildMipChain(unsigned char* image, int const& width, int const& height, int const& components, std::vector<std::vector<unsigned char>>& levels)
+	{
+		levels.resize(GetNumMips(width, height));
+		levels[0].assign(image, image + (size_t)width * height * components);
+
+		// 2x2 box filter, odd edges repeat their last texel
+		for (size_t mip = 1; mip < levels.size(); mip++)
+		{
+			int const srcWidth = glm::max(width >> (mip - 1), 1), srcHeight = glm::max(height >> (mip - 1), 1);
+			int const dstWidth = glm::max(width >> mip, 1), dstHeight = glm::max(height >> mip, 1);
+			std::vector<unsigned char> const& src = levels[mip - 1];
+			std::vector<unsigned char>& dst = levels[mip];
+			dst.resize((size_t)dstWidth * dstHeight * components);
+			for (int y = 0; y < dstHeight; y++)
+			{
+				int const y0 = glm::min(y * 2, srcHeight - 1), y1 = glm::min(y * 2 + 1, srcHeight - 1);
+				for (int x = 0; x < dstWidth; x++)
+				{
+					int const x0 = glm::min(x * 2, srcWidth - 1), x1 = glm::min(x * 2 + 1, srcWidth - 1);
+					for (int c = 0; c < components; c++)
+					{
+						unsigned int const sum = src[((size_t)y0 * srcWidth + x0) * components + c] + src[((size_t)y0 * srcWidth + x1) * components + c] +
+							src[((size_t)y1 * srcWidth + x0) * components + c] + src[((size_t)y1 * srcWidth + x1) * components + c];
+						dst[((size_t)y * dstWidth + x) * components + c] = (unsigned char)((sum + 2) / 4);
+					}
+				}
+			}
+		}
+	}
+
+	void TextureStreamer::CompressMipChain(int const& width, int const& height, int const& components, GLenum const& format, std::vector<std::vector<unsigned char>>& levels)
+	{
+		if (!BlockCompression::GetIsCompressed(format))
+			return;
+		std::vector<unsigned char> blocks;
+		for (size_t mip = 0; mip < levels.size(); mip++)
+		{
+			BlockCompression::Encode(levels[mip].data(), glm::max(width >> mip, 1), glm::max(height >> mip, 1), components, format, blocks);
+			levels[mip].swap(blocks);
+		}
+	}
+
+	int TextureStreamer::GetNumMips(int const& width, int const& height)
+	{
+		return (int)glm::floor(glm::log2((float)glm::max(width, height))) + 1;
+	}
+
+	int TextureStreamer::GetTailMip(TextureData const& textureData)
+	{
+		// everything is resident without streaming
+		int mip{ 0 };
+		while (TEXTURE_STREAMING_ENABLED && textureData.isStreamed && mip + 1 < textureData.numMips && glm::max(textureData.width >> mip, textureData.height >> mip) > TEXTURE_STREAMING_RESIDENT_SIZE)
+			mip++;
+		return mip;
+	}
+
+	uint64_t TextureStreamer::GetLevelBytes(int const& width, int const& height, int const& components, GLenum const& format, int const& mip)
+	{
+		return BlockCompression::GetLevelBytes(format, glm::max(width >> mip, 1), glm::max(height >> mip, 1), components);
+	}
+
+	uint64_t TextureStreamer::GetResidentBytes(TextureData const& textureData, int const& firstMip)
+	{
+		// uncompressed RGB is padded to four bytes on the GPU
+		int const components = textureData.nrComponents == 3 ? 4 : textureData.nrComponents;
+		uint64_t bytes{ 0 };
+		for (int mip = firstMip; mip < textureData.numMips; mip++)
+			bytes += GetLevelBytes(textureData.width, textureData.height, components, textureData.format, mip);
+		return bytes;
+	}
+
+	void TextureStreamer::ApplyBudget()
+	{
+		uint64_t const budget = (uint64_t)TEXTURE_STREAMING_BUDGET_MB * 1024 * 1024;
+		uint64_t total{ 0 };
+		for (StreamedTexture const* texture : s_Textures)
+			total += GetResidentBytes(*texture->textureData, texture->wantedMip);
+		if (total <= budget)
+			return;
+
+		// drop detail from the least recently drawn first
+		std::vector<StreamedTexture*> textures = s_Textures;
+		std::sort(textures.begin(), textures.end(), [](StreamedTexture const* a, StreamedTexture const* b) { return a->lastUsedFrame < b->lastUsedFrame; });
+		for (StreamedTexture* texture : textures)
+		{
+			int const tailMip = GetTailMip(*texture->textureData);
+			while (total > budget && texture->wantedMip < tailMip)
+			{
+				total -= GetResidentBytes(*texture->textureData, texture->wantedMip) - GetResidentBytes(*texture->textureData, texture->wantedMip + 1);
+				texture->wantedMip++;
+			}
+			if (total <= budget)
+				break;
+		}
+	}
+
+	void TextureStreamer::StartLoading(StreamedTexture& texture)
+	{
+		// every mip between the wanted and the resident one, read in the background
+		texture.loadingMip = texture.wantedMip;
+		StreamedTexture* streamed = &texture;
+		std::string const cachePath = texture.textureData->cachePath;
+		int const firstMip = texture.wantedMip, endMip = texture.textureData->residentMip;
+		texture.loading = std::async(std::launch::async, [streamed, cachePath, firstMip, endMip]() {
+			MipCacheHeader header;
+			return ReadMipCache(cachePath, firstMip, endMip, header, streamed->loadedLevels);
+		});
+	}
+
+	void TextureStreamer::Reallocate(StreamedTexture& texture, int const& newMip, std::vector<std::vector<unsigned char>> const& newLevels)
+	{
+		TextureData& textureData = *texture.textureData;
+		int const oldMip = textureData.residentMip;
+		unsigned int const oldID = textureData.ID;
+
+		// new storage sized for the new finest mip
+		unsigned int newID{ 0 };
+		glGenTextures(1, &newID);
+		glBindTexture(GL_TEXTURE_2D, newID);
+		glTexStorage2D(GL_TEXTURE_2D, textureData.numMips - newMip, textureData.format,
+			glm::max(textureData.width >> newMip, 1), glm::max(textureData.height >> newMip, 1));
+
+		// mips both have are copied on the GPU, whole levels so compressed tails smaller than a block copy too
+		for (int mip = glm::max(oldMip, newMip); mip < textureData.numMips; mip++)
+			glCopyImageSubData(oldID, GL_TEXTURE_2D, mip - oldMip, 0, 0, 0, newID, GL_TEXTURE_2D, mip - newMip, 0, 0, 0,
+				glm::max(textureData.width >> mip, 1), glm::max(textureData.height >> mip, 1), 1);
+
+		// streamed in mips are uploaded
+		for (int mip = newMip; mip < oldMip && mip - newMip < (int)newLevels.size(); mip++)
+			UploadLevel(textureData, mip - newMip, mip, newLevels[mip - newMip]);
+		SetSamplerParameters();
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// materials fetch the ID when binding
+		glDeleteTextures(1, &oldID);
+		textureData.ID = newID;
+		textureData.residentMip = newMip;
+	}
+
+	void TextureStreamer::UploadLevel(TextureData const& textureData, int const& level, int const& mip, std::vector<unsigned char> const& data)
+	{
+		// blocks go up as they are stored, the bound texture is written
+		int const width = glm::max(textureData.width >> mip, 1), height = glm::max(textureData.height >> mip, 1);
+		if (BlockCompression::GetIsCompressed(textureData.format))
+		{
+			glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, textureData.format, (GLsizei)data.size(), data.data());
+			return;
+		}
+
+		int const components = textureData.nrComponents;
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, components == 1 ? GL_RED : components == 2 ? GL_RG : components == 3 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void TextureStreamer::SetSamplerParameters()
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// Antisotropic filtering
+		GLfloat value, max_anisotropy = 4.0f;
+		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value);
+		glTexParameterf(GL_TEXTURE_2D, GL_MAX_TEXTURE_MAX_ANISOTROPY, glm::min(value, max_anisotropy));
+	}
+}
@@ -0,0 +1,97 @@
+#ifndef _CHROMA_TEXTURE_STREAMER_H
+#define _CHROMA_TEXTURE_STREAMER_H
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <texture/Texture.h>
+#include <texture/BlockCompression.h>
+#include <material/Material.h>
+#include <camera/Camera.h>
+
+namespace Chroma
+{
+	// Mip residency for 2D textures. Source images are decoded and block compressed once into
+	// a mip cache keyed by their contents, only the small tail mips are loaded up front. Draws request the mip
+	// their projected size needs, finer mips are read from the cache on I/O jobs and dropped
+	// again from the least recently used textures once the budget is exceeded.
+	class TextureStreamer
+	{
+	public:
+		// streaming and eviction, main thread
+		static void OnUpdate();
+
+		// background thread, builds the mip cache on a miss and reads the resident tail
+		static bool LoadResidentMips(std::shared_ptr<TextureData> textureData);
+		// main thread, uploads the resident tail and starts tracking the texture
+		static void InitializeTexture(std::shared_ptr<TextureData> textureData);
+		// main thread, stops tracking the texture and deletes its storage, the only delete of a streamed ID
+		static void Release(TextureData& textureData);
+
+		// screenSize is the projected height as a fraction of the screen
+		static void RequestMaterial(Material& material, float const& screenSize);
+		static void RequestMip(std::shared_ptr<TextureData> const& textureData, int const& mip);
+		static float GetScreenSize(Camera& renderCam, glm::vec3 const& center, float const& radius);
+
+		static inline uint64_t GetResidentBytes() { return s_ResidentBytes; }
+		static inline unsigned int GetNumPending() { return s_NumPending; }
+
+	private:
+		struct StreamedTexture
+		{
+			std::shared_ptr<TextureData> textureData;
+			// finest mip drawn with, kept while the texture is not drawn, the tail until the first request
+			int requestedMip{ 0 };
+			int frameRequest{ INT_MAX };
+			uint64_t lastUsedFrame{ 0 };
+			// after the budget
+			int wantedMip{ 0 };
+			// finest mip the cache can provide
+			int minMip{ 0 };
+			// I/O job, loads mips loadingMip up to the resident mip
+			std::future<bool> loading;
+			int loadingMip{ 0 };
+			std::vector<std::vector<unsigned char>> loadedLevels;
+		};
+
+		struct MipCacheHeader
+		{
+			uint32_t magic{ 0 };
+			uint32_t version{ 0 };
+			uint64_t key{ 0 };
+			int32_t width{ 0 }, height{ 0 };
+			int32_t components{ 0 }, numMips{ 0 };
+			// GL internal format of the stored levels
+			uint32_t format{ 0 };
+		};
+
+		// mip cache
+		static std::string GetCachePath(uint64_t const& key);
+		static bool ReadMipCache(std::string const& cachePath, int const& firstMip, int const& endMip, MipCacheHeader& header, std::vector<std::vector<unsigned char>>& levels);
+		static void WriteMipCache(std::string const& cachePath, MipCacheHeader const& header, std::vector<std::vector<unsigned char>> const& levels);
+		static void BuildMipChain(unsigned char* image, int const& width, int const& height, int const& components, std::vector<std::vector<unsigned char>>& levels);
+		static void CompressMipChain(int const& width, int const& height, int const& components, GLenum const& format, std::vector<std::vector<unsigned char>>& levels);
+
+		// sizes
+		static int GetNumMips(int const& width, int const& height);
+		static int GetTailMip(TextureData const& textureData);
+		static uint64_t GetLevelBytes(int const& width, int const& height, int const& components, GLenum const& format, int const& mip);
+		static uint64_t GetResidentBytes(TextureData const& textureData, int const& firstMip);
+
+		// residency
+		static void ApplyBudget();
+		static void StartLoading(StreamedTexture& texture);
+		static void Reallocate(StreamedTexture& texture, int const& newMip, std::vector<std::vector<unsigned char>> const& newLevels);
+		static void UploadLevel(TextureData const& textureData, int const& level, int const& mip, std::vector<unsigned char> const& data);
+		static void SetSamplerParameters();
+
+		static std::vector<StreamedTexture*> s_Textures;
+		static std::map<TextureData*, StreamedTexture*> s_Lookup;
+		static uint64_t s_Frame;
+		static uint64_t s_ResidentBytes;
+		static unsigned int s_NumPending;
+	};
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "Scene.h"
 #include <model/Model.h>
 #include <render/Render.h>
+#include <geometry/StaticBatcher.h>
 
 
 namespace Chroma
@@ -11,7 +12,7 @@ namespace Chroma
 	Light*              Scene::m_SunLight;
 	SkyBox*             Scene::m_Skybox;
 	IBL* 				Scene::m_IBL;
-	Texture				Scene::m_SceneNoise{ "resources/textures/noise/noise_00.jpg" };
+	Texture				Scene::m_SceneNoise{ "resources/textures/noise/noise_00.jpg", false };
 
 	// Entities Components
 	std::map<UID, IEntity*>    Scene::m_Entities;
@@ -40,6 +41,7 @@ namespace Chroma
 	std::set<UID> Scene::m_TransparentComponentUIDs;
 	std::set<UID> Scene::m_UnLitComponentUIDs;
 	std::set<UID> Scene::m_ForwardLitComponentUIDs;
+	std::set<UID> Scene::m_OccluderComponentUIDs;
 
 	std::set<UID> Scene::m_PhysicsComponentUIDs;
 
@@ -101,6 +103,11 @@ namespace Chroma
 			m_ForwardLitComponentUIDs.insert(newMeshComponent->GetUID());
 		else
 			SafeRemoveComponentUID(m_ForwardLitComponentUIDs, newMeshComponent->GetUID());
+		// occluder
+		if (static_cast<MeshComponent*>(newMeshComponent)->GetIsOccluder())
+			m_OccluderComponentUIDs.insert(newMeshComponent->GetUID());
+		else
+			SafeRemoveComponentUID(m_OccluderComponentUIDs, newMeshComponent->GetUID());
 	}
 
 
@@ -166,6 +173,7 @@ namespace Chroma
 		m_ForwardLitComponentUIDs.erase(UID);
 		m_LitComponentUIDs.erase(UID);
 		m_UnLitComponentUIDs.erase(UID);
+		m_OccluderComponentUIDs.erase(UID);
 
 		// statemachine
 		m_StateMachineUIDs.erase(UID);
@@ -242,6 +250,9 @@ namespace Chroma
 		// State
 		m_SceneState = SceneState::kSceneNotBuilt;
 
+		// static batches belong to the previous scene
+		StaticBatcher::Clear();
+
 		// timing
 		m_SceneBuildStartTime = std::chrono::high_resolution_clock::now();
 	}
@@ -274,6 +285,8 @@ namespace Chroma
 		// components
 		for (UID const& componentUID : m_ComponentUIDs)
 			GetComponent(componentUID)->Init();
+		// static meshes, merged once loaded
+		StaticBatcher::CollectStaticMeshes();
 
 		// Debug
 		CHROMA_INFO_UNDERLINE;
@@ -84,6 +84,7 @@ namespace Chroma
 		static inline std::set<UID>& GetTransparentComponentUIDs() { return m_TransparentComponentUIDs; }
 		static inline std::set<UID>& GetUnlitComponentUIDs() { return m_UnLitComponentUIDs; }
 		static inline std::set<UID>& GetForwardLitComponentUIDs() { return m_ForwardLitComponentUIDs; }
+		static inline std::set<UID>& GetOccluderComponentUIDs() { return m_OccluderComponentUIDs; }
 
 		static inline std::set<UID>& GetPhysicsComponentUIDs() { return m_PhysicsComponentUIDs; }
 		static inline std::set<UID>& GetUIComponentUIDs() { return m_UIComponentUIDs; }
@@ -138,6 +139,7 @@ namespace Chroma
 		static std::set<UID> m_ShadowReceivingComponentUIDs;
 		static std::set<UID> m_TransparentComponentUIDs;
 		static std::set<UID> m_UnLitComponentUIDs;
+		static std::set<UID> m_OccluderComponentUIDs;
 		// ui components
 		static std::set<UID> m_UIComponentUIDs;
 		// state machine components
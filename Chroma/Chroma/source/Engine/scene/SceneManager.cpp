@@ -2,6 +2,8 @@
 #include <scene/Scene.h>
 #include <serialization/scene/JSONScene.h>
 #include <serialization/formats/JSONDeserializer.h>
+#include <terrain/Terrain.h>
+#include <vegetation/Vegetation.h>
 
 namespace Chroma
 {
@@ -33,6 +35,10 @@ namespace Chroma
 
 		// Serialize Scene Entities
 		SceneJSON.AddIBL(Chroma::Scene::GetIBL());
+		if (Terrain::GetIsLoaded())
+			SceneJSON.AddTerrain(Terrain::GetGridSize(), Terrain::GetDirectory());
+		if (!Vegetation::GetSpecies().empty())
+			SceneJSON.AddVegetation(Vegetation::GetSpecies());
 
 		// Write JSON
 		SceneJSON.Write(sourceScenePath);
@@ -124,6 +130,40 @@ namespace Chroma
 		rapidjson::Value& ibl = jsonScene.GetIBL();
 		std::string iblSourcePath = ibl.GetString();
 		Chroma::Scene::GetIBL()->LoadIBL(iblSourcePath);
+
+		// Terrain
+		if (jsonScene.HasTerrain())
+		{
+			rapidjson::Value& terrain = jsonScene.GetTerrain();
+			glm::ivec2 gridSize(terrain[CHROMA_TERRAIN_GRID_KEY][0].GetInt(), terrain[CHROMA_TERRAIN_GRID_KEY][1].GetInt());
+			Terrain::Load(gridSize, terrain[CHROMA_TERRAIN_DIRECTORY_KEY].GetString());
+		}
+
+		// Vegetation
+		if (jsonScene.HasVegetation())
+		{
+			for (rapidjson::Value const& species : jsonScene.GetVegetation().GetArray())
+			{
+				Material speciesMaterial;
+				for (rapidjson::Value::ConstMemberIterator textureValue = species[CHROMA_MATERIAL_TEXTURES_KEY].MemberBegin(); textureValue != species[CHROMA_MATERIAL_TEXTURES_KEY].MemberEnd(); ++textureValue)
+				{
+					Texture newTexture(textureValue->value.GetString(), Chroma::Type::GetType<Chroma::Type::Texture>(textureValue->name.GetString()));
+					speciesMaterial.AddTexture(newTexture);
+				}
+				unsigned int speciesIndex = Vegetation::AddSpecies(species[CHROMA_SOURCE_PATH_KEY].GetString(), speciesMaterial);
+
+				for (rapidjson::Value const& scatterValue : species[CHROMA_SCATTER_KEY].GetArray())
+				{
+					VegetationScatter scatter;
+					scatter.min = glm::vec2(scatterValue["Min"][0].GetFloat(), scatterValue["Min"][1].GetFloat());
+					scatter.max = glm::vec2(scatterValue["Max"][0].GetFloat(), scatterValue["Max"][1].GetFloat());
+					scatter.height = scatterValue["Height"].GetFloat();
+					scatter.density = scatterValue["Density"].GetFloat();
+					scatter.seed = scatterValue["Seed"].GetUint();
+					Vegetation::Scatter(speciesIndex, scatter);
+				}
+			}
+		}
 		
 		// Init all entities
 		Chroma::Scene::PostSceneBuild();
@@ -135,7 +175,9 @@ namespace Chroma
 
 	void SceneManager::ClearScene()
 	{
-
+		// Terrain and vegetation
+		Terrain::Unload();
+		Vegetation::Clear();
 
 		// Remove and Destroy Entities
 		for (std::pair<UID, IEntity*> const& uidentity : Chroma::Scene::GetAllEntities())
@@ -65,6 +65,15 @@ namespace Chroma
 			m_CharProperties.emplace(std::make_pair(serializeKey, value));
 		}
 
+		template<>
+		void AddProperty<bool*>(const char* key, bool* value, EditorProperty editorPrpty)
+		{
+			ISerializerKey serializeKey;
+			serializeKey.m_Name = key;
+			serializeKey.m_EditorProperty = editorPrpty;
+			m_BoolProperties.emplace(std::make_pair(serializeKey, value));
+		}
+
 		template<>
 		void AddProperty<float*>(const char* key, float* value, EditorProperty editorPrpty)
 		{
@@ -174,6 +183,7 @@ namespace Chroma
 		}
 
 
+		std::map<ISerializerKey, bool*> m_BoolProperties;
 		std::map<ISerializerKey, float*> m_FloatProperties;
 		std::map<ISerializerKey, glm::vec2*> m_Vec2Properties;
 		std::map<ISerializerKey, glm::vec3*> m_Vec3Properties;
@@ -173,6 +173,14 @@ namespace Chroma
 					newScale.z = componentValue->value.GetArray()[2].GetFloat();
 					newStaticMesh->SetScale(newScale);
 				}
+				else if (componentAttrKey == "m_IsStatic")
+				{
+					newStaticMesh->SetIsStatic(componentValue->value.GetBool());
+				}
+				else if (componentAttrKey == "m_IsOccluder")
+				{
+					newStaticMesh->GetMaterial().SetIsOccluder(componentValue->value.GetBool());
+				}
 				else if (componentAttrKey == CHROMA_MATERIAL_KEY)
 				{
 					DeserializeMaterial(newStaticMesh, componentValue->value);
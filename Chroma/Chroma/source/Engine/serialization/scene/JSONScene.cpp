@@ -57,6 +57,60 @@ namespace Chroma
 		GetLevel().AddMember(newIBLKey, newiblSourcePath, m_Document.GetAllocator());
 	}
 
+	void JSONScene::AddTerrain(glm::ivec2 const& gridSize, std::string const& directory)
+	{
+		rapidjson::Value newTerrain(rapidjson::kObjectType);
+		rapidjson::Value newGridSize(rapidjson::kArrayType);
+		newGridSize.PushBack(gridSize.x, m_Document.GetAllocator());
+		newGridSize.PushBack(gridSize.y, m_Document.GetAllocator());
+		newTerrain.AddMember(CHROMA_TERRAIN_GRID_KEY, newGridSize, m_Document.GetAllocator());
+		rapidjson::Value newDirectory(directory.c_str(), m_Document.GetAllocator());
+		newTerrain.AddMember(CHROMA_TERRAIN_DIRECTORY_KEY, newDirectory, m_Document.GetAllocator());
+		GetLevel().AddMember(CHROMA_TERRAIN_KEY, newTerrain, m_Document.GetAllocator());
+	}
+
+	void JSONScene::AddVegetation(std::vector<VegetationSpecies*> const& species)
+	{
+		rapidjson::Value newVegetation(rapidjson::kArrayType);
+		for (VegetationSpecies* currentSpecies : species)
+		{
+			if (currentSpecies->scatters.empty())
+				continue;
+
+			// mesh and textures
+			rapidjson::Value newSpecies(rapidjson::kObjectType);
+			rapidjson::Value newSourcePath(currentSpecies->meshData.sourcePath.c_str(), m_Document.GetAllocator());
+			newSpecies.AddMember(CHROMA_SOURCE_PATH_KEY, newSourcePath, m_Document.GetAllocator());
+			rapidjson::Value newTextures(rapidjson::kObjectType);
+			for (Texture& texture : currentSpecies->material.GetTextureSet())
+			{
+				rapidjson::Value textureKey(Chroma::Type::GetName(texture.GetType()).c_str(), m_Document.GetAllocator());
+				rapidjson::Value textureValue(texture.GetSourcePath().c_str(), m_Document.GetAllocator());
+				newTextures.AddMember(textureKey, textureValue, m_Document.GetAllocator());
+			}
+			newSpecies.AddMember(CHROMA_MATERIAL_TEXTURES_KEY, newTextures, m_Document.GetAllocator());
+
+			// scatters
+			rapidjson::Value newScatters(rapidjson::kArrayType);
+			for (VegetationScatter const& scatter : currentSpecies->scatters)
+			{
+				rapidjson::Value newScatter(rapidjson::kObjectType);
+				rapidjson::Value newMin(rapidjson::kArrayType), newMax(rapidjson::kArrayType);
+				newMin.PushBack(scatter.min.x, m_Document.GetAllocator()).PushBack(scatter.min.y, m_Document.GetAllocator());
+				newMax.PushBack(scatter.max.x, m_Document.GetAllocator()).PushBack(scatter.max.y, m_Document.GetAllocator());
+				newScatter.AddMember("Min", newMin, m_Document.GetAllocator());
+				newScatter.AddMember("Max", newMax, m_Document.GetAllocator());
+				newScatter.AddMember("Height", scatter.height, m_Document.GetAllocator());
+				newScatter.AddMember("Density", scatter.density, m_Document.GetAllocator());
+				newScatter.AddMember("Seed", scatter.seed, m_Document.GetAllocator());
+				newScatters.PushBack(newScatter, m_Document.GetAllocator());
+			}
+			newSpecies.AddMember(CHROMA_SCATTER_KEY, newScatters, m_Document.GetAllocator());
+			newVegetation.PushBack(newSpecies, m_Document.GetAllocator());
+		}
+		GetLevel().AddMember(CHROMA_VEGETATION_KEY, newVegetation, m_Document.GetAllocator());
+	}
+
 	rapidjson::Value& JSONScene::GetRoot()
 	{
 		return m_Document[CHROMA_ROOT];
@@ -82,6 +136,26 @@ namespace Chroma
 		return GetLevel()[CHROMA_IBL_KEY];
 	}
 
+	bool JSONScene::HasTerrain()
+	{
+		return GetLevel().HasMember(CHROMA_TERRAIN_KEY);
+	}
+
+	rapidjson::Value& JSONScene::GetTerrain()
+	{
+		return GetLevel()[CHROMA_TERRAIN_KEY];
+	}
+
+	bool JSONScene::HasVegetation()
+	{
+		return GetLevel().HasMember(CHROMA_VEGETATION_KEY);
+	}
+
+	rapidjson::Value& JSONScene::GetVegetation()
+	{
+		return GetLevel()[CHROMA_VEGETATION_KEY];
+	}
+
 	JSONScene::JSONScene()
 	{
 		// Build Root Structure
@@ -224,6 +298,20 @@ namespace Chroma
 				jsonValue.AddMember(stringKey, stringValue, m_Document.GetAllocator());
 		}
 
+		// Bool Properties
+		for (auto& boolVal : serialized->m_BoolProperties)
+		{
+			rapidjson::Value boolKey(boolVal.first.m_Name, m_Document.GetAllocator());
+			rapidjson::Value boolValue(rapidjson::kFalseType);
+			boolValue.SetBool(*boolVal.second);
+
+			// Check which value type
+			if (Chroma::Type::IsMaterialEditorProperty(boolVal.first.m_EditorProperty.m_Type))
+				continue;
+			else
+				jsonValue.AddMember(boolKey, boolValue, m_Document.GetAllocator());
+		}
+
 		// Float Properties
 		for (auto& floatVal : serialized->m_FloatProperties)
 		{
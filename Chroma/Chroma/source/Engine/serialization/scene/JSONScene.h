@@ -5,6 +5,7 @@
 #include <common/PrecompiledHeader.h>
 #include <serialization/ISerializer.h>
 #include <scene/Scene.h>
+#include <vegetation/Vegetation.h>
 
 namespace Chroma
 {
@@ -17,12 +18,18 @@ namespace Chroma
 
 		// Scene Entities
 		void AddIBL(IBL* ibl);
+		void AddTerrain(glm::ivec2 const& gridSize, std::string const& directory);
+		void AddVegetation(std::vector<VegetationSpecies*> const& species);
 
 		rapidjson::Value& GetRoot();
 		rapidjson::Value& GetLevel();
 		rapidjson::Value& GetEntities();
 		rapidjson::Value& GetComponents();
 		rapidjson::Value& GetIBL();
+		bool HasTerrain();
+		rapidjson::Value& GetTerrain();
+		bool HasVegetation();
+		rapidjson::Value& GetVegetation();
 
 		JSONScene();
 		JSONScene(const char* loadScenePath);
@@ -46,6 +53,12 @@ namespace Chroma
 #define CHROMA_ENTITIES              "Entities"
 #define CHROMA_COMPONENTS            "Components"
 #define CHROMA_IBL_KEY	             "IBL"
+#define CHROMA_TERRAIN_KEY           "Terrain"
+#define CHROMA_TERRAIN_DIRECTORY_KEY "Directory"
+#define CHROMA_TERRAIN_GRID_KEY      "GridSize"
+#define CHROMA_VEGETATION_KEY        "Vegetation"
+#define CHROMA_SOURCE_PATH_KEY       "SourcePath"
+#define CHROMA_SCATTER_KEY           "Scatter"
 #define CHROMA_MATERIAL_KEY          "Material"
 #define CHROMA_MATERIAL_TEXTURES_KEY "Textures"
 #define CHROMA_MATERIAL_PROPERTY_FLAGS 	Chroma::Type::EditorProperty::kMaterialProperty | Chroma::Type::EditorProperty::kMaterialTextureProperty | Chroma::Type::EditorProperty::kMaterialUniformProperty | Chroma::Type::EditorProperty::kMaterialUniformColorProperty
@@ -49,7 +49,8 @@ namespace Chroma
 		{"kStringProperty",               Type::EditorProperty::kStringProperty},
 		{"kMaterialProperty",             Type::EditorProperty::kMaterialProperty},
 		{"kMaterialTextureProperty",      Type::EditorProperty::kMaterialTextureProperty},
-		{"kMaterialUniformProperty",      Type::EditorProperty::kMaterialUniformProperty}
+		{"kMaterialUniformProperty",      Type::EditorProperty::kMaterialUniformProperty},
+		{"kRenderFlagProperty",           Type::EditorProperty::kRenderFlagProperty}
 	};
 
 	std::map<std::string, Type::Texture> Type::m_TextureTypeMap =
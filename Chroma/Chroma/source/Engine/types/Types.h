@@ -76,7 +76,8 @@ namespace Chroma
 			kMaterialProperty = 7,
 			kMaterialTextureProperty = 8,
 			kMaterialUniformProperty = 9,
-			kMaterialUniformColorProperty = 10
+			kMaterialUniformColorProperty = 10,
+			kRenderFlagProperty = 11
 		};
 
 		// Getters
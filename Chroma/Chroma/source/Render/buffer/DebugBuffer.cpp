@@ -33,35 +33,37 @@ namespace Chroma
 		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 			CHROMA_WARN("Framebuffer Not Complete!");
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		// build Line VAO
-		GeneratePointVAO();
+		// build Lines VAO
+		GenerateLinesVAO();
 	}
 
 
-	void DebugBuffer::GeneratePointVAO()
+	void DebugBuffer::GenerateLinesVAO()
 	{
-		ChromaVertex singleVert;
-
 		// Generate buffers
-		// Vertex Array Object Buffer
-		glGenVertexArrays(1, &pointVAO);
-		// Vertex Buffer and Element Buffer
-		glGenBuffers(1, &pointVBO);
+		glGenVertexArrays(1, &m_LinesVAO);
+		glGenBuffers(1, &m_LinesVBO);
 
 		// Bind buffers
-		glBindVertexArray(pointVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, pointVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(ChromaVertex), &singleVert, GL_STATIC_DRAW);
+		glBindVertexArray(m_LinesVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_LinesVBO);
+		glBufferData(GL_ARRAY_BUFFER, m_LinesCapacity * sizeof(DebugVertex), NULL, GL_STREAM_DRAW);
 
 		// vertex positions
 		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, position));
+		// vertex colors
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, color));
 
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void DebugBuffer::DrawShapes()
 	{
 		BindAndClear();
+		PrepareLines();
 		// OVERLAY 
 		CopyColor(m_PostFXBuffer->GetFBO(), m_FBO);
 		DrawOverlayShapes();
@@ -96,6 +98,16 @@ namespace Chroma
 	}
 
 	void DebugBuffer::DrawOverlayShapes()
+	{
+		RenderLines(m_Lines.size(), m_OverlayLines.size());
+	}
+
+	void DebugBuffer::DrawDepthCulledShapes()
+	{
+		RenderLines(0, m_Lines.size());
+	}
+
+	void DebugBuffer::PrepareLines()
 	{
 		// skeletons
 		if (m_DebugSkeletons)
@@ -105,263 +117,183 @@ namespace Chroma
 		if (m_DebugSkeletonConstraints)
 			DrawSceneSkeletonConstraints();
 
-		// lines
-		for (LineShape const& line : m_OverlayLines)
-			RenderLine(line);
-		// spheres
-		for (SphereShape const& sphere : m_OverlaySpheres)
-			RenderSphere(sphere);
-		// boxes
-		for (BoxShape const& box : m_OverlayBoxes)
-			RenderBox(box);
-		//crosses
-		for (CrossShape const& cross : m_OverlayCrosses)
-			RenderCross(cross);
-		// joints
-		for (JointShape const& joint : m_OverlayJoints)
-			RenderJoint(joint);
-		// coordinates
-		for (CoordinatesShape const& coordinate : m_OverlayCoordinates)
-			RenderCoordinate(coordinate);
-		// grids
-		for (GridShape const& grid : m_OverlayGrids)
-			RenderGrid(grid);
-
-	}
-
-	void DebugBuffer::DrawDepthCulledShapes()
-	{
-		// lines
-		for (LineShape const& line : m_Lines)
-			RenderLine(line);
-		// spheres
-		for (SphereShape const&  sphere : m_Spheres)
-			RenderSphere(sphere);
-		// boxes
-		for (BoxShape const& box : m_Boxes)
-			RenderBox(box);
-		//crosses
-		for (CrossShape const& cross : m_Crosses)
-			RenderCross(cross);
-		// coordinates
-		for (CoordinatesShape const& coordinate : m_Coordinates)
-			RenderCoordinate(coordinate);
-		// grids
-		for (GridShape const& grid : m_Grids)
-			RenderGrid(grid);
+		UploadLines();
 	}
 
-	void DebugBuffer::RenderLine(LineShape const& line)
+	void DebugBuffer::UploadLines()
 	{
-		m_LineShader.Use();
-		m_LineShader.SetUniform("Start", line.start);
-		m_LineShader.SetUniform("End", line.end);
-		m_LineShader.SetUniform("view", Chroma::Scene::GetRenderCamera()->GetViewMatrix());
-		m_LineShader.SetUniform("projection", Chroma::Scene::GetRenderCamera()->GetProjectionMatrix());
-		m_LineShader.SetUniform("model", glm::mat4(1.0f));
-		m_LineShader.SetUniform("color", line.color);
+		size_t const numVertices = m_Lines.size() + m_OverlayLines.size();
+		if (numVertices == 0)
+			return;
 
-		BindPointVAO();
+		// orphaned each frame so the upload doesn't wait on the previous frame's draws
+		glBindBuffer(GL_ARRAY_BUFFER, m_LinesVBO);
+		while (m_LinesCapacity < numVertices)
+			m_LinesCapacity *= 2;
+		glBufferData(GL_ARRAY_BUFFER, m_LinesCapacity * sizeof(DebugVertex), NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_Lines.size() * sizeof(DebugVertex), m_Lines.data());
+		glBufferSubData(GL_ARRAY_BUFFER, m_Lines.size() * sizeof(DebugVertex), m_OverlayLines.size() * sizeof(DebugVertex), m_OverlayLines.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
-	void DebugBuffer::RenderSphere(SphereShape const& sphere)
+	void DebugBuffer::RenderLines(size_t const& first, size_t const& count)
 	{
-		m_SphereShader.Use();
-		m_SphereShader.SetUniform("VPMat", Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
-		m_SphereShader.SetUniform("model", sphere.transform);
-		m_SphereShader.SetUniform("radius", sphere.m_Radius);
-		m_SphereShader.SetUniform("color", sphere.color);
+		if (count == 0)
+			return;
 
-		BindPointVAO();
+		m_LinesShader.Use();
+		m_LinesShader.SetUniform("VPMat", Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
+		glBindVertexArray(m_LinesVAO);
+		glDrawArrays(GL_LINES, (GLint)first, (GLsizei)count);
+		glBindVertexArray(0);
 	}
 
-	void DebugBuffer::RenderBox(BoxShape const& box)
+	void DebugBuffer::AddLine(std::vector<DebugVertex>& lines, glm::vec3 const& from, glm::vec3 const& to, glm::vec3 const& color)
 	{
-		m_BoxShader.Use();
-		m_BoxShader.SetUniform("BBoxMin", box.bbox_min);
-		m_BoxShader.SetUniform("BBoxMax", box.bbox_max);
-		m_BoxShader.SetUniform("VPMat" , Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
-		m_BoxShader.SetUniform("model", box.transform);
-		m_BoxShader.SetUniform("color", box.color);
-
-		BindPointVAO();
+		DebugVertex vertex;
+		vertex.color = color;
+		vertex.position = from;
+		lines.push_back(vertex);
+		vertex.position = to;
+		lines.push_back(vertex);
 	}
 
-	void DebugBuffer::RenderCross(CrossShape const& cross)
+	void DebugBuffer::AddBox(std::vector<DebugVertex>& lines, glm::vec3 const& bbMin, glm::vec3 const& bbMax, glm::mat4 const& transform, glm::vec3 const& color)
 	{
-		m_CrossShader.Use();
-		m_CrossShader.SetUniform("model", cross.transform);
-		m_CrossShader.SetUniform("color", cross.color);
-		m_CrossShader.SetUniform("Size", cross.size);
-		m_CrossShader.SetUniform("VPMat", Scene::GetRenderCamera()->GetViewProjMatrix());
-		BindPointVAO();
+		// corner i takes max on the axes whose bit is set
+		glm::vec3 corners[8];
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			glm::vec3 const corner((i & 1) ? bbMax.x : bbMin.x, (i & 2) ? bbMax.y : bbMin.y, (i & 4) ? bbMax.z : bbMin.z);
+			corners[i] = glm::vec3(transform * glm::vec4(corner, 1.0f));
+		}
+		// edges join corners one bit apart
+		for (unsigned int i = 0; i < 8; i++)
+			for (unsigned int axis = 1; axis < 8; axis <<= 1)
+				if (!(i & axis))
+					AddLine(lines, corners[i], corners[i | axis], color);
 	}
 
-	void DebugBuffer::RenderJoint(JointShape const& joint)
+	void DebugBuffer::AddSphere(std::vector<DebugVertex>& lines, glm::vec3 const& center, float const& radius, glm::vec3 const& color)
 	{
-		m_JointShader.Use();
-		m_JointShader.SetUniform("JointPos", joint.jointPos);
-		m_JointShader.SetUniform("ChildPos", joint.childPos);
-		m_JointShader.SetUniform("Size", joint.size);
-		m_JointShader.SetUniform("VPMat", Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
-		m_JointShader.SetUniform("transform", joint.transform);
-		m_JointShader.SetUniform("color", joint.color);
-		BindPointVAO();
+		// a circle in each axis plane
+		const unsigned int segments{ 24 };
+		for (unsigned int i = 0; i < segments; i++)
+		{
+			float const start = glm::two_pi<float>() * (float)i / (float)segments;
+			float const end = glm::two_pi<float>() * (float)(i + 1) / (float)segments;
+			glm::vec2 const from = glm::vec2(std::cos(start), std::sin(start)) * radius;
+			glm::vec2 const to = glm::vec2(std::cos(end), std::sin(end)) * radius;
+			AddLine(lines, center + glm::vec3(from.x, from.y, 0.0f), center + glm::vec3(to.x, to.y, 0.0f), color);
+			AddLine(lines, center + glm::vec3(from.x, 0.0f, from.y), center + glm::vec3(to.x, 0.0f, to.y), color);
+			AddLine(lines, center + glm::vec3(0.0f, from.x, from.y), center + glm::vec3(0.0f, to.x, to.y), color);
+		}
 	}
 
-	void DebugBuffer::RenderCoordinate(CoordinatesShape const& coordinate)
+	void DebugBuffer::AddCross(std::vector<DebugVertex>& lines, glm::vec3 const& worldPos, float const& size, glm::vec3 const& color)
 	{
-		// Coordinate reference 
-		m_CoordinatesShader.Use();
-		m_CoordinatesShader.SetUniform("VPMat", Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
-		m_CoordinatesShader.SetUniform("transform", coordinate.transform);
-		m_CoordinatesShader.SetUniform("Size", coordinate.size);
-
-		BindPointVAO();
+		AddLine(lines, worldPos - glm::vec3(size, 0.0f, 0.0f), worldPos + glm::vec3(size, 0.0f, 0.0f), color);
+		AddLine(lines, worldPos - glm::vec3(0.0f, size, 0.0f), worldPos + glm::vec3(0.0f, size, 0.0f), color);
+		AddLine(lines, worldPos - glm::vec3(0.0f, 0.0f, size), worldPos + glm::vec3(0.0f, 0.0f, size), color);
 	}
 
-	void DebugBuffer::RenderGrid(GridShape const& grid)
+	void DebugBuffer::AddCoordinates(std::vector<DebugVertex>& lines, glm::mat4 const& transform, float const& size)
 	{
-		m_GridShader.Use();
-		m_GridShader.SetUniform("VPMat", Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
-		m_GridShader.SetUniform("color", grid.color);
-		m_GridShader.SetUniform("model", grid.transform);
-		m_GridShader.SetUniform("size", grid.size);
-
-		BindPointVAO();
+		// axes colored x red, y green, z blue
+		glm::vec3 const origin(transform * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		AddLine(lines, origin, glm::vec3(transform * glm::vec4(size, 0.0f, 0.0f, 1.0f)), glm::vec3(1.0f, 0.0f, 0.0f));
+		AddLine(lines, origin, glm::vec3(transform * glm::vec4(0.0f, size, 0.0f, 1.0f)), glm::vec3(0.0f, 1.0f, 0.0f));
+		AddLine(lines, origin, glm::vec3(transform * glm::vec4(0.0f, 0.0f, size, 1.0f)), glm::vec3(0.0f, 0.0f, 1.0f));
 	}
 
-	void DebugBuffer::BindPointVAO()
+	void DebugBuffer::AddGrid(std::vector<DebugVertex>& lines, float const& size, glm::vec3 const& color)
 	{
-		glBindVertexArray(pointVAO);
-		glDrawArrays(GL_POINTS, 0, 1);
-		glBindVertexArray(0);
+		// unit cells on the ground plane
+		float const halfSize = (float)(int)(size / 2.0f);
+		for (float i = -halfSize; i <= halfSize; i += 1.0f)
+		{
+			AddLine(lines, glm::vec3(-halfSize, 0.0f, i), glm::vec3(halfSize, 0.0f, i), color);
+			AddLine(lines, glm::vec3(i, 0.0f, -halfSize), glm::vec3(i, 0.0f, halfSize), color);
+		}
 	}
 
-
 	void DebugBuffer::DrawGrid(float const& size, glm::vec3 const& color)
 	{
-		GridShape newGrid;
-		newGrid.color = color;
-		newGrid.size = size;
-		m_Grids.push_back(newGrid);
+		AddGrid(m_Lines, size, color);
 	}
 
 	void DebugBuffer::DrawOverlayGrid(float const& size, glm::vec3 const& color)
 	{
-		GridShape newGrid;
-		newGrid.color = color;
-		newGrid.size = size;
-		m_Grids.push_back(newGrid);
+		AddGrid(m_OverlayLines, size, color);
 	}
 
 	void DebugBuffer::DrawCoordinates(const glm::mat4& transform, const float& size)
 	{
-		CoordinatesShape newCoordinate;
-		newCoordinate.transform = transform;
-		newCoordinate.size = size;
-		m_Coordinates.push_back(newCoordinate);
+		AddCoordinates(m_Lines, transform, size);
 	}
 
 	void DebugBuffer::DrawOverlayCoordinates(const glm::mat4& transform, const float& size)
 	{
-		CoordinatesShape newCoordinate;
-		newCoordinate.transform = transform;
-		newCoordinate.size = size;
-		m_OverlayCoordinates.push_back(newCoordinate);
+		AddCoordinates(m_OverlayLines, transform, size);
 	}
 
 	void DebugBuffer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
 	{
-		LineShape new_line;
-		new_line.start = from;
-		new_line.end = to;
-		new_line.color = color;
-		m_Lines.push_back(new_line);
+		AddLine(m_Lines, from, to, color);
 	}
 
 	void DebugBuffer::DrawOverlayLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
 	{
-		LineShape new_line;
-		new_line.start = from;
-		new_line.end = to;
-		new_line.color = color;
-		m_OverlayLines.push_back(new_line);
+		AddLine(m_OverlayLines, from, to, color);
 	}
 
 	void DebugBuffer::DrawBox(const glm::vec3& bbMin, const glm::vec3& bbMax, const glm::vec3& color)
 	{
-		BoxShape new_box;
-		new_box.bbox_min = bbMin;
-		new_box.bbox_max = bbMax;
-		new_box.color = color;
-		m_Boxes.push_back(new_box);
+		AddBox(m_Lines, bbMin, bbMax, glm::mat4(1.0f), color);
 	}
 
 	void DebugBuffer::DrawBox(const glm::vec3& bbMin, const glm::vec3& bbMax, const glm::mat4& trans, const glm::vec3& color)
 	{
-		BoxShape new_box;
-		new_box.bbox_min = bbMin;
-		new_box.bbox_max = bbMax;
-		new_box.color = color;
-		new_box.transform =  trans;
-		m_Boxes.push_back(new_box);
+		AddBox(m_Lines, bbMin, bbMax, trans, color);
 	}
 
 	void DebugBuffer::DrawOverlayBox(const glm::vec3& bbMin, const glm::vec3& bbMax, const glm::vec3& color)
 	{
-		BoxShape new_box;
-		new_box.bbox_min = bbMin;
-		new_box.bbox_max = bbMax;
-		new_box.color = color;
-		m_OverlayBoxes.push_back(new_box);
+		AddBox(m_OverlayLines, bbMin, bbMax, glm::mat4(1.0f), color);
 	}
 
 	void DebugBuffer::DrawSphere(const glm::vec3& center, const float& m_Radius, const glm::vec3& color)
 	{
-		SphereShape new_sphere;
-		new_sphere.transform = glm::translate(new_sphere.transform, center);
-		new_sphere.m_Radius = m_Radius;
-		new_sphere.color = color;
-		m_Spheres.push_back(new_sphere);
+		AddSphere(m_Lines, center, m_Radius, color);
 	}
 
 	void DebugBuffer::DrawOverlaySphere(const glm::vec3& center, const float& m_Radius, const glm::vec3& color)
 	{
-		SphereShape new_sphere;
-		new_sphere.transform = glm::translate(new_sphere.transform, center);
-		new_sphere.m_Radius = m_Radius;
-		new_sphere.color = color;
-		m_OverlaySpheres.push_back(new_sphere);
+		AddSphere(m_OverlayLines, center, m_Radius, color);
 	}
 
 	void DebugBuffer::DrawCross(const glm::vec3& worldPos, const float& size, const glm::vec3& color)
 	{
-		CrossShape new_cross;
-		new_cross.color = color;
-		new_cross.size = size;
-		new_cross.transform = glm::translate(new_cross.transform, worldPos);
-		m_Crosses.push_back(new_cross);
+		AddCross(m_Lines, worldPos, size, color);
 	}
 
 	void DebugBuffer::DrawOverlayCross(const glm::vec3& worldPos, const float& size, const glm::vec3& color)
 	{
-		CrossShape new_cross;
-		new_cross.color = color;
-		new_cross.size = size;
-		new_cross.transform = glm::translate(new_cross.transform, worldPos);
-		m_OverlayCrosses.push_back(new_cross);
+		AddCross(m_OverlayLines, worldPos, size, color);
 	}
 
 	void DebugBuffer::DrawOverlayJoint(const glm::vec3& originPosition, const glm::vec3 childPosition, const glm::mat4 jointTransform, const float& size, const glm::vec3& color)
 	{
-		JointShape newJoint;
-		newJoint.transform = jointTransform;
-		newJoint.jointPos = originPosition;
-		newJoint.childPos = childPosition;
-		newJoint.size = size;
-		newJoint.color = color;
-		m_OverlayJoints.push_back(newJoint);
+		// pyramid from a square around the joint to its child
+		glm::vec3 const Y = glm::normalize(originPosition - childPosition) * 0.05f * size;
+		glm::vec3 const X = glm::normalize(glm::cross(Y, glm::vec3(0.0f, 1.0f, 0.0f))) * 0.05f * size;
+		glm::vec3 const Z = glm::normalize(glm::cross(Y, X)) * 0.05f * size;
+		glm::vec3 const square[4]{ originPosition - X - Z, originPosition - X + Z, originPosition + X + Z, originPosition + X - Z };
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			AddLine(m_OverlayLines, square[i], square[(i + 1) % 4], color);
+			AddLine(m_OverlayLines, square[i], childPosition, color);
+		}
 	}
 
 	void DebugBuffer::ToggleDrawSkeletons()
@@ -409,22 +341,8 @@ namespace Chroma
 
 	void DebugBuffer::ClearColorAndDepth()
 	{
-		// Overlay buffer
 		m_OverlayLines.clear();
-		m_OverlayBoxes.clear();
-		m_OverlaySpheres.clear();
-		m_OverlayCrosses.clear();
-		m_OverlayJoints.clear();
-		m_OverlayCoordinates.clear();
-		m_OverlayGrids.clear();
-
-		// Depth culled buffer
 		m_Lines.clear();
-		m_Spheres.clear();
-		m_Boxes.clear();
-		m_Crosses.clear();
-		m_Coordinates.clear();
-		m_Grids.clear();
 	}
 
 	void DebugBuffer::Draw()
@@ -439,6 +357,7 @@ namespace Chroma
 	void DebugBuffer::DrawOverlay(IFramebuffer* drawOver)
 	{
 		// TODO : not implemented, faking it!
+		PrepareLines();
 		DrawOverlayShapes();
 		DrawDepthCulledShapes();
 	}
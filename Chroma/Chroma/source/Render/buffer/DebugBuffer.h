@@ -9,63 +9,21 @@
 #include <model/Vertex.h>
 #include <model/SpherePrimitive.h>
 #include <model/BoxPrimitive.h>
+#include <ChromaConfig.h>
 
 class Scene;
 
 namespace Chroma
 {
 
-	struct LineShape
+	// Debug shapes are expanded into line list vertices as they're added,
+	// so every shape of a depth mode draws from one buffer in a single call
+	struct DebugVertex
 	{
-		glm::vec3 start{ 0.0 };
-		glm::vec3 end{ 0.0 };
+		glm::vec3 position{ 0.0 };
 		glm::vec3 color{ 0.0 };
 	};
 
-	struct GridShape
-	{
-		glm::vec3 color{ 0.5 };
-		glm::mat4 transform{ 1.0 };
-		float size{ 10.0 };
-	};
-
-
-	struct BoxShape
-	{
-		glm::mat4 transform{ 1.0 };
-		glm::vec3 bbox_min{ 0.0 }, bbox_max{ 0.0 };
-		glm::vec3 color{ 1.0 };
-	};
-
-	struct SphereShape
-	{
-		glm::mat4 transform{ 1.0 };
-		float m_Radius{ 1.0 };
-		glm::vec3 color{ 1.0 };
-	};
-
-	struct JointShape
-	{
-		glm::mat4 transform{ 1.0 };
-		glm::vec3 jointPos{ 0.0 };
-		glm::vec3 childPos{ 0.0 };
-		glm::vec3 color{ 1.0 };
-		float size{ 1.0 };
-	};
-
-	struct CoordinatesShape
-	{
-		glm::mat4 transform{ 1.0 };
-		float size{ 1.0 };
-	};
-
-	struct CrossShape
-	{
-		glm::mat4 transform{ 1.0 };
-		glm::vec3 color{ 0.0 };
-		float size{ 1.0 };
-	};
-
 	class DebugBuffer : public IFramebuffer
 	{
 	public:
@@ -117,66 +75,19 @@ namespace Chroma
 		bool m_DebugSkeletons{false};
 		bool m_DebugSkeletonConstraints{ false };
 
-		// shapes
-		std::vector<LineShape> m_Lines;
-		std::vector<LineShape> m_OverlayLines;
-
-		std::vector<BoxShape> m_Boxes;
-		std::vector<BoxShape> m_OverlayBoxes;
+		// shapes, as line lists
+		std::vector<DebugVertex> m_Lines;
+		std::vector<DebugVertex> m_OverlayLines;
 
- 		std::vector<SphereShape> m_Spheres;
-		std::vector<SphereShape> m_OverlaySpheres;
-
-		std::vector<CrossShape> m_Crosses;
-		std::vector<CrossShape> m_OverlayCrosses;
-
-		std::vector<JointShape> m_OverlayJoints;
-
-		std::vector<CoordinatesShape> m_Coordinates;
-		std::vector<CoordinatesShape> m_OverlayCoordinates;
-
-		std::vector<GridShape> m_Grids;
-		std::vector<GridShape> m_OverlayGrids;
-
-		// attrs
-		unsigned int pointVAO, pointVBO;
+		// attrs, both lists share one buffer refilled each frame, overlay lines follow the depth culled ones
+		unsigned int m_LinesVAO{ 0 }, m_LinesVBO{ 0 };
+		size_t m_LinesCapacity{ DEBUG_BUFFER_INITIAL_VERTICES };
 
 		// shaders
-		const char* FragSource{ "resources/shaders/fragBasic.glsl" };
-		// line geometry shader
-		const char* lineVtxSource{ "resources/shaders/vertexLineDebug.glsl" };
-		const char* lineGeomSource{ "resources/shaders/geometryLineDebug.glsl" };
-		Shader m_LineShader{ FragSource, lineVtxSource, lineGeomSource };
-		// box geometry shader
-		const char* boxVtxSource{ "resources/shaders/vertexBoxDebug.glsl" };
-		const char* boxGeomSource{ "resources/shaders/geometryBoxDebug.glsl" };
-		Shader m_BoxShader{ FragSource, boxVtxSource, boxGeomSource };
-		// sphere geometry shader
-		const char* sphereVtxSource{ "resources/shaders/vertexSphereDebug.glsl" };
-		const char* sphereGeomSource{ "resources/shaders/geometrySphereDebug.glsl" };
-		Shader m_SphereShader{ FragSource, sphereVtxSource, sphereGeomSource };
-		// joint geometry shader
-		const char* jointFragSource{ "resources/shaders/fragJointDebug.glsl" };
-		const char* jointVtxSource{ "resources/shaders/vertexJointDebug.glsl" };
-		const char* jointGeomSource{ "resources/shaders/geometryJointDebug.glsl" };
-		Shader m_JointShader{ jointFragSource, jointVtxSource, jointGeomSource };
-		// coordinates geometry shader
-		const char* coordinatesFragSource{ "resources/shaders/fragCoordinatesDebug.glsl" };
-		const char* coordinatesVtxSource{ "resources/shaders/vertexCoordinatesDebug.glsl" };
-		const char* coordinatesGeomSource{ "resources/shaders/geometryCoordinatesDebug.glsl" };
-		Shader m_CoordinatesShader{ coordinatesFragSource, coordinatesVtxSource, coordinatesGeomSource };
-		// cross geometry shader
-		const char* crossFragSource{ "resources/shaders/fragCrossDebug.glsl" };
-		const char* crossVtxSource{ "resources/shaders/vertexCrossDebug.glsl" };
-		const char* crossGeomSource{ "resources/shaders/geometryCrossDebug.glsl" };
-		Shader m_CrossShader{ crossFragSource, crossVtxSource, crossGeomSource };
-		// grid geometry shader
-		const char* gridVtxSource{ "resources/shaders/vertexGridDebug.glsl" };
-		const char* gridGeomSource{ "resources/shaders/geometryGridDebug.glsl" };
-		Shader m_GridShader{ FragSource, gridVtxSource, gridGeomSource };
-
-		// point VAO
-		void GeneratePointVAO();
+		Shader m_LinesShader{ "resources/shaders/fragDebugLines.glsl", "resources/shaders/vertexDebugLines.glsl" };
+
+		// lines VAO
+		void GenerateLinesVAO();
 
 		// previous framebuffer to call from
 		IFramebuffer* m_PostFXBuffer;
@@ -185,15 +96,19 @@ namespace Chroma
 		void DrawShapes();
 		void DrawOverlayShapes();
 		void DrawDepthCulledShapes();
-		void RenderLine(LineShape const& line);
-		void RenderSphere(SphereShape const& sphere);
-		void RenderBox(BoxShape const& box);
-		void RenderCross(CrossShape const& cross);
-		void RenderJoint(JointShape const& joint);
-		void RenderCoordinate(CoordinatesShape const& coordinate);
-		void RenderGrid(GridShape const& grid);
-
-		void BindPointVAO();
+		// adds the scene's debug shapes and uploads every line, once per draw
+		void PrepareLines();
+		void UploadLines();
+		void RenderLines(size_t const& first, size_t const& count);
+
+		// shape expansion
+		static void AddLine(std::vector<DebugVertex>& lines, glm::vec3 const& from, glm::vec3 const& to, glm::vec3 const& color);
+		static void AddBox(std::vector<DebugVertex>& lines, glm::vec3 const& bbMin, glm::vec3 const& bbMax, glm::mat4 const& transform, glm::vec3 const& color);
+		static void AddSphere(std::vector<DebugVertex>& lines, glm::vec3 const& center, float const& radius, glm::vec3 const& color);
+		static void AddCross(std::vector<DebugVertex>& lines, glm::vec3 const& worldPos, float const& size, glm::vec3 const& color);
+		static void AddCoordinates(std::vector<DebugVertex>& lines, glm::mat4 const& transform, float const& size);
+		static void AddGrid(std::vector<DebugVertex>& lines, float const& size, glm::vec3 const& color);
+
 		// blitting depth buffer before rendering
 		void Init() override;
 	};
@@ -0,0 +1,88 @@
+#include "DownsampleBuffer.h"
+#include <render/Render.h>
+
+namespace Chroma
+{
+	void DownsampleBuffer::Draw()
+	{
+		if (m_IsDrawn)
+			return;
+		CHROMA_PROFILE_FUNCTION();
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+		glViewport(0, 0, GetWidth(), GetHeight());
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		m_DownsampleShader.Use();
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, Render::GetDepth());
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, Render::GetNormals());
+		RenderQuad();
+
+		// restore screen viewport
+		glViewport(0, 0, m_Width, m_Height);
+		UnBind();
+		m_IsDrawn = true;
+	}
+
+	void DownsampleBuffer::ResizeBuffers()
+	{
+		glBindTexture(GL_TEXTURE_2D, m_DepthTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, GetWidth(), GetHeight(), 0, GL_RED, GL_FLOAT, NULL);
+		glBindTexture(GL_TEXTURE_2D, m_NormalsTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, GetWidth(), GetHeight(), 0, GL_RG, GL_FLOAT, NULL);
+		m_IsDrawn = false;
+	}
+
+	void DownsampleBuffer::Init()
+	{
+		glGenFramebuffers(1, &m_FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+
+		// - closest depth, nearest filtered so upsampling compares exact texels
+		glGenTextures(1, &m_DepthTexture);
+		glBindTexture(GL_TEXTURE_2D, m_DepthTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, GetWidth(), GetHeight(), 0, GL_RED, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_DepthTexture, 0);
+
+		// - octahedral normals of the closest texel
+		glGenTextures(1, &m_NormalsTexture);
+		glBindTexture(GL_TEXTURE_2D, m_NormalsTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, GetWidth(), GetHeight(), 0, GL_RG, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_NormalsTexture, 0);
+
+		unsigned int attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+		glDrawBuffers(2, attachments);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			CHROMA_WARN("Framebuffer not complete!");
+		UnBind();
+
+		m_DownsampleShader.Use();
+		m_DownsampleShader.SetUniform("gDepth", 0);
+		m_DownsampleShader.SetUniform("gNormal", 1);
+		m_DownsampleShader.SetUniform("u_Divisor", (int)m_Divisor);
+		m_DownsampleShader.SetUniform("scale", m_Scale);
+		m_DownsampleShader.SetUniform("offset", m_Offset);
+	}
+
+	DownsampleBuffer::DownsampleBuffer(unsigned int const& divisor)
+		: m_Divisor(std::max(divisor, 1u))
+	{
+		Init();
+	}
+
+	DownsampleBuffer::~DownsampleBuffer()
+	{
+		glDeleteTextures(1, &m_DepthTexture);
+		glDeleteTextures(1, &m_NormalsTexture);
+		glDeleteFramebuffers(1, &m_FBO);
+	}
+}
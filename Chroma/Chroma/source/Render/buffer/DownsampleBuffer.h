@@ -0,0 +1,48 @@
+#ifndef _CHROMA_DOWNSAMPLE_BUFFER_
+#define _CHROMA_DOWNSAMPLE_BUFFER_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <buffer/IFramebuffer.h>
+
+namespace Chroma
+{
+	// Depth and normals of the gbuffer at 1/divisor of the screen resolution, for
+	// screen space effects tracing at reduced resolution. Each texel keeps the closest
+	// depth of its footprint with the matching normal, drawn at most once per frame.
+	class DownsampleBuffer : public IFramebuffer
+	{
+	public:
+		void Draw() override;
+		void ResizeBuffers() override;
+		bool GetIsReady() override { return m_DownsampleShader.GetIsReady(); };
+
+		inline void Invalidate() { m_IsDrawn = false; }
+
+		inline unsigned int GetDivisor() const { return m_Divisor; }
+		inline unsigned int GetWidth() const { return std::max(m_Width / m_Divisor, 1u); }
+		inline unsigned int GetHeight() const { return std::max(m_Height / m_Divisor, 1u); }
+		inline unsigned int GetDepthTexture() const { return m_DepthTexture; }
+		inline unsigned int GetNormalsTexture() const { return m_NormalsTexture; }
+
+		DownsampleBuffer(unsigned int const& divisor);
+		~DownsampleBuffer();
+
+	private:
+		// shader
+		const char* fragDownsampleSource{ "resources/shaders/fragDownsampleDepthNormals.glsl" };
+		Shader m_DownsampleShader{ fragDownsampleSource, vtxSource };
+
+		// textures
+		unsigned int m_DepthTexture{ 0 };
+		unsigned int m_NormalsTexture{ 0 };
+
+		unsigned int m_Divisor{ 2 };
+		bool m_IsDrawn{ false };
+
+		void Init() override;
+	};
+}
+
+#endif
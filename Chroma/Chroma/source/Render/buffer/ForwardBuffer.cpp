@@ -1,6 +1,7 @@
 #include "ForwardBuffer.h"
 #include <render/Render.h>
 #include <component/UIComponent.h>
+#include <particles/ParticleSystem.h>
 
 namespace Chroma
 {
@@ -48,6 +49,9 @@ namespace Chroma
 			// Check whether component is transparent
 			if (static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetIsTransparent())
 				continue;
+			// select level of detail and visible meshlets
+			static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->UpdateLOD(*Chroma::Scene::GetRenderCamera());
+			static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->CullMeshlets(*Chroma::Scene::GetRenderCamera());
 			// update the light view matrix
 			static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->SetMat4("lightSpaceMatrix", Chroma::Render::GetLightSpaceMatrix());
 			// render forward lit components
@@ -58,6 +62,9 @@ namespace Chroma
 		// Render Transparent Components
 		if(Chroma::Scene::GetTransparentComponentUIDs().size() > 0)
 			RenderTransparency();
+
+		// Render Particles
+		ParticleSystem::Draw();
 	}
 
 	void ForwardBuffer::RenderTransparency()
@@ -1,7 +1,11 @@
 #include "GBuffer.h"
 #include <component/MeshComponent.h>
+#include <terrain/Terrain.h>
+#include <vegetation/Vegetation.h>
 #include <render/Render.h>
 #include <shadow/ShadowBuffer.h>
+#include <geometry/StaticBatcher.h>
+#include <quality/QualityGovernor.h>
 
 namespace Chroma
 {
@@ -12,35 +16,23 @@ namespace Chroma
 		glGenFramebuffers(1, &m_FBO);
 		glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 
-		// SCENE DATA
-		// - WS Positions
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, Chroma::Render::GetWSPositions(), 0);
-
-		// - VS Positions
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, Chroma::Render::GetVSPositions(), 0);
-
-		// - fragposLightSpace 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, Chroma::Render::GetFragPosLightSpace(), 0);
-
 		// SURFACE DATA
+		// positions are reconstructed from depth, light space positions in the lighting pass
 		// - albebo 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, Chroma::Render::GetAlbedo(), 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, Chroma::Render::GetAlbedo(), 0);
 
-		// - WS Normals
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, GL_TEXTURE_2D, Chroma::Render::GetWSNormals(), 0);
-
-		// - VS Normals
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT5, GL_TEXTURE_2D, Chroma::Render::GetVSNormals(), 0);
+		// - WS Normals, octahedral encoded
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, Chroma::Render::GetNormals(), 0);
 
 		// - metalness/rougness/ambient occlusion buffer
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT6, GL_TEXTURE_2D, Chroma::Render::GetMetRoughAO(), 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, Chroma::Render::GetMetRoughAO(), 0);
 		
 		// - depth
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, Chroma::Render::GetDepth(), 0);
 
 		// - tell OpenGL which color attachments we'll use for rendering 
-		unsigned int attachments[7] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4, GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6};
-		glDrawBuffers(7, attachments);
+		unsigned int attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+		glDrawBuffers(3, attachments);
 		// create and attach depth buffer (renderbuffer)
 		glGenRenderbuffers(1, &m_RBO);
 		glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
@@ -79,33 +71,26 @@ namespace Chroma
 	{
 		// Geometry Buffer
 		m_lightingPassShader.Use();
-		m_lightingPassShader.SetUniform("gPosition", 0);
 		m_lightingPassShader.SetUniform("gNormal", 1);
 		m_lightingPassShader.SetUniform("gAlbedo", 2);
 		m_lightingPassShader.SetUniform("gMetRoughAO", 3);
-		m_lightingPassShader.SetUniform("gFragPosLightSpace", 4);
 		m_lightingPassShader.SetUniform("gShadowmap", 5);
 		m_lightingPassShader.SetUniform("SSAO", 6);
 		m_lightingPassShader.SetUniform("gDepth", 7);
 						 
 		// IBL				 
-		m_lightingPassShader.SetUniform("irradianceMap", 8);
 		m_lightingPassShader.SetUniform("prefilterMap", 9);
 		m_lightingPassShader.SetUniform("brdfLUT", 10);
 	}
 
 	void GBuffer::BindGBufferTextures()
 	{
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetWSPositions());
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetWSNormals());
+		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetNormals());
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetAlbedo());
 		glActiveTexture(GL_TEXTURE3);
 		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetMetRoughAO());
-		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetFragPosLightSpace());
 		glActiveTexture(GL_TEXTURE5);
 		glBindTexture(GL_TEXTURE_2D_ARRAY, Chroma::Render::GetShadowBuffer()->GetTexture());
 		glActiveTexture(GL_TEXTURE6);
@@ -113,8 +98,6 @@ namespace Chroma
 		glActiveTexture(GL_TEXTURE7);
 		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetDepth());
 		// IBL
-		glActiveTexture(GL_TEXTURE8);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, Chroma::Scene::GetIBL()->GetIrradianceMapID());
 		glActiveTexture(GL_TEXTURE9);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, Chroma::Scene::GetIBL()->GetPrefilterMapID());
 		glActiveTexture(GL_TEXTURE10);
@@ -123,39 +106,138 @@ namespace Chroma
 
 
 
+	void GBuffer::RasterizeOccluders()
+	{
+		CHROMA_PROFILE_FUNCTION();
+		m_OcclusionCuller.BeginFrame(Chroma::Scene::GetRenderCamera()->GetViewProjMatrix());
+
+		// Occluder Components
+		for (UID const& uid : Chroma::Scene::GetOccluderComponentUIDs())
+		{
+			MeshComponent* occluder = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid));
+			// flagged after its buffers were built, positions are kept from the next rebuild
+			if (occluder->GetOccluderPositions().empty())
+				continue;
+			m_OcclusionCuller.AddOccluder(occluder->GetOccluderPositions(), occluder->GetIndices(), occluder->GetWorldTransform());
+		}
+
+		m_OcclusionCuller.RasterizeOccluders();
+	}
+
+	bool GBuffer::GetIsOccluded(UID const& uid)
+	{
+		// nothing to test against
+		if (!m_OcclusionCuller.GetHasOccluders())
+			return false;
+
+		// meshes still to build their render buffers are drawn to initialize
+		MeshComponent* meshComponent = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid));
+		if (!meshComponent->GetRenderBuffersInitialized())
+			return false;
+
+		std::pair<glm::vec3, glm::vec3> bbox = meshComponent->GetLocalBBox();
+		return !m_OcclusionCuller.IsVisible(bbox.first, bbox.second, meshComponent->GetWorldTransform());
+	}
+
 	void GBuffer::DrawGeometryPass()
 	{
+		// 0. occlusion pass: rasterize marked occluders on the CPU
+		RasterizeOccluders();
+		// merge static meshes once they have loaded
+		StaticBatcher::Update();
+
 		// 1. geometry pass: render scene's geometry/color data into gbuffer
 		BindAndClear();
-		m_geometryPassShader.Use();
-		m_geometryPassShader.SetUniform("lightSpaceMatrix", static_cast<ShadowBuffer*>(Chroma::Render::GetShadowBuffer())->GetLightSpaceMatrix());
 
 		// Render Lit Components
+		// pooled meshes are sorted by variant and pool, so each variant is used and each pool VAO bound once
+		m_PooledDraws.clear();
 		for (UID const& uid : Chroma::Scene::GetLitComponentUIDs())
 		{
-			// transform components by entity transform
-			m_geometryPassShader.SetUniform("model", static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetWorldTransform());
+			// skip components hidden behind occluders or drawn through a static batch
+			if (GetIsOccluded(uid) || StaticBatcher::GetIsBatched(uid))
+				continue;
 
-			// check if mesh skinned
-			bool isSkinned = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetIsSkinned();
-			m_geometryPassShader.SetUniform("isSkinned", isSkinned);
-			if (isSkinned)
-				static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->SetJointUniforms(m_geometryPassShader);
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid));
 
-			// Draw Update Materials
-			// Check if Mesh is double sided
-			if (static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetIsDoubleSided())
+			// skip meshes whose variant is still linking
+			if (!m_geometryPassShader.GetVariant(meshComponent->GetShaderKeywords()).GetIsReady())
+				continue;
+
+			// select level of detail and visible meshlets
+			meshComponent->UpdateLOD(*Chroma::Scene::GetRenderCamera());
+			meshComponent->CullMeshlets(*Chroma::Scene::GetRenderCamera());
+
+			if (meshComponent->GetIsGeometryPooled() && meshComponent->GetRenderBuffersInitialized())
 			{
+				m_PooledDraws.push_back(PooledDraw{ meshComponent->GetShaderKeywords(), GeometryPool::GetVAO(meshComponent->GetGeometryAllocation().indexType), meshComponent });
+				continue;
+			}
+
+			// skinned meshes own their VAO, meshes still to build their buffers initialize on draw
+			Shader& geometryPassShader = UseGeometryPassVariant(meshComponent->GetShaderKeywords());
+			geometryPassShader.SetUniform("model", meshComponent->GetWorldTransform());
+			if (meshComponent->GetIsSkinned())
+				meshComponent->SetJointUniforms(geometryPassShader);
+			// Check if Mesh is double sided
+			if (meshComponent->GetIsDoubleSided())
 				glDisable(GL_CULL_FACE);
-				static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->DrawUpdateMaterials(m_geometryPassShader);
+			meshComponent->DrawUpdateMaterials(geometryPassShader);
+			if (meshComponent->GetIsDoubleSided())
 				glEnable(GL_CULL_FACE);
-			}
-			else // if not render one front facing
-				static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->DrawUpdateMaterials(m_geometryPassShader);
 		}
+		DrawPooledMeshes();
+
+		// Render Static Batches
+		StaticBatcher::DrawBatches([this](unsigned int const& keywords) -> Shader& { return UseGeometryPassVariant(keywords); }, *Chroma::Scene::GetRenderCamera());
+
+		// Render Terrain
+		Terrain::Draw();
+
+		// Render Vegetation
+		Vegetation::Draw();
 		UnBind();
 	}
 
+	void GBuffer::DrawPooledMeshes()
+	{
+		std::sort(m_PooledDraws.begin(), m_PooledDraws.end(), [](PooledDraw const& a, PooledDraw const& b) {
+			return a.keywords != b.keywords ? a.keywords < b.keywords : a.VAO < b.VAO;
+		});
+
+		Shader* geometryPassShader{ nullptr };
+		unsigned int boundKeywords{ UINT_MAX }, boundVAO{ 0 };
+		for (PooledDraw const& draw : m_PooledDraws)
+		{
+			if (draw.keywords != boundKeywords)
+			{
+				geometryPassShader = &UseGeometryPassVariant(draw.keywords);
+				boundKeywords = draw.keywords;
+			}
+			if (draw.VAO != boundVAO)
+			{
+				glBindVertexArray(draw.VAO);
+				boundVAO = draw.VAO;
+			}
+
+			// transform components by entity transform
+			geometryPassShader->SetUniform("model", draw.meshComponent->GetWorldTransform());
+			if (draw.meshComponent->GetIsDoubleSided())
+				glDisable(GL_CULL_FACE);
+			draw.meshComponent->DrawPooled(*geometryPassShader);
+			if (draw.meshComponent->GetIsDoubleSided())
+				glEnable(GL_CULL_FACE);
+		}
+		glBindVertexArray(0);
+	}
+
+	Shader& GBuffer::UseGeometryPassVariant(unsigned int const& keywords)
+	{
+		Shader& geometryPassShader = m_geometryPassShader.GetVariant(keywords);
+		geometryPassShader.Use();
+		return geometryPassShader;
+	}
+
 
 	void GBuffer::DrawLightingPass()
 	{
@@ -166,6 +248,8 @@ namespace Chroma
 		m_lightingPassShader.Use();
 		// updating transforms
 		SetTransformUniforms();
+		// light space positions are computed from the reconstructed world position
+		m_lightingPassShader.SetUniform("lightSpaceMatrix", static_cast<ShadowBuffer*>(Chroma::Render::GetShadowBuffer())->GetLightSpaceMatrix());
 		// activating textures
 		BindGBufferTextures();
 
@@ -188,7 +272,9 @@ namespace Chroma
 		DrawGeometryPass();
 
 		// 1.5 SSAO Pass : draw SSAO in ViewSpace to be used during lighting pass
+		QualityGovernor::BeginFeature(RenderFeature::kSSAO);
 		static_cast<SSAOBuffer*>(m_SSAOBuffer)->Draw();
+		QualityGovernor::EndFeature(RenderFeature::kSSAO);
 
 		// 2. Render pass to PostFX buffer
 		//m_PostFXBuffer->Bind();
@@ -9,6 +9,7 @@
 #include <ibl/IBL.h>
 #include <scene/Scene.h>
 #include <model/Model.h>
+#include <culling/OcclusionCuller.h>
 
 
 namespace Chroma
@@ -20,6 +21,7 @@ namespace Chroma
 		// functions
 		void Draw() override;
 		void ResizeBuffers() override;
+		bool GetIsReady() override { return m_geometryPassShader.GetIsReady() && m_lightingPassShader.GetIsReady() && m_SSAOBuffer->GetIsReady(); };
 
 		inline unsigned int GetSSAOTexture() const { return m_SSAOBuffer->GetTexture(); }
 
@@ -47,17 +49,28 @@ namespace Chroma
 		// scene
 		IFramebuffer* m_PostFXBuffer;
 
+		// occlusion
+		OcclusionCuller m_OcclusionCuller;
+
+		// pooled lit meshes of the frame, drawn sorted by shader variant then pool VAO
+		struct PooledDraw
+		{
+			unsigned int keywords;
+			unsigned int VAO;
+			MeshComponent* meshComponent;
+		};
+		std::vector<PooledDraw> m_PooledDraws;
+
 		// functions
 		void Init() override;
 		void BindGBufferTextures();
 
-		// gbuffer textures
-		unsigned int gPosition, gViewPosition, gViewNormal, gFragPosLightSpace;
-		unsigned int gAlbedo, gNormal, gMetRoughAO;
-		unsigned int gDepth;
-
 		// passes
+		void RasterizeOccluders();
+		bool GetIsOccluded(UID const& uid);
 		void DrawGeometryPass();
+		Shader& UseGeometryPassVariant(unsigned int const& keywords);
+		void DrawPooledMeshes();
 		void DrawLightingPass();
 		void BlitDepthBuffer();
 
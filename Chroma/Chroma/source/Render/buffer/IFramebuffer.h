@@ -27,6 +27,8 @@ namespace Chroma
 		virtual unsigned int GetTexture() { return m_FBOTexture; };
 
 		virtual unsigned int GetFBO() { return m_FBO; };
+		// false while the buffer's programs are still linking
+		virtual bool GetIsReady() { return m_ScreenShader->GetIsReady(); };
 
 		void SetScale(glm::vec2 newScale) { m_Scale = newScale; };
 		void SetTranslation(glm::vec2 newPosition) { m_Offset = newPosition; };
@@ -1,7 +1,5 @@
 #include "PostFXBuffer.h"
 #include <render/Render.h>
-#include <buffer/SSRBuffer.h>
-#include <buffer/VXGIBuffer.h>
 #include <buffer/GBuffer.h>
 
 namespace Chroma
@@ -10,6 +8,7 @@ namespace Chroma
 	{
 		m_ScreenShader = new Shader(fragSource, vtxSource);
 		blurShader = new Shader(blurfragSource, vtxSource);
+		upscaleShader = new Shader(upscaleFragSource, vtxSource);
 		// generate and Bind frame buffers
 		glGenFramebuffers(1, &hdrFBO);
 		glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
@@ -44,6 +43,9 @@ namespace Chroma
 		// generate Blur Buffers and textures
 		genBlurBuffer();
 
+		// generate Upscale Buffer
+		genUpscaleBuffer();
+
 		// configure shaders
 		ConfigureShaders();
 	}
@@ -53,6 +55,9 @@ namespace Chroma
 		blurShader->Use();
 		blurShader->SetUniform("scale", m_Scale);
 		blurShader->SetUniform("offset", m_Offset);
+		upscaleShader->Use();
+		upscaleShader->SetUniform("scale", m_Scale);
+		upscaleShader->SetUniform("offset", m_Offset);
 		m_ScreenShader->Use();
 		m_ScreenShader->SetUniform("scale", m_Scale);
 		m_ScreenShader->SetUniform("offset", m_Offset);
@@ -63,6 +68,10 @@ namespace Chroma
 		blurShader->Use();
 		blurShader->SetUniform("image", 0);
 
+		upscaleShader->Use();
+		upscaleShader->SetUniform("u_Input", 0);
+		upscaleShader->SetUniform("u_Sharpness", DYNAMIC_RESOLUTION_SHARPNESS);
+
 		m_ScreenShader->Use();
 		m_ScreenShader->SetUniform("u_Background", 0);
 		m_ScreenShader->SetUniform("u_BloomTx", 1);
@@ -86,12 +95,6 @@ namespace Chroma
 		glBindTexture(GL_TEXTURE_2D, colorBuffersTextures[1]);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, m_Width, m_Height, 0, GL_RGBA, GL_FLOAT, NULL);
 
-		// blur FBOs
-		glBindTexture(GL_TEXTURE_2D, blurColorBuffers[0]);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL);
-		glBindTexture(GL_TEXTURE_2D, blurColorBuffers[1]);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL);
-
 		// rbo
 		glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
 		// attach buffers
@@ -101,27 +104,51 @@ namespace Chroma
 
 	void PostFXBuffer::genBlurBuffer()
 	{
-		// ping-pong-framebuffer for blurring
+		// ping-pong-framebuffer for blurring, textures are attached when drawn
 		glGenFramebuffers(2, blurFBOs);
-		glGenTextures(2, blurColorBuffers);
+		blurColorBuffers[0] = blurColorBuffers[1] = 0;
+	}
+
+	void PostFXBuffer::genUpscaleBuffer()
+	{
+		// composite target is attached when drawn, its linear filtering does the upscale
+		glGenFramebuffers(1, &upscaleFBO);
+	}
+
+	bool PostFXBuffer::GetIsUpscaling()
+	{
+		return m_Width != (unsigned int)Render::GetOutputWidth() || m_Height != (unsigned int)Render::GetOutputHeight();
+	}
+
+	void PostFXBuffer::BindCompositeTarget(unsigned int const& compositeTexture)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, upscaleFBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, compositeTexture, 0);
+	}
+
+	void PostFXBuffer::Upscale(unsigned int const& compositeTexture, unsigned int const& outputFBO)
+	{
+		CHROMA_PROFILE_FUNCTION();
+		glBindFramebuffer(GL_FRAMEBUFFER, outputFBO);
+		glViewport(0, 0, Render::GetOutputWidth(), Render::GetOutputHeight());
+		upscaleShader->Use();
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, compositeTexture);
+		RenderQuad();
+		Render::SetRenderViewport();
+	}
+
+	void PostFXBuffer::DrawBloom(unsigned int const& pingTexture, unsigned int const& pongTexture)
+	{
+		CHROMA_PROFILE_FUNCTION();
+		blurColorBuffers[0] = pingTexture;
+		blurColorBuffers[1] = pongTexture;
 		for (unsigned int i = 0; i < 2; i++)
 		{
 			glBindFramebuffer(GL_FRAMEBUFFER, blurFBOs[i]);
-			glBindTexture(GL_TEXTURE_2D, blurColorBuffers[i]);
-			glTexImage2D(
-				GL_TEXTURE_2D, 0, GL_RGB16F, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL
-			);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glFramebufferTexture2D(
-				GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, blurColorBuffers[i], 0
-			);
-			// also check if framebuffers are complete (no need for depth buffer)
-			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-				CHROMA_WARN("POSTFX BUFFER:: Blur Framebuffer not complete!");
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, blurColorBuffers[i], 0);
 		}
+		blurFragments();
 	}
 
 	void PostFXBuffer::blurFragments()
@@ -160,7 +187,7 @@ namespace Chroma
 		glBindTexture(GL_TEXTURE_2D, Render::GetForwardBuffer()->GetTexture());
 		// Bloom
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, colorBuffersTextures[1]);
+		glBindTexture(GL_TEXTURE_2D, m_BloomTexture);
 		// Direct lighting
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, Render::GetDirectLightingShadows());
@@ -169,13 +196,13 @@ namespace Chroma
 		glBindTexture(GL_TEXTURE_2D, Render::GetIndirectLighting());
 		// ssr
 		glActiveTexture(GL_TEXTURE4);
-		glBindTexture(GL_TEXTURE_2D, static_cast<SSRBuffer*>(Chroma::Render::GetSSRBuffer())->GetSSRReflectedUVTexture());
+		glBindTexture(GL_TEXTURE_2D, m_SSRTexture);
 		// vxgi - irradiance
 		glActiveTexture(GL_TEXTURE5);
-		glBindTexture(GL_TEXTURE_2D, static_cast<VXGIBuffer*>(Chroma::Render::GetVXGIBuffer())->GetTexture());
+		glBindTexture(GL_TEXTURE_2D, m_VXGITexture);
 		// vxgi - reflections
 		//glActiveTexture(GL_TEXTURE6);
-		//glBindTexture(GL_TEXTURE_2D, static_cast<SSRBuffer*>(Chroma::Render::GetSSRBuffer())->GetSSRReflectedUVTexture());
+		//glBindTexture(GL_TEXTURE_2D, m_SSRTexture);
 		// ssao
 		glActiveTexture(GL_TEXTURE7);
 		glBindTexture(GL_TEXTURE_2D, static_cast<GBuffer*>(Render::GetGBuffer())->GetSSAOTexture());
@@ -184,7 +211,7 @@ namespace Chroma
 		glBindTexture(GL_TEXTURE_2D, Render::GetMetRoughAO());
 		// depth
 		glActiveTexture(GL_TEXTURE9);
-		glBindTexture(GL_TEXTURE_2D, Render::GetVSPositions());
+		glBindTexture(GL_TEXTURE_2D, Render::GetDepth());
 
 		// uniforms
 		m_ScreenShader->SetUniform("u_BloomAmount", m_BloomAmount);
@@ -201,37 +228,16 @@ namespace Chroma
 		RenderQuad();
 	}
 
-	void PostFXBuffer::Draw(const bool& useBloom)
+	void PostFXBuffer::DrawComposite(unsigned int const& bloomTexture, unsigned int const& ssrTexture, unsigned int const& vxgiTexture)
 	{
-		if (useBloom)
-		{
-			// blur BrightFragments
-			UnBind();
-			bool horizontal = true, first_iteration = true;
-			blurShader->Use();
-			for (int i = 0; i < blurIterations; i++)
-			{
-				glBindFramebuffer(GL_FRAMEBUFFER, blurFBOs[horizontal]);
-				blurShader->SetUniform("horizontal", horizontal);
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(
-					GL_TEXTURE_2D, first_iteration ? colorBuffersTextures[1] : blurColorBuffers[!horizontal]
-				);
-				RenderQuad();
-				horizontal = !horizontal;
-				if (first_iteration)
-					first_iteration = false;
-			}
-			UnBind();
-			// Composite blur and HDR and tone
-			m_ScreenShader->Use();
-			m_ScreenShader->SetUniform("u_Bloom", useBloom);
-			Draw();
-			RenderQuad();
-		}
-		else
-			Draw();
-
+		CHROMA_PROFILE_FUNCTION();
+		// composite blur and HDR and tone into the bound target, no bloom texture when disabled
+		m_BloomTexture = bloomTexture;
+		m_SSRTexture = ssrTexture;
+		m_VXGITexture = vxgiTexture;
+		m_ScreenShader->Use();
+		m_ScreenShader->SetUniform("u_Bloom", bloomTexture != 0);
+		Draw();
 	}
 
 	void PostFXBuffer::BindAndClear()
@@ -248,6 +254,7 @@ namespace Chroma
 	PostFXBuffer::~PostFXBuffer()
 	{
 		delete blurShader;
+		delete upscaleShader;
 		delete m_ScreenShader;
 	}
 }
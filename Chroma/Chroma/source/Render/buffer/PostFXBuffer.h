@@ -10,11 +10,21 @@ namespace Chroma
 	public:
 		unsigned int GetTexture() override { return colorBuffersTextures[0]; }
 		unsigned int GetFBO() override { return hdrFBO; };
+		bool GetIsReady() override { return m_ScreenShader->GetIsReady() && blurShader->GetIsReady() && upscaleShader->GetIsReady(); };
 
 		void Draw() override;
-		void Draw(const bool& useBloom);
 		void BindAndClear() override;
 
+		// render graph passes, targets are graph textures
+		// - blurs the bright fragments, the result ends in the ping texture
+		void DrawBloom(unsigned int const& pingTexture, unsigned int const& pongTexture);
+		// - composites into the bound framebuffer
+		void DrawComposite(unsigned int const& bloomTexture, unsigned int const& ssrTexture, unsigned int const& vxgiTexture);
+		// - below output resolution the frame is composited into a render resolution target first
+		bool GetIsUpscaling();
+		void BindCompositeTarget(unsigned int const& compositeTexture);
+		void Upscale(unsigned int const& compositeTexture, unsigned int const& outputFBO);
+
 		float m_BloomAmount{ 1.0f };
 		float m_IndirectContribution{ 1.0f };
 		float m_SSRContribution{ 1.0f };
@@ -38,6 +48,9 @@ namespace Chroma
 
 		// Textures
 		unsigned int colorBuffersTextures[2];
+		unsigned int m_BloomTexture{ 0 };
+		unsigned int m_SSRTexture{ 0 };
+		unsigned int m_VXGITexture{ 0 };
 
 		// Bloom m_FBO and Textures
 		void genBlurBuffer();
@@ -50,6 +63,12 @@ namespace Chroma
 		int blurIterations{ 10 };
 		void blurFragments();
 
+		// Upscale, the composite target is attached when drawn
+		const char* upscaleFragSource{ "resources/shaders/fragUpscale.glsl" };
+		Shader* upscaleShader;
+		unsigned int upscaleFBO;
+		void genUpscaleBuffer();
+
 		// Functions
 		void Init() override;
 		void SetTransformUniforms() override;
@@ -1,5 +1,7 @@
 #include "SSAOBuffer.h"
 #include <render/Render.h>
+#include <buffer/DownsampleBuffer.h>
+#include <quality/RenderQuality.h>
 
 namespace Chroma
 {
@@ -16,9 +18,11 @@ namespace Chroma
 		// generate ssao ColorBuffer Texture Object
 		glGenTextures(1, &ssaoColorBuffer);
 		glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, GetTraceWidth(), GetTraceHeight(), 0, GL_RGB, GL_FLOAT, NULL);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssaoColorBuffer, 0);
 
 		// blur buffers
@@ -61,6 +65,15 @@ namespace Chroma
 		}
 	}
 
+	void SSAOBuffer::SetKernelSamples(unsigned int const& samples)
+	{
+		// regenerated rather than truncated, the kernel is distributed over its whole length
+		kernelSamples = glm::clamp(samples, 1u, 64u);
+		ssaoKernel.clear();
+		generateSampleKernel();
+		SSAOShader.SetUniform("kernelSize", kernelSamples);
+	}
+
 	void SSAOBuffer::generateNoiseTexture()
 	{
 		// generate random noise tile
@@ -72,8 +85,8 @@ namespace Chroma
 				0.0f);
 			ssaoNoise.push_back(noise);
 		}
-		// set noise m_Scale for uniform
-		noiseScale = glm::vec2(float(m_Width) / std::sqrtf(noiseSize), float(m_Height) / std::sqrtf(noiseSize));
+		// set noise m_Scale for uniform, tiled over the traced resolution
+		noiseScale = glm::vec2(float(GetTraceWidth()) / std::sqrtf(noiseSize), float(GetTraceHeight()) / std::sqrtf(noiseSize));
 		// generating texture
 		glGenTextures(1, &noiseTexture);
 		glBindTexture(GL_TEXTURE_2D, noiseTexture);
@@ -99,8 +112,8 @@ namespace Chroma
 		SSAOShader.SetUniform("bias", 0.025f);
 		SSAOShader.SetUniform("noiseScale", noiseScale);
 
-		SSAOShader.SetUniform("gViewPosition", 0);
-		SSAOShader.SetUniform("gViewNormal", 1);
+		SSAOShader.SetUniform("gDepth", 0);
+		SSAOShader.SetUniform("gNormal", 1);
 		SSAOShader.SetUniform("texNoise", 2);
 
 		SSAOShader.SetUniform("scale", m_Scale);
@@ -111,36 +124,84 @@ namespace Chroma
 
 		SSAOBlurShader.SetUniform("scale", m_Scale);
 		SSAOBlurShader.SetUniform("offset", m_Offset);
+
+		// reduced resolution, blurred with a 4x4 depth aware footprint
+		SSAOUpsampleShader.Use();
+		SSAOUpsampleShader.SetUniform("u_LowResInput", 0);
+		SSAOUpsampleShader.SetUniform("u_LowResDepth", 1);
+		SSAOUpsampleShader.SetUniform("u_Depth", 2);
+		SSAOUpsampleShader.SetUniform("u_Radius", 2);
+
+		SSAOUpsampleShader.SetUniform("scale", m_Scale);
+		SSAOUpsampleShader.SetUniform("offset", m_Offset);
 	}
 
 	void SSAOBuffer::Draw()
 	{
 		CHROMA_PROFILE_FUNCTION();
+		// match the quality tier's resolution and samples
+		if (RenderQuality::GetSettings().ssaoKernelSamples != kernelSamples)
+			SetKernelSamples(RenderQuality::GetSettings().ssaoKernelSamples);
+		unsigned int const divisor = RenderQuality::GetSettings().ssaoResolutionDivisor;
+		if (divisor != m_ResolutionDivisor && (divisor == 1 || Render::GetDownsampleBuffer(divisor) != nullptr))
+		{
+			m_ResolutionDivisor = divisor;
+			ResizeBuffers();
+		}
+
+		// reduced resolution traces against downsampled depth and normals
+		unsigned int depthTexture{ Chroma::Render::GetDepth() };
+		unsigned int normalsTexture{ Chroma::Render::GetNormals() };
+		if (m_ResolutionDivisor > 1)
+		{
+			DownsampleBuffer* downsampleBuffer = Render::GetDownsampleBuffer(m_ResolutionDivisor);
+			if (!downsampleBuffer->GetIsReady())
+				return;
+			downsampleBuffer->Draw();
+			depthTexture = downsampleBuffer->GetDepthTexture();
+			normalsTexture = downsampleBuffer->GetNormalsTexture();
+		}
+
 		// binding frame buffer and clearing color buffer
 		glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+		glViewport(0, 0, GetTraceWidth(), GetTraceHeight());
 		glClear(GL_COLOR_BUFFER_BIT);
 		// updating shader uniforms
 		SSAOShader.Use();
 		sendKernelSamplesToShader();
-		SSAOShader.SetUniform("projection", Chroma::Scene::GetRenderCamera()->GetProjectionMatrix());
-		//sending textures
+		//sending textures, view positions are reconstructed from depth
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetVSPositions());
+		glBindTexture(GL_TEXTURE_2D, depthTexture);
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetVSNormals());
+		glBindTexture(GL_TEXTURE_2D, normalsTexture);
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, noiseTexture);
 		RenderQuad();
+		glViewport(0, 0, m_Width, m_Height);
 		UnBind();
 
 		// binding frame buffer and clearing color buffer
 		glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
 		glClear(GL_COLOR_BUFFER_BIT);
-		// updating shader uniforms
-		SSAOBlurShader.Use();
-		// sending textures
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+		if (m_ResolutionDivisor > 1)
+		{
+			// blur and upsample, weighted by depth similarity to the full resolution depth
+			SSAOUpsampleShader.Use();
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, depthTexture);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetDepth());
+		}
+		else
+		{
+			// updating shader uniforms
+			SSAOBlurShader.Use();
+			// sending textures
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+		}
 		RenderQuad();
 		UnBind();
 
@@ -150,10 +211,14 @@ namespace Chroma
 	{
 		// textures
 		glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, GetTraceWidth(), GetTraceHeight(), 0, GL_RGB, GL_FLOAT, NULL);
 
 		glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_Width, m_Height, 0, GL_RGB, GL_FLOAT, NULL);
+
+		// noise tiles over the traced resolution
+		noiseScale = glm::vec2(float(GetTraceWidth()) / std::sqrtf(noiseSize), float(GetTraceHeight()) / std::sqrtf(noiseSize));
+		SSAOShader.SetUniform("noiseScale", noiseScale);
 	}
 
 
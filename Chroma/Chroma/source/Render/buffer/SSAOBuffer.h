@@ -16,6 +16,7 @@ namespace Chroma
 		void ResizeBuffers() override;
 
 		virtual unsigned int GetTexture() override { return ssaoColorBufferBlur; };
+		bool GetIsReady() override { return SSAOShader.GetIsReady() && SSAOBlurShader.GetIsReady() && SSAOUpsampleShader.GetIsReady(); };
 
 		SSAOBuffer();
 		~SSAOBuffer();
@@ -28,13 +29,18 @@ namespace Chroma
 		// shader
 		const char* fragSource{ "resources/shaders/fragSSAO.glsl" };
 		const char* fragBlurSource{ "resources/shaders/fragSSAOBlur.glsl" };
+		const char* fragUpsampleSource{ "resources/shaders/fragBilateralUpsample.glsl" };
 		const char* vtxSource{ "resources/shaders/frameBufferVertex.glsl" };
 		Shader SSAOShader{ fragSource , vtxSource };
 		Shader SSAOBlurShader{ fragBlurSource, vtxSource };
+		Shader SSAOUpsampleShader{ fragUpsampleSource, vtxSource };
 
-		// buffers
+		// buffers, ssao is traced at 1/divisor resolution and blurred back to screen resolution
 		unsigned int ssaoFBO, ssaoColorBuffer;
 		unsigned int ssaoBlurFBO, ssaoColorBufferBlur;
+		unsigned int m_ResolutionDivisor{ 1 };
+		inline unsigned int GetTraceWidth() const { return std::max(m_Width / m_ResolutionDivisor, 1u); }
+		inline unsigned int GetTraceHeight() const { return std::max(m_Height / m_ResolutionDivisor, 1u); }
 		void generateBuffers();
 
 		// initialize
@@ -44,6 +50,7 @@ namespace Chroma
 		unsigned int kernelSamples{ 16 };
 		std::vector<glm::vec3> ssaoKernel;
 		void generateSampleKernel();
+		void SetKernelSamples(unsigned int const& samples);
 
 		// noise texture
 		float noiseSize{ 16.0f };
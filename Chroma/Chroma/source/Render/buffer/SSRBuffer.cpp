@@ -1,20 +1,44 @@
 #include "SSRBuffer.h"
 #include <render/Render.h>
 #include <buffer/GBuffer.h>
+#include <buffer/DownsampleBuffer.h>
+#include <quality/RenderQuality.h>
 
 namespace Chroma
 {
 	void SSRBuffer::Draw()
 	{
 		CHROMA_PROFILE_FUNCTION();
-		BindAndClear();
+		// reduced resolution traces against downsampled depth and normals
+		unsigned int depthTexture{ Chroma::Render::GetDepth() };
+		unsigned int normalsTexture{ Chroma::Render::GetNormals() };
+		if (m_ResolutionDivisor > 1)
+		{
+			DownsampleBuffer* downsampleBuffer = Render::GetDownsampleBuffer(m_ResolutionDivisor);
+			if (!downsampleBuffer->GetIsReady())
+			{
+				// pooled targets aren't cleared, nothing is reflected until it links
+				BindAndClear();
+				UnBind();
+				return;
+			}
+			downsampleBuffer->Draw();
+			depthTexture = downsampleBuffer->GetDepthTexture();
+			normalsTexture = downsampleBuffer->GetNormalsTexture();
+			glBindFramebuffer(GL_FRAMEBUFFER, m_LowResFBO);
+			glViewport(0, 0, GetTraceWidth(), GetTraceHeight());
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
+		else
+			BindAndClear();
+
 		// Bind Textures
-		// 0 VsNormals
+		// 0 Normals
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetVSNormals());
-		// 1 VsPositions
+		glBindTexture(GL_TEXTURE_2D, normalsTexture);
+		// 1 Depth, view positions are reconstructed
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetVSPositions());
+		glBindTexture(GL_TEXTURE_2D, depthTexture);
 		// 2 testColor
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetAlbedo());
@@ -26,9 +50,47 @@ namespace Chroma
 		SetTransformUniforms();
 		RenderQuad();
 
+		if (m_ResolutionDivisor > 1)
+		{
+			// upsample, weighted by depth similarity to the full resolution depth
+			glViewport(0, 0, m_Width, m_Height);
+			BindAndClear();
+			m_UpsampleShader.Use();
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, m_LowResReflectedUVs);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, depthTexture);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, Chroma::Render::GetDepth());
+			RenderQuad();
+		}
+
 		UnBind();
 	}
 
+	void SSRBuffer::SetTargets(unsigned int const& reflectedUVs, unsigned int const& lowResReflectedUVs)
+	{
+		m_SSRReflectedUVs = reflectedUVs;
+		glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_SSRReflectedUVs, 0);
+
+		m_LowResReflectedUVs = lowResReflectedUVs;
+		if (m_ResolutionDivisor > 1)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, m_LowResFBO);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_LowResReflectedUVs, 0);
+		}
+		UnBind();
+	}
+
+	unsigned int SSRBuffer::UpdateResolutionDivisor()
+	{
+		unsigned int const divisor = RenderQuality::GetSettings().ssrResolutionDivisor;
+		if (divisor == 1 || Render::GetDownsampleBuffer(divisor) != nullptr)
+			m_ResolutionDivisor = divisor;
+		return m_ResolutionDivisor;
+	}
+
 	SSRBuffer::SSRBuffer()
 	{
 		Init();
@@ -36,43 +98,29 @@ namespace Chroma
 
 	void SSRBuffer::Init()
 	{
+		// targets are attached each frame
 		glGenFramebuffers(1, &m_FBO);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
-
-		// - Reflected UV Texture
-		glGenTextures(1, &m_SSRReflectedUVs);
-		glBindTexture(GL_TEXTURE_2D, m_SSRReflectedUVs);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_Width, m_Height, 0, GL_RGBA, GL_FLOAT, NULL);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_SSRReflectedUVs, 0);
-
-		//// create depth buffer (renderbuffer)
-		//glGenRenderbuffers(1, &m_RBO);
-		//glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
-
-		//// attach buffers
-		//glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, m_Width, m_Height);
-		//glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_RBO);
-
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-			CHROMA_WARN("Framebuffer not complete!");
-
-		// reset to default framebuffer
-		UnBind();
+		glGenFramebuffers(1, &m_LowResFBO);
 
 		// Set Shader Uniforms
 		m_ScreenShader->Use();
-		m_ScreenShader->SetUniform("vsNormals", 0);
-		m_ScreenShader->SetUniform("vsPositions", 1);
+		m_ScreenShader->SetUniform("gNormal", 0);
+		m_ScreenShader->SetUniform("gDepth", 1);
 		m_ScreenShader->SetUniform("vAlbedo", 2);
 
+		// reflected uvs only blend across a 2x2 footprint
+		m_UpsampleShader.Use();
+		m_UpsampleShader.SetUniform("u_LowResInput", 0);
+		m_UpsampleShader.SetUniform("u_LowResDepth", 1);
+		m_UpsampleShader.SetUniform("u_Depth", 2);
+		m_UpsampleShader.SetUniform("u_Radius", 1);
+		m_UpsampleShader.SetUniform("scale", m_Scale);
+		m_UpsampleShader.SetUniform("offset", m_Offset);
+
 	}
 
 	void SSRBuffer::ResizeBuffers()
 	{
-		glBindTexture(GL_TEXTURE_2D, m_SSRReflectedUVs);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_Width, m_Height, 0, GL_RGBA, GL_FLOAT, NULL);
-
+		// targets follow the render resolution through the render graph
 	}
 }
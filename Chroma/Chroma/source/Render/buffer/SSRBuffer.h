@@ -8,9 +8,13 @@ namespace Chroma
 	class SSRBuffer :	public IFramebuffer
 	{
 	public:
-		unsigned int GetSSRReflectedUVTexture() { return m_SSRReflectedUVs; }
+		// targets are render graph textures, the trace target is only used below full resolution
+		void SetTargets(unsigned int const& reflectedUVs, unsigned int const& lowResReflectedUVs);
+		// matches the quality tier's resolution, before the trace target is sized
+		unsigned int UpdateResolutionDivisor();
 
 		void Draw() override;
+		bool GetIsReady() override { return m_ScreenShader->GetIsReady() && m_UpsampleShader.GetIsReady(); };
 
 		SSRBuffer();
 		~SSRBuffer() {};
@@ -18,9 +22,17 @@ namespace Chroma
 	protected:
 		// Shader
 		const char* fragSource{ "resources/shaders/fragSSRBuffer.glsl" };
+		const char* fragUpsampleSource{ "resources/shaders/fragBilateralUpsample.glsl" };
 
 		// Reflected UVs Texture
-		unsigned int m_SSRReflectedUVs;
+		unsigned int m_SSRReflectedUVs{ 0 };
+
+		// Reduced resolution trace, upsampled into the reflected UVs
+		unsigned int m_LowResFBO;
+		unsigned int m_LowResReflectedUVs{ 0 };
+		unsigned int m_ResolutionDivisor{ 1 };
+		inline unsigned int GetTraceWidth() const { return std::max(m_Width / m_ResolutionDivisor, 1u); }
+		inline unsigned int GetTraceHeight() const { return std::max(m_Height / m_ResolutionDivisor, 1u); }
 
 		// funcs
 		void Init() override;
@@ -28,6 +40,7 @@ namespace Chroma
 
 		// shader
 		Shader* m_ScreenShader{ new Shader(fragSource, vtxSource) };
+		Shader m_UpsampleShader{ fragUpsampleSource, vtxSource };
 
 	};
 }
@@ -5,13 +5,21 @@
 #include "shadow/ShadowBuffer.h"
 #include "buffer/DebugBuffer.h"
 #include "editor/ui/EditorUI.h"
+#include "geometry/StaticBatcher.h"
 
 
+static_assert(VXGI_CLIPMAP_RESOLUTION % VXGI_BRICK_SIZE == 0, "VXGI clipmaps hold whole bricks.");
+static_assert(VXGI_SCROLL_GRANULARITY % VXGI_BRICK_SIZE == 0, "VXGI clipmaps scroll by whole bricks.");
+
 namespace Chroma
 {
 	VXGIBuffer::~VXGIBuffer()
 	{
-		if (m_Voxel3DTexture) delete m_Voxel3DTexture;
+		for (VoxelClipmap& clipmap : m_Clipmaps)
+			delete clipmap.bricks;
+		if (m_DynamicBricks) delete m_DynamicBricks;
+		glDeleteVertexArrays(1, &m_VoxelVisualizationVAO);
+		glDeleteBuffers(1, &m_VoxelVisualizationVBO);
 		if (m_ScreenShader) delete m_ScreenShader;
 	}
 
@@ -43,7 +51,7 @@ namespace Chroma
 	void VXGIBuffer::Draw(const bool& visualizeVoxelization)
 	{
 
-		if (EditorUI::m_VXGI && m_VoxelGridMovedThisFrame)
+		if (EditorUI::m_VXGI)
 		{
 			Voxelize();
 		}
@@ -118,8 +126,14 @@ namespace Chroma
 			CHROMA_WARN("Framebuffer not complete!");
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-		// Create 3D Voxel Texture
-		m_Voxel3DTexture = new Texture3D(m_VoxelGridTextureSize, m_VoxelGridTextureSize, m_VoxelGridTextureSize, true);
+		// Create sparse voxel storage, bricks are allocated as geometry is found
+		for (unsigned int level = 0; level < VXGI_CLIPMAP_LEVELS; level++)
+		{
+			VoxelClipmap clipmap;
+			clipmap.bricks = new VoxelBrickMap(m_VoxelGridTextureSize);
+			m_Clipmaps.push_back(clipmap);
+		}
+		m_DynamicBricks = new VoxelBrickMap(m_VoxelGridTextureSize);
 
 		// Set up GL Points for Voxel Visualization
 		SetupVoxelVisualizationVAO();
@@ -130,32 +144,27 @@ namespace Chroma
 
 	void VXGIBuffer::SetupVoxelVisualizationVAO()
 	{
-		std::vector<glm::vec3> voxelVerts(m_NumVoxels);
-
 		// Generate buffers
 		// Vertex Array Object Buffer
 		glGenVertexArrays(1, &m_VoxelVisualizationVAO);
-		// Vertex Buffer and Element Buffer
-		unsigned int VBO;
-		glGenBuffers(1, &VBO);
+		// Instance Buffer, filled with the allocated bricks when drawn
+		glGenBuffers(1, &m_VoxelVisualizationVBO);
 
 		// Bind buffers
 		glBindVertexArray(m_VoxelVisualizationVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, m_NumVoxels * sizeof(glm::vec3) , &voxelVerts[0], GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, m_VoxelVisualizationVBO);
 
-		// vertex positions
+		// brick positions, per instance
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-
-		// clear vector
-		voxelVerts.clear();
+		glVertexAttribDivisor(0, 1);
+		glBindVertexArray(0);
 	}
 
 	void VXGIBuffer::DrawVoxelVisualization()
 	{
 		// -------------------------------------------------------
-		// Render 3D texture to screen.
+		// Render allocated bricks to screen.
 		// -------------------------------------------------------
 
 		BindAndClear();
@@ -163,20 +172,42 @@ namespace Chroma
 		// Bind Voxel Visualization Shader
 		m_VoxelVisualizationShader.Use();
 
+		// finest level, dynamic voxels drawn over static
+		DrawBrickVisualization(m_Clipmaps[0].bricks, m_Clipmaps[0]);
+		if (m_HasDynamicVoxels)
+			DrawBrickVisualization(m_DynamicBricks, m_Clipmaps[0]);
+
+		Draw();
+	}
+
+	void VXGIBuffer::DrawBrickVisualization(VoxelBrickMap* brickMap, const VoxelClipmap& clipmap)
+	{
+		// allocated bricks, toroidal -> grid window
+		int const numBricksPerAxis = (int)brickMap->GetNumBricksPerAxis();
+		glm::ivec3 const offsetBricks = glm::ivec3(GetClipmapOffset(clipmap)) / VXGI_BRICK_SIZE;
+		std::vector<glm::vec3> brickPositions;
+		for (glm::ivec3 const& brick : brickMap->GetAllocatedBricks())
+			brickPositions.push_back(glm::vec3(((brick - offsetBricks) % numBricksPerAxis + numBricksPerAxis) % numBricksPerAxis));
+		if (brickPositions.empty())
+			return;
+
 		// Set voxel shader uniforms
-		UpdateVoxelShaderUniforms(m_VoxelVisualizationShader);
+		UpdateVoxelShaderUniforms(m_VoxelVisualizationShader, clipmap);
 
-		// Bind voxel grid
+		// Bind bricks
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_3D, m_Voxel3DTexture->GetID());
-		m_VoxelVisualizationShader.SetUniform("voxelTexture", 0);
-		
-		// Render Grid VAO
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetPoolTexture());
+		m_VoxelVisualizationShader.SetUniform("u_VoxelTexture", 0);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetIndirectionTexture());
+		m_VoxelVisualizationShader.SetUniform("u_VoxelIndirection", 1);
+
+		// Render a point per voxel of each brick
 		glBindVertexArray(m_VoxelVisualizationVAO);
-		glDrawArrays(GL_POINTS, 0, m_NumVoxels);
+		glBindBuffer(GL_ARRAY_BUFFER, m_VoxelVisualizationVBO);
+		glBufferData(GL_ARRAY_BUFFER, brickPositions.size() * sizeof(glm::vec3), brickPositions.data(), GL_STREAM_DRAW);
+		glDrawArraysInstanced(GL_POINTS, 0, VXGI_BRICK_SIZE * VXGI_BRICK_SIZE * VXGI_BRICK_SIZE, (GLsizei)brickPositions.size());
 		glBindVertexArray(0);
-
-		Draw();
 	}
 
 	void VXGIBuffer::ConeTraceScene()
@@ -190,54 +221,161 @@ namespace Chroma
 
 		// Set uniforms
 		// Grid Uniforms
-		UpdateVoxelShaderUniforms(m_VoxelConeTracing);
+		UpdateVoxelShaderUniforms(m_VoxelConeTracing, m_Clipmaps[0]);
 		// Voxel Cone Tracing Uniforms
 		m_VoxelConeTracing.SetUniform("u_VoxelRayMaxDistance", 20.0f);
 		m_VoxelConeTracing.SetUniform("u_VoxelRayStepSize", 0.75f);
 		m_VoxelConeTracing.SetUniform("u_VoxelNumCones", 16);
 
-		// Bind WS Positions and Normals and MetRoughAO
-		m_VoxelConeTracing.SetUniform("u_PositionsWS", 0);
+		// Bind Depth and Normals and MetRoughAO, positions are reconstructed from depth
+		m_VoxelConeTracing.SetUniform("u_Depth", 0);
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, Render::GetWSPositions());
+		glBindTexture(GL_TEXTURE_2D, Render::GetDepth());
 
-		m_VoxelConeTracing.SetUniform("u_NormalsWS", 1);
+		m_VoxelConeTracing.SetUniform("u_Normals", 1);
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, Render::GetWSNormals());
+		glBindTexture(GL_TEXTURE_2D, Render::GetNormals());
 
 		m_VoxelConeTracing.SetUniform("u_MetRoughAO", 2);
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, Render::GetMetRoughAO());
 
-		// Bind voxel grid
-		glActiveTexture(GL_TEXTURE3);
-		glBindTexture(GL_TEXTURE_3D, m_Voxel3DTexture->GetID());
-		m_VoxelConeTracing.SetUniform("u_VoxelTexture", 3);
+		// Bind voxel clipmaps and dynamic layer
+		UpdateClipmapUniforms(m_VoxelConeTracing, 3);
+	}
+
+	void VXGIBuffer::UpdateVoxelGridSize()
+	{
+		m_VoxelGridSize = m_VoxelGridWSSize / (float)m_VoxelGridTextureSize;
+		// each level doubles the last
+		for (unsigned int level = 0; level < m_Clipmaps.size(); level++)
+			m_Clipmaps[level].gridSize = m_VoxelGridSize * (float)(1 << level);
+		InvalidateVoxels();
+	}
+
+	void VXGIBuffer::UpdateVoxelShaderUniforms(Shader& shader, const VoxelClipmap& clipmap)
+	{
+		shader.SetUniform("u_VoxelGridResolution", (int)m_VoxelGridTextureSize);
+		shader.SetUniform("u_VoxelGridSize", clipmap.gridSize);
+		shader.SetUniform("u_VoxelGridCentroid", GetClipmapCentroid(clipmap));
+		shader.SetUniform("u_VoxelGridOffset", GetClipmapOffset(clipmap));
+	}
+
+	void VXGIBuffer::UpdateClipmapUniforms(Shader& shader, const unsigned int& firstTextureUnit)
+	{
+		// three textures per brick map
+		for (unsigned int level = 0; level < m_Clipmaps.size(); level++)
+		{
+			std::string const index = "[" + std::to_string(level) + "]";
+			shader.SetUniform("u_VoxelClipmapCentroids" + index, GetClipmapCentroid(m_Clipmaps[level]));
+			shader.SetUniform("u_VoxelClipmapOffsets" + index, GetClipmapOffset(m_Clipmaps[level]));
+			BindBrickMap(shader, "u_VoxelClipmap", index, m_Clipmaps[level].bricks, firstTextureUnit + level * 3);
+		}
+		BindBrickMap(shader, "u_VoxelDynamic", "", m_DynamicBricks, firstTextureUnit + (unsigned int)m_Clipmaps.size() * 3);
+	}
+
+	void VXGIBuffer::BindBrickMap(Shader& shader, const std::string& prefix, const std::string& index, VoxelBrickMap* brickMap, const unsigned int& firstTextureUnit)
+	{
+		GLint poolSize[3];
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetPoolTexture());
+		glGetTexLevelParameteriv(GL_TEXTURE_3D, 0, GL_TEXTURE_WIDTH, &poolSize[0]);
+		glGetTexLevelParameteriv(GL_TEXTURE_3D, 0, GL_TEXTURE_HEIGHT, &poolSize[1]);
+		glGetTexLevelParameteriv(GL_TEXTURE_3D, 0, GL_TEXTURE_DEPTH, &poolSize[2]);
+		shader.SetUniform(prefix + "PoolSize" + index, glm::vec3(poolSize[0], poolSize[1], poolSize[2]));
+
+		unsigned int const textures[3]{ brickMap->GetIndirectionTexture(), brickMap->GetPoolTexture(), brickMap->GetCoarseTexture() };
+		const char* const names[3]{ "Indirection", "Pool", "Coarse" };
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			shader.SetUniform(prefix + names[i] + index, (int)(firstTextureUnit + i));
+			glActiveTexture(GL_TEXTURE0 + firstTextureUnit + i);
+			glBindTexture(GL_TEXTURE_3D, textures[i]);
+		}
+	}
+
+	glm::vec3 VXGIBuffer::GetClipmapCentroid(const VoxelClipmap& clipmap) const
+	{
+		return (glm::vec3(clipmap.origin) + glm::vec3((float)m_VoxelGridTextureSize * 0.5f)) * GetVoxelWorldSize(clipmap);
 	}
 
-	void VXGIBuffer::UpdateVoxelShaderUniforms(Shader& shader)
+	glm::vec3 VXGIBuffer::GetClipmapOffset(const VoxelClipmap& clipmap) const
 	{
-		shader.SetUniform("u_VoxelGridResolution", m_Voxel3DTexture->GetTextureData()->depth);
-		shader.SetUniform("u_VoxelGridSize", m_VoxelGridSize);
-		shader.SetUniform("u_VoxelGridCentroid", m_VoxelGridCentroid);
+		// texel the grid's minimum corner wraps to
+		int const resolution = (int)m_VoxelGridTextureSize;
+		return glm::vec3(((clipmap.origin % resolution) + resolution) % resolution);
+	}
+
+	glm::ivec3 VXGIBuffer::GetSnappedOrigin(const VoxelClipmap& clipmap) const
+	{
+		// snapped to the scroll granularity so mips cover the same voxels after a scroll
+		glm::vec3 const minCorner = m_VoxelGridCentroid / GetVoxelWorldSize(clipmap) - glm::vec3((float)m_VoxelGridTextureSize * 0.5f);
+		float const granularity = (float)VXGI_SCROLL_GRANULARITY;
+		return glm::ivec3(glm::floor(minCorner / granularity + 0.5f) * granularity);
 	}
 
 	std::pair<glm::vec3, glm::vec3> VXGIBuffer::GetVoxelGridHalfExtents()
 	{
+		glm::vec3 const centroid = GetClipmapCentroid(m_Clipmaps[0]);
 		glm::vec3 extents((float)m_VoxelGridTextureSize / (1.0f / m_VoxelGridSize));
-		return  std::make_pair<glm::vec3, glm::vec3>(m_VoxelGridCentroid - extents, m_VoxelGridCentroid + extents);
+		return  std::make_pair<glm::vec3, glm::vec3>(centroid - extents, centroid + extents);
 	}
 
-	void VXGIBuffer::Voxelize()
+	void VXGIBuffer::InvalidateVoxels()
 	{
-		// first we clear the previous voxelization
-		m_Voxel3DTexture->Clear(glm::vec4(0.0));
+		for (VoxelClipmap& clipmap : m_Clipmaps)
+			clipmap.isValid = false;
+	}
+
+	unsigned int VXGIBuffer::GetNumAllocatedBricks() const
+	{
+		unsigned int numBricks{ m_DynamicBricks->GetNumAllocated() };
+		for (const VoxelClipmap& clipmap : m_Clipmaps)
+			numBricks += clipmap.bricks->GetNumAllocated();
+		return numBricks;
+	}
 
+	size_t VXGIBuffer::GetVoxelMemoryUsage() const
+	{
+		size_t memoryUsage{ m_DynamicBricks->GetMemoryUsage() };
+		for (const VoxelClipmap& clipmap : m_Clipmaps)
+			memoryUsage += clipmap.bricks->GetMemoryUsage();
+		return memoryUsage;
+	}
+
+	void VXGIBuffer::Voxelize()
+	{
 		// Use the voxelshader
 		m_VoxelShader.Use();
+		BeginVoxelization();
+
+		// Static geometry, only where the clipmaps scrolled
+		std::vector<bool> levelsChanged;
+		for (VoxelClipmap& clipmap : m_Clipmaps)
+			levelsChanged.push_back(ScrollClipmap(clipmap, GetSnappedOrigin(clipmap)));
+
+		// Dynamic geometry, every frame
+		bool const dynamicChanged = VoxelizeDynamic();
+
+		// Regenerate MipMaps, only for brick maps that changed
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+		for (unsigned int level = 0; level < m_Clipmaps.size(); level++)
+			if (levelsChanged[level])
+				UpdateBrickMapMips(m_Clipmaps[level].bricks);
+		if (dynamicChanged)
+			UpdateBrickMapMips(m_DynamicBricks);
 
+		EndVoxelization();
+	}
+
+	void VXGIBuffer::BeginVoxelization()
+	{
 		// Set voxel shader uniforms
-		UpdateVoxelShaderUniforms(m_VoxelShader);
+		m_VoxelShader.SetUniform("lightSpaceMatrix", static_cast<ShadowBuffer*>(Render::GetShadowBuffer())->GetLightSpaceMatrix());
+
+		// Shadowmap, past any material textures
+		glActiveTexture(GL_TEXTURE15);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, static_cast<ShadowBuffer*>(Chroma::Render::GetShadowBuffer())->GetTexture());
+		m_VoxelShader.SetUniform("shadowmap", 15);
 
 		// Set to default framebuffer
 		UnBind();
@@ -252,77 +390,270 @@ namespace Chroma
 		// meshes at grazing angles
 		if (GL_CONSERVATIVE_RASTERIZATION_NV)
 		{
-			CHROMA_INFO("Conservative Rasterization Supported!");
 			glEnable(GL_CONSERVATIVE_RASTERIZATION_NV);
 			glSubpixelPrecisionBiasNV(5,5);
 		}
+	}
+
+	void VXGIBuffer::EndVoxelization()
+	{
+		// Reset RenderState
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glEnable(GL_CULL_FACE);
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_BLEND);
+		if (GL_CONSERVATIVE_RASTERIZATION_NV)
+		{
+			glDisable(GL_CONSERVATIVE_RASTERIZATION_NV);
+		}
 
+		// Reset Viewport
+		Render::SetRenderViewport();
+	}
+
+	bool VXGIBuffer::ScrollClipmap(VoxelClipmap& clipmap, const glm::ivec3& newOrigin)
+	{
+		glm::ivec3 const delta = newOrigin - clipmap.origin;
+		if (clipmap.isValid && delta == glm::ivec3(0))
+			return false;
+
+		int const resolution = (int)m_VoxelGridTextureSize;
+		glm::ivec3 const oldOrigin = clipmap.origin;
+		clipmap.origin = newOrigin;
+		glm::ivec3 const newMax = newOrigin + glm::ivec3(resolution);
+
+		// nothing left to keep, rebuild the whole level
+		if (!clipmap.isValid || glm::any(glm::greaterThanEqual(glm::abs(delta), glm::ivec3(resolution))))
+		{
+			clipmap.bricks->FreeAll();
+			AllocateStaticRegion(clipmap, newOrigin, newMax);
+			VoxelizeStaticRegion(clipmap, newOrigin, newMax);
+			clipmap.isValid = true;
+			return true;
+		}
+
+		// one slab per axis moved along, overlapping corners are voxelized twice
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (delta[axis] == 0)
+				continue;
+
+			glm::ivec3 slabMin = newOrigin, slabMax = newMax;
+			if (delta[axis] > 0)
+				slabMin[axis] = oldOrigin[axis] + resolution;
+			else
+				slabMax[axis] = oldOrigin[axis];
+
+			// the slab's bricks wrap onto those of the slab scrolled out
+			FreeRegion(clipmap, slabMin, slabMax);
+			AllocateStaticRegion(clipmap, slabMin, slabMax);
+			VoxelizeStaticRegion(clipmap, slabMin, slabMax);
+		}
+		return true;
+	}
+
+	glm::ivec3 VXGIBuffer::GetToroidalBrick(const glm::ivec3& brick) const
+	{
+		int const numBricksPerAxis = (int)m_VoxelGridTextureSize / VXGI_BRICK_SIZE;
+		return ((brick % numBricksPerAxis) + numBricksPerAxis) % numBricksPerAxis;
+	}
+
+	void VXGIBuffer::FreeRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax)
+	{
+		// regions are brick aligned, origins snap to whole bricks
+		glm::ivec3 const brickMin = regionMin / VXGI_BRICK_SIZE, brickMax = regionMax / VXGI_BRICK_SIZE;
+		for (int z = brickMin.z; z < brickMax.z; z++)
+			for (int y = brickMin.y; y < brickMax.y; y++)
+				for (int x = brickMin.x; x < brickMax.x; x++)
+					clipmap.bricks->Free(GetToroidalBrick(glm::ivec3(x, y, z)));
+	}
 
-		// Texture
+	void VXGIBuffer::AllocateStaticRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax)
+	{
+		// bricks the region's static triangles touch, padded by a voxel for conservative rasterization
+		float const voxelWorldSize = GetVoxelWorldSize(clipmap);
+		m_Occupancy.Reset(glm::ivec3(glm::floor(glm::vec3(regionMin) / (float)VXGI_BRICK_SIZE)), glm::ivec3(glm::ceil(glm::vec3(regionMax) / (float)VXGI_BRICK_SIZE)), voxelWorldSize * VXGI_BRICK_SIZE);
+		m_Occupancy.SetPadding(voxelWorldSize);
+		for (const UID& uid : Scene::GetLitComponentUIDs())
+		{
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			if (!meshComponent->GetIsStatic())
+				continue;
+
+			// static meshes keep their CPU positions, boxes otherwise
+			if (!meshComponent->GetOccluderPositions().empty() && !meshComponent->GetIndices().empty())
+				m_Occupancy.AddMesh(meshComponent->GetOccluderPositions(), meshComponent->GetIndices(), meshComponent->GetWorldTransform());
+			else
+			{
+				std::pair<glm::vec3, glm::vec3> const bbox = GetWorldBBox(meshComponent);
+				m_Occupancy.AddBox(bbox.first, bbox.second);
+			}
+		}
+
+		for (glm::ivec3 const& brick : m_Occupancy.GetOccupiedBricks())
+			clipmap.bricks->Allocate(GetToroidalBrick(brick));
+	}
+
+	void VXGIBuffer::BindVoxelWriteTarget(VoxelBrickMap* brickMap)
+	{
+		// fragments look up their brick's pool slot before writing
+		brickMap->Upload();
+		glActiveTexture(GL_TEXTURE14);
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetIndirectionTexture());
+		m_VoxelShader.SetUniform("u_VoxelIndirection", 14);
+		glBindImageTexture(0, brickMap->GetPoolTexture(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+	}
+
+	void VXGIBuffer::UpdateBrickMapMips(VoxelBrickMap* brickMap)
+	{
+		//  !!! SLOW !!!
+		// Pool mips within each brick
+		brickMap->GenerateMipmaps();
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		// Coarse texels from each brick's last mip, a row of bricks per fragment
+		unsigned int const numBricksPerAxis = brickMap->GetNumBricksPerAxis();
+		m_BrickCoarseShader.Use();
+		m_BrickCoarseShader.SetUniform("scale", glm::vec2(1.0f));
+		m_BrickCoarseShader.SetUniform("offset", glm::vec2(0.0f));
+		m_BrickCoarseShader.SetUniform("u_VoxelGridResolution", (int)m_VoxelGridTextureSize);
 		glActiveTexture(GL_TEXTURE0);
-		m_Voxel3DTexture->Bind();
-		m_VoxelShader.SetUniform("u_VoxelTexture", 0);
-		glBindImageTexture(0, m_Voxel3DTexture->GetID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetIndirectionTexture());
+		m_BrickCoarseShader.SetUniform("u_VoxelIndirection", 0);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetPoolTexture());
+		m_BrickCoarseShader.SetUniform("u_VoxelTexture", 1);
+		glBindImageTexture(1, brickMap->GetCoarseTexture(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+		m_BrickCoarseShader.SetUniform("u_VoxelCoarseTexture", 1);
+
+		glViewport(0, 0, numBricksPerAxis, numBricksPerAxis);
+		RenderQuad();
+		glViewport(0, 0, m_VoxelGridTextureSize, m_VoxelGridTextureSize);
+
+		// Coarse mips, past the brick size
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+		glBindTexture(GL_TEXTURE_3D, brickMap->GetCoarseTexture());
+		glGenerateMipmap(GL_TEXTURE_3D);
+		glBindTexture(GL_TEXTURE_3D, 0);
+	}
 
-		// Render Scene
-		m_VoxelShader.SetUniform("lightSpaceMatrix", static_cast<ShadowBuffer*>(Render::GetShadowBuffer())->GetLightSpaceMatrix());
+	void VXGIBuffer::VoxelizeStaticRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax)
+	{
+		// Set voxel shader uniforms
+		UpdateVoxelShaderUniforms(m_VoxelShader, clipmap);
+		m_VoxelShader.SetUniform("u_VoxelRegionMin", glm::vec3(regionMin - clipmap.origin));
+		m_VoxelShader.SetUniform("u_VoxelRegionMax", glm::vec3(regionMax - clipmap.origin));
+		BindVoxelWriteTarget(clipmap.bricks);
+
+		// Render static meshes overlapping the region
+		glm::vec3 const regionMinWS = glm::vec3(regionMin) * GetVoxelWorldSize(clipmap);
+		glm::vec3 const regionMaxWS = glm::vec3(regionMax) * GetVoxelWorldSize(clipmap);
 		for (const UID& uid : Scene::GetLitComponentUIDs())
 		{
-			// SET UNIFORMS AND DRAW
 			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			if (!meshComponent->GetIsStatic() || meshComponent->GetIsStaticBatched())
+				continue;
 
-			// model transform
-			m_VoxelShader.SetUniform("model", meshComponent->GetWorldTransform());
+			std::pair<glm::vec3, glm::vec3> const bbox = GetWorldBBox(meshComponent);
+			if (glm::any(glm::lessThan(bbox.second, regionMinWS)) || glm::any(glm::greaterThan(bbox.first, regionMaxWS)))
+				continue;
 
-			// Shadowmap
-			glActiveTexture(GL_TEXTURE0 + meshComponent->GetMaterial().GetNumTextures() + 1);
-			m_VoxelShader.SetUniform("shadowmap", meshComponent->GetMaterial().GetNumTextures() + 1);
-			glBindTexture(GL_TEXTURE_2D_ARRAY, static_cast<ShadowBuffer*>(Chroma::Render::GetShadowBuffer())->GetTexture());
+			DrawVoxelizedMesh(meshComponent);
+		}
 
-			meshComponent->DrawUpdateMaterials(m_VoxelShader);
+		// Merged static batches, already in world space
+		m_VoxelShader.SetUniform("isSkinned", false);
+		StaticBatcher::DrawBatchesInBounds(m_VoxelShader, regionMinWS, regionMaxWS);
+	}
+
+	bool VXGIBuffer::VoxelizeDynamic()
+	{
+		// the dynamic layer only spans the finest level's window, cones leaving it
+		// see static geometry alone, so dynamic meshes further out are skipped
+		VoxelClipmap const& clipmap = m_Clipmaps[0];
+		glm::vec3 const windowMinWS = glm::vec3(clipmap.origin) * GetVoxelWorldSize(clipmap);
+		glm::vec3 const windowMaxWS = glm::vec3(clipmap.origin + glm::ivec3(m_VoxelGridTextureSize)) * GetVoxelWorldSize(clipmap);
+		std::vector<MeshComponent*> dynamicMeshes;
+		for (const UID& uid : Scene::GetLitComponentUIDs())
+		{
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			if (meshComponent->GetIsStatic())
+				continue;
+			std::pair<glm::vec3, glm::vec3> const bbox = GetWorldBBox(meshComponent);
+			if (glm::any(glm::lessThan(bbox.second, windowMinWS)) || glm::any(glm::greaterThan(bbox.first, windowMaxWS)))
+				continue;
+			dynamicMeshes.push_back(meshComponent);
 		}
 
-		//  !!! SLOW !!!
-		// Regenerate Voxel3DTexture MipMaps
-		glGenerateMipmap(GL_TEXTURE_3D);
+		// cleared once more after the last dynamic mesh is gone
+		bool const hasDynamicMeshes = !dynamicMeshes.empty();
+		if (!hasDynamicMeshes && !m_HasDynamicVoxels)
+			return false;
 
-		// Reset RenderState
-		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-		glEnable(GL_CULL_FACE);
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_BLEND);
-		if (GL_CONSERVATIVE_RASTERIZATION_NV)
+		m_DynamicBricks->FreeAll();
+		m_HasDynamicVoxels = hasDynamicMeshes;
+		if (!hasDynamicMeshes)
 		{
-			glDisable(GL_CONSERVATIVE_RASTERIZATION_NV);
+			m_DynamicBricks->Upload();
+			return true;
 		}
 
-		// Reset Viewport
-		glViewport(0, 0, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight());
+		// Bricks under dynamic mesh bounds, shares the finest level's window
+		glm::ivec3 const originBricks = clipmap.origin / VXGI_BRICK_SIZE;
+		m_Occupancy.Reset(originBricks, originBricks + glm::ivec3(m_DynamicBricks->GetNumBricksPerAxis()), GetVoxelWorldSize(clipmap) * VXGI_BRICK_SIZE);
+		m_Occupancy.SetPadding(GetVoxelWorldSize(clipmap));
+		for (MeshComponent* meshComponent : dynamicMeshes)
+		{
+			std::pair<glm::vec3, glm::vec3> const bbox = GetWorldBBox(meshComponent);
+			m_Occupancy.AddBox(bbox.first, bbox.second);
+		}
+		for (glm::ivec3 const& brick : m_Occupancy.GetOccupiedBricks())
+			m_DynamicBricks->Allocate(GetToroidalBrick(brick));
 
+		// Set voxel shader uniforms
+		UpdateVoxelShaderUniforms(m_VoxelShader, clipmap);
+		m_VoxelShader.SetUniform("u_VoxelRegionMin", glm::vec3(0.0f));
+		m_VoxelShader.SetUniform("u_VoxelRegionMax", glm::vec3((float)m_VoxelGridTextureSize));
+		BindVoxelWriteTarget(m_DynamicBricks);
 
+		for (MeshComponent* meshComponent : dynamicMeshes)
+			DrawVoxelizedMesh(meshComponent);
+		return true;
 	}
 
-	bool VXGIBuffer::OnCameraMoved(CameraMovedEvent& e)
+	void VXGIBuffer::DrawVoxelizedMesh(MeshComponent* meshComponent)
 	{
-		// Calculate Voxel Grid Centroid and Size based on Camera Frustum
-		// Collect Shadow Cascade BBox Data
-		for (const float& distance : static_cast<ShadowBuffer*>(Render::GetShadowBuffer())->m_CascadeSplitDistances)
-			CHROMA_INFO("Distance : {0}", distance);
+		// model transform
+		m_VoxelShader.SetUniform("model", meshComponent->GetWorldTransform());
+		meshComponent->DrawUpdateMaterials(m_VoxelShader);
+	}
 
-		Camera* renderCam = Scene::GetRenderCamera();
-		glm::vec3 startPos = renderCam->GetPosition() + (renderCam->GetDirection() * renderCam->GetNearDist());
-		glm::vec3 endPos = renderCam->GetPosition() + (renderCam->GetDirection() * static_cast<ShadowBuffer*>(Render::GetShadowBuffer())->m_CascadeSplitDistances[0]);
+	std::pair<glm::vec3, glm::vec3> VXGIBuffer::GetWorldBBox(MeshComponent* meshComponent)
+	{
+		// local box corners through the world transform
+		std::pair<glm::vec3, glm::vec3> const localBBox = meshComponent->GetLocalBBox();
+		glm::mat4 const worldTransform = meshComponent->GetWorldTransform();
+		glm::vec3 bboxMin(std::numeric_limits<float>::max()), bboxMax(-std::numeric_limits<float>::max());
+		for (int i = 0; i < 8; i++)
+		{
+			glm::vec3 const corner(i & 1 ? localBBox.second.x : localBBox.first.x, i & 2 ? localBBox.second.y : localBBox.first.y, i & 4 ? localBBox.second.z : localBBox.first.z);
+			glm::vec3 const cornerWS = glm::vec3(worldTransform * glm::vec4(corner, 1.0f));
+			bboxMin = glm::min(bboxMin, cornerWS);
+			bboxMax = glm::max(bboxMax, cornerWS);
+		}
+		return std::make_pair(bboxMin, bboxMax);
+	}
 
-		// Calculate camera frustum center
-		//glm::vec3 nearGrid = renderCam->GetPosition() + (renderCam->GetDirection() * glm::vec3(renderCam->GetNearDist() * 3.0));
-		glm::vec3 farGrid = renderCam->GetPosition() + (renderCam->GetDirection() * glm::vec3(m_VoxelGridWSSize*2.0f));
+	bool VXGIBuffer::OnCameraMoved(CameraMovedEvent& e)
+	{
+		// Clipmaps are centered on the camera, each level scrolls once it
+		// moves a full granularity step, rotating never revoxelizes
+		glm::vec3 const cameraPosition = Scene::GetRenderCamera()->GetPosition();
 
 		// Update Grid Centroid
-		m_VoxelGridMovedThisFrame = glm::distance2(farGrid, m_VoxelGridCentroid) > 0.0f;
-
-		m_VoxelGridCentroid = farGrid;
+		m_VoxelGridMovedThisFrame = glm::distance2(cameraPosition, m_VoxelGridCentroid) > 0.0f;
 
-		//CHROMA_INFO(e.GetPosition().x);
+		m_VoxelGridCentroid = cameraPosition;
 		return true;
 	}
 }
@@ -1,13 +1,26 @@
 #ifndef CHROMA_VXGIBUFFER_H
 #define CHROMA_VXGIBUFFER_H
 
+#include <ChromaConfig.h>
 #include "buffer/IFramebuffer.h"
-#include "texture/Texture3D.h"
+#include "texture/VoxelBrickMap.h"
+#include "geometry/VoxelOccupancy.h"
 #include "model/BoxPrimitive.h"
 
 namespace Chroma
 {
 	class CameraMovedEvent;
+	class MeshComponent;
+
+	// One level of the voxel clipmap, addressed toroidally so the grid scrolls
+	// without moving bricks, origin is the level's minimum corner in voxels
+	struct VoxelClipmap
+	{
+		VoxelBrickMap* bricks{ nullptr };
+		glm::ivec3 origin{ 0 };
+		float gridSize{ 0.0f };
+		bool isValid{ false };
+	};
 
 	class VXGIBuffer : public IFramebuffer
 	{
@@ -18,12 +31,21 @@ namespace Chroma
 		virtual void BindAndClear() override;
 		virtual void Draw() override;
 		void Draw(const bool& visualizeVoxelization);
+		bool GetIsReady() override { return m_VoxelShader.GetIsReady() && m_VoxelConeTracing.GetIsReady() && m_VoxelVisualizationShader.GetIsReady() && m_BrickCoarseShader.GetIsReady(); };
 
 		void SetVoxelGridWSSize(const float& newSize) { m_VoxelGridWSSize = newSize;  UpdateVoxelGridSize(); }
 		void SetVoxelGridCenter(const glm::vec3& newCenter) { m_VoxelGridCentroid = newCenter; };
 		std::pair<glm::vec3, glm::vec3> GetVoxelGridHalfExtents();
 
+		// scrolls the static clipmaps voxelizing only newly exposed slabs, and
+		// revoxelizes the dynamic layer
 		void Voxelize();
+		// static voxels are rebuilt from scratch on the next voxelization, lighting changed
+		void InvalidateVoxels();
+
+		// sparse storage stats, all levels and the dynamic layer
+		unsigned int GetNumAllocatedBricks() const;
+		size_t GetVoxelMemoryUsage() const;
 
 		// events
 		bool OnCameraMoved(CameraMovedEvent& e);
@@ -33,8 +55,13 @@ namespace Chroma
 		virtual void ResizeBuffers() override;
 		virtual void Init() override;
 
-		Texture3D* m_Voxel3DTexture;
-		const unsigned int m_VoxelGridTextureSize{ 128 };
+		// static geometry, finest level first
+		std::vector<VoxelClipmap> m_Clipmaps;
+		// non static meshes, revoxelized every frame in the finest level's window only,
+		// coarser levels hold static geometry alone
+		VoxelBrickMap* m_DynamicBricks{ nullptr };
+		bool m_HasDynamicVoxels{ false };
+		const unsigned int m_VoxelGridTextureSize{ VXGI_CLIPMAP_RESOLUTION };
 		void SetupVoxelVisualizationVAO();
 
 	private: // voxelization
@@ -42,15 +69,43 @@ namespace Chroma
 		float m_VoxelGridWSSize{ 8.5f };
 		float m_VoxelGridSize{ 0.0390625f };
 		glm::vec3 m_VoxelGridCentroid{ 0.0f };
-		void UpdateVoxelGridSize() { m_VoxelGridSize = m_VoxelGridWSSize / (float)m_VoxelGridTextureSize; }
-		void UpdateVoxelShaderUniforms(Shader& shader);
+		void UpdateVoxelGridSize();
+		void UpdateVoxelShaderUniforms(Shader& shader, const VoxelClipmap& clipmap);
+		void UpdateClipmapUniforms(Shader& shader, const unsigned int& firstTextureUnit);
+		void BindBrickMap(Shader& shader, const std::string& prefix, const std::string& index, VoxelBrickMap* brickMap, const unsigned int& firstTextureUnit);
 		bool m_VoxelGridMovedThisFrame{ false };
 
+		// voxel space, a voxel spans two grid sizes
+		float GetVoxelWorldSize(const VoxelClipmap& clipmap) const { return clipmap.gridSize * 2.0f; }
+		glm::vec3 GetClipmapCentroid(const VoxelClipmap& clipmap) const;
+		glm::vec3 GetClipmapOffset(const VoxelClipmap& clipmap) const;
+		glm::ivec3 GetSnappedOrigin(const VoxelClipmap& clipmap) const;
+
+		// incremental voxelization
+		void BeginVoxelization();
+		void EndVoxelization();
+		bool ScrollClipmap(VoxelClipmap& clipmap, const glm::ivec3& newOrigin);
+		void VoxelizeStaticRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax);
+		bool VoxelizeDynamic();
+		void BindVoxelWriteTarget(VoxelBrickMap* brickMap);
+
+		// sparse bricks, regions in voxels
+		VoxelOccupancy m_Occupancy;
+		Shader m_BrickCoarseShader{ "resources/shaders/fragVoxelBrickCoarse.glsl", "resources/shaders/frameBufferVertex.glsl" };
+		glm::ivec3 GetToroidalBrick(const glm::ivec3& brick) const;
+		void FreeRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax);
+		void AllocateStaticRegion(const VoxelClipmap& clipmap, const glm::ivec3& regionMin, const glm::ivec3& regionMax);
+		void UpdateBrickMapMips(VoxelBrickMap* brickMap);
+		void DrawVoxelizedMesh(MeshComponent* meshComponent);
+		static std::pair<glm::vec3, glm::vec3> GetWorldBBox(MeshComponent* meshComponent);
+
 	private: // voxel visualization
 		Shader m_VoxelVisualizationShader{ "resources/shaders/fragVoxelVisualization.glsl" , "resources/shaders/vtxVoxelVisualization.glsl", "resources/shaders/geomVoxelVisualization.glsl" };
+		// one instance per allocated brick, a point per voxel within it
 		unsigned int m_VoxelVisualizationVAO{ 0 };
-		const unsigned int m_NumVoxels{ m_VoxelGridTextureSize * m_VoxelGridTextureSize * m_VoxelGridTextureSize };
+		unsigned int m_VoxelVisualizationVBO{ 0 };
 		void DrawVoxelVisualization();
+		void DrawBrickVisualization(VoxelBrickMap* brickMap, const VoxelClipmap& clipmap);
 
 	private: // cone tracing
 		Shader m_VoxelConeTracing{ "resources/shaders/voxelConeTracing.glsl", "resources/shaders/frameBufferVertex.glsl"};
@@ -0,0 +1,297 @@
+#include "OcclusionCuller.h"
+#include <jobsystem/JobSystem.h>
+
+// SSE
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+static_assert(OCCLUSION_TILE_WIDTH % 4 == 0, "Occlusion tiles are rasterized 4 pixels at a time");
+
+namespace Chroma
+{
+	void OcclusionCuller::BeginFrame(glm::mat4 const& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+
+		// clear occluders
+		m_Triangles.clear();
+		for (std::vector<unsigned int>& tileBin : m_TileBins)
+			tileBin.clear();
+
+		// clear depth to far plane
+		std::fill(m_HiZ[0].depth.begin(), m_HiZ[0].depth.end(), 1.0f);
+	}
+
+	void OcclusionCuller::AddOccluder(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, glm::mat4 const& modelTransform)
+	{
+		// transform to clip space
+		glm::mat4 modelViewProjection = m_ViewProjection * modelTransform;
+		m_ClipPositions.resize(positions.size());
+		for (unsigned int i = 0; i < positions.size(); i++)
+			m_ClipPositions[i] = modelViewProjection * glm::vec4(positions[i], 1.0f);
+
+		// collect triangles
+		for (unsigned int i = 0; i + 2 < indices.size(); i += 3)
+		{
+			glm::vec4 const& c0 = m_ClipPositions[indices[i]];
+			glm::vec4 const& c1 = m_ClipPositions[indices[i + 1]];
+			glm::vec4 const& c2 = m_ClipPositions[indices[i + 2]];
+
+			// triangles crossing the near plane are dropped rather than clipped,
+			// dropping an occluder can only ever make the result more conservative
+			if (c0.z < -c0.w || c1.z < -c1.w || c2.z < -c2.w)
+				continue;
+
+			// trivially reject triangles fully outside one of the side planes
+			if ((c0.x > c0.w && c1.x > c1.w && c2.x > c2.w) || (c0.x < -c0.w && c1.x < -c1.w && c2.x < -c2.w))
+				continue;
+			if ((c0.y > c0.w && c1.y > c1.w && c2.y > c2.w) || (c0.y < -c0.w && c1.y < -c1.w && c2.y < -c2.w))
+				continue;
+
+			ScreenTriangle triangle;
+			triangle.v0 = ClipToScreen(c0);
+			triangle.v1 = ClipToScreen(c1);
+			triangle.v2 = ClipToScreen(c2);
+
+			m_Triangles.push_back(triangle);
+			BinTriangle((unsigned int)m_Triangles.size() - 1);
+		}
+	}
+
+	void OcclusionCuller::RasterizeOccluders()
+	{
+		if (m_Triangles.empty())
+		{
+			BuildHiZ();
+			return;
+		}
+
+		// each tile is owned by a single job, only the tiles are waited on
+		unsigned int numTiles = m_NumTilesX * m_NumTilesY;
+		JobCounter tileCounter;
+		Chroma::JobSystem::Dispatch(numTiles, 1, [this](JobDispatchArgs args) {
+			RasterizeTile(args.jobIndex);
+		}, tileCounter);
+		Chroma::JobSystem::Wait(tileCounter);
+
+		// build hierarchical depth
+		BuildHiZ();
+	}
+
+	bool OcclusionCuller::IsVisible(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::mat4 const& modelTransform) const
+	{
+		glm::mat4 modelViewProjection = m_ViewProjection * modelTransform;
+
+		// project bbox corners, collecting screen rect and nearest depth
+		glm::vec2 screenMin(std::numeric_limits<float>::max());
+		glm::vec2 screenMax(-std::numeric_limits<float>::max());
+		float nearestDepth{ std::numeric_limits<float>::max() };
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			glm::vec3 corner(i & 1 ? bboxMax.x : bboxMin.x, i & 2 ? bboxMax.y : bboxMin.y, i & 4 ? bboxMax.z : bboxMin.z);
+			glm::vec4 clipPosition = modelViewProjection * glm::vec4(corner, 1.0f);
+
+			// bounds cross the near plane, treat as visible
+			if (clipPosition.z < -clipPosition.w || clipPosition.w <= 0.0f)
+				return true;
+
+			glm::vec3 screenPosition = ClipToScreen(clipPosition);
+			screenMin = glm::min(screenMin, glm::vec2(screenPosition));
+			screenMax = glm::max(screenMax, glm::vec2(screenPosition));
+			nearestDepth = glm::min(nearestDepth, screenPosition.z);
+		}
+
+		// outside of the view
+		if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= (float)m_Width || screenMin.y >= (float)m_Height || nearestDepth > 1.0f)
+			return false;
+
+		// covered pixel rect
+		int minX = glm::clamp((int)screenMin.x, 0, (int)m_Width - 1);
+		int minY = glm::clamp((int)screenMin.y, 0, (int)m_Height - 1);
+		int maxX = glm::clamp((int)screenMax.x, 0, (int)m_Width - 1);
+		int maxY = glm::clamp((int)screenMax.y, 0, (int)m_Height - 1);
+
+		// pick the finest level where the rect covers at most 4x4 texels
+		unsigned int level{ 0 };
+		while (level + 1 < m_HiZ.size() && ((maxX >> level) - (minX >> level) > 3 || (maxY >> level) - (minY >> level) > 3))
+			level++;
+
+		// visible if any texel holds occluder depth further than the bounds
+		HiZLevel const& hiZ = m_HiZ[level];
+		for (int y = minY >> level; y <= (maxY >> level); y++)
+			for (int x = minX >> level; x <= (maxX >> level); x++)
+				if (hiZ.depth[y * hiZ.width + x] >= nearestDepth)
+					return true;
+
+		return false;
+	}
+
+	float OcclusionCuller::GetHiZDepth(unsigned int const& level, unsigned int const& x, unsigned int const& y) const
+	{
+		HiZLevel const& hiZ = m_HiZ[level];
+		return hiZ.depth[glm::min(y, hiZ.height - 1) * hiZ.width + glm::min(x, hiZ.width - 1)];
+	}
+
+	void OcclusionCuller::BinTriangle(unsigned int const& triangleIndex)
+	{
+		ScreenTriangle const& triangle = m_Triangles[triangleIndex];
+
+		// pixel bounds
+		float minX = glm::min(triangle.v0.x, glm::min(triangle.v1.x, triangle.v2.x));
+		float minY = glm::min(triangle.v0.y, glm::min(triangle.v1.y, triangle.v2.y));
+		float maxX = glm::max(triangle.v0.x, glm::max(triangle.v1.x, triangle.v2.x));
+		float maxY = glm::max(triangle.v0.y, glm::max(triangle.v1.y, triangle.v2.y));
+		if (maxX < 0.0f || maxY < 0.0f || minX >= (float)m_Width || minY >= (float)m_Height)
+			return;
+
+		// overlapped tiles
+		int tileMinX = glm::clamp((int)minX / OCCLUSION_TILE_WIDTH, 0, (int)m_NumTilesX - 1);
+		int tileMinY = glm::clamp((int)minY / OCCLUSION_TILE_HEIGHT, 0, (int)m_NumTilesY - 1);
+		int tileMaxX = glm::clamp((int)maxX / OCCLUSION_TILE_WIDTH, 0, (int)m_NumTilesX - 1);
+		int tileMaxY = glm::clamp((int)maxY / OCCLUSION_TILE_HEIGHT, 0, (int)m_NumTilesY - 1);
+
+		for (int tileY = tileMinY; tileY <= tileMaxY; tileY++)
+			for (int tileX = tileMinX; tileX <= tileMaxX; tileX++)
+				m_TileBins[tileY * m_NumTilesX + tileX].push_back(triangleIndex);
+	}
+
+	void OcclusionCuller::RasterizeTile(unsigned int const& tileIndex)
+	{
+		// tile pixel bounds, exclusive max
+		int tileX0 = (tileIndex % m_NumTilesX) * OCCLUSION_TILE_WIDTH;
+		int tileY0 = (tileIndex / m_NumTilesX) * OCCLUSION_TILE_HEIGHT;
+		int tileX1 = tileX0 + OCCLUSION_TILE_WIDTH;
+		int tileY1 = tileY0 + OCCLUSION_TILE_HEIGHT;
+
+		float* depthBuffer = m_HiZ[0].depth.data();
+		const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero = _mm_setzero_ps();
+
+		// triangles are processed in submission order, keeping the result deterministic
+		for (unsigned int const& triangleIndex : m_TileBins[tileIndex])
+		{
+			ScreenTriangle const& triangle = m_Triangles[triangleIndex];
+			glm::vec3 v0 = triangle.v0;
+			glm::vec3 v1 = triangle.v1;
+			glm::vec3 v2 = triangle.v2;
+
+			// occluders are rasterized regardless of winding
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+			if (glm::abs(area) < 1e-6f)
+				continue;
+			if (area < 0.0f)
+			{
+				std::swap(v1, v2);
+				area = -area;
+			}
+
+			// edge functions E(x, y) = A * x + B * y + C, positive inside
+			float A0 = v1.y - v2.y, B0 = v2.x - v1.x, C0 = v1.x * v2.y - v1.y * v2.x;
+			float A1 = v2.y - v0.y, B1 = v0.x - v2.x, C1 = v2.x * v0.y - v2.y * v0.x;
+			float A2 = v0.y - v1.y, B2 = v1.x - v0.x, C2 = v0.x * v1.y - v0.y * v1.x;
+
+			// depth plane z(x, y) = ZA * x + ZB * y + ZC
+			float inverseArea = 1.0f / area;
+			float ZA = (A1 * (v1.z - v0.z) + A2 * (v2.z - v0.z)) * inverseArea;
+			float ZB = (B1 * (v1.z - v0.z) + B2 * (v2.z - v0.z)) * inverseArea;
+			float ZC = v0.z + (C1 * (v1.z - v0.z) + C2 * (v2.z - v0.z)) * inverseArea;
+
+			// pixel bounds clipped to tile, x aligned to the SIMD width
+			int minX = glm::max((int)glm::floor(glm::min(v0.x, glm::min(v1.x, v2.x))), tileX0) & ~3;
+			int minY = glm::max((int)glm::floor(glm::min(v0.y, glm::min(v1.y, v2.y))), tileY0);
+			int maxX = glm::min((int)glm::ceil(glm::max(v0.x, glm::max(v1.x, v2.x))), tileX1);
+			int maxY = glm::min((int)glm::ceil(glm::max(v0.y, glm::max(v1.y, v2.y))), tileY1);
+			minX = glm::max(minX, tileX0);
+
+			const __m128 A0x4 = _mm_set1_ps(A0), A1x4 = _mm_set1_ps(A1), A2x4 = _mm_set1_ps(A2);
+			const __m128 ZAx4 = _mm_set1_ps(ZA);
+
+			for (int y = minY; y < maxY; y++)
+			{
+				float pixelY = (float)y + 0.5f;
+				const __m128 rowE0 = _mm_set1_ps(B0 * pixelY + C0);
+				const __m128 rowE1 = _mm_set1_ps(B1 * pixelY + C1);
+				const __m128 rowE2 = _mm_set1_ps(B2 * pixelY + C2);
+				const __m128 rowZ = _mm_set1_ps(ZB * pixelY + ZC);
+				float* depthRow = depthBuffer + y * m_Width;
+
+				for (int x = minX; x < maxX; x += 4)
+				{
+					__m128 pixelX = _mm_add_ps(_mm_set1_ps((float)x), pixelOffsets);
+
+					// coverage
+					__m128 e0 = _mm_add_ps(_mm_mul_ps(A0x4, pixelX), rowE0);
+					__m128 e1 = _mm_add_ps(_mm_mul_ps(A1x4, pixelX), rowE1);
+					__m128 e2 = _mm_add_ps(_mm_mul_ps(A2x4, pixelX), rowE2);
+					__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					// depth test, keeping the nearest occluder
+					__m128 depth = _mm_add_ps(_mm_mul_ps(ZAx4, pixelX), rowZ);
+					__m128 previousDepth = _mm_loadu_ps(depthRow + x);
+					__m128 nearestDepth = _mm_min_ps(previousDepth, depth);
+					_mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(inside, nearestDepth), _mm_andnot_ps(inside, previousDepth)));
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::BuildHiZ()
+	{
+		for (unsigned int level = 1; level < m_HiZ.size(); level++)
+		{
+			HiZLevel const& source = m_HiZ[level - 1];
+			HiZLevel& target = m_HiZ[level];
+
+			for (unsigned int y = 0; y < target.height; y++)
+			{
+				unsigned int sourceY0 = glm::min(y * 2, source.height - 1);
+				unsigned int sourceY1 = glm::min(y * 2 + 1, source.height - 1);
+				for (unsigned int x = 0; x < target.width; x++)
+				{
+					unsigned int sourceX0 = glm::min(x * 2, source.width - 1);
+					unsigned int sourceX1 = glm::min(x * 2 + 1, source.width - 1);
+
+					// furthest depth of the 2x2 footprint
+					float maxDepth = glm::max(
+						glm::max(source.depth[sourceY0 * source.width + sourceX0], source.depth[sourceY0 * source.width + sourceX1]),
+						glm::max(source.depth[sourceY1 * source.width + sourceX0], source.depth[sourceY1 * source.width + sourceX1]));
+					target.depth[y * target.width + x] = maxDepth;
+				}
+			}
+		}
+	}
+
+	glm::vec3 OcclusionCuller::ClipToScreen(glm::vec4 const& clipPosition) const
+	{
+		glm::vec3 ndc = glm::vec3(clipPosition) / clipPosition.w;
+		return glm::vec3((ndc.x * 0.5f + 0.5f) * (float)m_Width, (ndc.y * 0.5f + 0.5f) * (float)m_Height, ndc.z * 0.5f + 0.5f);
+	}
+
+	OcclusionCuller::OcclusionCuller(unsigned int const& width, unsigned int const& height)
+	{
+		// dimensions rounded up to whole tiles
+		m_NumTilesX = (width + OCCLUSION_TILE_WIDTH - 1) / OCCLUSION_TILE_WIDTH;
+		m_NumTilesY = (height + OCCLUSION_TILE_HEIGHT - 1) / OCCLUSION_TILE_HEIGHT;
+		m_Width = m_NumTilesX * OCCLUSION_TILE_WIDTH;
+		m_Height = m_NumTilesY * OCCLUSION_TILE_HEIGHT;
+		m_TileBins.resize(m_NumTilesX * m_NumTilesY);
+
+		// depth pyramid down to a single texel
+		unsigned int levelWidth{ m_Width }, levelHeight{ m_Height };
+		while (true)
+		{
+			HiZLevel level;
+			level.width = levelWidth;
+			level.height = levelHeight;
+			level.depth.resize(levelWidth * levelHeight, 1.0f);
+			m_HiZ.push_back(level);
+
+			if (levelWidth == 1 && levelHeight == 1)
+				break;
+			levelWidth = glm::max(1u, (levelWidth + 1) / 2);
+			levelHeight = glm::max(1u, (levelHeight + 1) / 2);
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef CHROMA_OCCLUSION_CULLER_H
+#define CHROMA_OCCLUSION_CULLER_H
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// Software occlusion culling.
+	// Marked occluder meshes are rasterized on the CPU into a low resolution depth buffer.
+	// The buffer is split into tiles which are rasterized in parallel on the JobSystem, 4 pixels
+	// at a time using SSE. A hierarchical max depth (HiZ) pyramid is built from the result and
+	// candidate bounds are tested against it before draw submission.
+	// No GPU resources are touched and each tile is owned by one job, so results are deterministic.
+	class OcclusionCuller
+	{
+	public:
+		// Frame
+		void BeginFrame(glm::mat4 const& viewProjection);
+		void AddOccluder(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, glm::mat4 const& modelTransform);
+		void RasterizeOccluders();
+
+		// Queries
+		bool IsVisible(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::mat4 const& modelTransform) const;
+		bool IsVisible(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax) const { return IsVisible(bboxMin, bboxMax, glm::mat4(1.0f)); }
+
+		// Accessors
+		inline bool GetHasOccluders() const { return !m_Triangles.empty(); }
+		inline unsigned int GetNumOccluderTriangles() const { return (unsigned int)m_Triangles.size(); }
+		inline unsigned int GetWidth() const { return m_Width; }
+		inline unsigned int GetHeight() const { return m_Height; }
+		inline unsigned int GetNumHiZLevels() const { return (unsigned int)m_HiZ.size(); }
+		float GetDepth(unsigned int const& x, unsigned int const& y) const { return GetHiZDepth(0, x, y); }
+		float GetHiZDepth(unsigned int const& level, unsigned int const& x, unsigned int const& y) const;
+
+		OcclusionCuller(unsigned int const& width = OCCLUSION_BUFFER_WIDTH, unsigned int const& height = OCCLUSION_BUFFER_HEIGHT);
+		~OcclusionCuller() = default;
+
+	private:
+		// screen space triangle, xy in pixels, z in 0-1 depth
+		struct ScreenTriangle
+		{
+			glm::vec3 v0, v1, v2;
+		};
+
+		// max depth pyramid level, level 0 is the rasterized depth buffer
+		struct HiZLevel
+		{
+			unsigned int width{ 0 };
+			unsigned int height{ 0 };
+			std::vector<float> depth;
+		};
+
+		// dimensions
+		unsigned int m_Width, m_Height;
+		unsigned int m_NumTilesX, m_NumTilesY;
+
+		// frame
+		glm::mat4 m_ViewProjection{ 1.0f };
+		std::vector<ScreenTriangle> m_Triangles;
+		std::vector<std::vector<unsigned int>> m_TileBins;
+		std::vector<glm::vec4> m_ClipPositions;
+
+		// depth
+		std::vector<HiZLevel> m_HiZ;
+
+		// functions
+		void BinTriangle(unsigned int const& triangleIndex);
+		void RasterizeTile(unsigned int const& tileIndex);
+		void BuildHiZ();
+		glm::vec3 ClipToScreen(glm::vec4 const& clipPosition) const;
+	};
+}
+
+#endif
@@ -0,0 +1,284 @@
+#include "GeometryPool.h"
+
+
+namespace Chroma
+{
+	GeometryPool::Pool GeometryPool::m_Pools[2];
+	std::vector<glm::mat4> GeometryPool::m_DrawTransforms;
+	unsigned int GeometryPool::m_DrawIDBuffer{ 0 };
+	unsigned int GeometryPool::m_DrawDataBuffer{ 0 };
+	unsigned int GeometryPool::m_DrawDataTexture{ 0 };
+	unsigned int GeometryPool::m_IndirectBuffer{ 0 };
+
+	GeometryAllocation GeometryPool::Allocate(std::vector<ChromaPackedVertex> const& vertices, std::vector<unsigned int> const& indices, GLenum const& indexType)
+	{
+		GeometryAllocation allocation;
+		if (vertices.empty() || indices.empty())
+			return allocation;
+
+		Pool& pool = GetPool(indexType);
+		allocation.indexType = pool.indexType;
+		allocation.vertexCount = (unsigned int)vertices.size();
+		allocation.indexCount = (unsigned int)indices.size();
+		allocation.baseVertex = AllocateRange(pool.freeVertices, pool.vertexEnd, allocation.vertexCount);
+		allocation.firstIndex = AllocateRange(pool.freeIndices, pool.indexEnd, allocation.indexCount);
+
+		if (pool.VAO == 0 || pool.vertexEnd > pool.vertexCapacity || pool.indexEnd > pool.indexCapacity)
+			Grow(pool, pool.vertexEnd, pool.indexEnd);
+
+		// upload through the copy targets so no VAO element binding is disturbed
+		glBindBuffer(GL_COPY_WRITE_BUFFER, pool.VBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.baseVertex * sizeof(ChromaPackedVertex), vertices.size() * sizeof(ChromaPackedVertex), vertices.data());
+
+		const unsigned int indexSize = GetIndexSize(pool.indexType);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, pool.EBO);
+		if (pool.indexType == GL_UNSIGNED_SHORT)
+		{
+			std::vector<unsigned short> shortIndices(indices.begin(), indices.end());
+			glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.firstIndex * indexSize, shortIndices.size() * indexSize, shortIndices.data());
+		}
+		else
+			glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.firstIndex * indexSize, indices.size() * indexSize, indices.data());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		allocation.isValid = true;
+		return allocation;
+	}
+
+	void GeometryPool::Free(GeometryAllocation& allocation)
+	{
+		if (!allocation.isValid)
+			return;
+
+		Pool& pool = GetPool(allocation.indexType);
+		FreeRange(pool.freeVertices, pool.vertexEnd, allocation.baseVertex, allocation.vertexCount);
+		FreeRange(pool.freeIndices, pool.indexEnd, allocation.firstIndex, allocation.indexCount);
+		allocation = GeometryAllocation();
+	}
+
+	unsigned int GeometryPool::GetVAO(GLenum const& indexType)
+	{
+		return GetPool(indexType).VAO;
+	}
+
+	void GeometryPool::BeginDrawList()
+	{
+		m_DrawTransforms.clear();
+		for (Pool& pool : m_Pools)
+			pool.commands.clear();
+	}
+
+	bool GeometryPool::AddDraw(GeometryAllocation const& allocation, unsigned int const& firstIndex, unsigned int const& indexCount, glm::mat4 const& modelTransform)
+	{
+		if (!allocation.isValid || m_DrawTransforms.size() >= GEOMETRY_POOL_MAX_DRAWS)
+			return false;
+
+		// base instance selects the draw ID, and with it the transform
+		DrawElementsIndirectCommand command;
+		command.count = indexCount;
+		command.instanceCount = 1;
+		command.firstIndex = firstIndex;
+		command.baseVertex = (GLint)allocation.baseVertex;
+		command.baseInstance = (GLuint)m_DrawTransforms.size();
+		GetPool(allocation.indexType).commands.push_back(command);
+		m_DrawTransforms.push_back(modelTransform);
+		return true;
+	}
+
+	void GeometryPool::SubmitDrawList(Shader& shader)
+	{
+		if (m_DrawTransforms.empty())
+			return;
+
+		InitDrawBuffers();
+
+		// per draw data, orphaned every submit
+		glBindBuffer(GL_TEXTURE_BUFFER, m_DrawDataBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, GEOMETRY_POOL_MAX_DRAWS * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, m_DrawTransforms.size() * sizeof(glm::mat4), m_DrawTransforms.data());
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		shader.Use();
+		shader.SetUniform("isIndirect", true);
+		shader.SetUniform("drawData", GEOMETRY_POOL_DRAW_DATA_UNIT);
+		glActiveTexture(GL_TEXTURE0 + GEOMETRY_POOL_DRAW_DATA_UNIT);
+		glBindTexture(GL_TEXTURE_BUFFER, m_DrawDataTexture);
+
+		// one multi draw per pool
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+		for (Pool& pool : m_Pools)
+		{
+			if (pool.commands.empty())
+				continue;
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, pool.commands.size() * sizeof(DrawElementsIndirectCommand), pool.commands.data(), GL_STREAM_DRAW);
+			glBindVertexArray(pool.VAO);
+			glMultiDrawElementsIndirect(GL_TRIANGLES, pool.indexType, (void*)0, (GLsizei)pool.commands.size(), 0);
+		}
+		glBindVertexArray(0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+		// reset
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glActiveTexture(GL_TEXTURE0);
+		shader.SetUniform("isIndirect", false);
+	}
+
+	GeometryPool::Pool& GeometryPool::GetPool(GLenum const& indexType)
+	{
+		Pool& pool = indexType == GL_UNSIGNED_SHORT ? m_Pools[0] : m_Pools[1];
+		pool.indexType = indexType == GL_UNSIGNED_SHORT ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		return pool;
+	}
+
+	void GeometryPool::Grow(Pool& pool, unsigned int const& minVertexCapacity, unsigned int const& minIndexCapacity)
+	{
+		InitDrawBuffers();
+
+		unsigned int vertexCapacity = glm::max(pool.vertexCapacity, (unsigned int)GEOMETRY_POOL_INITIAL_VERTICES);
+		while (vertexCapacity < minVertexCapacity)
+			vertexCapacity *= 2;
+		unsigned int indexCapacity = glm::max(pool.indexCapacity, (unsigned int)GEOMETRY_POOL_INITIAL_INDICES);
+		while (indexCapacity < minIndexCapacity)
+			indexCapacity *= 2;
+		const unsigned int indexSize = GetIndexSize(pool.indexType);
+
+		// new storage, previous contents copied on the GPU
+		unsigned int VBO, EBO;
+		glGenBuffers(1, &VBO);
+		glGenBuffers(1, &EBO);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)vertexCapacity * sizeof(ChromaPackedVertex), nullptr, GL_STATIC_DRAW);
+		if (pool.VBO != 0)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, pool.VBO);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)pool.vertexCapacity * sizeof(ChromaPackedVertex));
+			glDeleteBuffers(1, &pool.VBO);
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)indexCapacity * indexSize, nullptr, GL_STATIC_DRAW);
+		if (pool.EBO != 0)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, pool.EBO);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)pool.indexCapacity * indexSize);
+			glDeleteBuffers(1, &pool.EBO);
+		}
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		pool.VBO = VBO;
+		pool.EBO = EBO;
+		pool.vertexCapacity = vertexCapacity;
+		pool.indexCapacity = indexCapacity;
+
+		// the VAO name is kept, meshes hold on to it
+		if (pool.VAO == 0)
+			glGenVertexArrays(1, &pool.VAO);
+		SetupVAO(pool);
+
+		CHROMA_INFO("GEOMETRY POOL :: {0} bit pool grown to {1} vertices, {2} indices.", indexSize * 8, vertexCapacity, indexCapacity);
+	}
+
+	void GeometryPool::SetupVAO(Pool& pool)
+	{
+		glBindVertexArray(pool.VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO);
+
+		// vertex positions
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaPackedVertex), (void*)0);
+		// vertex normals
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_normal));
+		// vertex uvs
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_texCoords));
+		// vertex tangents, w is the bitangent sign
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_tangent));
+		// vertex colors // is at the 7th index as 5 and 6 are used for skinning
+		glEnableVertexAttribArray(7);
+		glVertexAttribPointer(7, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_color));
+		// second UV set
+		glEnableVertexAttribArray(8);
+		glVertexAttribPointer(8, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_texCoords2));
+		// draw ID, advanced per instance so base instance picks it
+		glBindBuffer(GL_ARRAY_BUFFER, m_DrawIDBuffer);
+		glEnableVertexAttribArray(9);
+		glVertexAttribIPointer(9, 1, GL_UNSIGNED_INT, sizeof(unsigned int), (void*)0);
+		glVertexAttribDivisor(9, 1);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	unsigned int GeometryPool::AllocateRange(std::vector<Range>& freeRanges, unsigned int& end, unsigned int const& size)
+	{
+		// first fit from freed ranges, otherwise append
+		for (size_t i = 0; i < freeRanges.size(); i++)
+		{
+			if (freeRanges[i].size < size)
+				continue;
+			unsigned int offset = freeRanges[i].offset;
+			freeRanges[i].offset += size;
+			freeRanges[i].size -= size;
+			if (freeRanges[i].size == 0)
+				freeRanges.erase(freeRanges.begin() + i);
+			return offset;
+		}
+		unsigned int offset = end;
+		end += size;
+		return offset;
+	}
+
+	void GeometryPool::FreeRange(std::vector<Range>& freeRanges, unsigned int& end, unsigned int const& offset, unsigned int const& size)
+	{
+		// sorted insert, merging with neighbours
+		auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), offset, [](Range const& range, unsigned int const& value) { return range.offset < value; });
+		next = freeRanges.insert(next, Range{ offset, size });
+		if (next + 1 != freeRanges.end() && next->offset + next->size == (next + 1)->offset)
+		{
+			next->size += (next + 1)->size;
+			freeRanges.erase(next + 1);
+		}
+		if (next != freeRanges.begin() && (next - 1)->offset + (next - 1)->size == next->offset)
+		{
+			(next - 1)->size += next->size;
+			next = freeRanges.erase(next) - 1;
+		}
+
+		// trailing free space returns to the end
+		if (next->offset + next->size == end)
+		{
+			end = next->offset;
+			freeRanges.erase(next);
+		}
+	}
+
+	void GeometryPool::InitDrawBuffers()
+	{
+		if (m_DrawIDBuffer != 0)
+			return;
+
+		// static draw IDs
+		std::vector<unsigned int> drawIDs(GEOMETRY_POOL_MAX_DRAWS);
+		for (unsigned int i = 0; i < GEOMETRY_POOL_MAX_DRAWS; i++)
+			drawIDs[i] = i;
+		glGenBuffers(1, &m_DrawIDBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_DrawIDBuffer);
+		glBufferData(GL_ARRAY_BUFFER, drawIDs.size() * sizeof(unsigned int), drawIDs.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// model matrices, four RGBA32F texels per draw
+		glGenBuffers(1, &m_DrawDataBuffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_DrawDataBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, GEOMETRY_POOL_MAX_DRAWS * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+		glGenTextures(1, &m_DrawDataTexture);
+		glBindTexture(GL_TEXTURE_BUFFER, m_DrawDataTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_DrawDataBuffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		glGenBuffers(1, &m_IndirectBuffer);
+	}
+}
@@ -0,0 +1,87 @@
+#ifndef _CHROMA_GEOMETRY_POOL_
+#define _CHROMA_GEOMETRY_POOL_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <shader/Shader.h>
+#include <model/PackedVertex.h>
+
+namespace Chroma
+{
+	// Range of a mesh within a geometry pool, indices are relative to baseVertex
+	struct GeometryAllocation
+	{
+		bool isValid{ false };
+		GLenum indexType{ GL_UNSIGNED_INT };
+		unsigned int baseVertex{ 0 };
+		unsigned int vertexCount{ 0 };
+		unsigned int firstIndex{ 0 };
+		unsigned int indexCount{ 0 };
+	};
+
+	// Static meshes sharing the packed vertex format are sub-allocated from one large
+	// vertex and index buffer per index type, served by a single VAO each.
+	// Draws can be gathered into a list and submitted with glMultiDrawElementsIndirect,
+	// the per draw model matrix is fetched in the vertex shader through aDrawID.
+	class GeometryPool
+	{
+	public:
+		// Allocation
+		static GeometryAllocation Allocate(std::vector<ChromaPackedVertex> const& vertices, std::vector<unsigned int> const& indices, GLenum const& indexType);
+		static void Free(GeometryAllocation& allocation);
+		static unsigned int GetVAO(GLenum const& indexType);
+
+		// Indirect submission
+		static void BeginDrawList();
+		static bool AddDraw(GeometryAllocation const& allocation, unsigned int const& firstIndex, unsigned int const& indexCount, glm::mat4 const& modelTransform);
+		static void SubmitDrawList(Shader& shader);
+		static unsigned int GetNumDraws() { return (unsigned int)m_DrawTransforms.size(); }
+
+	private:
+		// layout expected by GL_DRAW_INDIRECT_BUFFER
+		struct DrawElementsIndirectCommand
+		{
+			GLuint count;
+			GLuint instanceCount;
+			GLuint firstIndex;
+			GLint baseVertex;
+			GLuint baseInstance;
+		};
+
+		struct Range
+		{
+			unsigned int offset;
+			unsigned int size;
+		};
+
+		struct Pool
+		{
+			GLenum indexType{ GL_UNSIGNED_INT };
+			unsigned int VAO{ 0 }, VBO{ 0 }, EBO{ 0 };
+			unsigned int vertexCapacity{ 0 }, indexCapacity{ 0 };
+			unsigned int vertexEnd{ 0 }, indexEnd{ 0 };
+			std::vector<Range> freeVertices, freeIndices;
+			std::vector<DrawElementsIndirectCommand> commands;
+		};
+
+		// pools
+		static Pool m_Pools[2];
+		static Pool& GetPool(GLenum const& indexType);
+		static unsigned int GetIndexSize(GLenum const& indexType) { return indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int); }
+		static void Grow(Pool& pool, unsigned int const& minVertexCapacity, unsigned int const& minIndexCapacity);
+		static void SetupVAO(Pool& pool);
+		static unsigned int AllocateRange(std::vector<Range>& freeRanges, unsigned int& end, unsigned int const& size);
+		static void FreeRange(std::vector<Range>& freeRanges, unsigned int& end, unsigned int const& offset, unsigned int const& size);
+
+		// draw list
+		static std::vector<glm::mat4> m_DrawTransforms;
+		static unsigned int m_DrawIDBuffer;
+		static unsigned int m_DrawDataBuffer, m_DrawDataTexture;
+		static unsigned int m_IndirectBuffer;
+		static void InitDrawBuffers();
+	};
+}
+
+#endif
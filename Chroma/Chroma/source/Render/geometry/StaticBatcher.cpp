@@ -0,0 +1,277 @@
+#include "StaticBatcher.h"
+#include <scene/Scene.h>
+#include <component/MeshComponent.h>
+#include <model/PackedVertex.h>
+#include <resources/TextureStreamer.h>
+
+
+namespace Chroma
+{
+	std::vector<UID> StaticBatcher::m_PendingUIDs;
+	std::set<UID> StaticBatcher::m_BatchedUIDs;
+	std::vector<StaticBatch> StaticBatcher::m_Batches;
+	unsigned int StaticBatcher::m_NumDrawnBatches{ 0 };
+
+	void StaticBatcher::CollectStaticMeshes()
+	{
+		m_PendingUIDs.clear();
+		for (UID const& uid : Scene::GetLitComponentUIDs())
+		{
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			if (GetIsMeshBatchable(meshComponent))
+				m_PendingUIDs.push_back(uid);
+		}
+
+		if (!m_PendingUIDs.empty())
+			CHROMA_INFO("STATIC BATCHER :: Collected {0} static meshes.", m_PendingUIDs.size());
+	}
+
+	void StaticBatcher::Update()
+	{
+		if (m_PendingUIDs.empty())
+			return;
+
+		// meshes load asynchronously, batch once every one of them has arrived or failed
+		for (UID const& uid : m_PendingUIDs)
+		{
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			if (meshComponent != nullptr && !meshComponent->GetMeshLoaded() && !meshComponent->GetMeshLoadFailed())
+				return;
+		}
+
+		BuildBatches();
+		m_PendingUIDs.clear();
+	}
+
+	void StaticBatcher::Clear()
+	{
+		for (StaticBatch& batch : m_Batches)
+			GeometryPool::Free(batch.allocation);
+		m_Batches.clear();
+		m_BatchedUIDs.clear();
+		m_PendingUIDs.clear();
+		m_NumDrawnBatches = 0;
+	}
+
+	void StaticBatcher::DrawBatches(std::function<Shader&(unsigned int const&)> const& useShaderVariant, Camera& renderCam)
+	{
+		m_NumDrawnBatches = 0;
+		for (StaticBatch& batch : m_Batches)
+		{
+			if (!GetIsInFrustum(renderCam.GetViewProjMatrix(), batch.bboxMin, batch.bboxMax, true))
+				continue;
+
+			// merged meshes share the material, the batch bounds are a conservative size for its mips
+			TextureStreamer::RequestMaterial(batch.material, TextureStreamer::GetScreenSize(renderCam, (batch.bboxMin + batch.bboxMax) * 0.5f, glm::length(batch.bboxMax - batch.bboxMin) * 0.5f));
+
+			// variant for the batch's material
+			Shader& shader = useShaderVariant(batch.material.GetShaderKeywords());
+			shader.SetUniform("model", glm::mat4(1.0f));
+			batch.material.SetMaterialUniforms(shader);
+			batch.material.SetTextureUniforms(shader);
+			if (batch.material.GetIsDoubleSided())
+			{
+				glDisable(GL_CULL_FACE);
+				DrawBatch(batch);
+				glEnable(GL_CULL_FACE);
+			}
+			else
+				DrawBatch(batch);
+			m_NumDrawnBatches++;
+		}
+	}
+
+	void StaticBatcher::AddShadowDraws(Shader& shader, glm::mat4 const& lightSpaceMatrix)
+	{
+		for (StaticBatch& batch : m_Batches)
+		{
+			// depth is clamped in the shadow pass, only the cascade sides cull
+			if (!batch.material.GetCastsShadows() || !GetIsInFrustum(lightSpaceMatrix, batch.bboxMin, batch.bboxMax, false))
+				continue;
+
+			// world space already, drawn directly if the draw list is full
+			if (!GeometryPool::AddDraw(batch.allocation, batch.allocation.firstIndex, batch.allocation.indexCount, glm::mat4(1.0f)))
+			{
+				shader.Use();
+				shader.SetUniform("model", glm::mat4(1.0f));
+				DrawBatch(batch);
+			}
+		}
+	}
+
+	void StaticBatcher::DrawBatchesInBounds(Shader& shader, glm::vec3 const& bboxMin, glm::vec3 const& bboxMax)
+	{
+		for (StaticBatch& batch : m_Batches)
+		{
+			if (glm::any(glm::lessThan(batch.bboxMax, bboxMin)) || glm::any(glm::greaterThan(batch.bboxMin, bboxMax)))
+				continue;
+
+			shader.SetUniform("model", glm::mat4(1.0f));
+			batch.material.SetMaterialUniforms(shader);
+			batch.material.SetTextureUniforms(shader);
+			DrawBatch(batch);
+		}
+	}
+
+	void StaticBatcher::BuildBatches()
+	{
+		// group by material and chunk
+		std::map<std::string, std::vector<MeshComponent*>> groups;
+		for (UID const& uid : m_PendingUIDs)
+		{
+			MeshComponent* meshComponent = static_cast<MeshComponent*>(Scene::GetComponent(uid));
+			// failed loads and meshes already cleaned up by a draw before collection can't be merged
+			if (!GetIsMeshBatchable(meshComponent) || !meshComponent->GetMeshLoaded() || meshComponent->GetIndices().empty())
+				continue;
+
+			// meshes not yet drawn still update their colliders and occluder positions
+			if (!meshComponent->GetRenderBuffersInitialized())
+				meshComponent->SetupMesh();
+
+			glm::mat4 worldTransform = meshComponent->GetWorldTransform();
+			std::pair<glm::vec3, glm::vec3> bbox = meshComponent->GetLocalBBox();
+			glm::vec3 center = glm::vec3(worldTransform * glm::vec4((bbox.first + bbox.second) * 0.5f, 1.0f));
+			glm::ivec3 chunk = glm::ivec3(glm::floor(center / STATIC_BATCH_CHUNK_SIZE));
+
+			std::string key = BuildMaterialKey(meshComponent->GetMaterial()) + "|" + std::to_string(chunk.x) + "," + std::to_string(chunk.y) + "," + std::to_string(chunk.z);
+			groups[key].push_back(meshComponent);
+		}
+
+		unsigned int numMeshes{ 0 };
+		for (auto& group : groups)
+		{
+			std::vector<MeshComponent*>& meshComponents = group.second;
+			std::vector<ChromaPackedVertex> vertices;
+			std::vector<unsigned int> indices;
+			StaticBatch batch;
+			batch.material = meshComponents[0]->GetMaterial();
+			batch.bboxMin = glm::vec3(std::numeric_limits<float>::max());
+			batch.bboxMax = glm::vec3(-std::numeric_limits<float>::max());
+
+			auto flush = [&]()
+			{
+				if (indices.empty())
+					return;
+				batch.allocation = GeometryPool::Allocate(vertices, indices, vertices.size() <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT);
+				if (batch.allocation.isValid)
+					m_Batches.push_back(batch);
+				vertices.clear();
+				indices.clear();
+				batch.bboxMin = glm::vec3(std::numeric_limits<float>::max());
+				batch.bboxMax = glm::vec3(-std::numeric_limits<float>::max());
+				batch.numMeshes = 0;
+			};
+
+			for (MeshComponent* meshComponent : meshComponents)
+			{
+				std::vector<ChromaVertex> meshVertices = meshComponent->GetVertices();
+				std::vector<unsigned int>& meshIndices = meshComponent->GetIndices();
+				if (meshVertices.empty())
+					continue;
+
+				// chunks stay addressable by 16 bit indices where possible
+				if (!vertices.empty() && vertices.size() + meshVertices.size() > STATIC_BATCH_MAX_VERTICES)
+					flush();
+
+				// bake the world transform, mirrored transforms flip the winding
+				glm::mat4 worldTransform = meshComponent->GetWorldTransform();
+				glm::mat3 tangentTransform = glm::mat3(worldTransform);
+				glm::mat3 normalTransform = glm::transpose(glm::inverse(tangentTransform));
+				bool flipWinding = glm::determinant(tangentTransform) < 0.0f;
+
+				unsigned int baseVertex = (unsigned int)vertices.size();
+				for (ChromaVertex vertex : meshVertices)
+				{
+					vertex.m_position = glm::vec3(worldTransform * glm::vec4(vertex.m_position, 1.0f));
+					vertex.m_normal = normalTransform * vertex.m_normal;
+					vertex.m_tangent = tangentTransform * vertex.m_tangent;
+					vertex.m_bitangent = tangentTransform * vertex.m_bitangent;
+					batch.bboxMin = glm::min(batch.bboxMin, vertex.m_position);
+					batch.bboxMax = glm::max(batch.bboxMax, vertex.m_position);
+					vertices.push_back(VertexCompression::Pack(vertex));
+				}
+				for (size_t i = 0; i < meshIndices.size(); i += 3)
+				{
+					indices.push_back(baseVertex + meshIndices[i]);
+					indices.push_back(baseVertex + meshIndices[flipWinding ? i + 2 : i + 1]);
+					indices.push_back(baseVertex + meshIndices[flipWinding ? i + 1 : i + 2]);
+				}
+				batch.numMeshes++;
+
+				// the mesh is drawn through its batch from now on
+				m_BatchedUIDs.insert(meshComponent->GetUID());
+				meshComponent->SetIsStaticBatched(true);
+				meshComponent->CleanUp();
+				numMeshes++;
+			}
+			flush();
+		}
+
+		CHROMA_INFO("STATIC BATCHER :: Merged {0} static meshes into {1} batches.", numMeshes, m_Batches.size());
+	}
+
+	bool StaticBatcher::GetIsMeshBatchable(MeshComponent* meshComponent)
+	{
+		return meshComponent != nullptr && meshComponent->GetIsStatic() && !meshComponent->GetIsStaticBatched()
+			&& meshComponent->GetType() == Chroma::Type::Component::kStaticMeshComponent && !meshComponent->GetIsSkinned()
+			&& meshComponent->GetIsRenderable() && !meshComponent->GetIsTransparent() && !meshComponent->GetIsForwardLit();
+	}
+
+	std::string StaticBatcher::BuildMaterialKey(Material& material)
+	{
+		// materials are copied per mesh, compare what is uploaded for them
+		std::string key;
+		for (Texture& texture : material.GetTextureSet())
+			key += std::to_string((int)texture.GetType()) + ":" + texture.GetSourcePath() + ";";
+
+		glm::vec2 uvMultiply = material.GetUVMultiply();
+		key += "uv:" + std::to_string(uvMultiply.x) + "," + std::to_string(uvMultiply.y) + ";";
+		key += "flags:" + std::to_string(material.GetIsDoubleSided()) + std::to_string(material.GetCastsShadows()) + std::to_string(material.GetReceivesShadows())
+			+ std::to_string(material.GetUsesGameTime()) + std::to_string(material.GetUsesSceneNoise()) + ";";
+
+		UniformArray& uniforms = material.GetUniformArray();
+		for (auto const& uniform : uniforms.m_IntUniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second) + ";";
+		for (auto const& uniform : uniforms.m_UIntUniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second) + ";";
+		for (auto const& uniform : uniforms.m_FloatUniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second) + ";";
+		for (auto const& uniform : uniforms.m_Vec2Uniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second.x) + "," + std::to_string(uniform.second.y) + ";";
+		for (auto const& uniform : uniforms.m_Vec3Uniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second.x) + "," + std::to_string(uniform.second.y) + "," + std::to_string(uniform.second.z) + ";";
+		for (auto const& uniform : uniforms.m_Vec4Uniforms)
+			key += uniform.first + "=" + std::to_string(uniform.second.x) + "," + std::to_string(uniform.second.y) + "," + std::to_string(uniform.second.z) + "," + std::to_string(uniform.second.w) + ";";
+		for (auto const& uniform : uniforms.m_Mat4Uniforms)
+			for (unsigned int i = 0; i < 16; i++)
+				key += (i == 0 ? uniform.first + "=" : ",") + std::to_string(glm::value_ptr(uniform.second)[i]) + (i == 15 ? ";" : "");
+
+		return key;
+	}
+
+	bool StaticBatcher::GetIsInFrustum(glm::mat4 const& viewProjection, glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, bool const& testDepth)
+	{
+		// box against each clip plane, using the corner furthest along the plane normal
+		glm::vec4 rowW(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+		unsigned int numAxes = testDepth ? 3 : 2;
+		for (unsigned int axis = 0; axis < numAxes; axis++)
+		{
+			glm::vec4 row(viewProjection[0][axis], viewProjection[1][axis], viewProjection[2][axis], viewProjection[3][axis]);
+			for (glm::vec4 const& plane : { rowW + row, rowW - row })
+			{
+				glm::vec3 corner(plane.x >= 0.0f ? bboxMax.x : bboxMin.x, plane.y >= 0.0f ? bboxMax.y : bboxMin.y, plane.z >= 0.0f ? bboxMax.z : bboxMin.z);
+				if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void StaticBatcher::DrawBatch(StaticBatch const& batch)
+	{
+		glBindVertexArray(GeometryPool::GetVAO(batch.allocation.indexType));
+		unsigned int indexSize = batch.allocation.indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+		glDrawElementsBaseVertex(GL_TRIANGLES, batch.allocation.indexCount, batch.allocation.indexType, (void*)((size_t)batch.allocation.firstIndex * indexSize), (GLint)batch.allocation.baseVertex);
+		glBindVertexArray(0);
+	}
+}
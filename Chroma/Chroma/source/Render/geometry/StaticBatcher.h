@@ -0,0 +1,62 @@
+#ifndef _CHROMA_STATIC_BATCHER_
+#define _CHROMA_STATIC_BATCHER_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <uid/UID.h>
+#include <camera/Camera.h>
+#include <material/Material.h>
+#include <geometry/GeometryPool.h>
+
+namespace Chroma
+{
+	class MeshComponent;
+
+	// Merged static geometry of one material within one chunk, vertices are in world space
+	struct StaticBatch
+	{
+		GeometryAllocation allocation;
+		Material material;
+		glm::vec3 bboxMin{ 0.0f }, bboxMax{ 0.0f };
+		unsigned int numMeshes{ 0 };
+	};
+
+	// Opt-in static batching, meshes flagged static are collected after the scene is built.
+	// Once all are loaded, meshes sharing a material are merged per spatial chunk with their
+	// world transforms baked in, and drawn as one call per chunk instead of one per mesh.
+	class StaticBatcher
+	{
+	public:
+		static void CollectStaticMeshes();
+		static void Update();
+		static void Clear();
+
+		// batched meshes are no longer drawn individually by the deferred and shadow passes
+		static inline bool GetIsBatched(UID const& uid) { return m_BatchedUIDs.find(uid) != m_BatchedUIDs.end(); }
+		static inline std::vector<StaticBatch>& GetBatches() { return m_Batches; }
+
+		// Draw
+		static void DrawBatches(std::function<Shader&(unsigned int const&)> const& useShaderVariant, Camera& renderCam);
+		static void AddShadowDraws(Shader& shader, glm::mat4 const& lightSpaceMatrix);
+		// batches overlapping a world space box, drawn with the shader already in use
+		static void DrawBatchesInBounds(Shader& shader, glm::vec3 const& bboxMin, glm::vec3 const& bboxMax);
+		static inline unsigned int GetNumDrawnBatches() { return m_NumDrawnBatches; }
+		// world space box against the clip planes of a view projection, near and far optional
+		static bool GetIsInFrustum(glm::mat4 const& viewProjection, glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, bool const& testDepth);
+
+	private:
+		static void BuildBatches();
+		static bool GetIsMeshBatchable(MeshComponent* meshComponent);
+		static std::string BuildMaterialKey(Material& material);
+		static void DrawBatch(StaticBatch const& batch);
+
+		static std::vector<UID> m_PendingUIDs;
+		static std::set<UID> m_BatchedUIDs;
+		static std::vector<StaticBatch> m_Batches;
+		static unsigned int m_NumDrawnBatches;
+	};
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include "VoxelOccupancy.h"
+
+namespace Chroma
+{
+	void VoxelOccupancy::Reset(glm::ivec3 const& regionMin, glm::ivec3 const& regionMax, float const& brickWorldSize)
+	{
+		m_RegionMin = regionMin;
+		m_RegionMax = glm::max(regionMax, regionMin);
+		m_BrickWorldSize = brickWorldSize;
+		glm::ivec3 const size = GetRegionSize();
+		m_Occupied.assign((size_t)size.x * size.y * size.z, 0);
+		m_NumOccupied = 0;
+	}
+
+	void VoxelOccupancy::AddTriangle(glm::vec3 const& v0, glm::vec3 const& v1, glm::vec3 const& v2)
+	{
+		glm::ivec3 rangeMin, rangeMax;
+		if (!GetBrickRange(glm::min(v0, glm::min(v1, v2)), glm::max(v0, glm::max(v1, v2)), rangeMin, rangeMax))
+			return;
+
+		glm::vec3 const halfSize(m_BrickWorldSize * 0.5f + m_Padding);
+		for (int z = rangeMin.z; z < rangeMax.z; z++)
+			for (int y = rangeMin.y; y < rangeMax.y; y++)
+				for (int x = rangeMin.x; x < rangeMax.x; x++)
+				{
+					glm::ivec3 const brick(x, y, z);
+					if (m_Occupied[GetIndex(brick)])
+						continue;
+					glm::vec3 const center = (glm::vec3(brick) + 0.5f) * m_BrickWorldSize;
+					if (GetTriangleOverlapsBox(center, halfSize, v0, v1, v2))
+						Mark(brick);
+				}
+	}
+
+	void VoxelOccupancy::AddMesh(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, glm::mat4 const& modelTransform)
+	{
+		// transformed once, indices are shared between triangles
+		std::vector<glm::vec3> positionsWS;
+		positionsWS.reserve(positions.size());
+		for (glm::vec3 const& position : positions)
+			positionsWS.push_back(glm::vec3(modelTransform * glm::vec4(position, 1.0f)));
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			if (indices[i] >= positionsWS.size() || indices[i + 1] >= positionsWS.size() || indices[i + 2] >= positionsWS.size())
+				continue;
+			AddTriangle(positionsWS[indices[i]], positionsWS[indices[i + 1]], positionsWS[indices[i + 2]]);
+		}
+	}
+
+	void VoxelOccupancy::AddBox(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax)
+	{
+		glm::ivec3 rangeMin, rangeMax;
+		if (!GetBrickRange(bboxMin, bboxMax, rangeMin, rangeMax))
+			return;
+
+		for (int z = rangeMin.z; z < rangeMax.z; z++)
+			for (int y = rangeMin.y; y < rangeMax.y; y++)
+				for (int x = rangeMin.x; x < rangeMax.x; x++)
+					Mark(glm::ivec3(x, y, z));
+	}
+
+	bool VoxelOccupancy::GetIsOccupied(glm::ivec3 const& brick) const
+	{
+		if (glm::any(glm::lessThan(brick, m_RegionMin)) || glm::any(glm::greaterThanEqual(brick, m_RegionMax)))
+			return false;
+		return m_Occupied[GetIndex(brick)] != 0;
+	}
+
+	std::vector<glm::ivec3> VoxelOccupancy::GetOccupiedBricks() const
+	{
+		std::vector<glm::ivec3> bricks;
+		bricks.reserve(m_NumOccupied);
+		for (int z = m_RegionMin.z; z < m_RegionMax.z; z++)
+			for (int y = m_RegionMin.y; y < m_RegionMax.y; y++)
+				for (int x = m_RegionMin.x; x < m_RegionMax.x; x++)
+					if (m_Occupied[GetIndex(glm::ivec3(x, y, z))])
+						bricks.push_back(glm::ivec3(x, y, z));
+		return bricks;
+	}
+
+	unsigned int VoxelOccupancy::GetIndex(glm::ivec3 const& brick) const
+	{
+		glm::ivec3 const size = GetRegionSize();
+		glm::ivec3 const local = brick - m_RegionMin;
+		return (unsigned int)((local.z * size.y + local.y) * size.x + local.x);
+	}
+
+	void VoxelOccupancy::Mark(glm::ivec3 const& brick)
+	{
+		uint8_t& occupied = m_Occupied[GetIndex(brick)];
+		if (occupied)
+			return;
+		occupied = 1;
+		m_NumOccupied++;
+	}
+
+	bool VoxelOccupancy::GetBrickRange(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::ivec3& rangeMin, glm::ivec3& rangeMax) const
+	{
+		rangeMin = glm::max(glm::ivec3(glm::floor((bboxMin - m_Padding) / m_BrickWorldSize)), m_RegionMin);
+		rangeMax = glm::min(glm::ivec3(glm::floor((bboxMax + m_Padding) / m_BrickWorldSize)) + 1, m_RegionMax);
+		return glm::all(glm::lessThan(rangeMin, rangeMax));
+	}
+
+	bool VoxelOccupancy::GetTriangleOverlapsBox(glm::vec3 const& boxCenter, glm::vec3 const& boxHalfSize, glm::vec3 const& v0, glm::vec3 const& v1, glm::vec3 const& v2)
+	{
+		// separating axis test, box moved to the origin
+		glm::vec3 const a = v0 - boxCenter, b = v1 - boxCenter, c = v2 - boxCenter;
+		glm::vec3 const edges[3]{ b - a, c - b, a - c };
+
+		auto separatedOnAxis = [&](glm::vec3 const& axis)
+		{
+			// degenerate axes from parallel edges separate nothing
+			if (glm::dot(axis, axis) < 1e-12f)
+				return false;
+			float const pA = glm::dot(a, axis), pB = glm::dot(b, axis), pC = glm::dot(c, axis);
+			float const radius = glm::dot(boxHalfSize, glm::abs(axis));
+			return std::min(pA, std::min(pB, pC)) > radius || std::max(pA, std::max(pB, pC)) < -radius;
+		};
+
+		// box face normals
+		for (int axis = 0; axis < 3; axis++)
+		{
+			glm::vec3 faceNormal(0.0f);
+			faceNormal[axis] = 1.0f;
+			if (separatedOnAxis(faceNormal))
+				return false;
+		}
+
+		// triangle normal
+		if (separatedOnAxis(glm::cross(edges[0], edges[1])))
+			return false;
+
+		// edge cross products
+		for (glm::vec3 const& edge : edges)
+			for (int axis = 0; axis < 3; axis++)
+			{
+				glm::vec3 faceNormal(0.0f);
+				faceNormal[axis] = 1.0f;
+				if (separatedOnAxis(glm::cross(edge, faceNormal)))
+					return false;
+			}
+
+		return true;
+	}
+}
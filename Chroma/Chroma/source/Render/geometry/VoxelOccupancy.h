@@ -0,0 +1,53 @@
+#ifndef _CHROMA_VOXEL_OCCUPANCY_
+#define _CHROMA_VOXEL_OCCUPANCY_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// CPU voxel occupancy at brick granularity.
+	// Marks which bricks of a region are touched by mesh triangles, using a separating axis
+	// triangle box test, or by boxes where no triangles are kept. Brick coordinates are in
+	// world space, brick (0,0,0) spans 0 to brickWorldSize on each axis.
+	// No GPU resources are touched, the result drives which bricks a brick map allocates.
+	class VoxelOccupancy
+	{
+	public:
+		// region is [regionMin, regionMax) in brick coordinates, clears all occupancy
+		void Reset(glm::ivec3 const& regionMin, glm::ivec3 const& regionMax, float const& brickWorldSize);
+
+		// Marking, world space
+		void AddTriangle(glm::vec3 const& v0, glm::vec3 const& v1, glm::vec3 const& v2);
+		void AddMesh(std::vector<glm::vec3> const& positions, std::vector<unsigned int> const& indices, glm::mat4 const& modelTransform);
+		void AddBox(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax);
+
+		// Queries
+		bool GetIsOccupied(glm::ivec3 const& brick) const;
+		inline unsigned int GetNumOccupied() const { return m_NumOccupied; }
+		inline unsigned int GetNumBricks() const { return (unsigned int)m_Occupied.size(); }
+		// occupied bricks in brick coordinates
+		std::vector<glm::ivec3> GetOccupiedBricks() const;
+
+		// padding around bricks in world units, matches voxelization's conservative rasterization
+		inline void SetPadding(float const& padding) { m_Padding = padding; }
+
+	private:
+		glm::ivec3 m_RegionMin{ 0 }, m_RegionMax{ 0 };
+		float m_BrickWorldSize{ 1.0f };
+		float m_Padding{ 0.0f };
+		std::vector<uint8_t> m_Occupied;
+		unsigned int m_NumOccupied{ 0 };
+
+		inline glm::ivec3 GetRegionSize() const { return m_RegionMax - m_RegionMin; }
+		unsigned int GetIndex(glm::ivec3 const& brick) const;
+		void Mark(glm::ivec3 const& brick);
+		// brick range overlapping a world space box, clamped to the region, false if empty
+		bool GetBrickRange(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::ivec3& rangeMin, glm::ivec3& rangeMax) const;
+		static bool GetTriangleOverlapsBox(glm::vec3 const& boxCenter, glm::vec3 const& boxHalfSize, glm::vec3 const& v0, glm::vec3 const& v1, glm::vec3 const& v2);
+	};
+}
+
+#endif
@@ -0,0 +1,296 @@
+#include "RenderGraph.h"
+#include <render/Render.h>
+
+namespace Chroma
+{
+	std::vector<RenderGraph::Resource> RenderGraph::s_Resources;
+	std::vector<RenderGraph::Pass> RenderGraph::s_Passes;
+	std::vector<RenderGraph::PooledTexture> RenderGraph::s_Pool;
+	unsigned int RenderGraph::s_ZeroTexture{ 0 };
+	uint64_t RenderGraph::s_Frame{ 0 };
+	uint64_t RenderGraph::s_PooledBytes{ 0 };
+	unsigned int RenderGraph::s_NumPasses{ 0 };
+	unsigned int RenderGraph::s_NumCulledPasses{ 0 };
+
+	unsigned int RenderGraph::ImportTexture(std::string const& name, unsigned int const& texture)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.texture = texture;
+		resource.isImported = true;
+		s_Resources.push_back(resource);
+		return (unsigned int)s_Resources.size() - 1;
+	}
+
+	unsigned int RenderGraph::CreateTexture(std::string const& name, RenderGraphTextureDesc const& desc)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.desc = desc;
+		s_Resources.push_back(resource);
+		return (unsigned int)s_Resources.size() - 1;
+	}
+
+	void RenderGraph::SetOutput(unsigned int const& resource)
+	{
+		s_Resources[resource].isOutput = true;
+	}
+
+	void RenderGraph::AddPass(std::string const& name, std::vector<unsigned int> const& reads, std::vector<unsigned int> const& writes,
+		std::function<void()> const& execute, bool const& hasSideEffects)
+	{
+		unsigned int const passIndex = (unsigned int)s_Passes.size();
+		Pass pass;
+		pass.name = name;
+		pass.reads = reads;
+		pass.writes = writes;
+		pass.execute = execute;
+		pass.hasSideEffects = hasSideEffects;
+		s_Passes.push_back(pass);
+
+		for (unsigned int const& resource : reads)
+			s_Resources[resource].readers.push_back(passIndex);
+		for (unsigned int const& resource : writes)
+			s_Resources[resource].writers.push_back(passIndex);
+	}
+
+	void RenderGraph::Execute()
+	{
+		CHROMA_PROFILE_FUNCTION();
+		s_Frame++;
+
+		Cull();
+		std::vector<unsigned int> const order = Sort();
+
+		// lifetimes over the execution order
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			Pass const& pass = s_Passes[order[i]];
+			for (std::vector<unsigned int> const* resources : { &pass.reads, &pass.writes })
+			{
+				for (unsigned int const& resource : *resources)
+				{
+					s_Resources[resource].firstUse = glm::min(s_Resources[resource].firstUse, (int)i);
+					s_Resources[resource].lastUse = glm::max(s_Resources[resource].lastUse, (int)i);
+				}
+			}
+		}
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			Pass const& pass = s_Passes[order[i]];
+
+			// transient textures are taken from the pool at their first writer
+			for (unsigned int const& resource : pass.writes)
+				if (!s_Resources[resource].isImported && s_Resources[resource].texture == 0)
+					s_Resources[resource].texture = AcquireTexture(s_Resources[resource].desc);
+
+			pass.execute();
+
+			// and handed back after their last use, later passes may alias them
+			for (std::vector<unsigned int> const* resources : { &pass.reads, &pass.writes })
+			{
+				for (unsigned int const& resource : *resources)
+				{
+					if (s_Resources[resource].isImported || s_Resources[resource].lastUse != (int)i || s_Resources[resource].texture == 0)
+						continue;
+					ReleaseTexture(s_Resources[resource].texture);
+					s_Resources[resource].texture = 0;
+				}
+			}
+		}
+
+		TrimPool();
+
+		s_NumPasses = (unsigned int)s_Passes.size();
+		s_NumCulledPasses = s_NumPasses - (unsigned int)order.size();
+		s_Resources.clear();
+		s_Passes.clear();
+	}
+
+	unsigned int RenderGraph::GetTexture(unsigned int const& resource)
+	{
+		unsigned int const texture = s_Resources[resource].texture;
+		return texture != 0 ? texture : GetZeroTexture();
+	}
+
+	void RenderGraph::ReleaseTextures()
+	{
+		for (PooledTexture const& pooled : s_Pool)
+			glDeleteTextures(1, &pooled.texture);
+		s_Pool.clear();
+		s_PooledBytes = 0;
+	}
+
+	void RenderGraph::Cull()
+	{
+		// passes writing outputs or with side effects are kept
+		std::vector<unsigned int> stack;
+		for (unsigned int i = 0; i < s_Passes.size(); i++)
+		{
+			Pass& pass = s_Passes[i];
+			pass.isCulled = !pass.hasSideEffects && std::none_of(pass.writes.begin(), pass.writes.end(), [](unsigned int const& resource) { return s_Resources[resource].isOutput; });
+			if (!pass.isCulled)
+				stack.push_back(i);
+		}
+
+		// along with every writer of what they read
+		while (!stack.empty())
+		{
+			unsigned int const passIndex = stack.back();
+			stack.pop_back();
+			for (unsigned int const& resource : s_Passes[passIndex].reads)
+			{
+				for (unsigned int const& writer : s_Resources[resource].writers)
+				{
+					if (!s_Passes[writer].isCulled)
+						continue;
+					s_Passes[writer].isCulled = false;
+					stack.push_back(writer);
+				}
+			}
+		}
+	}
+
+	std::vector<unsigned int> RenderGraph::Sort()
+	{
+		// writers of a texture run in declaration order, its readers after all of them
+		size_t const numPasses = s_Passes.size();
+		std::vector<std::vector<unsigned int>> dependents(numPasses);
+		std::vector<unsigned int> numDependencies(numPasses, 0);
+		std::vector<std::vector<bool>> hasEdge(numPasses, std::vector<bool>(numPasses, false));
+		auto addEdge = [&](unsigned int const& from, unsigned int const& to)
+		{
+			if (from == to || hasEdge[from][to] || s_Passes[from].isCulled || s_Passes[to].isCulled)
+				return;
+			hasEdge[from][to] = true;
+			dependents[from].push_back(to);
+			numDependencies[to]++;
+		};
+		for (Resource const& resource : s_Resources)
+		{
+			for (size_t i = 1; i < resource.writers.size(); i++)
+				addEdge(resource.writers[i - 1], resource.writers[i]);
+			for (unsigned int const& reader : resource.readers)
+				if (std::find(resource.writers.begin(), resource.writers.end(), reader) == resource.writers.end())
+					for (unsigned int const& writer : resource.writers)
+						addEdge(writer, reader);
+		}
+
+		// ties keep declaration order
+		std::vector<unsigned int> order;
+		std::vector<bool> isScheduled(numPasses, false);
+		for (bool scheduled = true; scheduled;)
+		{
+			scheduled = false;
+			for (unsigned int i = 0; i < numPasses; i++)
+			{
+				if (isScheduled[i] || s_Passes[i].isCulled || numDependencies[i] != 0)
+					continue;
+				isScheduled[i] = true;
+				order.push_back(i);
+				for (unsigned int const& dependent : dependents[i])
+					numDependencies[dependent]--;
+				scheduled = true;
+				break;
+			}
+		}
+
+		// cycles fall back to declaration order
+		for (unsigned int i = 0; i < numPasses; i++)
+		{
+			if (isScheduled[i] || s_Passes[i].isCulled)
+				continue;
+			CHROMA_WARN("RENDER GRAPH :: Cycle through pass : {0}", s_Passes[i].name);
+			order.push_back(i);
+		}
+		return order;
+	}
+
+	unsigned int RenderGraph::AcquireTexture(RenderGraphTextureDesc const& desc)
+	{
+		int const width = glm::max(Render::GetRenderWidth() / (int)desc.divisor, 1);
+		int const height = glm::max(Render::GetRenderHeight() / (int)desc.divisor, 1);
+		for (PooledTexture& pooled : s_Pool)
+		{
+			if (pooled.isAcquired || !(pooled.desc == desc) || pooled.width != width || pooled.height != height)
+				continue;
+			pooled.isAcquired = true;
+			pooled.lastUsedFrame = s_Frame;
+			return pooled.texture;
+		}
+
+		PooledTexture pooled;
+		pooled.desc = desc;
+		pooled.width = width;
+		pooled.height = height;
+		pooled.isAcquired = true;
+		pooled.lastUsedFrame = s_Frame;
+		glGenTextures(1, &pooled.texture);
+		glBindTexture(GL_TEXTURE_2D, pooled.texture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, desc.internalFormat, width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		s_Pool.push_back(pooled);
+		s_PooledBytes += (uint64_t)width * height * GetBytesPerTexel(desc.internalFormat);
+		return pooled.texture;
+	}
+
+	void RenderGraph::ReleaseTexture(unsigned int const& texture)
+	{
+		for (PooledTexture& pooled : s_Pool)
+			if (pooled.texture == texture)
+				pooled.isAcquired = false;
+	}
+
+	void RenderGraph::TrimPool()
+	{
+		// targets no pass has used for a while are freed
+		for (size_t i = s_Pool.size(); i-- > 0;)
+		{
+			PooledTexture const& pooled = s_Pool[i];
+			if (pooled.isAcquired || pooled.lastUsedFrame + RENDER_GRAPH_POOL_FRAMES > s_Frame)
+				continue;
+			s_PooledBytes -= (uint64_t)pooled.width * pooled.height * GetBytesPerTexel(pooled.desc.internalFormat);
+			glDeleteTextures(1, &pooled.texture);
+			s_Pool.erase(s_Pool.begin() + i);
+		}
+	}
+
+	unsigned int RenderGraph::GetBytesPerTexel(GLenum const& internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_R8:
+			return 1;
+		case GL_RG8:
+		case GL_R16F:
+			return 2;
+		case GL_RGB16F:
+		case GL_RGBA16F:
+			return 8;
+		case GL_RGBA32F:
+			return 16;
+		default:
+			return 4;
+		}
+	}
+
+	unsigned int RenderGraph::GetZeroTexture()
+	{
+		if (s_ZeroTexture == 0)
+		{
+			unsigned char const zero[4]{ 0, 0, 0, 0 };
+			glGenTextures(1, &s_ZeroTexture);
+			glBindTexture(GL_TEXTURE_2D, s_ZeroTexture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, zero);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+		return s_ZeroTexture;
+	}
+}
@@ -0,0 +1,107 @@
+#ifndef _CHROMA_RENDER_GRAPH_
+#define _CHROMA_RENDER_GRAPH_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// Transient texture, sized as a fraction of the render resolution
+	struct RenderGraphTextureDesc
+	{
+		GLenum internalFormat{ GL_RGBA8 };
+		unsigned int divisor{ 1 };
+		GLenum filter{ GL_NEAREST };
+
+		bool operator==(RenderGraphTextureDesc const& other) const { return internalFormat == other.internalFormat && divisor == other.divisor && filter == other.filter; }
+	};
+
+	// Frame graph rebuilt every frame. Passes declare the textures they read and write,
+	// the graph orders them so every writer of a texture runs before its readers, culls
+	// passes that don't contribute to an output and only allocates the transient textures
+	// of the passes that run. Transient textures come from a pool and are handed back
+	// after their last reader, so targets whose lifetimes don't overlap share memory.
+	class RenderGraph
+	{
+	public:
+		// resources, handles are valid until the graph is executed
+		static unsigned int ImportTexture(std::string const& name, unsigned int const& texture);
+		static unsigned int CreateTexture(std::string const& name, RenderGraphTextureDesc const& desc);
+		// passes writing an output are kept, and everything they read from
+		static void SetOutput(unsigned int const& resource);
+
+		// side effects keep a pass nothing reads from
+		static void AddPass(std::string const& name, std::vector<unsigned int> const& reads, std::vector<unsigned int> const& writes,
+			std::function<void()> const& execute, bool const& hasSideEffects = false);
+
+		// compiles, runs and clears the frame's passes
+		static void Execute();
+
+		// GL texture of a resource, transient ones only during the passes using them.
+		// Textures nothing wrote to this frame read as zero.
+		static unsigned int GetTexture(unsigned int const& resource);
+
+		// pooled textures are sized for the render resolution
+		static void ReleaseTextures();
+
+		static inline unsigned int GetNumPasses() { return s_NumPasses; }
+		static inline unsigned int GetNumCulledPasses() { return s_NumCulledPasses; }
+		static inline uint64_t GetPooledBytes() { return s_PooledBytes; }
+		static inline unsigned int GetNumPooledTextures() { return (unsigned int)s_Pool.size(); }
+
+	private:
+		struct Resource
+		{
+			std::string name;
+			RenderGraphTextureDesc desc;
+			unsigned int texture{ 0 };
+			bool isImported{ false };
+			bool isOutput{ false };
+			// passes in declaration order
+			std::vector<unsigned int> writers;
+			std::vector<unsigned int> readers;
+			// first and last position in the execution order, transient textures only live between them
+			int firstUse{ INT_MAX };
+			int lastUse{ -1 };
+		};
+
+		struct Pass
+		{
+			std::string name;
+			std::vector<unsigned int> reads;
+			std::vector<unsigned int> writes;
+			std::function<void()> execute;
+			bool hasSideEffects{ false };
+			bool isCulled{ true };
+		};
+
+		struct PooledTexture
+		{
+			RenderGraphTextureDesc desc;
+			int width{ 0 }, height{ 0 };
+			unsigned int texture{ 0 };
+			bool isAcquired{ false };
+			uint64_t lastUsedFrame{ 0 };
+		};
+
+		static void Cull();
+		static std::vector<unsigned int> Sort();
+		static unsigned int AcquireTexture(RenderGraphTextureDesc const& desc);
+		static void ReleaseTexture(unsigned int const& texture);
+		static void TrimPool();
+		static unsigned int GetBytesPerTexel(GLenum const& internalFormat);
+		static unsigned int GetZeroTexture();
+
+		static std::vector<Resource> s_Resources;
+		static std::vector<Pass> s_Passes;
+		static std::vector<PooledTexture> s_Pool;
+		static unsigned int s_ZeroTexture;
+		static uint64_t s_Frame;
+		static uint64_t s_PooledBytes;
+		static unsigned int s_NumPasses, s_NumCulledPasses;
+	};
+}
+
+#endif
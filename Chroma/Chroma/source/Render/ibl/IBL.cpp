@@ -1,55 +1,80 @@
 #include "IBL.h"
 #include <core/Application.h>
+#include <ibl/IBLCache.h>
+#include <jobsystem/JobSystem.h>
 
 namespace Chroma
 {
-	void IBL::Init()
+	// direction through a texel of a GL cube map face, s and t in [-1, 1]
+	static glm::vec3 GetCubeMapDirection(unsigned int const& face, float const& s, float const& t)
 	{
-		glDisable(GL_CULL_FACE); // double sided rendering
-		glDepthFunc(GL_LEQUAL);
-		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
-		// env cube map
-		GenerateEnvCubeMap();
+		switch (face)
+		{
+		case 0: return glm::vec3(1.0f, -t, -s);
+		case 1: return glm::vec3(-1.0f, -t, s);
+		case 2: return glm::vec3(s, 1.0f, t);
+		case 3: return glm::vec3(s, -1.0f, -t);
+		case 4: return glm::vec3(s, -t, 1.0f);
+		default: return glm::vec3(-s, -t, -1.0f);
+		}
+	}
 
-		// irradiance map
-		GenerateIrradianceMap();
+	// first 3 bands of real spherical harmonics, matches IrradianceSH in the lighting shaders
+	static void EvaluateSHBasis(glm::vec3 const& n, float(&basis)[9])
+	{
+		basis[0] = 0.282095f;
+		basis[1] = 0.488603f * n.y;
+		basis[2] = 0.488603f * n.z;
+		basis[3] = 0.488603f * n.x;
+		basis[4] = 1.092548f * n.x * n.y;
+		basis[5] = 1.092548f * n.y * n.z;
+		basis[6] = 0.315392f * (3.0f * n.z * n.z - 1.0f);
+		basis[7] = 1.092548f * n.x * n.z;
+		basis[8] = 0.546274f * (n.x * n.x - n.y * n.y);
+	}
 
-		// prefilter importance map
-		GeneratePrefilterMap();
+	void IBL::Init()
+	{
+		// capture buffers, resized per map
+		glGenFramebuffers(1, &m_captureFBO);
+		glGenRenderbuffers(1, &m_captureRBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_captureRBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-		// brdf LUT map
-		GenerateBRDFLUTMap();
+		// brdf LUT map, independent of the environment so shared by every scene
+		glGenTextures(1, &m_brdfLUTTexture);
+		glBindTexture(GL_TEXTURE_2D, m_brdfLUTTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, IBL_BRDF_LUT_SIZE, IBL_BRDF_LUT_SIZE, 0, GL_RG, GL_FLOAT, 0);
+		// be sure to set wrapping mode to GL_CLAMP_TO_EDGE
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glEnable(GL_CULL_FACE);
-		glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+		if (!IBLCache::LoadBRDFLUT(m_brdfLUTTexture))
+		{
+			GenerateBRDFLUTMap();
+			IBLCache::SaveBRDFLUT(m_brdfLUTTexture);
+		}
 	}
 
 	void IBL::ClearTextureBuffers()
 	{
-		Texture::ClearTexureMemory(m_brdfLUTTexture);
 		Texture::ClearTexureMemory(m_envCubeMap);
 		Texture::ClearTexureMemory(m_prefilterMap);
-		Texture::ClearTexureMemory(m_irradianceMap);
 	}
 
-	void IBL::GenerateEnvCubeMap()
+	void IBL::AllocateEnvironmentMaps()
 	{
-		// init capture buffers
-		glGenFramebuffers(1, &m_captureFBO);
-		glGenRenderbuffers(1, &m_captureRBO);
-
-		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
-		glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_captureRBO);
-
-		// init env cube map
+		// env cube map
 		glGenTextures(1, &m_envCubeMap);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_envCubeMap);
 		for (unsigned int i = 0; i < 6; ++i)
 		{
 			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F,
-				512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
+				IBL_ENV_CUBEMAP_SIZE, IBL_ENV_CUBEMAP_SIZE, 0, GL_RGB, GL_FLOAT, nullptr);
 		}
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -57,65 +82,70 @@ namespace Chroma
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		// convert HDR equirectangular environment map to cubemap equivalent
-		m_envMapShader.Use();
-		m_envMapShader.SetUniform("equirectangularMap", 0);
-		m_envMapShader.SetUniform("projection", captureProjection);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_HDRtexture.GetID());
-
-		glViewport(0, 0, 512, 512); // don't forget to configure the viewport to the capture dimensions.
-		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
-		for (unsigned int i = 0; i < 6; ++i)
-		{
-			m_envMapShader.SetUniform("view", captureViews[i]);
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-				GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, m_envCubeMap, 0);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-			// draw cube
-			m_captureCube.BindDrawVAO();
-		}
-		glViewport(0, 0, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight());
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	}
-
-	void IBL::GenerateIrradianceMap()
-	{
-		// generate Texture
-		glGenTextures(1, &m_irradianceMap);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_irradianceMap);
+		// prefilter map, roughness per mip
+		glGenTextures(1, &m_prefilterMap);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilterMap);
 		for (unsigned int i = 0; i < 6; ++i)
 		{
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0,
-				GL_RGB, GL_FLOAT, nullptr);
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, IBL_PREFILTER_SIZE, IBL_PREFILTER_SIZE, 0, GL_RGB, GL_FLOAT, nullptr);
 		}
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, IBL_PREFILTER_MIPS - 1);
+		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	}
 
+	void IBL::BakeEnvironmentMaps()
+	{
+		CHROMA_INFO("IBL :: Baking environment maps for : {0}", m_SourcePath);
+		m_HDRtexture = Chroma::TextureLoader::LoadHDRTexture(m_SourcePath);
+
+		glDisable(GL_CULL_FACE); // double sided rendering
+		glDepthFunc(GL_LEQUAL);
+		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+		// env cube map
+		GenerateEnvCubeMap();
+
+		// prefilter importance map
+		GeneratePrefilterMap();
+
+		glEnable(GL_CULL_FACE);
+		glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+		// irradiance
+		ProjectIrradianceSH();
+
+		// the source is only needed to bake
+		m_HDRtexture.Destroy();
+	}
+
+	void IBL::GenerateEnvCubeMap()
+	{
 		// Update the capture buffers to the new resolution
 		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
 		glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, IBL_ENV_CUBEMAP_SIZE, IBL_ENV_CUBEMAP_SIZE);
 
-		// convolute the irradiance cubemap
-		m_irradienceMapShader.Use();
-		m_irradienceMapShader.SetUniform("environmentMap", 0);
-		m_irradienceMapShader.SetUniform("projection", captureProjection);
+		// convert HDR equirectangular environment map to cubemap equivalent
+		m_envMapShader.Use();
+		m_envMapShader.SetUniform("equirectangularMap", 0);
+		m_envMapShader.SetUniform("projection", captureProjection);
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_envCubeMap);
+		glBindTexture(GL_TEXTURE_2D, m_HDRtexture.GetID());
 
-		glViewport(0, 0, 32, 32); // don't forget to configure the viewport to the capture dimensions.
-		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
+		glViewport(0, 0, IBL_ENV_CUBEMAP_SIZE, IBL_ENV_CUBEMAP_SIZE); // don't forget to configure the viewport to the capture dimensions.
 		for (unsigned int i = 0; i < 6; ++i)
 		{
-			m_irradienceMapShader.SetUniform("view", captureViews[i]);
+			m_envMapShader.SetUniform("view", captureViews[i]);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-				GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, m_irradianceMap, 0);
+				GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, m_envCubeMap, 0);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
+			// draw cube
 			m_captureCube.BindDrawVAO();
 		}
 		glViewport(0, 0, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight());
@@ -124,26 +154,6 @@ namespace Chroma
 
 	void IBL::GeneratePrefilterMap()
 	{
-		// generate texture
-		glGenTextures(1, &m_prefilterMap);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilterMap);
-		for (unsigned int i = 0; i < 6; ++i)
-		{
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
-		}
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-
-		// Update the capture buffers to the new resolution
-		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
-		glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 128, 128);
-
 		// convolute the prefilter cubemap
 		m_prefilterMapShader.Use();
 		m_prefilterMapShader.SetUniform("environmentMap", 0);
@@ -152,17 +162,15 @@ namespace Chroma
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_envCubeMap);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
-		unsigned int maxMipLevels = 5;
-		for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
+		for (unsigned int mip = 0; mip < IBL_PREFILTER_MIPS; ++mip)
 		{
 			// reisze framebuffer according to mip-level size.
-			unsigned int mipWidth = 128 * std::pow(0.5, mip);
-			unsigned int mipHeight = 128 * std::pow(0.5, mip);
+			unsigned int mipSize = IBL_PREFILTER_SIZE >> mip;
 			glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
-			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-			glViewport(0, 0, mipWidth, mipHeight);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipSize, mipSize);
+			glViewport(0, 0, mipSize, mipSize);
 
-			float roughness = (float)mip / (float)(maxMipLevels - 1);
+			float roughness = (float)mip / (float)(IBL_PREFILTER_MIPS - 1);
 			m_prefilterMapShader.SetUniform("roughness", roughness);
 			for (unsigned int i = 0; i < 6; ++i)
 			{
@@ -180,24 +188,13 @@ namespace Chroma
 
 	void IBL::GenerateBRDFLUTMap()
 	{
-		glGenTextures(1, &m_brdfLUTTexture);
-
-		// pre-allocate enough memory for the LUT texture.
-		glBindTexture(GL_TEXTURE_2D, m_brdfLUTTexture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
-		// be sure to set wrapping mode to GL_CLAMP_TO_EDGE
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// then re-configure capture framebuffer object and render screen-space quad with BRDF shader.
+		// re-configure capture framebuffer object and render screen-space quad with BRDF shader.
 		glBindFramebuffer(GL_FRAMEBUFFER, m_captureFBO);
 		glBindRenderbuffer(GL_RENDERBUFFER, m_captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, IBL_BRDF_LUT_SIZE, IBL_BRDF_LUT_SIZE);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_brdfLUTTexture, 0);
 
-		glViewport(0, 0, 512, 512);
+		glViewport(0, 0, IBL_BRDF_LUT_SIZE, IBL_BRDF_LUT_SIZE);
 		m_brdfShader.Use();
 		m_brdfShader.SetUniform("scale", glm::vec2(1.0));
 		m_brdfShader.SetUniform("offset", glm::vec2(0.0));
@@ -206,41 +203,94 @@ namespace Chroma
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		glViewport(0, 0, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight());
-
 	}
 
-
-	void IBL::Draw()
+	void IBL::ProjectIrradianceSH()
 	{
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_HDRtexture.GetID());
-		m_captureCube.Draw(m_envMapShader);
-	}
+		// read back the env cube map, each job projects one row of texels
+		unsigned int const size{ IBL_ENV_CUBEMAP_SIZE };
+		std::vector<float> texels(6 * size * size * 3);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, m_envCubeMap);
+		for (unsigned int face = 0; face < 6; face++)
+			glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB, GL_FLOAT, &texels[face * size * size * 3]);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-	void IBL::SetIBLTexture(HDRTexture newHDRTexture)
-	{
-		m_HDRtexture = newHDRTexture;
-		Init();
+		struct RowProjection
+		{
+			glm::vec3 coefficients[9];
+			float weight;
+		};
+		std::vector<RowProjection> rows(6 * size);
+		// only the projection jobs are waited on, other systems' jobs keep running
+		JobCounter rowCounter;
+		Chroma::JobSystem::Dispatch(6 * size, 16, [&texels, &rows, size](JobDispatchArgs args) {
+			unsigned int const face = args.jobIndex / size;
+			unsigned int const y = args.jobIndex % size;
+			RowProjection& row = rows[args.jobIndex];
+			for (glm::vec3& coefficient : row.coefficients)
+				coefficient = glm::vec3(0.0f);
+			row.weight = 0.0f;
+
+			float const t = 2.0f * ((float)y + 0.5f) / (float)size - 1.0f;
+			float basis[9];
+			for (unsigned int x = 0; x < size; x++)
+			{
+				float const s = 2.0f * ((float)x + 0.5f) / (float)size - 1.0f;
+				// texel solid angle, up to a constant the normalization removes
+				float const distanceSquared = 1.0f + s * s + t * t;
+				float const weight = 1.0f / (distanceSquared * std::sqrt(distanceSquared));
+				EvaluateSHBasis(glm::normalize(GetCubeMapDirection(face, s, t)), basis);
+
+				float const* texel = &texels[((face * size + y) * size + x) * 3];
+				glm::vec3 const radiance = glm::vec3(texel[0], texel[1], texel[2]) * weight;
+				for (unsigned int i = 0; i < 9; i++)
+					row.coefficients[i] += radiance * basis[i];
+				row.weight += weight;
+			}
+		}, rowCounter);
+		Chroma::JobSystem::Wait(rowCounter);
+
+		float totalWeight{ 0.0f };
+		for (glm::vec3& coefficient : m_IrradianceSH)
+			coefficient = glm::vec3(0.0f);
+		for (RowProjection const& row : rows)
+		{
+			for (unsigned int i = 0; i < 9; i++)
+				m_IrradianceSH[i] += row.coefficients[i];
+			totalWeight += row.weight;
+		}
+
+		// normalize to the sphere, then convolve with the clamped cosine per band and divide by pi
+		static const float bandScale[9]{ 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+		float const normalization = 4.0f * glm::pi<float>() / totalWeight;
+		for (unsigned int i = 0; i < 9; i++)
+			m_IrradianceSH[i] *= normalization * bandScale[i];
 	}
 
 	void IBL::LoadIBL(std::string const& newHDRTexturePath)
 	{
-		// clear old texture
-		m_HDRtexture.Destroy();
-
-		// new texture
-		m_HDRtexture = Chroma::TextureLoader::LoadHDRTexture(newHDRTexturePath);
+		// unchanged source and settings keep the current maps
+		uint64_t const cacheKey = IBLCache::HashEnvironment(newHDRTexturePath);
+		m_SourcePath = newHDRTexturePath;
+		if (cacheKey != 0 && cacheKey == m_CacheKey)
+			return;
+		m_CacheKey = cacheKey;
 
 		// clear existing texture buffers
 		ClearTextureBuffers();
+		AllocateEnvironmentMaps();
 
-		// initialize
-		Init();
+		// bake only what the cache doesn't have
+		if (!IBLCache::LoadEnvironment(m_CacheKey, m_envCubeMap, m_prefilterMap, m_IrradianceSH))
+		{
+			BakeEnvironmentMaps();
+			IBLCache::SaveEnvironment(m_CacheKey, m_envCubeMap, m_prefilterMap, m_IrradianceSH);
+		}
 	}
 
 	IBL::IBL()
 	{
-		m_HDRtexture = Chroma::TextureLoader::LoadHDRTexture("resources/hdri/BasketballCourt_3k.hdr");
 		Init();
+		LoadIBL("resources/hdri/BasketballCourt_3k.hdr");
 	}
-}
\ No newline at end of file
+}
@@ -16,17 +16,14 @@ namespace Chroma
 	{
 	public:
 
-		void Draw();
-
-		void SetIBLTexture(HDRTexture newHDRTexture);
 		void LoadIBL(std::string const& newHDRTexturePath);
-		inline std::string  GetSourcePath() { return m_HDRtexture.GetSourcePath(); };
+		inline std::string GetSourcePath() const { return m_SourcePath; };
 
 		inline unsigned int GetEnvCubeMapID() const { return m_envCubeMap; };
-		inline unsigned int GetIrradianceMapID() const { return m_irradianceMap; };
 		inline unsigned int GetPrefilterMapID() const { return m_prefilterMap; };
-		inline unsigned int GetHDRTextureID() { return m_HDRtexture.GetID(); };
 		inline unsigned int GetBRDFLUTID() const { return m_brdfLUTTexture; };
+		// diffuse irradiance as 9 SH coefficients, cosine convolved and divided by pi
+		inline glm::vec3 const* GetIrradianceSH() const { return m_IrradianceSH; };
 
 		template <typename UniformType>
 		void SetUniform(std::string uniformName, UniformType uniform)
@@ -47,28 +44,32 @@ namespace Chroma
 		   glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)),
 		   glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f))
 		};
-		// hdr texture
+		// hdr source, only loaded to bake maps missing from the cache
 		HDRTexture m_HDRtexture;
+		std::string m_SourcePath;
+		uint64_t m_CacheKey{ 0 };
 		// capture primitives
 		BoxPrimitive m_captureCube;
 		NDCPlanePrimitive m_capturePlane;
-		// shaders
+		// shaders, IBLCache hashes the same paths into its keys
 		Shader m_envMapShader{ "resources/shaders/fragIBL.glsl", "resources/shaders/vertexCubeMap.glsl" };
-		Shader m_irradienceMapShader{ "resources/shaders/fragIrradiance.glsl", "resources/shaders/vertexCubeMap.glsl" };
 		Shader m_prefilterMapShader{ "resources/shaders/fragPrefilter.glsl", "resources/shaders/vertexCubeMap.glsl" };
 		Shader m_brdfShader{ "resources/shaders/fragBRDF.glsl", "resources/shaders/frameBufferVertex.glsl" };
 		// capture buffers
 		unsigned int m_captureFBO, m_captureRBO;
 		// textures
-		unsigned int m_envCubeMap, m_irradianceMap, m_prefilterMap, m_brdfLUTTexture;
+		unsigned int m_envCubeMap{ 0 }, m_prefilterMap{ 0 }, m_brdfLUTTexture{ 0 };
+		glm::vec3 m_IrradianceSH[9];
 
 		// functions
 		void Init();
 		void ClearTextureBuffers();
+		void AllocateEnvironmentMaps();
+		void BakeEnvironmentMaps();
 		void GenerateEnvCubeMap();
-		void GenerateIrradianceMap();
 		void GeneratePrefilterMap();
 		void GenerateBRDFLUTMap();
+		void ProjectIrradianceSH();
 	};
 }
 
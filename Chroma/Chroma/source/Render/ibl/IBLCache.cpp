@@ -0,0 +1,181 @@
+#include "IBLCache.h"
+#include <shader/ShaderCache.h>
+
+#define IBL_CACHE_MAGIC 0x4C424943 // "CIBL"
+#define IBL_CACHE_VERSION 1
+#define IBL_CACHE_HASH_CHUNK (64 * 1024)
+
+namespace Chroma
+{
+	// bake shaders as IBL loads them, the cached maps go stale when any of them change
+	static char const* const IBL_BAKE_SHADERS[] = {
+		"resources/shaders/fragIBL.glsl",
+		"resources/shaders/vertexCubeMap.glsl",
+		"resources/shaders/fragPrefilter.glsl",
+		"resources/shaders/fragBRDF.glsl",
+		"resources/shaders/frameBufferVertex.glsl"
+	};
+
+	uint64_t IBLCache::HashEnvironment(std::string const& hdrSourcePath)
+	{
+		uint64_t hash = ShaderCache::HashSource("HDR");
+		if (!HashFile(hdrSourcePath, hash))
+			return 0;
+		return ShaderCache::HashCombine(hash, GetSettingsHash());
+	}
+
+	bool IBLCache::LoadEnvironment(uint64_t const& key, unsigned int const& envCubeMap, unsigned int const& prefilterMap, glm::vec3(&irradianceSH)[9])
+	{
+		if (!IBL_CACHE_ENABLED || key == 0)
+			return false;
+
+		std::ifstream cacheFile(GetCachePath(key), std::ios::binary);
+		if (!cacheFile || !ReadHeader(cacheFile, key))
+			return false;
+
+		cacheFile.read(reinterpret_cast<char*>(irradianceSH), sizeof(irradianceSH));
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, envCubeMap);
+		for (unsigned int face = 0; face < 6; face++)
+			if (!ReadLevel(cacheFile, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, IBL_ENV_CUBEMAP_SIZE, GL_RGB, 3))
+				return false;
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+		for (unsigned int mip = 0; mip < IBL_PREFILTER_MIPS; mip++)
+			for (unsigned int face = 0; face < 6; face++)
+				if (!ReadLevel(cacheFile, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, IBL_PREFILTER_SIZE >> mip, GL_RGB, 3))
+					return false;
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		CHROMA_INFO("IBL CACHE :: Loaded environment : {0}", GetCachePath(key));
+		return true;
+	}
+
+	void IBLCache::SaveEnvironment(uint64_t const& key, unsigned int const& envCubeMap, unsigned int const& prefilterMap, glm::vec3 const(&irradianceSH)[9])
+	{
+		if (!IBL_CACHE_ENABLED || key == 0)
+			return;
+
+		CreateDirectoryA(IBL_CACHE_DIR, NULL);
+		std::ofstream cacheFile(GetCachePath(key), std::ios::binary | std::ios::trunc);
+		if (!cacheFile)
+		{
+			CHROMA_WARN("IBL CACHE :: Could not write environment to : {0}", GetCachePath(key));
+			return;
+		}
+		WriteHeader(cacheFile, key);
+		cacheFile.write(reinterpret_cast<char const*>(irradianceSH), sizeof(irradianceSH));
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, envCubeMap);
+		for (unsigned int face = 0; face < 6; face++)
+			WriteLevel(cacheFile, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, IBL_ENV_CUBEMAP_SIZE, GL_RGB, 3);
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+		for (unsigned int mip = 0; mip < IBL_PREFILTER_MIPS; mip++)
+			for (unsigned int face = 0; face < 6; face++)
+				WriteLevel(cacheFile, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, IBL_PREFILTER_SIZE >> mip, GL_RGB, 3);
+
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	}
+
+	bool IBLCache::LoadBRDFLUT(unsigned int const& brdfLUT)
+	{
+		if (!IBL_CACHE_ENABLED)
+			return false;
+
+		uint64_t const key = GetSettingsHash();
+		std::ifstream cacheFile(GetCachePath(key), std::ios::binary);
+		if (!cacheFile || !ReadHeader(cacheFile, key))
+			return false;
+
+		glBindTexture(GL_TEXTURE_2D, brdfLUT);
+		bool const loaded = ReadLevel(cacheFile, GL_TEXTURE_2D, 0, IBL_BRDF_LUT_SIZE, GL_RG, 2);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return loaded;
+	}
+
+	void IBLCache::SaveBRDFLUT(unsigned int const& brdfLUT)
+	{
+		if (!IBL_CACHE_ENABLED)
+			return;
+
+		uint64_t const key = GetSettingsHash();
+		CreateDirectoryA(IBL_CACHE_DIR, NULL);
+		std::ofstream cacheFile(GetCachePath(key), std::ios::binary | std::ios::trunc);
+		if (!cacheFile)
+		{
+			CHROMA_WARN("IBL CACHE :: Could not write BRDF LUT to : {0}", GetCachePath(key));
+			return;
+		}
+		WriteHeader(cacheFile, key);
+		glBindTexture(GL_TEXTURE_2D, brdfLUT);
+		WriteLevel(cacheFile, GL_TEXTURE_2D, 0, IBL_BRDF_LUT_SIZE, GL_RG, 2);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	uint64_t IBLCache::GetSettingsHash()
+	{
+		uint64_t hash = ShaderCache::HashSource("IBL");
+		for (uint64_t const& setting : { IBL_CACHE_VERSION, IBL_ENV_CUBEMAP_SIZE, IBL_PREFILTER_SIZE, IBL_PREFILTER_MIPS, IBL_BRDF_LUT_SIZE })
+			hash = ShaderCache::HashCombine(hash, setting);
+		for (char const* shaderPath : IBL_BAKE_SHADERS)
+			HashFile(shaderPath, hash);
+		return hash;
+	}
+
+	bool IBLCache::HashFile(std::string const& sourcePath, uint64_t& hash)
+	{
+		// read in chunks rather than whole, HDR sources run to tens of megabytes
+		std::ifstream file(sourcePath, std::ios::binary);
+		if (!file)
+			return false;
+		std::string chunk(IBL_CACHE_HASH_CHUNK, '\0');
+		while (file.read(&chunk[0], IBL_CACHE_HASH_CHUNK) || file.gcount() > 0)
+		{
+			chunk.resize((size_t)file.gcount());
+			hash = ShaderCache::HashSource(chunk, hash);
+			chunk.resize(IBL_CACHE_HASH_CHUNK);
+		}
+		return true;
+	}
+
+	std::string IBLCache::GetCachePath(uint64_t const& key)
+	{
+		char fileName[17];
+		snprintf(fileName, sizeof(fileName), "%016llx", (unsigned long long)key);
+		return std::string(IBL_CACHE_DIR) + "/" + fileName + ".ibl";
+	}
+
+	bool IBLCache::ReadHeader(std::ifstream& file, uint64_t const& key)
+	{
+		FileHeader header;
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		return file && header.magic == IBL_CACHE_MAGIC && header.version == IBL_CACHE_VERSION && header.key == key;
+	}
+
+	void IBLCache::WriteHeader(std::ofstream& file, uint64_t const& key)
+	{
+		FileHeader header;
+		header.magic = IBL_CACHE_MAGIC;
+		header.version = IBL_CACHE_VERSION;
+		header.key = key;
+		file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	}
+
+	bool IBLCache::ReadLevel(std::ifstream& file, unsigned int const& target, unsigned int const& level, unsigned int const& size, unsigned int const& format, unsigned int const& components)
+	{
+		std::vector<uint16_t> texels(size * size * components);
+		file.read(reinterpret_cast<char*>(texels.data()), texels.size() * sizeof(uint16_t));
+		if (!file)
+			return false;
+		glTexSubImage2D(target, level, 0, 0, size, size, format, GL_HALF_FLOAT, texels.data());
+		return true;
+	}
+
+	void IBLCache::WriteLevel(std::ofstream& file, unsigned int const& target, unsigned int const& level, unsigned int const& size, unsigned int const& format, unsigned int const& components)
+	{
+		std::vector<uint16_t> texels(size * size * components);
+		glGetTexImage(target, level, format, GL_HALF_FLOAT, texels.data());
+		file.write(reinterpret_cast<char const*>(texels.data()), texels.size() * sizeof(uint16_t));
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef _CHROMA_IBL_CACHE_
+#define _CHROMA_IBL_CACHE_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// Baked IBL maps persisted to disk. Environment maps are keyed by a hash of the source HDR
+	// and the bake settings, the BRDF LUT only depends on the settings so one file serves every scene.
+	// Textures are stored level by level as half floats and must be allocated before loading.
+	// The settings include the bake shader sources, editing them rebakes without a version bump.
+	class IBLCache
+	{
+	public:
+		// hash of the HDR file contents and bake settings, the file is streamed through the hash
+		static uint64_t HashEnvironment(std::string const& hdrSourcePath);
+
+		// environment cubemap, prefiltered mip chain and irradiance SH, loading fails on a missing or stale file
+		static bool LoadEnvironment(uint64_t const& key, unsigned int const& envCubeMap, unsigned int const& prefilterMap, glm::vec3(&irradianceSH)[9]);
+		static void SaveEnvironment(uint64_t const& key, unsigned int const& envCubeMap, unsigned int const& prefilterMap, glm::vec3 const(&irradianceSH)[9]);
+
+		// shared BRDF LUT
+		static bool LoadBRDFLUT(unsigned int const& brdfLUT);
+		static void SaveBRDFLUT(unsigned int const& brdfLUT);
+
+	private:
+		struct FileHeader
+		{
+			uint32_t magic{ 0 };
+			uint32_t version{ 0 };
+			uint64_t key{ 0 };
+		};
+
+		static uint64_t GetSettingsHash();
+		static bool HashFile(std::string const& sourcePath, uint64_t& hash);
+		static std::string GetCachePath(uint64_t const& key);
+		static bool ReadHeader(std::ifstream& file, uint64_t const& key);
+		static void WriteHeader(std::ofstream& file, uint64_t const& key);
+		static bool ReadLevel(std::ifstream& file, unsigned int const& target, unsigned int const& level, unsigned int const& size, unsigned int const& format, unsigned int const& components);
+		static void WriteLevel(std::ofstream& file, unsigned int const& target, unsigned int const& level, unsigned int const& size, unsigned int const& format, unsigned int const& components);
+	};
+}
+
+#endif
@@ -18,6 +18,9 @@ namespace Chroma
 
 	void Material::Serialize(ISerializer* serializer)
 	{
+		// Render Flags
+		serializer->AddProperty("m_IsOccluder", &m_IsOccluder, EditorProperty(Chroma::Type::EditorProperty::kRenderFlagProperty));
+
 		// Texture Editor Property
 		EditorProperty editorPrpty(Chroma::Type::EditorProperty::kMaterialTextureProperty);
 
@@ -129,6 +132,29 @@ namespace Chroma
 		m_Uniforms.AddUniform("metalness", m_Metalness);
 	}
 
+	unsigned int Material::GetShaderKeywords()
+	{
+		unsigned int keywords{ ShaderKeyword::kNone };
+		for (Texture& texture : m_TextureSet)
+		{
+			switch (texture.GetType())
+			{
+			case Chroma::Type::Texture::kAlbedo:
+				keywords |= ShaderKeyword::kAlbedoMap;
+				break;
+			case Chroma::Type::Texture::kNormal:
+				keywords |= ShaderKeyword::kNormalMap;
+				break;
+			case Chroma::Type::Texture::kMetRoughAO:
+				keywords |= ShaderKeyword::kMetRoughAOMap;
+				break;
+			default:
+				break;
+			}
+		}
+		return keywords;
+	}
+
 	Material::~Material()
 	{
 	}
@@ -264,10 +290,7 @@ namespace Chroma
 
 	void Material::SetPBRLightingTextureUniforms(Shader& shader)
 	{
-		// Irradiance
-		glActiveTexture(GL_TEXTURE0 + GetNumTextures() + 1);
-		shader.SetUniform("irradianceMap", GetNumTextures() + 1);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, Scene::GetIBL()->GetIrradianceMapID());
+		// Irradiance is read from the IBL uniform buffer
 		// Prefilter Map
 		glActiveTexture(GL_TEXTURE0 + GetNumTextures() + 2);
 		shader.SetUniform("prefilterMap", GetNumTextures() + 2);
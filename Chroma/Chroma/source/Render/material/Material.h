@@ -31,6 +31,9 @@ namespace Chroma
 		void SetTextureSet(std::vector<Texture> newTextureSet);
 		void AddTexture(Texture& newTexture);
 
+		// Shader keywords for the maps present in the texture set
+		unsigned int GetShaderKeywords();
+
 		// Default Properties
 		inline glm::vec2 GetUVMultiply() { return m_UVMultiply; }
 		inline void SetUVMultiply(const glm::vec2& newUV) { m_UVMultiply = newUV; }
@@ -83,6 +86,8 @@ namespace Chroma
 		inline bool GetCastsShadows() const { return m_CastShadows; }
 		inline void SetReceivesShadows(bool const& check) { m_ReceivesShadows = check; };
 		inline bool GetReceivesShadows() const { return m_ReceivesShadows; }
+		inline void SetIsOccluder(bool const& check) { m_IsOccluder = check; };
+		inline bool GetIsOccluder() const { return m_IsOccluder; }
 
 		// Scene Globals
 		inline void SetUsesSceneNoise(bool const& check) { m_UsesSceneNoise = check; };
@@ -119,6 +124,7 @@ namespace Chroma
 		bool m_CastShadows{ true };
 		bool m_ReceivesShadows{ true };
 		bool m_IsDoubleSided{ false };
+		bool m_IsOccluder{ false };
 		bool m_UsesSceneNoise{ false };
 		bool m_UsesGameTime{ false };
 	};
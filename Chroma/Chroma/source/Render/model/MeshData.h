@@ -8,6 +8,30 @@
 
 namespace Chroma
 {
+	struct MeshLOD
+	{
+		// simplified indices into the full resolution vertices
+		std::vector<unsigned int> indices;
+		// range within the element buffer
+		unsigned int indexOffset{ 0 };
+		unsigned int indexCount{ 0 };
+		// projected screen height fraction below which this LOD is used
+		float screenSize{ 0.0f };
+	};
+
+	struct Meshlet
+	{
+		// range within indices
+		unsigned int indexOffset{ 0 };
+		unsigned int indexCount{ 0 };
+		// bounding sphere
+		glm::vec3 center{ 0.0f };
+		float radius{ 0.0f };
+		// normal cone, cutoff is the sine of the cone angle, 1.0 never culls
+		glm::vec3 coneAxis{ 0.0f, 0.0f, 1.0f };
+		float coneCutoff{ 1.0f };
+	};
+
 	struct MeshData
 	{
 		// File Source Data
@@ -19,11 +43,18 @@ namespace Chroma
 		std::vector<ChromaSkinnedVertex> skinnedVerts;
 		std::vector<unsigned int> indices;
 
+		// Level Of Detail, LOD0 is indices
+		std::vector<MeshLOD> lods;
+
+		// Clusters of LOD0, culled individually
+		std::vector<Meshlet> meshlets;
+
 		// Animation
 		bool isSkinned{ false };
 
 		// Loaded
 		bool isLoaded{ false };
+		bool isLoadFailed{ false };
 		bool isRenderBuffersInitialized{ false };
 
 		// Dimensions	
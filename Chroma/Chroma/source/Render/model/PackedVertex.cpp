@@ -0,0 +1,62 @@
+#include "PackedVertex.h"
+#include <glm/gtc/packing.hpp>
+
+
+// packed joint indices and weights assume this layout
+static_assert(MAX_VERT_INFLUENCES == 4, "Packed skinned vertices store 4 influences.");
+static_assert(MAX_JOINTS <= 128, "Packed skinned vertices store 8 bit joint indices.");
+
+namespace Chroma
+{
+	ChromaPackedVertex VertexCompression::Pack(ChromaVertex const& vertex)
+	{
+		ChromaPackedVertex packed;
+		packed.m_position = vertex.m_position;
+
+		// normal and tangent frame, bitangent rebuilt in the vertex shader from its sign
+		glm::vec3 normal = glm::length(vertex.m_normal) > 0.0f ? glm::normalize(vertex.m_normal) : glm::vec3(0.0f);
+		glm::vec3 tangent = glm::length(vertex.m_tangent) > 0.0f ? glm::normalize(vertex.m_tangent) : glm::vec3(0.0f);
+		float bitangentSign = glm::dot(glm::cross(normal, tangent), vertex.m_bitangent) < 0.0f ? -1.0f : 1.0f;
+		packed.m_normal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+		packed.m_tangent = glm::packSnorm3x10_1x2(glm::vec4(tangent, bitangentSign));
+
+		// uvs and colors
+		packed.m_texCoords = glm::packHalf2x16(vertex.m_texCoords);
+		packed.m_texCoords2 = glm::packHalf2x16(vertex.m_texCoords2);
+		packed.m_color = glm::packUnorm4x8(vertex.m_color);
+
+		return packed;
+	}
+
+	ChromaPackedSkinnedVertex VertexCompression::Pack(ChromaSkinnedVertex const& vertex)
+	{
+		ChromaPackedSkinnedVertex packed;
+		static_cast<ChromaPackedVertex&>(packed) = Pack(static_cast<ChromaVertex const&>(vertex));
+
+		for (unsigned int i = 0; i < MAX_VERT_INFLUENCES; i++)
+		{
+			packed.m_jointIDs[i] = (int8_t)glm::clamp(vertex.m_jointIDs[i], 0, MAX_JOINTS - 1);
+			packed.m_jointWeights[i] = (uint16_t)glm::round(glm::clamp(vertex.m_jointWeights[i], 0.0f, 1.0f) * 65535.0f);
+		}
+
+		return packed;
+	}
+
+	std::vector<ChromaPackedVertex> VertexCompression::Pack(std::vector<ChromaVertex> const& vertices)
+	{
+		std::vector<ChromaPackedVertex> packed;
+		packed.reserve(vertices.size());
+		for (ChromaVertex const& vertex : vertices)
+			packed.push_back(Pack(vertex));
+		return packed;
+	}
+
+	std::vector<ChromaPackedSkinnedVertex> VertexCompression::Pack(std::vector<ChromaSkinnedVertex> const& vertices)
+	{
+		std::vector<ChromaPackedSkinnedVertex> packed;
+		packed.reserve(vertices.size());
+		for (ChromaSkinnedVertex const& vertex : vertices)
+			packed.push_back(Pack(vertex));
+		return packed;
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef _CHROMA_PACKED_VERTEX_
+#define _CHROMA_PACKED_VERTEX_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <model/Vertex.h>
+#include <model/SkinnedVertex.h>
+
+// GPU vertex layout, converted from ChromaVertex when render buffers are built
+struct ChromaPackedVertex
+{
+	// position
+	glm::vec3 m_position{ 0.0 };
+	// normal, 10:10:10:2 snorm
+	uint32_t m_normal{ 0 };
+	// tangent, 10:10:10:2 snorm, w stores the bitangent sign
+	uint32_t m_tangent{ 0 };
+	// uvs, half floats
+	uint32_t m_texCoords{ 0 };
+	uint32_t m_texCoords2{ 0 };
+	// colors, 8 bit unorm
+	uint32_t m_color{ 0 };
+};
+
+struct ChromaPackedSkinnedVertex : public ChromaPackedVertex
+{
+	// joint indices, 8 bit
+	int8_t m_jointIDs[MAX_VERT_INFLUENCES]{ 0 };
+	// joint weights, 16 bit unorm
+	uint16_t m_jointWeights[MAX_VERT_INFLUENCES]{ 0 };
+};
+
+namespace Chroma
+{
+	class VertexCompression
+	{
+	public:
+		static ChromaPackedVertex Pack(ChromaVertex const& vertex);
+		static ChromaPackedSkinnedVertex Pack(ChromaSkinnedVertex const& vertex);
+		static std::vector<ChromaPackedVertex> Pack(std::vector<ChromaVertex> const& vertices);
+		static std::vector<ChromaPackedSkinnedVertex> Pack(std::vector<ChromaSkinnedVertex> const& vertices);
+	};
+}
+
+#endif
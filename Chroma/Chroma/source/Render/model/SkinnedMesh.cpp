@@ -1,6 +1,7 @@
 #include "SkinnedMesh.h"
 #include <entity/IEntity.h>
 #include <resources/ModelLoader.h>
+#include <model/PackedVertex.h>
 
 
 namespace Chroma
@@ -20,39 +21,37 @@ namespace Chroma
 		// Bind buffers
 		glBindVertexArray(m_MeshData.VAO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_MeshData.VBO);
-		glBufferData(GL_ARRAY_BUFFER, m_MeshData.skinnedVerts.size() * sizeof(ChromaSkinnedVertex), &m_MeshData.skinnedVerts[0], GL_STATIC_DRAW);
+		// vertices are packed for the GPU, full precision only remains on the CPU until cleanup
+		std::vector<ChromaPackedSkinnedVertex> packedVerts = VertexCompression::Pack(m_MeshData.skinnedVerts);
+		glBufferData(GL_ARRAY_BUFFER, packedVerts.size() * sizeof(ChromaPackedSkinnedVertex), &packedVerts[0], GL_STATIC_DRAW);
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_MeshData.EBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_MeshData.indices.size() * sizeof(unsigned int),
-			&m_MeshData.indices[0], GL_STATIC_DRAW);
+		SetupIndexBuffer();
 
 		// vertex positions
 		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaPackedSkinnedVertex), (void*)0);
 		// vertex normals
 		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_normal));
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_normal));
 		// vertex uvs
 		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_texCoords));
-		// vertex tangents
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_texCoords));
+		// vertex tangents, w is the bitangent sign
 		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_tangent));
-		// vertex bitangents
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_bitangent));
+		glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_tangent));
 		// vertex bone IDs
 		glEnableVertexAttribArray(5);
-		glVertexAttribIPointer(5, MAX_VERT_INFLUENCES, GL_INT, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_jointIDs));
+		glVertexAttribIPointer(5, MAX_VERT_INFLUENCES, GL_BYTE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_jointIDs));
 		// vertex bone weights
 		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, MAX_VERT_INFLUENCES, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_jointWeights));
+		glVertexAttribPointer(6, MAX_VERT_INFLUENCES, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_jointWeights));
 		// vertex colors 
 		glEnableVertexAttribArray(7);
-		glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_color));
+		glVertexAttribPointer(7, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_color));
 		// second UV set
 		glEnableVertexAttribArray(8);
-		glVertexAttribPointer(8, 2, GL_FLOAT, GL_FALSE, sizeof(ChromaSkinnedVertex), (void*)offsetof(ChromaSkinnedVertex, ChromaSkinnedVertex::m_texCoords2));
+		glVertexAttribPointer(8, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(ChromaPackedSkinnedVertex), (void*)offsetof(ChromaPackedSkinnedVertex, ChromaPackedSkinnedVertex::m_texCoords2));
 
 		glBindVertexArray(0);
 
@@ -2,6 +2,7 @@
 #include <scene/Scene.h>
 #include <resources/ModelLoader.h>
 #include <component/PhysicsComponent.h>
+#include <model/PackedVertex.h>
 
 
 namespace Chroma
@@ -40,45 +41,16 @@ namespace Chroma
 
 	void StaticMesh::SetupMesh()
 	{
-		// Generate buffers
-		// Vertex Array Object Buffer
-		glGenVertexArrays(1, &m_MeshData.VAO);
-		// Vertex Buffer and Element Buffer
-		glGenBuffers(1, &m_MeshData.VBO);
-		glGenBuffers(1, &m_MeshData.EBO);
-
-		// Bind buffers
-		glBindVertexArray(m_MeshData.VAO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_MeshData.VBO);
-		glBufferData(GL_ARRAY_BUFFER, m_MeshData.verts.size() * sizeof(ChromaVertex), &m_MeshData.verts[0], GL_STATIC_DRAW);
-	
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_MeshData.EBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_MeshData.indices.size() * sizeof(unsigned int),
-			&m_MeshData.indices[0], GL_STATIC_DRAW);
-
-		// vertex positions
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)0);
-		// vertex normals
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_normal));
-		// vertex uvs
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_texCoords));
-		// vertex tangents
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_tangent));
-		// vertex bitangents
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_bitangent));
-		// vertex colors // is at the 7th index as 5 and 6 are used for skinning
-		glEnableVertexAttribArray(7);
-		glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_color));
-		// second UV set
-		glEnableVertexAttribArray(8);
-		glVertexAttribPointer(8, 2, GL_FLOAT, GL_FALSE, sizeof(ChromaVertex), (void*)offsetof(ChromaVertex, ChromaVertex::m_texCoords2));
-
-		glBindVertexArray(0);
+		// vertices are packed for the GPU, full precision only remains on the CPU until cleanup
+		std::vector<ChromaPackedVertex> packedVerts = VertexCompression::Pack(m_MeshData.verts);
+
+		// sub-allocate from the shared pool, its VAO serves every static mesh of the same index type
+		GeometryPool::Free(m_GeometryAllocation);
+		std::vector<unsigned int> allIndices = BuildIndexData();
+		m_GeometryAllocation = GeometryPool::Allocate(packedVerts, allIndices, m_IndexType);
+		m_MeshData.VAO = GeometryPool::GetVAO(m_IndexType);
+		m_MeshData.VBO = 0;
+		m_MeshData.EBO = 0;
 
 		// Check if Physics Component needs update
 		if (GetParentEntity()->GetPhysicsComponentUIDs().size() > 0)
@@ -87,6 +59,14 @@ namespace Chroma
 			static_cast<PhysicsComponent*>(Scene::GetComponent(GetParentEntity()->GetPhysicsComponentUIDs()[0]))->UpdateCollisionShape();
 		}
 
+		// Keep CPU positions for occlusion culling and VXGI brick occupancy
+		if (GetIsOccluder() || GetIsStatic())
+		{
+			m_OccluderPositions.clear();
+			for (ChromaVertex const& vert : m_MeshData.verts)
+				m_OccluderPositions.push_back(vert.m_position);
+		}
+
 		// Cleanup
 		CleanUp();
 
@@ -134,10 +114,14 @@ namespace Chroma
 
 	void StaticMesh::BindDrawVAO()
 	{
+		// merged into a static batch, drawn from there
+		if (GetIsStaticBatched())
+			return;
+
 		if (m_MeshData.isRenderBuffersInitialized)
 		{
 			glBindVertexArray(m_MeshData.VAO);
-			glDrawElements(GL_TRIANGLES, m_MeshData.indices.size(), GL_UNSIGNED_INT, 0);
+			DrawElements();
 			glBindVertexArray(0); // reset to default
 		}
 		else if (m_MeshData.isRenderBuffersInitialized == false && m_MeshData.isLoaded)
@@ -152,11 +136,19 @@ namespace Chroma
 		m_MeshData.verts.clear();
 		// indices
 		m_MeshData.indices.clear();
-		// vao
-		glDeleteVertexArrays(1, &m_MeshData.VAO);
-		// buffers
-		glDeleteBuffers(1, &m_MeshData.VBO);
-		glDeleteBuffers(1, &m_MeshData.EBO);
+		// occluder
+		m_OccluderPositions.clear();
+		// pooled geometry is returned, primitives own their buffers
+		if (GetIsGeometryPooled())
+			GeometryPool::Free(m_GeometryAllocation);
+		else
+		{
+			// vao
+			glDeleteVertexArrays(1, &m_MeshData.VAO);
+			// buffers
+			glDeleteBuffers(1, &m_MeshData.VBO);
+			glDeleteBuffers(1, &m_MeshData.EBO);
+		}
 
 		CMPNT_DESTROYED
 	}
@@ -174,6 +166,9 @@ namespace Chroma
 		// File Properties
 		serializer->AddProperty("m_SourcePath", &m_MeshData.sourcePath);
 
+		// Render Flags
+		serializer->AddProperty("m_IsStatic", &m_IsStatic, EditorProperty(Chroma::Type::EditorProperty::kRenderFlagProperty));
+
 		// Material 
 		m_Material.Serialize(serializer);
 	}
@@ -181,8 +176,9 @@ namespace Chroma
 
 	void StaticMesh::CleanUp()
 	{
-		// verts
-		m_MeshData.verts.clear();
+		// verts, static meshes keep theirs until batched
+		if (!GetIsStatic() || GetIsStaticBatched())
+			m_MeshData.verts.clear();
 		// textures
 		m_MeshData.textures.clear();
 		CHROMA_INFO("Static Mesh Component : {0} Cleaned Up", m_UID.m_Data );
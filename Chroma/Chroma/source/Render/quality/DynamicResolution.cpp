@@ -0,0 +1,65 @@
+#include "DynamicResolution.h"
+
+namespace Chroma
+{
+	GPUTimer* DynamicResolution::m_FrameTimer{ nullptr };
+	bool DynamicResolution::m_Enabled{ DYNAMIC_RESOLUTION_ENABLED };
+	float DynamicResolution::m_TargetFrameTime{ DYNAMIC_RESOLUTION_TARGET_FRAME_TIME };
+	float DynamicResolution::m_RenderScale{ DYNAMIC_RESOLUTION_MAX_SCALE };
+	float DynamicResolution::m_GPUFrameTime{ 0.0f };
+	unsigned int DynamicResolution::m_FramesSinceChange{ 0 };
+
+	void DynamicResolution::Init()
+	{
+		m_FrameTimer = new GPUTimer();
+	}
+
+	void DynamicResolution::BeginFrame()
+	{
+		m_FrameTimer->Begin();
+	}
+
+	bool DynamicResolution::EndFrame()
+	{
+		m_FrameTimer->End();
+
+		// smoothed, single frame spikes shouldn't drop resolution
+		float const frameTime = m_FrameTimer->GetMilliseconds();
+		m_GPUFrameTime = m_GPUFrameTime == 0.0f ? frameTime : glm::mix(m_GPUFrameTime, frameTime, 0.1f);
+		m_FramesSinceChange++;
+
+		if (!m_Enabled || m_GPUFrameTime == 0.0f || m_FramesSinceChange < DYNAMIC_RESOLUTION_COOLDOWN_FRAMES)
+			return false;
+
+		float const renderScale = ComputeRenderScale();
+		if (renderScale == m_RenderScale)
+			return false;
+
+		m_RenderScale = renderScale;
+		m_FramesSinceChange = 0;
+		return true;
+	}
+
+	void DynamicResolution::SetEnabled(bool const& enabled)
+	{
+		m_Enabled = enabled;
+		m_FramesSinceChange = 0;
+	}
+
+	float DynamicResolution::ComputeRenderScale()
+	{
+		// quantized to steps so small fluctuations don't resize targets
+		float const step = DYNAMIC_RESOLUTION_STEP;
+		float renderScale{ m_RenderScale };
+		if (m_GPUFrameTime > m_TargetFrameTime * DYNAMIC_RESOLUTION_DOWNSCALE_THRESHOLD)
+		{
+			// pixel cost scales with area, aim just under budget
+			float const targetScale = m_RenderScale * std::sqrt(m_TargetFrameTime * DYNAMIC_RESOLUTION_DOWNSCALE_THRESHOLD / m_GPUFrameTime);
+			renderScale = std::floor(std::max(targetScale, m_RenderScale - step * 2.0f) / step + 1e-3f) * step;
+		}
+		else if (m_GPUFrameTime < m_TargetFrameTime * DYNAMIC_RESOLUTION_UPSCALE_THRESHOLD)
+			renderScale = std::round(m_RenderScale / step + 1.0f) * step;
+
+		return glm::clamp(renderScale, DYNAMIC_RESOLUTION_MIN_SCALE, DYNAMIC_RESOLUTION_MAX_SCALE);
+	}
+}
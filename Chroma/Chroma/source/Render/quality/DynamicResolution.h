@@ -0,0 +1,44 @@
+#ifndef _CHROMA_DYNAMIC_RESOLUTION_
+#define _CHROMA_DYNAMIC_RESOLUTION_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <quality/GPUTimer.h>
+
+namespace Chroma
+{
+	// Scales the internal render resolution to keep the GPU frame time under budget.
+	// The frame is timed with timestamp queries, the scale steps down when over budget
+	// and back up once there's headroom, with a cooldown so changes settle before the next.
+	class DynamicResolution
+	{
+	public:
+		static void Init();
+
+		// wrap the frame's GPU work, returns true when the render scale changed
+		static void BeginFrame();
+		static bool EndFrame();
+
+		static void SetEnabled(bool const& enabled);
+		static inline bool GetIsEnabled() { return m_Enabled; }
+		static inline void SetTargetFrameTime(float const& milliseconds) { m_TargetFrameTime = milliseconds; }
+		static inline float GetTargetFrameTime() { return m_TargetFrameTime; }
+
+		static inline float GetRenderScale() { return m_RenderScale; }
+		static inline float GetGPUFrameTime() { return m_GPUFrameTime; }
+
+	private:
+		static GPUTimer* m_FrameTimer;
+		static bool m_Enabled;
+		static float m_TargetFrameTime;
+		static float m_RenderScale;
+		static float m_GPUFrameTime;
+		static unsigned int m_FramesSinceChange;
+
+		static float ComputeRenderScale();
+	};
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include "GPUTimer.h"
+
+namespace Chroma
+{
+	void GPUTimer::Begin()
+	{
+		glQueryCounter(m_Queries[m_Index][0], GL_TIMESTAMP);
+	}
+
+	void GPUTimer::End()
+	{
+		glQueryCounter(m_Queries[m_Index][1], GL_TIMESTAMP);
+		m_Issued[m_Index] = true;
+		m_Index = (m_Index + 1) % GPU_TIMER_QUERY_LATENCY;
+		Resolve();
+	}
+
+	void GPUTimer::Resolve()
+	{
+		// oldest pair, reused next
+		if (!m_Issued[m_Index])
+			return;
+		GLint available{ GL_FALSE };
+		glGetQueryObjectiv(m_Queries[m_Index][1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available != GL_TRUE)
+			return;
+
+		GLuint64 start{ 0 }, end{ 0 };
+		glGetQueryObjectui64v(m_Queries[m_Index][0], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(m_Queries[m_Index][1], GL_QUERY_RESULT, &end);
+		m_Milliseconds = end > start ? (float)(end - start) / 1000000.0f : 0.0f;
+		m_Issued[m_Index] = false;
+	}
+
+	GPUTimer::GPUTimer()
+	{
+		glGenQueries(GPU_TIMER_QUERY_LATENCY * 2, &m_Queries[0][0]);
+		for (bool& issued : m_Issued)
+			issued = false;
+	}
+
+	GPUTimer::~GPUTimer()
+	{
+		glDeleteQueries(GPU_TIMER_QUERY_LATENCY * 2, &m_Queries[0][0]);
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef _CHROMA_GPU_TIMER_
+#define _CHROMA_GPU_TIMER_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// GPU time between Begin and End, measured with timestamp queries so timers can nest.
+	// Queries are read back a few frames later, so the result lags but never stalls.
+	class GPUTimer
+	{
+	public:
+		void Begin();
+		void End();
+
+		// latest resolved time in milliseconds, 0 until the first result arrives
+		inline float GetMilliseconds() const { return m_Milliseconds; }
+
+		GPUTimer();
+		~GPUTimer();
+
+	private:
+		unsigned int m_Queries[GPU_TIMER_QUERY_LATENCY][2];
+		bool m_Issued[GPU_TIMER_QUERY_LATENCY];
+		unsigned int m_Index{ 0 };
+		float m_Milliseconds{ 0.0f };
+
+		void Resolve();
+	};
+}
+
+#endif
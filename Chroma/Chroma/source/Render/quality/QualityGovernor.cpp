@@ -0,0 +1,102 @@
+#include "QualityGovernor.h"
+#include <quality/DynamicResolution.h>
+
+namespace Chroma
+{
+	std::vector<GPUTimer*> QualityGovernor::m_FeatureTimers;
+	std::deque<std::string> QualityGovernor::m_Decisions;
+	QualityTier QualityGovernor::m_MaxTier{ (QualityTier)RENDER_QUALITY_DEFAULT_TIER };
+	bool QualityGovernor::m_Enabled{ QUALITY_GOVERNOR_ENABLED };
+	unsigned int QualityGovernor::m_FramesSinceChange{ 0 };
+
+	void QualityGovernor::Init()
+	{
+		for (unsigned int i = 0; i < (unsigned int)RenderFeature::kNumFeatures; i++)
+			m_FeatureTimers.push_back(new GPUTimer());
+	}
+
+	void QualityGovernor::Update()
+	{
+		m_FramesSinceChange++;
+		float const gpuFrameTime = DynamicResolution::GetGPUFrameTime();
+		if (!m_Enabled || gpuFrameTime == 0.0f || m_FramesSinceChange < QUALITY_GOVERNOR_COOLDOWN_FRAMES)
+			return;
+
+		// resolution scaling takes the first step either way
+		float const targetFrameTime = DynamicResolution::GetTargetFrameTime();
+		bool const resolutionAtMin = !DynamicResolution::GetIsEnabled() || DynamicResolution::GetRenderScale() <= DYNAMIC_RESOLUTION_MIN_SCALE;
+		bool const resolutionAtMax = !DynamicResolution::GetIsEnabled() || DynamicResolution::GetRenderScale() >= DYNAMIC_RESOLUTION_MAX_SCALE;
+		unsigned int const tier = (unsigned int)RenderQuality::GetTier();
+
+		if (gpuFrameTime > targetFrameTime * DYNAMIC_RESOLUTION_DOWNSCALE_THRESHOLD && resolutionAtMin && tier > 0)
+		{
+			StepTier((QualityTier)(tier - 1), "over budget");
+		}
+		else if (gpuFrameTime < targetFrameTime * DYNAMIC_RESOLUTION_UPSCALE_THRESHOLD && resolutionAtMax && tier < (unsigned int)m_MaxTier)
+		{
+			// only when the next tier's added cost still fits under the downscale threshold
+			QualityTier const nextTier = (QualityTier)(tier + 1);
+			float const stepUpCost = EstimateStepUpCost(RenderQuality::GetSettings(), RenderQuality::GetTierSettings(nextTier));
+			if (gpuFrameTime + stepUpCost < targetFrameTime * DYNAMIC_RESOLUTION_DOWNSCALE_THRESHOLD)
+				StepTier(nextTier, "headroom, estimated cost " + std::to_string(stepUpCost) + " ms");
+		}
+	}
+
+	const char* QualityGovernor::GetFeatureName(RenderFeature const& feature)
+	{
+		static const char* names[]{ "Shadows", "Deferred", "SSAO", "SSR", "VXGI", "PostFX" };
+		return feature < RenderFeature::kNumFeatures ? names[(unsigned int)feature] : "Unknown";
+	}
+
+	void QualityGovernor::SetEnabled(bool const& enabled)
+	{
+		m_Enabled = enabled;
+		m_FramesSinceChange = 0;
+	}
+
+	void QualityGovernor::SetMaxTier(QualityTier const& tier)
+	{
+		m_MaxTier = tier;
+		m_FramesSinceChange = 0;
+		RenderQuality::SetTier(tier);
+	}
+
+	float QualityGovernor::EstimateStepUpCost(QualitySettings const& current, QualitySettings const& next)
+	{
+		// last measured costs scaled by the change in work, features never measured are assumed free
+		float cost{ 0.0f };
+		if (next.vxgi && !current.vxgi)
+			cost += GetFeatureTime(RenderFeature::kVXGI);
+		if (next.bloom && !current.bloom)
+			cost += GetFeatureTime(RenderFeature::kPostFX) * 0.5f;
+
+		// traced pixels scale with the square of the divisor
+		float const ssaoWork = (float)(current.ssaoResolutionDivisor * current.ssaoResolutionDivisor) / (float)(next.ssaoResolutionDivisor * next.ssaoResolutionDivisor)
+			* (float)next.ssaoKernelSamples / (float)current.ssaoKernelSamples;
+		cost += GetFeatureTime(RenderFeature::kSSAO) * std::max(ssaoWork - 1.0f, 0.0f);
+		float const ssrWork = (float)(current.ssrResolutionDivisor * current.ssrResolutionDivisor) / (float)(next.ssrResolutionDivisor * next.ssrResolutionDivisor);
+		cost += GetFeatureTime(RenderFeature::kSSR) * std::max(ssrWork - 1.0f, 0.0f);
+
+		// shadow cost is dominated by casters drawn per cascade, fill grows with the map size
+		float const shadowWork = (float)next.shadowCascades / (float)current.shadowCascades
+			* std::sqrt((float)next.shadowMapSize / (float)current.shadowMapSize);
+		cost += GetFeatureTime(RenderFeature::kShadows) * std::max(shadowWork - 1.0f, 0.0f);
+		return cost;
+	}
+
+	void QualityGovernor::StepTier(QualityTier const& tier, std::string const& reason)
+	{
+		std::string decision = std::string(RenderQuality::GetTierName(RenderQuality::GetTier())) + " -> " + RenderQuality::GetTierName(tier)
+			+ " : " + reason + ", GPU " + std::to_string(DynamicResolution::GetGPUFrameTime()) + " ms";
+		for (unsigned int i = 0; i < (unsigned int)RenderFeature::kNumFeatures; i++)
+			decision += std::string(", ") + GetFeatureName((RenderFeature)i) + " " + std::to_string(GetFeatureTime((RenderFeature)i)) + " ms";
+		CHROMA_INFO("QUALITY GOVERNOR :: {0}", decision);
+
+		m_Decisions.push_front(decision);
+		if (m_Decisions.size() > QUALITY_GOVERNOR_MAX_DECISIONS)
+			m_Decisions.pop_back();
+
+		RenderQuality::SetTier(tier);
+		m_FramesSinceChange = 0;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef _CHROMA_QUALITY_GOVERNOR_
+#define _CHROMA_QUALITY_GOVERNOR_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <quality/GPUTimer.h>
+#include <quality/RenderQuality.h>
+
+namespace Chroma
+{
+	// Passes with their GPU cost tracked
+	enum class RenderFeature : unsigned int
+	{
+		kShadows = 0,
+		kDeferred,
+		kSSAO,
+		kSSR,
+		kVXGI,
+		kPostFX,
+		kNumFeatures
+	};
+
+	// Steps the quality tier to hold the GPU frame time budget. Dynamic resolution responds
+	// first, the tier only steps down once the render scale is at its minimum and back up
+	// once it's at its maximum with enough headroom for the features the next tier adds.
+	// Never steps above the tier chosen by the user.
+	class QualityGovernor
+	{
+	public:
+		static void Init();
+		// once per frame, after the frame's GPU time is resolved
+		static void Update();
+
+		// per feature GPU cost
+		static inline void BeginFeature(RenderFeature const& feature) { m_FeatureTimers[(unsigned int)feature]->Begin(); }
+		static inline void EndFeature(RenderFeature const& feature) { m_FeatureTimers[(unsigned int)feature]->End(); }
+		static inline float GetFeatureTime(RenderFeature const& feature) { return m_FeatureTimers[(unsigned int)feature]->GetMilliseconds(); }
+		static const char* GetFeatureName(RenderFeature const& feature);
+
+		static void SetEnabled(bool const& enabled);
+		static inline bool GetIsEnabled() { return m_Enabled; }
+		static void SetMaxTier(QualityTier const& tier);
+		static inline QualityTier GetMaxTier() { return m_MaxTier; }
+
+		// most recent first
+		static inline std::deque<std::string> const& GetDecisions() { return m_Decisions; }
+
+	private:
+		static std::vector<GPUTimer*> m_FeatureTimers;
+		static std::deque<std::string> m_Decisions;
+		static QualityTier m_MaxTier;
+		static bool m_Enabled;
+		static unsigned int m_FramesSinceChange;
+
+		static float EstimateStepUpCost(QualitySettings const& current, QualitySettings const& next);
+		static void StepTier(QualityTier const& tier, std::string const& reason);
+	};
+}
+
+#endif
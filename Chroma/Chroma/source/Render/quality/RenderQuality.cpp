@@ -0,0 +1,55 @@
+#include "RenderQuality.h"
+
+namespace Chroma
+{
+	QualityTier RenderQuality::m_Tier{ (QualityTier)RENDER_QUALITY_DEFAULT_TIER };
+	QualitySettings RenderQuality::m_Settings{ RenderQuality::GetTierSettings((QualityTier)RENDER_QUALITY_DEFAULT_TIER) };
+
+	void RenderQuality::SetTier(QualityTier const& tier)
+	{
+		if (tier >= QualityTier::kNumTiers || tier == m_Tier)
+			return;
+		m_Tier = tier;
+		m_Settings = GetTierSettings(tier);
+		CHROMA_INFO("RENDER QUALITY :: Tier set to : {0}", GetTierName(tier));
+	}
+
+	QualitySettings RenderQuality::GetTierSettings(QualityTier const& tier)
+	{
+		QualitySettings settings;
+		switch (tier)
+		{
+		case QualityTier::kLow:
+			settings.ssaoResolutionDivisor = 4;
+			settings.ssrResolutionDivisor = 4;
+			settings.ssaoKernelSamples = 8;
+			settings.shadowCascades = 1;
+			settings.shadowMapSize = 1024;
+			settings.vxgi = false;
+			settings.bloom = false;
+			break;
+		case QualityTier::kMedium:
+			settings.ssaoResolutionDivisor = 2;
+			settings.ssrResolutionDivisor = 2;
+			settings.ssaoKernelSamples = 12;
+			settings.shadowCascades = 2;
+			settings.shadowMapSize = 2048;
+			settings.vxgi = false;
+			break;
+		case QualityTier::kHigh:
+			settings.ssaoResolutionDivisor = 2;
+			settings.ssrResolutionDivisor = 1;
+			settings.shadowMapSize = 2048;
+			break;
+		default:
+			break;
+		}
+		return settings;
+	}
+
+	const char* RenderQuality::GetTierName(QualityTier const& tier)
+	{
+		static const char* names[]{ "Low", "Medium", "High", "Ultra" };
+		return tier < QualityTier::kNumTiers ? names[(unsigned int)tier] : "Unknown";
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef _CHROMA_RENDER_QUALITY_
+#define _CHROMA_RENDER_QUALITY_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	enum class QualityTier : unsigned int
+	{
+		kLow = 0,
+		kMedium = 1,
+		kHigh = 2,
+		kUltra = 3,
+		kNumTiers
+	};
+
+	// Render settings scaled by quality tier
+	struct QualitySettings
+	{
+		// screen space effects trace at 1/divisor of the screen resolution, 1, 2 or 4
+		unsigned int ssaoResolutionDivisor{ 1 };
+		unsigned int ssrResolutionDivisor{ 1 };
+		unsigned int ssaoKernelSamples{ 16 };
+		// shadows
+		unsigned int shadowCascades{ SHADOW_NUMCASCADES };
+		unsigned int shadowMapSize{ 4096 };
+		// features the editor can also switch off
+		bool vxgi{ true };
+		bool bloom{ true };
+	};
+
+	// Active quality tier, buffers read the settings when they draw
+	class RenderQuality
+	{
+	public:
+		static void SetTier(QualityTier const& tier);
+		static inline QualityTier GetTier() { return m_Tier; }
+		static inline QualitySettings const& GetSettings() { return m_Settings; }
+
+		static QualitySettings GetTierSettings(QualityTier const& tier);
+		static const char* GetTierName(QualityTier const& tier);
+
+	private:
+		static QualityTier m_Tier;
+		static QualitySettings m_Settings;
+	};
+}
+
+#endif
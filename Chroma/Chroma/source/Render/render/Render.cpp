@@ -2,6 +2,7 @@
 #include <Editor/ui/EditorUI.h>
 #include <ubo/UniformBufferCamera.h>
 #include <ubo/UniformBufferLighting.h>
+#include <ubo/UniformBufferIBL.h>
 #include <event/CameraEvent.h>
 #include <window/Window.h>
 #include <buffer/GBuffer.h>
@@ -11,6 +12,11 @@
 #include <buffer/SSRBuffer.h>
 #include <buffer/EditorViewportBuffer.h>
 #include <buffer/VXGIBuffer.h>
+#include <buffer/DownsampleBuffer.h>
+#include <shader/ShaderCache.h>
+#include <quality/DynamicResolution.h>
+#include <quality/QualityGovernor.h>
+#include <graph/RenderGraph.h>
 
 namespace Chroma
 {
@@ -32,29 +38,25 @@ namespace Chroma
 	// Shadow Buffer
 	IFramebuffer* Render::m_ShadowBuffer;
 
-	// Graphics Debug
-	IFramebuffer* Render::m_GraphicsDebugBuffer;
-
 	// Editor Viewport
-	IFramebuffer* Render::m_EditorViewportBuffer;
+	IFramebuffer* Render::m_EditorViewportBuffer{ nullptr };
 
 	// VXGI
-	IFramebuffer* Render::m_VXGIBuffer;
+	IFramebuffer* Render::m_VXGIBuffer{ nullptr };
+	bool Render::m_VXGIWasEnabled{ false };
+
+	// Downsampled Depth and Normals
+	std::vector<DownsampleBuffer*> Render::m_DownsampleBuffers;
 
 	// Uniform Buffer Objects
 	UniformBuffer* Render::m_UBOCamera;
 	UniformBuffer* Render::m_UBOLighting;
+	UniformBuffer* Render::m_UBOIBL;
 	std::vector<UniformBuffer*> Render::m_UniformBufferObjects;
 
 	// Buffer Textures
-	// - positions
-	unsigned int Render::m_WSPositions;
-	unsigned int Render::m_VSPositions;
-	// - normals 
-	unsigned int Render::m_WSNormals;
-	unsigned int Render::m_VSNormals;
-	// - lightSpace 
-	unsigned int Render::m_FragPosLightSpace;
+	// - world space normals, octahedral encoded
+	unsigned int Render::m_Normals;
 	// - albedo	
 	unsigned int Render::m_Albedo;
 	// - MetRoughAO
@@ -65,6 +67,12 @@ namespace Chroma
 	unsigned int Render::m_DirectLightingShadows;
 	unsigned int Render::m_IndirectLighting;
 
+	// Resolution
+	int Render::m_OutputWidth{ SCREEN_WIDTH };
+	int Render::m_OutputHeight{ SCREEN_HEIGHT };
+	int Render::m_RenderWidth{ SCREEN_WIDTH };
+	int Render::m_RenderHeight{ SCREEN_HEIGHT };
+
 	// API
 	Render::API Render::s_API;
 
@@ -72,18 +80,10 @@ namespace Chroma
 	{
 		// DEBUG BUFFER
 		m_DebugBuffer->ClearColorAndDepth();
-	}
-
-	void Render::RenderDefferedComponents()
-	{
-		// DEFFERED BUFFER
-		m_GBuffer->Draw();
-	}
 
-	void Render::RenderForwardComponents()
-	{
-		// FORWARD BUFFER
-		m_ForwardBuffer->Draw();
+		// DOWNSAMPLED DEPTH AND NORMALS
+		for (DownsampleBuffer* downsampleBuffer : m_DownsampleBuffers)
+			downsampleBuffer->Invalidate();
 	}
 
 	void Render::RenderDebug()
@@ -92,8 +92,11 @@ namespace Chroma
 #ifdef EDITOR
 		// DEBUG BUFFER 
 		m_EditorViewportBuffer->Bind();
+		// drawn over the upscaled output
+		glViewport(0, 0, m_OutputWidth, m_OutputHeight);
 		// TODO : not implemented, faking it!
 		m_DebugBuffer->DrawOverlay(m_EditorViewportBuffer);
+		SetRenderViewport();
 		m_EditorViewportBuffer->UnBind();
 #else
 
@@ -102,42 +105,184 @@ namespace Chroma
 #endif
 	}
 
-	void Render::RenderPostFX()
+	void Render::BuildGraph()
 	{
 		CHROMA_PROFILE_FUNCTION();
-		// SSR
-		m_SSRBuffer->Draw();
-
+		// features switched off by the quality tier
+		QualitySettings const& quality = RenderQuality::GetSettings();
 #ifdef EDITOR
+		bool const vxgiEnabled = EditorUI::m_VXGI && quality.vxgi;
+		bool const bloomEnabled = EditorUI::m_Bloom && quality.bloom;
+		if (!m_VXGIWasEnabled && vxgiEnabled)
+		{
+			// voxels are only allocated once enabled
+			if (m_VXGIBuffer == nullptr)
+			{
+				m_VXGIBuffer = new VXGIBuffer();
+				m_VXGIBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+			}
+			// lighting may have changed while disabled, static voxels are rebuilt
+			else
+				static_cast<VXGIBuffer*>(m_VXGIBuffer)->InvalidateVoxels();
+		}
+		m_VXGIWasEnabled = vxgiEnabled;
+		bool const vxgiReady = vxgiEnabled && m_VXGIBuffer->GetIsReady();
+		unsigned int const outputFBO = m_EditorViewportBuffer->GetFBO();
+		unsigned int const outputTexture = m_EditorViewportBuffer->GetTexture();
+#else
+		bool const vxgiReady{ false };
+		bool const bloomEnabled = quality.bloom;
+		unsigned int const outputFBO{ 0 };
+		unsigned int const outputTexture{ 0 };
+#endif
+		PostFXBuffer* postFXBuffer = static_cast<PostFXBuffer*>(m_PostFXBuffer);
+
+		// targets with state across frames are owned by their buffers
+		unsigned int const shadowMap = RenderGraph::ImportTexture("ShadowMap", m_ShadowBuffer->GetTexture());
+		unsigned int const depth = RenderGraph::ImportTexture("Depth", m_Depth);
+		unsigned int const normals = RenderGraph::ImportTexture("Normals", m_Normals);
+		unsigned int const albedo = RenderGraph::ImportTexture("Albedo", m_Albedo);
+		unsigned int const metRoughAO = RenderGraph::ImportTexture("MetRoughAO", m_MetRoughAO);
+		unsigned int const directLighting = RenderGraph::ImportTexture("DirectLighting", m_DirectLightingShadows);
+		unsigned int const indirectLighting = RenderGraph::ImportTexture("IndirectLighting", m_IndirectLighting);
+		unsigned int const ssao = RenderGraph::ImportTexture("SSAO", static_cast<GBuffer*>(m_GBuffer)->GetSSAOTexture());
+		unsigned int const sceneColor = RenderGraph::ImportTexture("SceneColor", m_PostFXBuffer->GetTexture());
+		unsigned int const forwardColor = RenderGraph::ImportTexture("ForwardColor", m_ForwardBuffer->GetTexture());
+		// disabled features read as black
+		unsigned int const vxgi = RenderGraph::ImportTexture("VXGI", vxgiReady ? m_VXGIBuffer->GetTexture() : 0);
+		unsigned int const output = RenderGraph::ImportTexture("Output", outputTexture);
+		RenderGraph::SetOutput(output);
 
-		
-		if (EditorUI::m_VXGI && EditorUI::m_VXGIVisualization)
+		// Shadows
+		if (m_ShadowBuffer->GetIsReady())
 		{
-			// VXGI
-			static_cast<VXGIBuffer*>(m_VXGIBuffer)->Draw(EditorUI::m_VXGIVisualization);
-			m_EditorViewportBuffer->CopyColor(m_VXGIBuffer->GetFBO(), m_EditorViewportBuffer->GetFBO());
+			RenderGraph::AddPass("Shadows", {}, { shadowMap }, []
+			{
+				QualityGovernor::BeginFeature(RenderFeature::kShadows);
+				static_cast<ShadowBuffer*>(m_ShadowBuffer)->DrawShadowMaps();
+				QualityGovernor::EndFeature(RenderFeature::kShadows);
+			});
 		}
-		else if (EditorUI::m_VXGI)
+
+		// Deferred
+		if (m_GBuffer->GetIsReady())
 		{
-			// VXGI
-			static_cast<VXGIBuffer*>(m_VXGIBuffer)->Draw(false);
-			// POSTFX 
-			m_EditorViewportBuffer->BindAndClear();
-			static_cast<PostFXBuffer*>(m_PostFXBuffer)->Draw(EditorUI::m_Bloom);
+			RenderGraph::AddPass("Deferred", { shadowMap }, { depth, normals, albedo, metRoughAO, directLighting, indirectLighting, ssao, sceneColor }, []
+			{
+				QualityGovernor::BeginFeature(RenderFeature::kDeferred);
+				m_GBuffer->Draw();
+				QualityGovernor::EndFeature(RenderFeature::kDeferred);
+			});
+		}
+
+		// Forward, drawn over the deferred frame
+		RenderGraph::AddPass("Forward", { sceneColor, depth }, { sceneColor, forwardColor }, []
+		{
+			m_ForwardBuffer->Draw();
+		});
+
+		// SSR
+		unsigned int ssrUVs;
+		if (m_SSRBuffer->GetIsReady())
+		{
+			unsigned int const divisor = static_cast<SSRBuffer*>(m_SSRBuffer)->UpdateResolutionDivisor();
+			ssrUVs = RenderGraph::CreateTexture("SSR", { GL_RGBA8, 1, GL_NEAREST });
+			std::vector<unsigned int> ssrWrites{ ssrUVs };
+			// reduced resolution trace only lives within the pass
+			if (divisor > 1)
+				ssrWrites.push_back(RenderGraph::CreateTexture("SSRTrace", { GL_RGBA8, divisor, GL_NEAREST }));
+			RenderGraph::AddPass("SSR", { depth, normals, albedo }, ssrWrites, [ssrWrites]
+			{
+				QualityGovernor::BeginFeature(RenderFeature::kSSR);
+				SSRBuffer* ssrBuffer = static_cast<SSRBuffer*>(m_SSRBuffer);
+				ssrBuffer->SetTargets(RenderGraph::GetTexture(ssrWrites[0]), ssrWrites.size() > 1 ? RenderGraph::GetTexture(ssrWrites[1]) : 0);
+				ssrBuffer->Draw();
+				QualityGovernor::EndFeature(RenderFeature::kSSR);
+			});
 		}
 		else
+			ssrUVs = RenderGraph::ImportTexture("SSR", 0);
+
+		// nothing to present until the post fx programs have linked
+		if (!m_PostFXBuffer->GetIsReady())
 		{
-			// POSTFX 
-			m_EditorViewportBuffer->BindAndClear();
-			static_cast<PostFXBuffer*>(m_PostFXBuffer)->Draw(EditorUI::m_Bloom);
+#ifdef EDITOR
+			RenderGraph::AddPass("Clear", {}, { output }, []
+			{
+				m_EditorViewportBuffer->BindAndClear();
+				m_EditorViewportBuffer->UnBind();
+			});
+#endif
+			return;
+		}
 
+#ifdef EDITOR
+		if (vxgiReady && EditorUI::m_VXGIVisualization)
+		{
+			// voxels drawn in place of the frame
+			RenderGraph::AddPass("VXGI Visualization", { depth }, { output }, []
+			{
+				static_cast<VXGIBuffer*>(m_VXGIBuffer)->Draw(EditorUI::m_VXGIVisualization);
+				m_EditorViewportBuffer->CopyColor(m_VXGIBuffer->GetFBO(), m_EditorViewportBuffer->GetFBO());
+			});
+		}
+		else
+		{
+			// VXGI
+			if (vxgiReady)
+			{
+				RenderGraph::AddPass("VXGI", { shadowMap, depth, normals, albedo }, { vxgi }, []
+				{
+					QualityGovernor::BeginFeature(RenderFeature::kVXGI);
+					static_cast<VXGIBuffer*>(m_VXGIBuffer)->Draw(false);
+					QualityGovernor::EndFeature(RenderFeature::kVXGI);
+				});
+			}
+#endif
+			// Bloom, culled when the composite doesn't sample it
+			unsigned int const bloomPing = RenderGraph::CreateTexture("BloomPing", { GL_RGB16F, 1, GL_LINEAR });
+			unsigned int const bloomPong = RenderGraph::CreateTexture("BloomPong", { GL_RGB16F, 1, GL_LINEAR });
+			RenderGraph::AddPass("Bloom", { sceneColor }, { bloomPing, bloomPong }, [postFXBuffer, bloomPing, bloomPong]
+			{
+				postFXBuffer->DrawBloom(RenderGraph::GetTexture(bloomPing), RenderGraph::GetTexture(bloomPong));
+			});
+
+			// Composite, below output resolution into a render resolution target then upscaled
+			bool const isUpscaling = postFXBuffer->GetIsUpscaling();
+			unsigned int const composite = isUpscaling ? RenderGraph::CreateTexture("Composite", { GL_RGBA16F, 1, GL_LINEAR }) : output;
+			std::vector<unsigned int> compositeReads{ sceneColor, forwardColor, directLighting, indirectLighting, ssrUVs, vxgi, ssao, metRoughAO, depth };
+			if (bloomEnabled)
+				compositeReads.push_back(bloomPing);
+			RenderGraph::AddPass("Composite", compositeReads, { composite }, [postFXBuffer, isUpscaling, composite, outputFBO, bloomEnabled, bloomPing, ssrUVs, vxgi]
+			{
+				QualityGovernor::BeginFeature(RenderFeature::kPostFX);
+				if (isUpscaling)
+					postFXBuffer->BindCompositeTarget(RenderGraph::GetTexture(composite));
+				else
+					glBindFramebuffer(GL_FRAMEBUFFER, outputFBO);
+				postFXBuffer->DrawComposite(bloomEnabled ? RenderGraph::GetTexture(bloomPing) : 0, RenderGraph::GetTexture(ssrUVs), RenderGraph::GetTexture(vxgi));
+				postFXBuffer->UnBind();
+				if (!isUpscaling)
+					QualityGovernor::EndFeature(RenderFeature::kPostFX);
+			});
+			if (isUpscaling)
+			{
+				RenderGraph::AddPass("Upscale", { composite }, { output }, [postFXBuffer, composite, outputFBO]
+				{
+					postFXBuffer->Upscale(RenderGraph::GetTexture(composite), outputFBO);
+					postFXBuffer->UnBind();
+					QualityGovernor::EndFeature(RenderFeature::kPostFX);
+				});
+			}
+#ifdef EDITOR
 		}
-		m_EditorViewportBuffer->UnBind();
-#else
-		static_cast<PostFXBuffer*>(m_PostFXBuffer)->UnBind();
-		static_cast<PostFXBuffer*>(m_PostFXBuffer)->Draw(true);
 #endif
 
+		// Debug, drawn over the output
+		RenderGraph::AddPass("Debug", { sceneColor, depth }, { output }, []
+		{
+			RenderDebug();
+		}, true);
 	}
 
 	void Render::GenerateUniformBufferObjects()
@@ -149,11 +294,16 @@ namespace Chroma
 		// Lighting and Shadow Uniforms
 		m_UBOLighting = new UniformBufferLighting();
 		m_UniformBufferObjects.push_back(m_UBOLighting);
+
+		// Image Based Lighting irradiance
+		m_UBOIBL = new UniformBufferIBL();
+		m_UniformBufferObjects.push_back(m_UBOIBL);
 	}
 
 	void Render::UpdateUniformBufferObjects()
 	{
 		m_UBOLighting->OnUpdate();
+		m_UBOIBL->OnUpdate();
 	}
 
 	void Render::Init()
@@ -178,21 +328,29 @@ namespace Chroma
 		// Uniform Buffer Objects
 		GenerateUniformBufferObjects();
 
+		// Buffers' programs are submitted in bulk and link in the background
+		ShaderCache::InitParallelCompile();
+
+		// GPU frame and feature timing
+		DynamicResolution::Init();
+		QualityGovernor::Init();
+
 		// Buffer Textures
 		GenerateBufferTextures();
 
-		// Buffers
+		// Buffers, transient targets are pooled by the render graph
+		// VXGI and the downsampled buffers are created once used
 		m_PostFXBuffer = new PostFXBuffer();
 		m_GBuffer = new GBuffer(m_PostFXBuffer);
 		m_ForwardBuffer = new ForwardBuffer(m_PostFXBuffer);
 		m_DebugBuffer = new DebugBuffer(m_PostFXBuffer);
 		m_SSRBuffer = new SSRBuffer();
-		m_GraphicsDebugBuffer = new IFramebuffer();
 		m_ShadowBuffer = new ShadowBuffer();
+#ifdef EDITOR
 		m_EditorViewportBuffer = new EditorViewportBuffer();
-		m_VXGIBuffer = new VXGIBuffer();
+#endif
 
-		CHROMA_INFO("Renderer Initialized.");
+		CHROMA_INFO("Renderer Initialized, {0} shader programs linking.", ShaderCache::GetNumPendingPrograms());
 	}
 
 	void Render::RenderScene()
@@ -200,31 +358,33 @@ namespace Chroma
 
 		CHROMA_PROFILE_FUNCTION();
 
-		// Update UBOs
-		UpdateUniformBufferObjects();
+		// Finish programs done linking, passes still linking are skipped
+		ShaderCache::Update();
 
-		// Shadows
-		static_cast<ShadowBuffer*>(m_ShadowBuffer)->DrawShadowMaps();
-
-		// Deferred
-		RenderDefferedComponents();
+		DynamicResolution::BeginFrame();
 
-		// Forward
-		RenderForwardComponents();
-
-		// Post FX
-		RenderPostFX();
+		// Update UBOs
+		UpdateUniformBufferObjects();
 
-		// Debug
-		RenderDebug();
+		// Passes, ordered by the textures they read and write
+		BuildGraph();
+		RenderGraph::Execute();
 
 		// Clear
 		CleanUp();
+
+		// Dynamic resolution, targets take the new scale from the next frame
+		if (DynamicResolution::EndFrame())
+			ResizeRenderTargets();
+
+		// Quality tier, once the resolution is at its bounds
+		QualityGovernor::Update();
 	}
 
 	void Render::OnUpdate()
 	{
-		static_cast<VXGIBuffer*>(m_VXGIBuffer)->m_VoxelGridMovedThisFrame = false;
+		if (m_VXGIBuffer)
+			static_cast<VXGIBuffer*>(m_VXGIBuffer)->m_VoxelGridMovedThisFrame = false;
 	}
 
 	void Render::OnEvent(Event& e)
@@ -241,23 +401,64 @@ namespace Chroma
 		CHROMA_WARN("RENDERER :: Screen Resized : {0} by {1}", width, height);
 		CHROMA_INFO_UNDERLINE;
 
-		// make sure the viewport matches the new window dimensions;  
-		glViewport(0, 0, width, height);
+		m_OutputWidth = width;
+		m_OutputHeight = height;
 
 		// update scene camera projection to window aspect ratio
 		Chroma::Scene::GetRenderCamera()->SetAspectRatio((float)width/(float)height);
 		m_UBOCamera->OnUpdate();
 
-		// update buffers
-		ResizeBufferTextures(width, height);
-		m_PostFXBuffer->ScreenResizeCallback(width, height);
-		m_GBuffer->ScreenResizeCallback(width, height);
-		m_ForwardBuffer->ScreenResizeCallback(width, height);
-		m_DebugBuffer->ScreenResizeCallback(width, height);
-		m_GraphicsDebugBuffer->ScreenResizeCallback(width, height);
-		m_SSRBuffer->ScreenResizeCallback(width, height);
+		// output buffers
+#ifdef EDITOR
 		m_EditorViewportBuffer->ScreenResizeCallback(width, height);
-		m_VXGIBuffer->ScreenResizeCallback(width, height);
+#endif
+
+		// render buffers
+		ResizeRenderTargets();
+	}
+
+	void Render::SetRenderViewport()
+	{
+		glViewport(0, 0, m_RenderWidth, m_RenderHeight);
+	}
+
+	void Render::ResizeRenderTargets()
+	{
+		m_RenderWidth = std::max((int)std::round(m_OutputWidth * DynamicResolution::GetRenderScale()), 1);
+		m_RenderHeight = std::max((int)std::round(m_OutputHeight * DynamicResolution::GetRenderScale()), 1);
+		CHROMA_INFO("RENDERER :: Render Resolution : {0} by {1}, scale {2}", m_RenderWidth, m_RenderHeight, DynamicResolution::GetRenderScale());
+
+		// make sure the viewport matches the render resolution
+		SetRenderViewport();
+
+		// update buffers
+		ResizeBufferTextures(m_RenderWidth, m_RenderHeight);
+		m_PostFXBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		m_GBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		m_ForwardBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		m_DebugBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		m_SSRBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		if (m_VXGIBuffer)
+			m_VXGIBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		for (DownsampleBuffer* downsampleBuffer : m_DownsampleBuffers)
+			downsampleBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		// pooled targets are reallocated at the new size
+		RenderGraph::ReleaseTextures();
+	}
+
+	DownsampleBuffer* Render::GetDownsampleBuffer(unsigned int const& divisor)
+	{
+		for (DownsampleBuffer* downsampleBuffer : m_DownsampleBuffers)
+			if (downsampleBuffer->GetDivisor() == divisor)
+				return downsampleBuffer;
+
+		// half and quarter resolution, created the first time a pass traces at them
+		if (divisor != 2 && divisor != 4)
+			return nullptr;
+		DownsampleBuffer* downsampleBuffer = new DownsampleBuffer(divisor);
+		downsampleBuffer->ScreenResizeCallback(m_RenderWidth, m_RenderHeight);
+		m_DownsampleBuffers.push_back(downsampleBuffer);
+		return downsampleBuffer;
 	}
 
 	glm::mat4 Render::GetLightSpaceMatrix()
@@ -270,37 +471,19 @@ namespace Chroma
 		m_UBOCamera->OnUpdate();
 
 		static_cast<ShadowBuffer*>(m_ShadowBuffer)->CalculateCascadeLightSpaceMatrices();
-		static_cast<ShadowBuffer*>(m_ShadowBuffer)->DrawShadowMaps();
+		if (m_ShadowBuffer->GetIsReady())
+			static_cast<ShadowBuffer*>(m_ShadowBuffer)->DrawShadowMaps();
 
-		static_cast<VXGIBuffer*>(m_VXGIBuffer)->OnCameraMoved(e);
+		if (m_VXGIBuffer)
+			static_cast<VXGIBuffer*>(m_VXGIBuffer)->OnCameraMoved(e);
 
 		return true;
 	}
 
 	void Render::GenerateBufferTextures()
 	{
-		// - WS Positions
-		glGenTextures(1, &m_WSPositions);
-		glBindTexture(GL_TEXTURE_2D, m_WSPositions);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_FLOAT, NULL);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-		// - gViewPosition for SSAO viewspace position 
-		glGenTextures(1, &m_VSPositions);
-		glBindTexture(GL_TEXTURE_2D, m_VSPositions);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_FLOAT, NULL);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-		// - fragposLightSpace color buffer for shadowmapping
-		glGenTextures(1, &m_FragPosLightSpace);
-		glBindTexture(GL_TEXTURE_2D, m_FragPosLightSpace);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
 		// SURFACE DATA
+		// positions are reconstructed from depth and the inverse view projection
 		// - albebo buffer
 		glGenTextures(1, &m_Albedo);
 		glBindTexture(GL_TEXTURE_2D, m_Albedo);
@@ -308,17 +491,10 @@ namespace Chroma
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		// - WS normal
-		glGenTextures(1, &m_WSNormals);
-		glBindTexture(GL_TEXTURE_2D, m_WSNormals);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_FLOAT, NULL);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-		// - VS Normal
-		glGenTextures(1, &m_VSNormals);
-		glBindTexture(GL_TEXTURE_2D, m_VSNormals);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_FLOAT, NULL);
+		// - WS normal, octahedral encoded
+		glGenTextures(1, &m_Normals);
+		glBindTexture(GL_TEXTURE_2D, m_Normals);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RG, GL_FLOAT, NULL);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
@@ -357,18 +533,6 @@ namespace Chroma
 	void Render::ResizeBufferTextures(const int& newWidth, const int& newHeight)
 	{
 		// gbuffer textures
-		// - position color buffer
-		glBindTexture(GL_TEXTURE_2D, m_WSPositions);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, newWidth, newHeight, 0, GL_RGB, GL_FLOAT, NULL);
-
-		// - gViewPosition for SSAO viewspace position 
-		glBindTexture(GL_TEXTURE_2D, m_VSPositions);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, newWidth, newHeight, 0, GL_RGB, GL_FLOAT, NULL);
-
-		// - fragposLightSpace color buffer for shadowmapping
-		glBindTexture(GL_TEXTURE_2D, m_FragPosLightSpace);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-
 		// - depth buffer
 		glBindTexture(GL_TEXTURE_2D, m_Depth);
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, newWidth, newHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
@@ -385,13 +549,8 @@ namespace Chroma
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, newWidth, newHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 
 		// - normal buffer
-		glBindTexture(GL_TEXTURE_2D, m_WSNormals);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, newWidth, newHeight, 0, GL_RGB, GL_FLOAT, NULL);
-
-		// - gViewPosition for SSAO viewspace position 
-		glBindTexture(GL_TEXTURE_2D, m_VSNormals);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, newWidth, newHeight, 0, GL_RGB, GL_FLOAT, NULL);
-
+		glBindTexture(GL_TEXTURE_2D, m_Normals);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, newWidth, newHeight, 0, GL_RG, GL_FLOAT, NULL);
 
 		// - metalness/rougness/ambient occlusion buffer
 		glBindTexture(GL_TEXTURE_2D, m_MetRoughAO);
@@ -14,6 +14,7 @@
 namespace Chroma
 {
 	class CameraMovedEvent;
+	class DownsampleBuffer;
 
 	class Render
 	{
@@ -38,6 +39,13 @@ namespace Chroma
 		// Screen resize
 		static void ResizeBuffers(int const& width, int const& height);
 
+		// Render resolution, the output resolution scaled by dynamic resolution
+		inline static int GetRenderWidth() { return m_RenderWidth; }
+		inline static int GetRenderHeight() { return m_RenderHeight; }
+		inline static int GetOutputWidth() { return m_OutputWidth; }
+		inline static int GetOutputHeight() { return m_OutputHeight; }
+		static void SetRenderViewport();
+
 		// Getters
 		static DebugBuffer*& GetDebugBuffer() { return m_DebugBuffer; };
 		static IFramebuffer*& GetPostFXBuffer() { return m_PostFXBuffer; }
@@ -47,18 +55,14 @@ namespace Chroma
 		static IFramebuffer*& GetShadowBuffer() { return m_ShadowBuffer; }
 		static IFramebuffer*& GetEditorViewportBuffer() { return m_EditorViewportBuffer; }
 		static IFramebuffer*& GetVXGIBuffer() { return m_VXGIBuffer; }
+		// depth and normals at 1/divisor resolution, nullptr for unsupported divisors
+		static DownsampleBuffer* GetDownsampleBuffer(unsigned int const& divisor);
 
 		static glm::mat4 GetLightSpaceMatrix();
 		static inline std::vector<UniformBuffer*>& GetUniformBufferObjects() { return m_UniformBufferObjects; };
 
-		// Buffers
-		inline static unsigned int GetWSPositions() { return m_WSPositions; };
-		inline static unsigned int GetVSPositions() { return m_VSPositions; };
-
-		inline static unsigned int GetVSNormals() { return m_VSNormals; };
-		inline static unsigned int GetWSNormals() { return m_WSNormals; };
-
-		inline static unsigned int GetFragPosLightSpace() { return m_FragPosLightSpace; };
+		// Buffers, positions are reconstructed from depth
+		inline static unsigned int GetNormals() { return m_Normals; };
 
 		inline static unsigned int GetAlbedo() { return m_Albedo; }
 
@@ -73,17 +77,16 @@ namespace Chroma
 		// events
 		static bool OnCameraMoved(CameraMovedEvent& e);
 
+		// RESOLUTION
+		static int m_OutputWidth, m_OutputHeight;
+		static int m_RenderWidth, m_RenderHeight;
+		static void ResizeRenderTargets();
+
 		// BUFFER TEXTURES
 		static void GenerateBufferTextures();
 		static void ResizeBufferTextures(const int& newWidth, const int& newHeight);
-		// - positions
-		static unsigned int m_WSPositions;
-		static unsigned int m_VSPositions;
-		// - normals
-		static unsigned int m_WSNormals;
-		static unsigned int m_VSNormals;
-		// - lightSpace 
-		static unsigned int m_FragPosLightSpace;
+		// - world space normals, octahedral encoded
+		static unsigned int m_Normals;
 		// - albedo
 		static unsigned int m_Albedo;
 		// - MetRoughAO
@@ -98,18 +101,12 @@ namespace Chroma
 		// Start of Frame
 		static void CleanUp();
 
-		// DEFERRED LIGHTING RENDER
-		static void RenderDefferedComponents();
-
-		// FORWARD LIGHTING RENDER
-		static void RenderForwardComponents();
+		// RENDER GRAPH, the frame's passes with the textures they read and write
+		static void BuildGraph();
 
 		// DEBUG RENDER
 		static void RenderDebug();
 
-		// POST FX
-		static void RenderPostFX();
-
 		// Deffered Buffer
 		static IFramebuffer* m_GBuffer;
 
@@ -128,14 +125,15 @@ namespace Chroma
 		// Post FX
 		static IFramebuffer* m_PostFXBuffer;
 
-		// Graphics Debug Buffer
-		static IFramebuffer* m_GraphicsDebugBuffer;
-
-		// Editor Viewport Buffer
+		// Editor Viewport Buffer, editor builds only
 		static IFramebuffer* m_EditorViewportBuffer;
 
-		// VXGI Buffer
+		// VXGI Buffer, nullptr until first enabled
 		static IFramebuffer* m_VXGIBuffer;
+		static bool m_VXGIWasEnabled;
+
+		// Downsampled Depth and Normals, half and quarter resolution once used
+		static std::vector<DownsampleBuffer*> m_DownsampleBuffers;
 
 		// Uniform Buffer Objects
 		static void GenerateUniformBufferObjects();
@@ -144,6 +142,7 @@ namespace Chroma
 		static std::vector<UniformBuffer*> m_UniformBufferObjects;
 		static UniformBuffer* m_UBOCamera;
 		static UniformBuffer* m_UBOLighting;
+		static UniformBuffer* m_UBOIBL;
 
 		// API
 		static API s_API;
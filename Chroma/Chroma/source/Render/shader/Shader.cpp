@@ -1,10 +1,11 @@
 #include "Shader.h"
 #include <scene/Scene.h>
 #include <render/Render.h>
+#include <shader/ShaderCache.h>
 
 namespace Chroma
 {
-	void Shader::CompileAndLink()
+	std::vector<std::pair<unsigned int, std::string>> Shader::CompileAndLink()
 	{
 		const char* vShaderCode = vertexCode.c_str();
 		const char* fShaderCode = fragCode.c_str();
@@ -14,12 +15,10 @@ namespace Chroma
 		vertex = glCreateShader(GL_VERTEX_SHADER);
 		glShaderSource(vertex, 1, &vShaderCode, NULL);
 		glCompileShader(vertex);
-		CheckCompileErrors(vertex, "VERTEX");
 		// fragment Shader
 		fragment = glCreateShader(GL_FRAGMENT_SHADER);
 		glShaderSource(fragment, 1, &fShaderCode, NULL);
 		glCompileShader(fragment);
-		CheckCompileErrors(fragment, "FRAGMENT");
 		// if geometry shader is given, compile geometry shader
 		unsigned int geometry;
 		if (geometrySourcePath != "")
@@ -28,84 +27,98 @@ namespace Chroma
 			geometry = glCreateShader(GL_GEOMETRY_SHADER);
 			glShaderSource(geometry, 1, &gShaderCode, NULL);
 			glCompileShader(geometry);
-			CheckCompileErrors(geometry, "GEOMETRY");
 		}
 		// shader Program
 		glAttachShader(ShaderID, vertex);
 		glAttachShader(ShaderID, fragment);
 		if (geometrySourcePath != "")
 			glAttachShader(ShaderID, geometry);
+		// keep the linked binary retrievable for the on-disk cache
+		glProgramParameteri(ShaderID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(ShaderID);
-		CheckCompileErrors(ShaderID, "PROGRAM");
-		// delete the shaders as they're linked into our program now and no longer necessery
+		// flag the shaders for deletion, they stay queryable while attached to the program
 		glDeleteShader(vertex);
 		glDeleteShader(fragment);
 		if (geometrySourcePath != "")
 			glDeleteShader(geometry);
 
+		// status is only queried once linked, so compiles are not serialized
+		std::vector<std::pair<unsigned int, std::string>> shaders{ { vertex, "VERTEX" }, { fragment, "FRAGMENT" } };
+		if (geometrySourcePath != "")
+			shaders.push_back({ geometry, "GEOMETRY" });
+		return shaders;
 	}
 
-	std::string Shader::ExpandShaderSource(std::string shaderSourcePath)
+	ShaderSource const& Shader::ExpandShaderSource(std::string const& shaderSourcePath)
 	{
-		//  retrieve the vertex/fragment source code from filePath
-		std::ifstream shaderFileStream;
-		// create empty string stream to collect expanded shader strings
-		std::stringstream shaderstringstream;
-		// open file_
-		shaderFileStream.open(shaderSourcePath);
+		// expanded once per path
+		if (ShaderSource const* cachedSource = ShaderCache::FindSource(shaderSourcePath))
+			return *cachedSource;
+
+		// read the whole file at once
+		std::ifstream shaderFileStream(shaderSourcePath);
+		if (!shaderFileStream)
+			CHROMA_WARN("SHADER :: Could not open source : {0}", shaderSourcePath);
+		std::stringstream fileStream;
+		fileStream << shaderFileStream.rdbuf();
+		const std::string source = fileStream.str();
 
-		while (shaderFileStream)
+		// expand includes with included files, themselves expanded through the cache
+		std::string expandedSource;
+		expandedSource.reserve(source.size());
+		size_t lineStart{ 0 };
+		size_t nextInclude = source.find("#include");
+		while (lineStart < source.size())
 		{
-			std::string line;
-			std::getline(shaderFileStream, line);
-
-			// replace versions
-			//if (line.find("#version") != std::string::npos)
-			//	if (line.find("_OPENGL_VERSION_") != std::string::npos) // checking for opengl version override
-			//		line = "#version " + OPENGL_VERSION;
-
-			// replace MAX_VERT_INFLUENCES
-			if (line.find("#MAX_VERT_INFLUENCES") != std::string::npos)
-				Replace(line, "#MAX_VERT_INFLUENCES", std::to_string(MAX_VERT_INFLUENCES));
-
-			// replace MAX JOINTS
-			if (line.find("#MAX_JOINTS") != std::string::npos)
-				Replace(line, "#MAX_JOINTS", std::to_string(MAX_JOINTS));
-
-			// expand includes with included files
-			if (line.find("#include") != std::string::npos)
-				{
-					// fetching path of include
-					size_t start = line.find('"') + 1;
-					size_t end = line.rfind('"');
-					std::string includeSourcePath = shaderDir + line.substr(start, end - start);
-					// creating include source file
-					std::fstream includeFile;
-					includeFile.open(includeSourcePath);
-					std::stringstream includeSource;
-					includeSource << includeFile.rdbuf();
-					includeFile.close();
-					// replacing line with exanded include
-					line = includeSource.str();
-				}
-			shaderstringstream << line << std::endl;
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+				lineEnd = source.size() - 1;
+
+			if (nextInclude < lineStart)
+				nextInclude = source.find("#include", lineStart);
+
+			if (nextInclude <= lineEnd)
+			{
+				// fetching path of include
+				size_t start = source.find('"', nextInclude) + 1;
+				size_t end = source.find('"', start);
+				if (start != 0 && end != std::string::npos && end <= lineEnd)
+					expandedSource += ExpandShaderSource(shaderDir + source.substr(start, end - start)).code;
+				expandedSource += '\n';
+			}
+			else
+				expandedSource.append(source, lineStart, lineEnd - lineStart + 1);
+			lineStart = lineEnd + 1;
 		}
-		shaderFileStream.close();
 
-		return shaderstringstream.str();
+		// replace tokens once over the whole source
+		Replace(expandedSource, "#MAX_VERT_INFLUENCES", std::to_string(MAX_VERT_INFLUENCES));
+		Replace(expandedSource, "#MAX_JOINTS", std::to_string(MAX_JOINTS));
+		Replace(expandedSource, "#VXGI_CLIPMAP_LEVELS", std::to_string(VXGI_CLIPMAP_LEVELS));
+		Replace(expandedSource, "#VXGI_BRICK_SIZE", std::to_string(VXGI_BRICK_SIZE));
+
+		return ShaderCache::AddSource(shaderSourcePath, expandedSource);
 	}
 
 
 	void Shader::LoadShaderSource()
 	{
 		// Load and Expand Shader Source
-		vertexCode = ExpandShaderSource(vertexSourcePath);
-		fragCode = ExpandShaderSource(fragSourcePath);
+		ShaderSource const& vertexSource = ExpandShaderSource(vertexSourcePath);
+		ShaderSource const& fragSource = ExpandShaderSource(fragSourcePath);
+		vertexCode = vertexSource.code;
+		fragCode = fragSource.code;
+		InjectDefines(vertexCode);
+		InjectDefines(fragCode);
+		m_SourceHash = ShaderCache::HashCombine(ShaderCache::HashCombine(vertexSource.hash, fragSource.hash), m_Keywords);
 
 		// if geometry shader path is present, also load a geometry shader
 		if (geometrySourcePath != "")
 		{
-			geometryCode = ExpandShaderSource(geometrySourcePath);
+			ShaderSource const& geometrySource = ExpandShaderSource(geometrySourcePath);
+			geometryCode = geometrySource.code;
+			InjectDefines(geometryCode);
+			m_SourceHash = ShaderCache::HashCombine(m_SourceHash, geometrySource.hash);
 		}
 	}
 
@@ -119,28 +132,114 @@ namespace Chroma
 	void Shader::Replace(std::string& sourceString, std::string const& from, std::string const& to)
 	{
 		size_t start_pos = sourceString.find(from);
-		sourceString.replace(start_pos, from.length(), to);
+		while (start_pos != std::string::npos)
+		{
+			sourceString.replace(start_pos, from.length(), to);
+			start_pos = sourceString.find(from, start_pos + to.length());
+		}
+	}
+
+	std::string Shader::BuildProgramKey()
+	{
+		// identical expanded sources share a program whatever their paths
+		return std::to_string(m_SourceHash);
+	}
+
+	Shader& Shader::GetVariant(unsigned int const& keywords)
+	{
+		if (keywords == m_Keywords)
+			return *this;
+
+		std::shared_ptr<Shader>& variant = (*m_Variants)[keywords];
+		if (!variant)
+		{
+			variant = std::make_shared<Shader>(fragSourcePath, vertexSourcePath, geometrySourcePath, keywords);
+			CHROMA_INFO("SHADER :: Built variant {0} of : {1}", GetKeywordDefines(keywords), fragSourcePath);
+		}
+		return *variant;
 	}
 
-	Shader::Shader(std::string fragmentPath, std::string vertexPath, std::string geometryPath)
+	std::string Shader::GetKeywordDefines(unsigned int const& keywords)
+	{
+		static const char* keywordNames[ShaderKeyword::kNumKeywords]{ "SKINNED", "ALBEDO_MAP", "NORMAL_MAP", "METROUGHAO_MAP" };
+		std::string defines;
+		for (unsigned int i = 0; i < ShaderKeyword::kNumKeywords; i++)
+			if (keywords & (1 << i))
+				defines += std::string("#define ") + keywordNames[i] + "\n";
+		return defines;
+	}
+
+	void Shader::InjectDefines(std::string& shaderCode)
+	{
+		if (m_Keywords == ShaderKeyword::kNone)
+			return;
+
+		// defines must follow the version directive
+		size_t versionStart = shaderCode.find("#version");
+		size_t insertPosition = versionStart == std::string::npos ? 0 : shaderCode.find('\n', versionStart) + 1;
+		shaderCode.insert(insertPosition, GetKeywordDefines(m_Keywords));
+	}
+
+	Shader::Shader(std::string fragmentPath, std::string vertexPath, std::string geometryPath, unsigned int keywords)
 	{
 		// init
-		ShaderID = glCreateProgram();
 		fragSourcePath = fragmentPath;
 		vertexSourcePath = vertexPath;
 		geometrySourcePath = geometryPath;
+		m_Keywords = keywords;
 
-		// load shader source files
+		// load shader source files, expanded sources are cached
 		LoadShaderSource();
 
-		// compile and link shaders
-		CompileAndLink();
+		// share an already built program
+		std::string programKey = BuildProgramKey();
+		ShaderID = ShaderCache::Acquire(programKey);
+		if (ShaderID != 0)
+		{
+			m_Program = std::make_shared<ShaderProgram>(ShaderID);
+			CleanUp();
+			return;
+		}
+		ShaderID = glCreateProgram();
+
+		// use the cached binary, otherwise compile and link shaders
+		ShaderCache::Add(programKey, ShaderID);
+		m_Program = std::make_shared<ShaderProgram>(ShaderID);
+		if (ShaderCache::LoadProgramBinary(ShaderID, m_SourceHash))
+			BindUniformBufferBlockIndices(ShaderID);
+		else
+		{
+			// link in the background, errors are reported and the binary saved once linked
+			std::vector<std::pair<unsigned int, std::string>> shaders = CompileAndLink();
+			unsigned int programID{ ShaderID };
+			uint64_t sourceHash{ m_SourceHash };
+			std::string sources{ vertexSourcePath + " | " + fragSourcePath + " | " + geometrySourcePath };
+			ShaderCache::AddPending(ShaderID, [programID, sourceHash, sources, shaders]()
+			{
+				for (std::pair<unsigned int, std::string> const& shader : shaders)
+					CheckCompileErrors(shader.first, shader.second, sources);
+				if (CheckCompileErrors(programID, "PROGRAM", sources))
+					ShaderCache::SaveProgramBinary(programID, sourceHash);
+				BindUniformBufferBlockIndices(programID);
+			});
+		}
 
 		// Clean up expanded source
 		CleanUp();
+	}
 
-		// Bind Uniform Buffer Objects
-		BindUniformBufferBlockIndices();
+	Shader& Shader::operator=(Shader const& other)
+	{
+		// uniforms keep pointing at this shader's program ID
+		ShaderID = other.ShaderID;
+		m_Program = other.m_Program;
+		shaderDir = other.shaderDir;
+		fragSourcePath = other.fragSourcePath;
+		vertexSourcePath = other.vertexSourcePath;
+		geometrySourcePath = other.geometrySourcePath;
+		m_Keywords = other.m_Keywords;
+		m_Variants = other.m_Variants;
+		return *this;
 	}
 
 	Shader::~Shader()
@@ -150,25 +249,33 @@ namespace Chroma
 
 	void Shader::Destroy()
 	{
-		glDeleteProgram(ShaderID);
+		// shared programs are deleted with their last owner, copies included
+		m_Program.reset();
 	}
 
 
 	void Shader::Use() const
 	{
+		// drawing with a program still linking waits for it
+		ShaderCache::WaitForProgram(ShaderID);
 		glUseProgram(ShaderID);
 	}
 
+	bool Shader::GetIsReady() const
+	{
+		return ShaderCache::GetIsProgramReady(ShaderID);
+	}
+
 
-	void Shader::BindUniformBufferBlockIndices()
+	void Shader::BindUniformBufferBlockIndices(unsigned int const& programID)
 	{
 		for (UniformBuffer*& ubo : Chroma::Render::GetUniformBufferObjects())
 		{
-			ubo->BindUniformBlockIndex(*this);
+			ubo->BindUniformBlockIndex(programID);
 		}
 	}
 
-	void Shader::CheckCompileErrors(GLuint shader, std::string type)
+	bool Shader::CheckCompileErrors(GLuint shader, std::string type, std::string const& sources)
 	{
 		GLint success;
 		GLchar infoLog[1024];
@@ -179,9 +286,7 @@ namespace Chroma
 			{
 				glGetShaderInfoLog(shader, 1024, NULL, infoLog);
 				CHROMA_WARN("ERROR::SHADER : COMPILATION_ERROR of m_Type: {0} \n {1}", type, infoLog);
-				CHROMA_WARN("SHADER FRAG SOURCE : {0}", fragSourcePath);
-				CHROMA_WARN("SHADER VTX SOURCE : {0}", vertexSourcePath);
-				CHROMA_WARN("SHADER GEOM SOURCE  : {0}", geometrySourcePath);
+				CHROMA_WARN("SHADER SOURCES : {0}", sources);
 			}
 		}
 		else
@@ -191,11 +296,10 @@ namespace Chroma
 			{
 				glGetProgramInfoLog(shader, 1024, NULL, infoLog);
 				CHROMA_WARN("ERROR::SHADER : COMPILATION_ERROR of m_Type: {0} \n {1}", type, infoLog);
-				CHROMA_WARN("SHADER FRAG SOURCE : {0}", fragSourcePath);
-				CHROMA_WARN("SHADER VTX SOURCE : {0}", vertexSourcePath);
-				CHROMA_WARN("SHADER GEOM SOURCE  : {0}", geometrySourcePath);
+				CHROMA_WARN("SHADER SOURCES : {0}", sources);
 			}
 		}
+		return success == GL_TRUE;
 	}
 }
 
@@ -6,12 +6,27 @@
 // chroma
 #include <ChromaConfig.h>
 #include <shader/Uniform.h>
+#include <shader/ShaderCache.h>
 #include <ChromaConfig.h>
 #include <camera/Camera.h>
 #include <light/Light.h>
 
 namespace Chroma
 {
+	// Feature keywords, each used combination compiles into its own program with the matching #defines
+	namespace ShaderKeyword
+	{
+		enum : unsigned int
+		{
+			kNone = 0,
+			kSkinned = 1 << 0,
+			kAlbedoMap = 1 << 1,
+			kNormalMap = 1 << 2,
+			kMetRoughAOMap = 1 << 3,
+			kNumKeywords = 4
+		};
+	}
+
 	class Shader
 	{
 	public:
@@ -23,32 +38,52 @@ namespace Chroma
 
 		// Rendering
 		void Use() const;
+		// false while the program is still linking in the background
+		bool GetIsReady() const;
 
-		// Uniforms
+		// Permutations, variants share the sources and are built on first use
+		Shader& GetVariant(unsigned int const& keywords);
+		inline unsigned int GetKeywords() const { return m_Keywords; }
+		static std::string GetKeywordDefines(unsigned int const& keywords);
+
+		// Uniforms, set on the program every Shader with the same sources shares,
+		// values that differ per object belong in material uniforms set each draw
 		template<typename UniformType>
 		void SetUniform(std::string uniformName, UniformType uniformValue) {
 			m_Uniforms.SetUniform(uniformName, uniformValue);
 		};
 
-		//constructor reads and builds the shader
-		Shader(std::string fragmentPath, std::string vertexPath, std::string geometryPath="");
+		//constructor reads and builds the shader, or shares an identical cached program
+		Shader(std::string fragmentPath, std::string vertexPath, std::string geometryPath="", unsigned int keywords = ShaderKeyword::kNone);
+		Shader(Shader const& other) { *this = other; };
+		Shader& operator=(Shader const& other);
 		Shader() {};
 		~Shader();
 
 	private:
 		// Functions
-		void BindUniformBufferBlockIndices();
-		void CheckCompileErrors(GLuint shader, std::string type);
-		void CompileAndLink();
+		static void BindUniformBufferBlockIndices(unsigned int const& programID);
+		static bool CheckCompileErrors(GLuint shader, std::string type, std::string const& sources);
+		std::vector<std::pair<unsigned int, std::string>> CompileAndLink();
+		std::string BuildProgramKey();
 		void LoadShaderSource();
+		void InjectDefines(std::string& shaderCode);
 		void CleanUp();
 		void Replace(std::string& sourceString, std::string const& from, std::string const& to);
-		std::string ExpandShaderSource(std::string shaderSourcePath);
+		ShaderSource const& ExpandShaderSource(std::string const& shaderSourcePath);
 
 		//Attrs
 		std::string shaderDir{ "resources/shaders/" };
 		std::string fragSourcePath, vertexSourcePath, geometrySourcePath;
 		std::string fragCode, vertexCode, geometryCode;
+		// content hash of the expanded sources and keywords, keys the program cache
+		uint64_t m_SourceHash{ 0 };
+		// copies share the program reference, released with the last of them
+		std::shared_ptr<ShaderProgram> m_Program;
+
+		// Permutations, shared between copies
+		unsigned int m_Keywords{ ShaderKeyword::kNone };
+		std::shared_ptr<std::map<unsigned int, std::shared_ptr<Shader>>> m_Variants{ std::make_shared<std::map<unsigned int, std::shared_ptr<Shader>>>() };
 
 		// Uniforms
 		Uniform m_Uniforms{ &ShaderID };
@@ -0,0 +1,243 @@
+#include "ShaderCache.h"
+
+
+namespace Chroma
+{
+	std::map<std::string, ShaderCache::CachedProgram> ShaderCache::m_Programs;
+	std::map<std::string, ShaderSource> ShaderCache::m_Sources;
+	std::map<unsigned int, ShaderCache::PendingProgram> ShaderCache::m_PendingPrograms;
+	bool ShaderCache::m_ParallelCompile{ false };
+
+	// binary file header
+	static const uint32_t SHADER_BINARY_MAGIC{ 0x42534843 }; // "CHSB"
+
+	// KHR/ARB_parallel_shader_compile, not exposed by the loader
+	static const GLenum SHADER_COMPLETION_STATUS{ 0x91B1 };
+	typedef void (APIENTRYP PFNMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+	ShaderSource const* ShaderCache::FindSource(std::string const& sourcePath)
+	{
+		auto it = m_Sources.find(sourcePath);
+		return it == m_Sources.end() ? nullptr : &it->second;
+	}
+
+	ShaderSource const& ShaderCache::AddSource(std::string const& sourcePath, std::string const& code)
+	{
+		ShaderSource& source = m_Sources[sourcePath];
+		source.code = code;
+		source.hash = HashSource(code);
+		return source;
+	}
+
+	unsigned int ShaderCache::Acquire(std::string const& programKey)
+	{
+		auto it = m_Programs.find(programKey);
+		if (it == m_Programs.end())
+			return 0;
+		it->second.refCount++;
+		return it->second.programID;
+	}
+
+	void ShaderCache::Add(std::string const& programKey, unsigned int const& programID)
+	{
+		CachedProgram& program = m_Programs[programKey];
+		program.programID = programID;
+		program.refCount = 1;
+	}
+
+	void ShaderCache::Release(unsigned int const& programID)
+	{
+		for (auto it = m_Programs.begin(); it != m_Programs.end(); it++)
+		{
+			if (it->second.programID != programID)
+				continue;
+			// other owners may still be waiting on the link
+			if (--it->second.refCount == 0)
+			{
+				m_PendingPrograms.erase(programID);
+				glDeleteProgram(programID);
+				m_Programs.erase(it);
+			}
+			return;
+		}
+
+		// never cached
+		m_PendingPrograms.erase(programID);
+		glDeleteProgram(programID);
+	}
+
+	void ShaderCache::InitParallelCompile()
+	{
+		if (!SHADER_PARALLEL_COMPILE_ENABLED)
+			return;
+
+		static const char* extensions[]{ "GL_KHR_parallel_shader_compile", "GL_ARB_parallel_shader_compile" };
+		static const char* functions[]{ "glMaxShaderCompilerThreadsKHR", "glMaxShaderCompilerThreadsARB" };
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			if (!glfwExtensionSupported(extensions[i]))
+				continue;
+			PFNMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreads = (PFNMAXSHADERCOMPILERTHREADSPROC)glfwGetProcAddress(functions[i]);
+			if (maxShaderCompilerThreads == nullptr)
+				continue;
+			// let the driver pick the thread count
+			maxShaderCompilerThreads(0xFFFFFFFF);
+			m_ParallelCompile = true;
+			CHROMA_INFO("SHADER CACHE :: Parallel compile enabled : {0}", extensions[i]);
+			return;
+		}
+		CHROMA_INFO("SHADER CACHE :: Parallel compile unsupported, programs finish linking on first use.");
+	}
+
+	void ShaderCache::AddPending(unsigned int const& programID, std::function<void()> const& onLinked)
+	{
+		m_PendingPrograms[programID].onLinked = onLinked;
+	}
+
+	bool ShaderCache::GetIsProgramReady(unsigned int const& programID)
+	{
+		if (!GetIsProgramPending(programID))
+			return true;
+
+		// without the extension any status query waits for the link
+		if (m_ParallelCompile)
+		{
+			GLint completed{ GL_FALSE };
+			glGetProgramiv(programID, SHADER_COMPLETION_STATUS, &completed);
+			if (completed != GL_TRUE)
+				return false;
+		}
+		FinalizeProgram(programID);
+		return true;
+	}
+
+	void ShaderCache::WaitForProgram(unsigned int const& programID)
+	{
+		if (GetIsProgramPending(programID))
+			FinalizeProgram(programID);
+	}
+
+	void ShaderCache::DeferUniform(unsigned int const& programID, std::string const& uniformName, std::function<void()> const& setUniform)
+	{
+		m_PendingPrograms[programID].uniforms[uniformName] = setUniform;
+	}
+
+	void ShaderCache::Update()
+	{
+		std::vector<unsigned int> pendingIDs;
+		for (auto const& pending : m_PendingPrograms)
+			pendingIDs.push_back(pending.first);
+		for (unsigned int const& programID : pendingIDs)
+			GetIsProgramReady(programID);
+	}
+
+	void ShaderCache::FinalizeProgram(unsigned int const& programID)
+	{
+		// removed first, deferred uniforms are set through the regular path
+		PendingProgram pending = std::move(m_PendingPrograms[programID]);
+		m_PendingPrograms.erase(programID);
+
+		if (pending.onLinked)
+			pending.onLinked();
+		for (auto const& uniform : pending.uniforms)
+			uniform.second();
+	}
+
+	bool ShaderCache::LoadProgramBinary(unsigned int const& programID, uint64_t const& sourceHash)
+	{
+		if (!SHADER_BINARY_CACHE_ENABLED)
+			return false;
+
+		std::ifstream binaryFile(GetBinaryPath(sourceHash), std::ios::binary);
+		if (!binaryFile)
+			return false;
+
+		uint32_t magic{ 0 }, format{ 0 }, length{ 0 };
+		binaryFile.read((char*)&magic, sizeof(uint32_t));
+		binaryFile.read((char*)&format, sizeof(uint32_t));
+		binaryFile.read((char*)&length, sizeof(uint32_t));
+		if (!binaryFile || magic != SHADER_BINARY_MAGIC || length == 0)
+			return false;
+
+		std::vector<char> binary(length);
+		binaryFile.read(binary.data(), length);
+		if (!binaryFile)
+			return false;
+
+		glProgramBinary(programID, (GLenum)format, binary.data(), (GLsizei)length);
+		GLint success{ 0 };
+		glGetProgramiv(programID, GL_LINK_STATUS, &success);
+		return success == GL_TRUE;
+	}
+
+	void ShaderCache::SaveProgramBinary(unsigned int const& programID, uint64_t const& sourceHash)
+	{
+		if (!SHADER_BINARY_CACHE_ENABLED)
+			return;
+
+		GLint success{ 0 }, length{ 0 };
+		glGetProgramiv(programID, GL_LINK_STATUS, &success);
+		glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (success != GL_TRUE || length <= 0)
+			return;
+
+		std::vector<char> binary(length);
+		GLenum format{ 0 };
+		glGetProgramBinary(programID, length, &length, &format, binary.data());
+
+		CreateDirectoryA(SHADER_BINARY_CACHE_DIR, NULL);
+		std::ofstream binaryFile(GetBinaryPath(sourceHash), std::ios::binary | std::ios::trunc);
+		if (!binaryFile)
+		{
+			CHROMA_WARN("SHADER CACHE :: Could not write program binary to : {0}", GetBinaryPath(sourceHash));
+			return;
+		}
+		uint32_t header[3]{ SHADER_BINARY_MAGIC, (uint32_t)format, (uint32_t)length };
+		binaryFile.write((const char*)header, sizeof(header));
+		binaryFile.write(binary.data(), length);
+	}
+
+	uint64_t ShaderCache::HashSource(std::string const& source, uint64_t hash)
+	{
+		for (char const& c : source)
+		{
+			hash ^= (uint64_t)(unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	uint64_t ShaderCache::HashCombine(uint64_t hash, uint64_t const& value)
+	{
+		for (unsigned int i = 0; i < sizeof(uint64_t); i++)
+		{
+			hash ^= (value >> (i * 8)) & 0xff;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	uint64_t ShaderCache::GetDriverHash()
+	{
+		static uint64_t driverHash{ 0 };
+		if (driverHash == 0)
+		{
+			std::string driver;
+			for (GLenum const& name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				if (value != nullptr)
+					driver += value;
+			}
+			driverHash = HashSource(driver);
+		}
+		return driverHash;
+	}
+
+	std::string ShaderCache::GetBinaryPath(uint64_t const& sourceHash)
+	{
+		char fileName[17];
+		snprintf(fileName, sizeof(fileName), "%016llx", (unsigned long long)(sourceHash ^ GetDriverHash()));
+		return std::string(SHADER_BINARY_CACHE_DIR) + "/" + fileName + ".bin";
+	}
+}
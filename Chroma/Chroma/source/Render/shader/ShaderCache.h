@@ -0,0 +1,89 @@
+#ifndef _CHROMA_SHADER_CACHE_H_
+#define _CHROMA_SHADER_CACHE_H_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// Expanded source of a shader file, includes resolved and tokens replaced
+	struct ShaderSource
+	{
+		std::string code;
+		uint64_t hash{ 0 };
+	};
+
+	// Process wide cache of linked programs, keyed by a hash of the expanded sources and defines,
+	// so every Shader built from the same sources shares one program object.
+	// Linked binaries are also persisted to disk keyed by a hash of the expanded source.
+	// Expanded sources are memoised per path, so shared includes are read and expanded once.
+	class ShaderCache
+	{
+	public:
+		// Expanded sources
+		static ShaderSource const* FindSource(std::string const& sourcePath);
+		static ShaderSource const& AddSource(std::string const& sourcePath, std::string const& code);
+		static void ClearSources() { m_Sources.clear(); }
+
+		// Shared programs, acquired programs are reference counted
+		static unsigned int Acquire(std::string const& programKey);
+		static void Add(std::string const& programKey, unsigned int const& programID);
+		static void Release(unsigned int const& programID);
+		static inline unsigned int GetNumPrograms() { return (unsigned int)m_Programs.size(); }
+
+		// Program binaries, loading fails when the driver rejects the binary
+		static bool LoadProgramBinary(unsigned int const& programID, uint64_t const& sourceHash);
+		static void SaveProgramBinary(unsigned int const& programID, uint64_t const& sourceHash);
+
+		// Pending programs link in the background, on drivers with parallel compile they are polled without stalling
+		static void InitParallelCompile();
+		static inline bool GetIsParallelCompileEnabled() { return m_ParallelCompile; }
+		static void AddPending(unsigned int const& programID, std::function<void()> const& onLinked);
+		static inline bool GetIsProgramPending(unsigned int const& programID) { return !m_PendingPrograms.empty() && m_PendingPrograms.find(programID) != m_PendingPrograms.end(); }
+		static bool GetIsProgramReady(unsigned int const& programID);
+		static void WaitForProgram(unsigned int const& programID);
+		static void DeferUniform(unsigned int const& programID, std::string const& uniformName, std::function<void()> const& setUniform);
+		static void Update();
+		static inline unsigned int GetNumPendingPrograms() { return (unsigned int)m_PendingPrograms.size(); }
+
+		// FNV-1a, chained by passing the previous hash
+		static uint64_t HashSource(std::string const& source, uint64_t hash = 14695981039346656037ull);
+		static uint64_t HashCombine(uint64_t hash, uint64_t const& value);
+
+	private:
+		struct CachedProgram
+		{
+			unsigned int programID{ 0 };
+			unsigned int refCount{ 0 };
+		};
+		static std::map<std::string, CachedProgram> m_Programs;
+		static std::map<std::string, ShaderSource> m_Sources;
+
+		// uniforms set before linking are applied once linked, latest value per name
+		struct PendingProgram
+		{
+			std::function<void()> onLinked;
+			std::map<std::string, std::function<void()>> uniforms;
+		};
+		static std::map<unsigned int, PendingProgram> m_PendingPrograms;
+		static bool m_ParallelCompile;
+		static void FinalizeProgram(unsigned int const& programID);
+
+		// binaries are only valid for the driver that produced them
+		static uint64_t GetDriverHash();
+		static std::string GetBinaryPath(uint64_t const& sourceHash);
+	};
+
+	// One reference to a cached program, shared by every copy of the Shader that acquired it
+	struct ShaderProgram
+	{
+		unsigned int programID{ 0 };
+
+		ShaderProgram(unsigned int const& id) : programID{ id } {};
+		~ShaderProgram() { ShaderCache::Release(programID); };
+	};
+}
+
+#endif
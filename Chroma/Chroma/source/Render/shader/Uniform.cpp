@@ -1,40 +1,56 @@
 #include "Uniform.h"
+#include <shader/ShaderCache.h>
 
 namespace Chroma
 {
 	void Uniform::SetBool(const std::string& name, bool value, unsigned int const& shaderID) 
 	{
-		glUniform1i(glGetUniformLocation(shaderID, name.c_str()), (int)value);
+		// programs still linking receive the value once linked
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { SetBool(name, value, shaderID); });
+		glProgramUniform1i(shaderID, glGetUniformLocation(shaderID, name.c_str()), (int)value);
 	}
 
 	void Uniform::SetInt(const std::string& name, int value, unsigned int const& shaderID)
 	{
-		glUniform1i(glGetUniformLocation(shaderID, name.c_str()), value);
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { SetInt(name, value, shaderID); });
+		glProgramUniform1i(shaderID, glGetUniformLocation(shaderID, name.c_str()), value);
 	}
 
 	void Uniform::SetFloat(const std::string& name, float value, unsigned int const& shaderID)
 	{
-		glUniform1f(glGetUniformLocation(shaderID, name.c_str()), value);
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { SetFloat(name, value, shaderID); });
+		glProgramUniform1f(shaderID, glGetUniformLocation(shaderID, name.c_str()), value);
 	}
 
 	void Uniform::setVec2(const std::string& name, glm::vec2 value, unsigned int const& shaderID)
 	{
-		glUniform2f(glGetUniformLocation(shaderID, name.c_str()), value.x, value.y);
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { setVec2(name, value, shaderID); });
+		glProgramUniform2f(shaderID, glGetUniformLocation(shaderID, name.c_str()), value.x, value.y);
 	}
 
 	void Uniform::setVec3(const std::string& name, glm::vec3 value, unsigned int const& shaderID)
 	{
-		glUniform3f(glGetUniformLocation(shaderID, name.c_str()), value.x, value.y, value.z);
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { setVec3(name, value, shaderID); });
+		glProgramUniform3f(shaderID, glGetUniformLocation(shaderID, name.c_str()), value.x, value.y, value.z);
 	}
 
 	void Uniform::SetVec4(const std::string& name, glm::vec4 const& value, unsigned int const& shaderID)
 	{
-		glUniform4f(glGetUniformLocation(shaderID, name.c_str()), value.x, value.y, value.z, value.w);
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { SetVec4(name, value, shaderID); });
+		glProgramUniform4f(shaderID, glGetUniformLocation(shaderID, name.c_str()), value.x, value.y, value.z, value.w);
 	}
 
 	void Uniform::SetMat4(const std::string& name, glm::mat4 value, unsigned int const& shaderID)
 	{
-		glUniformMatrix4fv(glGetUniformLocation(shaderID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+		if (ShaderCache::GetIsProgramPending(shaderID))
+			return ShaderCache::DeferUniform(shaderID, name, [=]() { SetMat4(name, value, shaderID); });
+		glProgramUniformMatrix4fv(shaderID, glGetUniformLocation(shaderID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
 	}
 
 
@@ -1,10 +1,14 @@
 #include "ShadowBuffer.h"
 #include <component/MeshComponent.h>
+#include <geometry/GeometryPool.h>
+#include <geometry/StaticBatcher.h>
+#include <vegetation/Vegetation.h>
 #include <scene/Scene.h>
 #include <input/Input.h>
 #include <core/Application.h>
 #include <editor/ui/EditorUI.h>
 #include "render/Render.h"
+#include <quality/RenderQuality.h>
 
 namespace Chroma
 {
@@ -135,21 +139,40 @@ namespace Chroma
 		float camFar = Chroma::Scene::GetRenderCamera()->GetFarDist();
 
 		// Calculate the Cascade Split distances
-		for (unsigned int i = 0; i < SHADOW_NUMCASCADES; ++i)
+		for (unsigned int i = 0; i < m_NumCascades; ++i)
 		{
-			float step = static_cast<float>(i + 1) / static_cast<float>(SHADOW_NUMCASCADES);
+			float step = static_cast<float>(i + 1) / static_cast<float>(m_NumCascades);
 			float log = camNear * glm::pow((camFar / camNear), step);
 			float uniform = camNear + (camFar - camNear) * step;
 			m_CascadeSplitDistances.push_back((m_CascadeSplitDistanceRatio * log) + ((1.0 - m_CascadeSplitDistanceRatio) * uniform));
 		}
 	}
 
+	void ShadowBuffer::ApplyQualitySettings()
+	{
+		// the array keeps every layer, fewer cascades only draw fewer
+		QualitySettings const& settings = RenderQuality::GetSettings();
+		unsigned int const numCascades = glm::clamp(settings.shadowCascades, 1u, (unsigned int)SHADOW_NUMCASCADES);
+		if (settings.shadowMapSize == m_ShadowMapSize && numCascades == m_NumCascades)
+			return;
+
+		if (settings.shadowMapSize != m_ShadowMapSize)
+		{
+			m_ShadowMapSize = settings.shadowMapSize;
+			BuildCSMTextureArray();
+		}
+		m_NumCascades = numCascades;
+		CalculateCascadeLightSpaceMatrices();
+	}
+
 	void ShadowBuffer::Init()
 	{
 		// Create frame buffer to store depth to
 		glGenFramebuffers(1, &m_CascadeShadowFBO);
 
 		// Generate cascade textures
+		m_ShadowMapSize = RenderQuality::GetSettings().shadowMapSize;
+		m_NumCascades = glm::clamp(RenderQuality::GetSettings().shadowCascades, 1u, (unsigned int)SHADOW_NUMCASCADES);
 		glGenTextures(1, &m_CascadedTexureArray);
 		BuildCSMTextureArray();
 
@@ -172,6 +195,7 @@ namespace Chroma
 	void ShadowBuffer::DrawShadowMaps()
 	{
 		CHROMA_PROFILE_FUNCTION();
+		ApplyQualitySettings();
 	
 		// Bind Shadow Depth Framebuffer
 		glBindFramebuffer(GL_FRAMEBUFFER, m_CascadeShadowFBO);
@@ -183,7 +207,7 @@ namespace Chroma
 		glEnable(GL_DEPTH_CLAMP);
 		glCullFace(GL_FRONT);
 		// Iterate over each cascade frustrum
-		for (unsigned int i = 0; i < SHADOW_NUMCASCADES; i++)
+		for (unsigned int i = 0; i < m_NumCascades; i++)
 		{
 			// Set to current texture in array
 			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_CascadedTexureArray, 0, i);
@@ -209,25 +233,60 @@ namespace Chroma
 			m_DepthShader.SetUniform("lightSpaceMatrix", m_CascadeLightSpaceMatrices[i]);
 			//m_DepthShader.SetUniform("lightSpaceMatrix", m_CascadeLightSpaceMatrices[0]);
 
-			// render scene
+			// render scene, pooled static casters are gathered into one indirect draw
+			GeometryPool::BeginDrawList();
 			for (UID const& uid : Chroma::Scene::GetShadowCastingComponentUIDs())
 			{
-				m_DepthShader.SetUniform("model", static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetWorldTransform());
+				if (StaticBatcher::GetIsBatched(uid))
+					continue;
+
+				MeshComponent* meshComponent = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid));
+				glm::mat4 worldTransform = meshComponent->GetWorldTransform();
+				bool isSkinned = meshComponent->GetIsSkinned();
+
+				if (!isSkinned && meshComponent->GetIsGeometryPooled() && meshComponent->GetRenderBuffersInitialized())
+				{
+					// skip casters outside the cascade, depth is clamped so only the sides are tested
+					glm::mat4 lightSpaceModel = m_CascadeLightSpaceMatrices[i] * worldTransform;
+					std::pair<glm::vec3, glm::vec3> bbox = meshComponent->GetLocalBBox();
+					glm::vec2 clipMin{ 1.0f }, clipMax{ -1.0f };
+					for (unsigned int corner = 0; corner < 8; corner++)
+					{
+						glm::vec3 position((corner & 1) ? bbox.second.x : bbox.first.x, (corner & 2) ? bbox.second.y : bbox.first.y, (corner & 4) ? bbox.second.z : bbox.first.z);
+						glm::vec2 clipPosition = glm::vec2(lightSpaceModel * glm::vec4(position, 1.0f));
+						clipMin = glm::min(clipMin, clipPosition);
+						clipMax = glm::max(clipMax, clipPosition);
+					}
+					if (clipMax.x < -1.0f || clipMax.y < -1.0f || clipMin.x > 1.0f || clipMin.y > 1.0f)
+						continue;
+
+					unsigned int firstIndex, indexCount;
+					meshComponent->GetLODIndexRange(firstIndex, indexCount);
+					if (GeometryPool::AddDraw(meshComponent->GetGeometryAllocation(), firstIndex, indexCount, worldTransform))
+						continue;
+				}
+
+				m_DepthShader.SetUniform("model", worldTransform);
 
 				// check if mesh skinned
-				bool isSkinned = static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->GetIsSkinned();
 				m_DepthShader.SetUniform("isSkinned", isSkinned);
 				if (isSkinned)
-					static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->SetJointUniforms(m_DepthShader);
+					meshComponent->SetJointUniforms(m_DepthShader);
 
-				static_cast<MeshComponent*>(Chroma::Scene::GetComponent(uid))->Draw(m_DepthShader);
+				meshComponent->Draw(m_DepthShader);
 			}
+			m_DepthShader.SetUniform("isSkinned", false);
+			StaticBatcher::AddShadowDraws(m_DepthShader, m_CascadeLightSpaceMatrices[i]);
+			GeometryPool::SubmitDrawList(m_DepthShader);
+
+			// instanced vegetation uses its own alpha tested depth shader
+			Vegetation::DrawShadows(m_CascadeLightSpaceMatrices[i]);
 		}
 
 		// Reset back to previous render settings
 		glDisable(GL_DEPTH_CLAMP);
 		glCullFace(GL_BACK); // reset to original culling mode
-		glViewport(0, 0, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight());
+		Render::SetRenderViewport();
 		UnBind();
 
 		//// TEST
@@ -17,6 +17,7 @@ namespace Chroma
 		// getters and setters
 		glm::mat4 GetLightSpaceMatrix() { return m_CascadeLightSpaceMatrices[0]; };
 		unsigned int GetTexture() override { return m_CascadedTexureArray; }
+		bool GetIsReady() override { return m_DepthShader.GetIsReady(); };
 
 		// calculate shadows
 		void DrawShadowMaps();
@@ -33,8 +34,10 @@ namespace Chroma
 		// Called from Render on CameraChanged
 		void CalculateCascadeLightSpaceMatrices();
 
-		// Resolution
+		// Resolution and cascades in use, from the quality tier
 		unsigned int m_ShadowMapSize{ 4096 };
+		unsigned int m_NumCascades{ SHADOW_NUMCASCADES };
+		void ApplyQualitySettings();
 
 		// Textures
 		void BuildCSMTextureArray();
@@ -1,42 +1,284 @@
 #include "Terrain.h"
-#include <entity/IEntity.h>
+#include <scene/Scene.h>
+#include <geometry/StaticBatcher.h>
+#include <resources/TextureStreamer.h>
 
 namespace Chroma
 {
+	std::string Terrain::s_Directory;
+	glm::ivec2 Terrain::s_GridSize{ 0 };
+	std::vector<TerrainChunk*> Terrain::s_Chunks;
+	unsigned int Terrain::s_NumResident{ 0 };
+	std::vector<TerrainNode> Terrain::s_Selection;
+	TerrainLayer Terrain::s_Layers[4];
+	bool Terrain::s_ReportedMissingData{ false };
+	unsigned int Terrain::s_GridVAO{ 0 }, Terrain::s_GridVBO{ 0 }, Terrain::s_GridEBO{ 0 };
+	Shader* Terrain::s_Shader{ nullptr };
 
 	void Terrain::Init()
 	{
-		// Setting Default Transform
-		TerrainIdentityMatrix = glm::scale(TerrainIdentityMatrix, glm::vec3(10.0f));
-		TerrainIdentityMatrix = glm::rotate(TerrainIdentityMatrix, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+		s_Shader = new Shader("resources/shaders/fragTerrain.glsl", "resources/shaders/vertexTerrain.glsl");
+		GenerateGridMesh();
 
-		TerrainTransformMatrix = TerrainIdentityMatrix;
+		// grass, rock, dirt, snow
+		s_Layers[0].color = glm::vec3(0.25f, 0.35f, 0.12f);
+		s_Layers[1].color = glm::vec3(0.4f, 0.38f, 0.35f);
+		s_Layers[2].color = glm::vec3(0.35f, 0.25f, 0.15f);
+		s_Layers[3].color = glm::vec3(0.9f, 0.9f, 0.92f);
+		s_Layers[3].roughness = 0.6f;
 	}
 
+	void Terrain::Load(glm::ivec2 const& gridSize, std::string const& directory)
+	{
+		Unload();
+		s_Directory = directory;
+		s_GridSize = gridSize;
+		s_ReportedMissingData = false;
+		for (int z = 0; z < gridSize.y; z++)
+			for (int x = 0; x < gridSize.x; x++)
+				s_Chunks.push_back(new TerrainChunk(glm::ivec2(x, z)));
+		CHROMA_INFO("TERRAIN :: {0} x {1} chunks from : {2}", gridSize.x, gridSize.y, directory);
+	}
+
+	void Terrain::Unload()
+	{
+		// loads in flight still write to their chunk
+		for (TerrainChunk* chunk : s_Chunks)
+		{
+			if (chunk->m_Loading.valid())
+				chunk->m_Loading.wait();
+			delete chunk;
+		}
+		s_Chunks.clear();
+		s_Selection.clear();
+		s_NumResident = 0;
+		s_GridSize = glm::ivec2(0);
+	}
+
+	void Terrain::OnUpdate()
+	{
+		if (s_Chunks.empty())
+			return;
+
+		Camera& renderCam = *Chroma::Scene::GetRenderCamera();
+		StreamChunks(renderCam.GetPosition());
+		SelectNodes(renderCam);
+	}
+
+	void Terrain::Draw()
+	{
+		if (s_Selection.empty() || !s_Shader->GetIsReady())
+			return;
+
+		s_Shader->Use();
+		s_Shader->SetUniform("chunkSize", TERRAIN_CHUNK_SIZE);
+		s_Shader->SetUniform("heightResolution", (float)TERRAIN_HEIGHT_RESOLUTION);
+		s_Shader->SetUniform("gridResolution", (float)TERRAIN_GRID_RESOLUTION);
+		s_Shader->SetUniform("heightMap", 0);
+		s_Shader->SetUniform("splatMap", 1);
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			std::string const index = "[" + std::to_string(i) + "]";
+			// layers tile everywhere, the camera is always close to some of the terrain
+			TextureStreamer::RequestMip(s_Layers[i].albedo.GetTextureData(), 0);
+			unsigned int const albedo = s_Layers[i].albedo.GetID();
+			glActiveTexture(GL_TEXTURE2 + i);
+			glBindTexture(GL_TEXTURE_2D, albedo);
+			s_Shader->SetUniform("layerAlbedo" + index, (int)(2 + i));
+			s_Shader->SetUniform("layerHasAlbedo" + index, albedo != 0);
+			s_Shader->SetUniform("layerColor" + index, s_Layers[i].color);
+			s_Shader->SetUniform("layerRoughness" + index, s_Layers[i].roughness);
+			s_Shader->SetUniform("layerTiling" + index, s_Layers[i].tiling);
+		}
+
+		// selection is built chunk by chunk, textures only change between chunks
+		glBindVertexArray(s_GridVAO);
+		TerrainChunk const* boundChunk{ nullptr };
+		for (TerrainNode const& node : s_Selection)
+		{
+			if (node.chunk != boundChunk)
+			{
+				boundChunk = node.chunk;
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D, boundChunk->GetHeightMap());
+				glActiveTexture(GL_TEXTURE1);
+				glBindTexture(GL_TEXTURE_2D, boundChunk->GetSplatMap());
+				s_Shader->SetUniform("chunkMin", boundChunk->GetMin());
+			}
+			DrawNode(node);
+		}
+		glBindVertexArray(0);
+	}
+
+	void Terrain::StreamChunks(glm::vec3 const& cameraPosition)
+	{
+		glm::ivec2 const cameraChunk(glm::floor(glm::vec2(cameraPosition.x, cameraPosition.z) / TERRAIN_CHUNK_SIZE));
+		unsigned int numUploads{ 0 };
 
-	void Terrain::setTerrainHeight(double newTerrainHeight)
+		for (TerrainChunk* chunk : s_Chunks)
+		{
+			glm::ivec2 const offset = glm::abs(chunk->m_Coord - cameraChunk);
+			int const distance = glm::max(offset.x, offset.y);
+
+			switch (chunk->m_State)
+			{
+			case TerrainChunkState::kUnloaded:
+				// read from disk in the background
+				if (distance <= TERRAIN_STREAM_RADIUS)
+				{
+					chunk->m_State = TerrainChunkState::kLoading;
+					chunk->m_Loading = std::async(std::launch::async, &TerrainChunk::Load, chunk, s_Directory);
+				}
+				break;
+			case TerrainChunkState::kLoading:
+				// uploads are spread over frames, chunks the camera has left are dropped
+				if (numUploads < TERRAIN_MAX_UPLOADS_PER_FRAME && chunk->m_Loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+				{
+					// missing chunks are flat, reported once for the directory rather than per chunk
+					if (!chunk->m_Loading.get() && !s_ReportedMissingData)
+					{
+						CHROMA_WARN("TERRAIN :: Missing chunk data in : {0}, missing chunks are flat.", s_Directory);
+						s_ReportedMissingData = true;
+					}
+					if (distance <= TERRAIN_STREAM_RADIUS + 1)
+					{
+						chunk->Upload();
+						s_NumResident++;
+						numUploads++;
+					}
+					else
+						chunk->Unload();
+				}
+				break;
+			case TerrainChunkState::kLoaded:
+				// one chunk of hysteresis so crossing a border doesn't thrash
+				if (distance > TERRAIN_STREAM_RADIUS + 1)
+				{
+					chunk->Unload();
+					s_NumResident--;
+				}
+				break;
+			}
+		}
+	}
+
+	void Terrain::SelectNodes(Camera& renderCam)
+	{
+		s_Selection.clear();
+		unsigned int const topLevel = TERRAIN_LOD_LEVELS - 1;
+		for (TerrainChunk const* chunk : s_Chunks)
+		{
+			if (chunk->m_State != TerrainChunkState::kLoaded)
+				continue;
+
+			// beyond the coarsest range the whole chunk is drawn at the coarsest level
+			if (!SelectNode(*chunk, chunk->GetMin(), topLevel, renderCam) &&
+				StaticBatcher::GetIsInFrustum(renderCam.GetViewProjMatrix(), chunk->GetBBoxMin(), chunk->GetBBoxMax(), true))
+				s_Selection.push_back(TerrainNode{ chunk, chunk->GetMin(), TERRAIN_CHUNK_SIZE, topLevel, 0xF });
+		}
+	}
+
+	bool Terrain::SelectNode(TerrainChunk const& chunk, glm::vec2 const& nodeMin, unsigned int const& level, Camera& renderCam)
 	{
-		TerrainTransformMatrix = glm::translate(TerrainIdentityMatrix, glm::vec3(0.0f, newTerrainHeight, 0.0f));
+		float const size = GetNodeSize(level);
+		glm::vec3 const bboxMin(nodeMin.x, chunk.GetBBoxMin().y, nodeMin.y);
+		glm::vec3 const bboxMax(nodeMin.x + size, chunk.GetBBoxMax().y, nodeMin.y + size);
+
+		// out of range, the parent covers this area
+		if (!GetIsInRange(bboxMin, bboxMax, renderCam.GetPosition(), GetLODRange(level)))
+			return false;
+
+		// covered but not visible
+		if (!StaticBatcher::GetIsInFrustum(renderCam.GetViewProjMatrix(), bboxMin, bboxMax, true))
+			return true;
+
+		// finest level, or the finer range does not reach this node
+		if (level == 0 || !GetIsInRange(bboxMin, bboxMax, renderCam.GetPosition(), GetLODRange(level - 1)))
+		{
+			s_Selection.push_back(TerrainNode{ &chunk, nodeMin, size, level, 0xF });
+			return true;
+		}
+
+		// children in their range select themselves, the other quadrants are drawn at this level
+		unsigned int quadrantMask{ 0 };
+		float const childSize = size * 0.5f;
+		for (unsigned int quadrant = 0; quadrant < 4; quadrant++)
+			if (!SelectNode(chunk, nodeMin + glm::vec2(quadrant & 1, quadrant >> 1) * childSize, level - 1, renderCam))
+				quadrantMask |= 1 << quadrant;
+		if (quadrantMask != 0)
+			s_Selection.push_back(TerrainNode{ &chunk, nodeMin, size, level, quadrantMask });
+		return true;
 	}
 
-	glm::mat4 Terrain::GetWorldTransform()
+	float Terrain::GetNodeSize(unsigned int const& level)
 	{
-		return GetParentEntity()->GetTransform() * TerrainTransformMatrix;
+		return TERRAIN_CHUNK_SIZE / (float)(1 << (TERRAIN_LOD_LEVELS - 1 - level));
 	}
 
-	glm::mat4 Terrain::GetTransform()
+	float Terrain::GetLODRange(unsigned int const& level)
 	{
-		return TerrainTransformMatrix;
+		return TERRAIN_LOD_RANGE * (float)(1 << level);
 	}
 
-	Terrain::Terrain()
+	bool Terrain::GetIsInRange(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::vec3 const& position, float const& range)
 	{
-		Init();
-		SetupQuad();
+		glm::vec3 const closest = glm::clamp(position, bboxMin, bboxMax);
+		return glm::distance2(closest, position) < range * range;
 	}
 
+	void Terrain::GenerateGridMesh()
+	{
+		// vertices in 0-1 over the node, scaled and placed in the vertex shader
+		unsigned int const resolution = TERRAIN_GRID_RESOLUTION;
+		std::vector<glm::vec2> vertices;
+		for (unsigned int z = 0; z <= resolution; z++)
+			for (unsigned int x = 0; x <= resolution; x++)
+				vertices.push_back(glm::vec2(x, z) / (float)resolution);
+
+		// one quadrant after another, counter clockwise seen from above
+		unsigned int const half = resolution / 2;
+		std::vector<unsigned int> indices;
+		for (unsigned int quadrant = 0; quadrant < 4; quadrant++)
+		{
+			glm::uvec2 const start = glm::uvec2(quadrant & 1, quadrant >> 1) * half;
+			for (unsigned int z = start.y; z < start.y + half; z++)
+				for (unsigned int x = start.x; x < start.x + half; x++)
+				{
+					unsigned int const corner = z * (resolution + 1) + x;
+					unsigned int const below = corner + resolution + 1;
+					indices.insert(indices.end(), { corner, below, corner + 1, corner + 1, below, below + 1 });
+				}
+		}
+
+		glGenVertexArrays(1, &s_GridVAO);
+		glGenBuffers(1, &s_GridVBO);
+		glGenBuffers(1, &s_GridEBO);
+		glBindVertexArray(s_GridVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, s_GridVBO);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), vertices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_GridEBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+		glBindVertexArray(0);
+	}
 
-	Terrain::~Terrain()
+	void Terrain::DrawNode(TerrainNode const& node)
 	{
+		// morph to the next level over the end of this level's range, the coarsest never morphs
+		float const morphEnd = node.level + 1 < TERRAIN_LOD_LEVELS ? GetLODRange(node.level) : FLT_MAX;
+		s_Shader->SetUniform("nodeMin", node.min);
+		s_Shader->SetUniform("nodeSize", node.size);
+		s_Shader->SetUniform("morphRange", glm::vec2(morphEnd * TERRAIN_LOD_MORPH_START, morphEnd));
+
+		unsigned int const quadrantIndices = TERRAIN_GRID_RESOLUTION * TERRAIN_GRID_RESOLUTION / 4 * 6;
+		if (node.quadrantMask == 0xF)
+		{
+			glDrawElements(GL_TRIANGLES, 4 * quadrantIndices, GL_UNSIGNED_INT, (void*)0);
+			return;
+		}
+		for (unsigned int quadrant = 0; quadrant < 4; quadrant++)
+			if (node.quadrantMask & (1 << quadrant))
+				glDrawElements(GL_TRIANGLES, quadrantIndices, GL_UNSIGNED_INT, (void*)((size_t)quadrant * quadrantIndices * sizeof(unsigned int)));
 	}
 }
@@ -1,32 +1,84 @@
 #ifndef _CHROMA_TERRAIN_
 #define _CHROMA_TERRAIN_
-#include "model/PlanePrimitive.h"
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <shader/Shader.h>
+#include <camera/Camera.h>
+#include <terrain/TerrainChunk.h>
+#include <texture/Texture.h>
 
 namespace Chroma
 {
-	class Terrain : public PlanePrimitive
+	// Splat layer, the chunk splat map RGBA channels weight layers 0 to 3
+	struct TerrainLayer
 	{
-	private:
-		// Transform Data
-		glm::mat4 TerrainIdentityMatrix = glm::mat4(1);
-		glm::mat4 TerrainTransformMatrix = glm::mat4(1);
-		double TerrainHeight;
+		// unloaded uses the flat color, shared so streaming can replace the ID
+		Texture albedo;
+		glm::vec3 color{ 0.5f };
+		float roughness{ 0.9f };
+		// world units per texture repeat
+		float tiling{ 8.0f };
+	};
 
-		// initialize
-		void Init();
+	// Selected CDLOD node, drawn with the grid mesh scaled to its size.
+	// Nodes only partly in range of their finer level draw the quadrants that are not.
+	struct TerrainNode
+	{
+		TerrainChunk const* chunk{ nullptr };
+		glm::vec2 min{ 0.0f };
+		float size{ 0.0f };
+		unsigned int level{ 0 };
+		unsigned int quadrantMask{ 0xF };
+	};
 
+	// Chunked heightmap terrain. Chunks around the camera are streamed from disk in the background
+	// and each gets a heightfield collider, the visible ones are drawn into the gbuffer with
+	// continuous distance based LOD from a quadtree per chunk.
+	class Terrain
+	{
 	public:
-		/*  Functions  */
-		void setTerrainHeight(double newTerrainHeight);
-		double getTerrainHeight() { return TerrainHeight; };
-	
-		glm::mat4 GetWorldTransform() override;
-		glm::mat4 GetTransform() override;
-
-		Terrain();
-		Terrain(Camera* camera_val);
-		~Terrain();
+		static void Init();
+		// world of gridSize chunks starting at the origin, data read from <directory>/chunk_<x>_<z>.r16 and .splat
+		static void Load(glm::ivec2 const& gridSize, std::string const& directory = TERRAIN_DATA_DIR);
+		static void Unload();
+
+		// streaming and LOD selection
+		static void OnUpdate();
+		// geometry pass, gbuffer must be bound
+		static void Draw();
+
+		static void SetLayer(unsigned int const& index, TerrainLayer const& layer) { s_Layers[index] = layer; }
+		static inline unsigned int GetNumResidentChunks() { return s_NumResident; }
+		static inline unsigned int GetNumDrawnNodes() { return (unsigned int)s_Selection.size(); }
+		static inline bool GetIsLoaded() { return !s_Chunks.empty(); }
+		static inline glm::ivec2 GetGridSize() { return s_GridSize; }
+		static inline std::string GetDirectory() { return s_Directory; }
+
+	private:
+		static void StreamChunks(glm::vec3 const& cameraPosition);
+		static void SelectNodes(Camera& renderCam);
+		static bool SelectNode(TerrainChunk const& chunk, glm::vec2 const& nodeMin, unsigned int const& level, Camera& renderCam);
+		static float GetNodeSize(unsigned int const& level);
+		static float GetLODRange(unsigned int const& level);
+		static bool GetIsInRange(glm::vec3 const& bboxMin, glm::vec3 const& bboxMax, glm::vec3 const& position, float const& range);
+		static void GenerateGridMesh();
+		static void DrawNode(TerrainNode const& node);
+
+		static std::string s_Directory;
+		static glm::ivec2 s_GridSize;
+		static std::vector<TerrainChunk*> s_Chunks;
+		static unsigned int s_NumResident;
+		static std::vector<TerrainNode> s_Selection;
+		static TerrainLayer s_Layers[4];
+		static bool s_ReportedMissingData;
+
+		// grid mesh indices are ordered by quadrant so partial nodes draw a sub range
+		static unsigned int s_GridVAO, s_GridVBO, s_GridEBO;
+		static Shader* s_Shader;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
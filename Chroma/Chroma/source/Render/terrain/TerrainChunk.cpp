@@ -0,0 +1,107 @@
+#include "TerrainChunk.h"
+#include <physics/PhysicsEngine.h>
+
+namespace Chroma
+{
+	bool TerrainChunk::Load(std::string const& directory)
+	{
+		// heights, 16 bit unsigned normalized to the height scale, missing chunks are flat
+		unsigned int const numHeights = TERRAIN_HEIGHT_RESOLUTION * TERRAIN_HEIGHT_RESOLUTION;
+		std::vector<uint16_t> rawHeights(numHeights, 0);
+		std::ifstream heightFile(GetFilePath(directory, ".r16"), std::ios::binary);
+		bool const foundHeights = (bool)heightFile;
+		if (foundHeights)
+			heightFile.read(reinterpret_cast<char*>(rawHeights.data()), numHeights * sizeof(uint16_t));
+
+		m_Heights.resize(numHeights);
+		for (unsigned int i = 0; i < numHeights; i++)
+			m_Heights[i] = (float)rawHeights[i] / 65535.0f * TERRAIN_HEIGHT_SCALE;
+		std::pair<std::vector<float>::iterator, std::vector<float>::iterator> range = std::minmax_element(m_Heights.begin(), m_Heights.end());
+		m_MinHeight = *range.first;
+		m_MaxHeight = *range.second;
+
+		// splat weights RGBA8, missing chunks use the first layer
+		unsigned int const numSplat = TERRAIN_SPLAT_RESOLUTION * TERRAIN_SPLAT_RESOLUTION;
+		m_Splat.assign(numSplat * 4, 0);
+		std::ifstream splatFile(GetFilePath(directory, ".splat"), std::ios::binary);
+		if (!splatFile || !splatFile.read(reinterpret_cast<char*>(m_Splat.data()), m_Splat.size()))
+			for (unsigned int i = 0; i < numSplat; i++)
+				m_Splat[i * 4] = 255;
+		return foundHeights;
+	}
+
+	void TerrainChunk::Upload()
+	{
+		// heights are sampled by the vertex shader, border samples are shared with neighbours
+		glGenTextures(1, &m_HeightMap);
+		glBindTexture(GL_TEXTURE_2D, m_HeightMap);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, TERRAIN_HEIGHT_RESOLUTION, TERRAIN_HEIGHT_RESOLUTION, 0, GL_RED, GL_FLOAT, m_Heights.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenTextures(1, &m_SplatMap);
+		glBindTexture(GL_TEXTURE_2D, m_SplatMap);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TERRAIN_SPLAT_RESOLUTION, TERRAIN_SPLAT_RESOLUTION, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_Splat.data());
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		// splat weights are only needed on the GPU
+		std::vector<uint8_t>().swap(m_Splat);
+
+		CreateCollider();
+		m_State = TerrainChunkState::kLoaded;
+	}
+
+	void TerrainChunk::Unload()
+	{
+		if (m_RigidBody)
+		{
+			Physics::RemoveBodyFromWorld(m_RigidBody);
+			delete m_RigidBody->getMotionState();
+			delete m_RigidBody;
+			m_RigidBody = nullptr;
+		}
+		delete m_CollisionShape;
+		m_CollisionShape = nullptr;
+
+		glDeleteTextures(1, &m_HeightMap);
+		glDeleteTextures(1, &m_SplatMap);
+		m_HeightMap = m_SplatMap = 0;
+
+		std::vector<float>().swap(m_Heights);
+		std::vector<uint8_t>().swap(m_Splat);
+		m_State = TerrainChunkState::kUnloaded;
+	}
+
+	std::string TerrainChunk::GetFilePath(std::string const& directory, std::string const& extension) const
+	{
+		return directory + "/chunk_" + std::to_string(m_Coord.x) + "_" + std::to_string(m_Coord.y) + extension;
+	}
+
+	void TerrainChunk::CreateCollider()
+	{
+		// rows run along z, the shape is centred on its bounds
+		m_CollisionShape = new btHeightfieldTerrainShape(TERRAIN_HEIGHT_RESOLUTION, TERRAIN_HEIGHT_RESOLUTION, m_Heights.data(),
+			1.0f, m_MinHeight, m_MaxHeight, 1, PHY_FLOAT, false);
+		float const spacing = TERRAIN_CHUNK_SIZE / (float)(TERRAIN_HEIGHT_RESOLUTION - 1);
+		m_CollisionShape->setLocalScaling(btVector3(spacing, 1.0f, spacing));
+
+		glm::vec3 const center = (GetBBoxMin() + GetBBoxMax()) * 0.5f;
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(center.x, center.y, center.z));
+
+		// static body
+		btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+		btRigidBody::btRigidBodyConstructionInfo rbInfo(0.0f, motionState, m_CollisionShape, btVector3(0, 0, 0));
+		rbInfo.m_friction = TERRAIN_FRICTION;
+		m_RigidBody = new btRigidBody(rbInfo);
+		Physics::AddBodyToWorld(m_RigidBody);
+	}
+}
@@ -0,0 +1,57 @@
+#ifndef _CHROMA_TERRAIN_CHUNK_
+#define _CHROMA_TERRAIN_CHUNK_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+// bullet
+#include <bullet/btBulletDynamicsCommon.h>
+#include <bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+namespace Chroma
+{
+	enum class TerrainChunkState { kUnloaded, kLoading, kLoaded };
+
+	// One square of the terrain grid. Heights and splat weights are read from disk on a
+	// background thread, textures and the heightfield collider are created on the main thread.
+	class TerrainChunk
+	{
+	public:
+		// disk, safe to run off the main thread, false when the heightmap is missing
+		bool Load(std::string const& directory);
+		// textures and collider from the loaded data
+		void Upload();
+		// frees the GPU, physics and CPU data, the chunk can be streamed in again
+		void Unload();
+
+		inline glm::vec2 GetMin() const { return glm::vec2(m_Coord) * TERRAIN_CHUNK_SIZE; }
+		inline glm::vec3 GetBBoxMin() const { return glm::vec3(GetMin().x, m_MinHeight, GetMin().y); }
+		inline glm::vec3 GetBBoxMax() const { return glm::vec3(GetMin().x + TERRAIN_CHUNK_SIZE, m_MaxHeight, GetMin().y + TERRAIN_CHUNK_SIZE); }
+		inline unsigned int GetHeightMap() const { return m_HeightMap; }
+		inline unsigned int GetSplatMap() const { return m_SplatMap; }
+
+		glm::ivec2 m_Coord{ 0 };
+		TerrainChunkState m_State{ TerrainChunkState::kUnloaded };
+		// pending disk load
+		std::future<bool> m_Loading;
+
+		TerrainChunk(glm::ivec2 const& coord) : m_Coord(coord) {};
+		~TerrainChunk() { Unload(); };
+
+	private:
+		std::string GetFilePath(std::string const& directory, std::string const& extension) const;
+		void CreateCollider();
+
+		// world space heights, kept while resident as the collider reads them in place
+		std::vector<float> m_Heights;
+		std::vector<uint8_t> m_Splat;
+		float m_MinHeight{ 0.0f }, m_MaxHeight{ 0.0f };
+
+		unsigned int m_HeightMap{ 0 }, m_SplatMap{ 0 };
+		btHeightfieldTerrainShape* m_CollisionShape{ nullptr };
+		btRigidBody* m_RigidBody{ nullptr };
+	};
+}
+
+#endif
@@ -0,0 +1,343 @@
+#include "BlockCompression.h"
+
+namespace Chroma
+{
+	// BC7 4 bit index interpolation weights, out of 64
+	static const int s_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	// little endian bit stream over one block
+	struct BlockWriter
+	{
+		unsigned char* block;
+		unsigned int bit{ 0 };
+
+		void Write(uint32_t const& value, unsigned int const& numBits)
+		{
+			for (unsigned int i = 0; i < numBits; i++, bit++)
+				if ((value >> i) & 1u)
+					block[bit >> 3] |= (unsigned char)(1u << (bit & 7u));
+		}
+	};
+
+	GLenum BlockCompression::GetFormat(unsigned char const* image, int const& width, int const& height, int const& components, Chroma::Type::Texture const& type)
+	{
+		if (!TEXTURE_COMPRESSION_ENABLED)
+			return components == 1 ? GL_R8 : components == 2 ? GL_RG8 : components == 3 ? GL_RGB8 : GL_RGBA8;
+
+		if (components == 1)
+			return GL_COMPRESSED_RED_RGTC1;
+		// tangent space normals are unit length, z is rebuilt from x and y when sampling
+		if (components == 2 || (type == Chroma::Type::Texture::kNormal && components >= 3))
+			return GL_COMPRESSED_RG_RGTC2;
+
+		// alpha that is fully opaque doesn't need the larger block
+		if (components == 4)
+			for (size_t i = 0; i < (size_t)width * height; i++)
+				if (image[i * 4 + 3] != 255)
+					return TEXTURE_COMPRESSION_BC7 ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	}
+
+	bool BlockCompression::GetIsCompressed(GLenum const& format)
+	{
+		return GetBlockBytes(format) != 0;
+	}
+
+	uint64_t BlockCompression::GetLevelBytes(GLenum const& format, int const& width, int const& height, int const& components)
+	{
+		unsigned int const blockBytes = GetBlockBytes(format);
+		if (blockBytes == 0)
+			return (uint64_t)width * height * components;
+		return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+	}
+
+	void BlockCompression::Encode(unsigned char const* image, int const& width, int const& height, int const& components, GLenum const& format, std::vector<unsigned char>& blocks)
+	{
+		blocks.assign(GetLevelBytes(format, width, height, components), 0);
+		if (!GetIsCompressed(format))
+		{
+			std::copy(image, image + blocks.size(), blocks.begin());
+			return;
+		}
+
+		unsigned int const blockBytes = GetBlockBytes(format);
+		int const blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+		unsigned char texels[16][4];
+		for (int y = 0; y < blocksY; y++)
+		{
+			for (int x = 0; x < blocksX; x++)
+			{
+				FetchBlock(image, width, height, components, x, y, texels);
+				unsigned char* block = &blocks[((size_t)y * blocksX + x) * blockBytes];
+				switch (format)
+				{
+				case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+					EncodeBC1(texels, block);
+					break;
+				case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+					EncodeBC4(texels, 3, block);
+					EncodeBC1(texels, block + 8);
+					break;
+				case GL_COMPRESSED_RED_RGTC1:
+					EncodeBC4(texels, 0, block);
+					break;
+				case GL_COMPRESSED_RG_RGTC2:
+					EncodeBC4(texels, 0, block);
+					EncodeBC4(texels, 1, block + 8);
+					break;
+				case GL_COMPRESSED_RGBA_BPTC_UNORM:
+					EncodeBC7(texels, block);
+					break;
+				}
+			}
+		}
+	}
+
+	unsigned int BlockCompression::GetBlockBytes(GLenum const& format)
+	{
+		switch (format)
+		{
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RED_RGTC1:
+			return 8;
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+		case GL_COMPRESSED_RG_RGTC2:
+		case GL_COMPRESSED_RGBA_BPTC_UNORM:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	void BlockCompression::FetchBlock(unsigned char const* image, int const& width, int const& height, int const& components, int const& blockX, int const& blockY, unsigned char texels[16][4])
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			int const x = glm::min(blockX * 4 + (i & 3), width - 1);
+			int const y = glm::min(blockY * 4 + (i >> 2), height - 1);
+			unsigned char const* texel = &image[((size_t)y * width + x) * components];
+			for (int c = 0; c < 4; c++)
+				texels[i][c] = c < components ? texel[c] : (c == 3 ? 255 : 0);
+		}
+	}
+
+	void BlockCompression::FitEndpoints(unsigned char const texels[16][4], int const& channels, float endpoint0[4], float endpoint1[4])
+	{
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 16; i++)
+			for (int c = 0; c < channels; c++)
+				mean[c] += texels[i][c] / 16.0f;
+
+		float covariance[4][4] = {};
+		for (int i = 0; i < 16; i++)
+			for (int a = 0; a < channels; a++)
+				for (int b = 0; b < channels; b++)
+					covariance[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+
+		// principal axis by power iteration
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (int iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float length{ 0.0f };
+			for (int a = 0; a < channels; a++)
+			{
+				for (int b = 0; b < channels; b++)
+					next[a] += covariance[a][b] * axis[b];
+				length = glm::max(length, glm::abs(next[a]));
+			}
+			if (length < 1e-6f)
+				break;
+			for (int a = 0; a < channels; a++)
+				axis[a] = next[a] / length;
+		}
+
+		// extent of the block along the axis
+		float axisLength2{ 0.0f };
+		for (int c = 0; c < channels; c++)
+			axisLength2 += axis[c] * axis[c];
+		float tMin{ 0.0f }, tMax{ 0.0f };
+		for (int i = 0; i < 16 && axisLength2 > 1e-6f; i++)
+		{
+			float t{ 0.0f };
+			for (int c = 0; c < channels; c++)
+				t += (texels[i][c] - mean[c]) * axis[c];
+			tMin = glm::min(tMin, t / axisLength2);
+			tMax = glm::max(tMax, t / axisLength2);
+		}
+		for (int c = 0; c < 4; c++)
+		{
+			endpoint0[c] = c < channels ? glm::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f) : 255.0f;
+			endpoint1[c] = c < channels ? glm::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f) : 255.0f;
+		}
+	}
+
+	void BlockCompression::EncodeBC1(unsigned char const texels[16][4], unsigned char* block)
+	{
+		float endpoint0[4], endpoint1[4];
+		FitEndpoints(texels, 3, endpoint0, endpoint1);
+
+		// RGB565, the larger endpoint first selects the four color mode
+		auto quantize = [](float const* endpoint)
+		{
+			return (uint16_t)((int(endpoint[0] * 31.0f / 255.0f + 0.5f) << 11) | (int(endpoint[1] * 63.0f / 255.0f + 0.5f) << 5) | int(endpoint[2] * 31.0f / 255.0f + 0.5f));
+		};
+		uint16_t color0 = quantize(endpoint0), color1 = quantize(endpoint1);
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		int palette[4][3];
+		for (int e = 0; e < 2; e++)
+		{
+			uint16_t const color = e == 0 ? color0 : color1;
+			int const r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+			palette[e][0] = (r << 3) | (r >> 2);
+			palette[e][1] = (g << 2) | (g >> 4);
+			palette[e][2] = (b << 3) | (b >> 2);
+		}
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		uint32_t indices{ 0 };
+		for (int i = 0; i < 16 && color0 != color1; i++)
+		{
+			int bestIndex{ 0 }, bestError{ INT_MAX };
+			for (int p = 0; p < 4; p++)
+			{
+				int error{ 0 };
+				for (int c = 0; c < 3; c++)
+					error += (texels[i][c] - palette[p][c]) * (texels[i][c] - palette[p][c]);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= (uint32_t)bestIndex << (i * 2);
+		}
+
+		block[0] = (unsigned char)(color0 & 0xFF);
+		block[1] = (unsigned char)(color0 >> 8);
+		block[2] = (unsigned char)(color1 & 0xFF);
+		block[3] = (unsigned char)(color1 >> 8);
+		for (int i = 0; i < 4; i++)
+			block[4 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+	}
+
+	void BlockCompression::EncodeBC4(unsigned char const texels[16][4], int const& channel, unsigned char* block)
+	{
+		// eight value mode, the larger endpoint first
+		int value0{ 0 }, value1{ 255 };
+		for (int i = 0; i < 16; i++)
+		{
+			value0 = glm::max(value0, (int)texels[i][channel]);
+			value1 = glm::min(value1, (int)texels[i][channel]);
+		}
+
+		int palette[8] = { value0, value1 };
+		for (int p = 1; p < 7; p++)
+			palette[p + 1] = ((7 - p) * value0 + p * value1 + 3) / 7;
+
+		uint64_t indices{ 0 };
+		for (int i = 0; i < 16 && value0 != value1; i++)
+		{
+			int bestIndex{ 0 }, bestError{ INT_MAX };
+			for (int p = 0; p < 8; p++)
+			{
+				int const error = glm::abs(texels[i][channel] - palette[p]);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= (uint64_t)bestIndex << (i * 3);
+		}
+
+		block[0] = (unsigned char)value0;
+		block[1] = (unsigned char)value1;
+		for (int i = 0; i < 6; i++)
+			block[2 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+	}
+
+	void BlockCompression::EncodeBC7(unsigned char const texels[16][4], unsigned char* block)
+	{
+		// mode 6, one RGBA subset with 7 bit endpoints, a p bit each and 4 bit indices
+		float endpoints[2][4];
+		FitEndpoints(texels, 4, endpoints[0], endpoints[1]);
+
+		int quantized[2][4], pBits[2], decoded[2][4];
+		for (int e = 0; e < 2; e++)
+		{
+			int bestError{ INT_MAX };
+			for (int p = 0; p < 2; p++)
+			{
+				int candidate[4], error{ 0 };
+				for (int c = 0; c < 4; c++)
+				{
+					candidate[c] = glm::clamp(int((endpoints[e][c] - p) * 0.5f + 0.5f), 0, 127);
+					int const difference = ((candidate[c] << 1) | p) - int(endpoints[e][c] + 0.5f);
+					error += difference * difference;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					pBits[e] = p;
+					for (int c = 0; c < 4; c++)
+						quantized[e][c] = candidate[c];
+				}
+			}
+			for (int c = 0; c < 4; c++)
+				decoded[e][c] = (quantized[e][c] << 1) | pBits[e];
+		}
+
+		int palette[16][4];
+		for (int p = 0; p < 16; p++)
+			for (int c = 0; c < 4; c++)
+				palette[p][c] = ((64 - s_BC7Weights[p]) * decoded[0][c] + s_BC7Weights[p] * decoded[1][c] + 32) >> 6;
+
+		int indices[16];
+		for (int i = 0; i < 16; i++)
+		{
+			int bestError{ INT_MAX };
+			for (int p = 0; p < 16; p++)
+			{
+				int error{ 0 };
+				for (int c = 0; c < 4; c++)
+					error += (texels[i][c] - palette[p][c]) * (texels[i][c] - palette[p][c]);
+				if (error < bestError)
+				{
+					bestError = error;
+					indices[i] = p;
+				}
+			}
+		}
+
+		// the first index is stored without its top bit, flip the endpoints if it's set
+		if (indices[0] & 8)
+		{
+			for (int c = 0; c < 4; c++)
+				std::swap(quantized[0][c], quantized[1][c]);
+			std::swap(pBits[0], pBits[1]);
+			for (int i = 0; i < 16; i++)
+				indices[i] = 15 - indices[i];
+		}
+
+		std::fill(block, block + 16, (unsigned char)0);
+		BlockWriter writer{ block };
+		writer.Write(1u << 6, 7);
+		for (int c = 0; c < 4; c++)
+		{
+			writer.Write(quantized[0][c], 7);
+			writer.Write(quantized[1][c], 7);
+		}
+		writer.Write(pBits[0], 1);
+		writer.Write(pBits[1], 1);
+		writer.Write(indices[0], 3);
+		for (int i = 1; i < 16; i++)
+			writer.Write(indices[i], 4);
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef _CHROMA_BLOCK_COMPRESSION_
+#define _CHROMA_BLOCK_COMPRESSION_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <types/Types.h>
+
+// EXT_texture_compression_s3tc, not part of core but supported by every desktop driver
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace Chroma
+{
+	// CPU encoders for the 4x4 block formats, run once at import into the mip cache.
+	// BC1 for opaque color, BC3 or BC7 (mode 6 only) with alpha, BC4 and BC5 for one and
+	// two channel images. Normal maps keep x and y in BC5, shaders rebuild z.
+	// Endpoints are fit along the principal axis of each block, indices
+	// are picked by testing every palette entry.
+	class BlockCompression
+	{
+	public:
+		// GL internal format for an image, uncompressed formats when compression is disabled
+		static GLenum GetFormat(unsigned char const* image, int const& width, int const& height, int const& components, Chroma::Type::Texture const& type);
+		static bool GetIsCompressed(GLenum const& format);
+		static uint64_t GetLevelBytes(GLenum const& format, int const& width, int const& height, int const& components);
+
+		// image is tightly packed with the given components, blocks are written row by row
+		static void Encode(unsigned char const* image, int const& width, int const& height, int const& components, GLenum const& format, std::vector<unsigned char>& blocks);
+
+	private:
+		static unsigned int GetBlockBytes(GLenum const& format);
+
+		// block texels as RGBA, edges repeat the last texel
+		static void FetchBlock(unsigned char const* image, int const& width, int const& height, int const& components, int const& blockX, int const& blockY, unsigned char texels[16][4]);
+		static void FitEndpoints(unsigned char const texels[16][4], int const& channels, float endpoint0[4], float endpoint1[4]);
+
+		static void EncodeBC1(unsigned char const texels[16][4], unsigned char* block);
+		static void EncodeBC4(unsigned char const texels[16][4], int const& channel, unsigned char* block);
+		static void EncodeBC7(unsigned char const texels[16][4], unsigned char* block);
+	};
+}
+
+#endif
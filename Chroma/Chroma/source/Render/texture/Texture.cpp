@@ -1,6 +1,7 @@
 #include "Texture.h"
 #include <resources/TextureLoader.h>
 #include <resources/ResourceManager.h>
+#include <resources/TextureStreamer.h>
 
 namespace Chroma
 {
@@ -20,7 +21,15 @@ namespace Chroma
 	void Texture::Destroy()
 	{
 		CHROMA_TRACE("Removing Texture : {0}", m_TextureData->ID);
+		// streamed IDs change on every residency change, only the streamer deletes them
+		if (m_TextureData->isStreamed)
+		{
+			Chroma::TextureStreamer::Release(*m_TextureData);
+			return;
+		}
 		glDeleteTextures(1, &m_TextureData->ID);
+		m_TextureData->ID = 0;
+		m_TextureData->isInitialized = false;
 	}
 
 	void Texture::ClearTexureMemory(unsigned int const& TextureID)
@@ -46,6 +55,13 @@ namespace Chroma
 		LoadFromFile(sourcePath);
 	}
 
+	Texture::Texture(std::string sourcePath, bool const& isStreamable)
+	{
+		m_TextureData->isStreamable = isStreamable;
+
+		LoadFromFile(sourcePath);
+	}
+
 	Texture::Texture(std::shared_ptr<TextureData> textData)
 	{
 		m_TextureData = textData;
@@ -84,9 +100,8 @@ namespace Chroma
 
 	void Texture::SetID(Texture& refTexture)
 	{
-		m_TextureData->ID = refTexture.GetID();
-		m_TextureData->isLoaded = refTexture.GetTextureData()->isLoaded;
-		m_TextureData->isInitialized = refTexture.GetTextureData()->isInitialized;
+		// shared rather than copied, a streamed ID is replaced on residency changes
+		m_TextureData = refTexture.GetTextureData();
 	}
 }
 
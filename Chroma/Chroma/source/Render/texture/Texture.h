@@ -26,6 +26,19 @@ namespace Chroma
 		bool isInitialized{ false };
 		bool isLoaded{ false };
 
+		// Streaming, mips residentMip to numMips - 1 are on the GPU
+		// textures drawn without requesting mips, such as UI, load fully resident and untracked
+		bool isStreamable{ true };
+		bool isStreamed{ false };
+		int numMips{ 1 };
+		int residentMip{ 0 };
+		// GL internal format of the mips, block compressed unless disabled
+		unsigned int format{ 0 };
+		// mip cache finer mips are streamed from
+		std::string cachePath{ "" };
+		// resident mips awaiting upload, finest first
+		std::vector<std::vector<unsigned char>> mipData;
+
 		// Constructors
 		TextureData() {};
 
@@ -41,6 +54,7 @@ namespace Chroma
 		Texture(unsigned int newID);
 		Texture(std::string sourcePath);
 		Texture(std::string sourcePath, Chroma::Type::Texture type);
+		Texture(std::string sourcePath, bool const& isStreamable);
 		Texture(std::shared_ptr<TextureData> textData);
 		bool operator <(const Texture& rhs) const;
 
@@ -0,0 +1,199 @@
+#include "VoxelBrickMap.h"
+
+namespace Chroma
+{
+	const uint32_t VoxelBrickMap::kEmpty;
+
+	VoxelBrickMap::VoxelBrickMap(unsigned int const& gridResolution)
+	{
+		m_NumBricksPerAxis = gridResolution / VXGI_BRICK_SIZE;
+		m_Indirection.assign(m_NumBricksPerAxis * m_NumBricksPerAxis * m_NumBricksPerAxis, kEmpty);
+
+		// Indirection, one slot per brick
+		glGenTextures(1, &m_IndirectionTexture);
+		glBindTexture(GL_TEXTURE_3D, m_IndirectionTexture);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexStorage3D(GL_TEXTURE_3D, 1, GL_R32UI, m_NumBricksPerAxis, m_NumBricksPerAxis, m_NumBricksPerAxis);
+		m_IndirectionDirty = true;
+
+		// Coarse, one texel per brick, repeating for toroidal addressing
+		glGenTextures(1, &m_CoarseTexture);
+		glBindTexture(GL_TEXTURE_3D, m_CoarseTexture);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexStorage3D(GL_TEXTURE_3D, GetNumMips(m_NumBricksPerAxis), GL_RGBA16F, m_NumBricksPerAxis, m_NumBricksPerAxis, m_NumBricksPerAxis);
+		glm::vec4 const clearColor(0.0f);
+		for (unsigned int mip = 0; mip < GetNumMips(m_NumBricksPerAxis); mip++)
+			glClearTexImage(m_CoarseTexture, mip, GL_RGBA, GL_FLOAT, &clearColor);
+		glBindTexture(GL_TEXTURE_3D, 0);
+
+		// Pool
+		m_PoolTexture = CreatePoolTexture(m_PoolDepth);
+		AddFreeSlots(0, m_PoolDepth);
+	}
+
+	VoxelBrickMap::~VoxelBrickMap()
+	{
+		glDeleteTextures(1, &m_IndirectionTexture);
+		glDeleteTextures(1, &m_PoolTexture);
+		glDeleteTextures(1, &m_CoarseTexture);
+	}
+
+	bool VoxelBrickMap::Allocate(glm::ivec3 const& brick)
+	{
+		uint32_t& entry = m_Indirection[GetIndex(brick)];
+		if (entry != kEmpty)
+			return true;
+		if (m_FreeSlots.empty() && !GrowPool())
+			return false;
+
+		entry = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+		m_NumAllocated++;
+		m_IndirectionDirty = true;
+
+		// slots are reused, clear what the last brick left
+		glm::ivec3 const offset = glm::ivec3(UnpackSlot(entry)) * VXGI_BRICK_SIZE;
+		glm::vec4 const clearColor(0.0f);
+		glClearTexSubImage(m_PoolTexture, 0, offset.x, offset.y, offset.z, VXGI_BRICK_SIZE, VXGI_BRICK_SIZE, VXGI_BRICK_SIZE, GL_RGBA, GL_FLOAT, &clearColor);
+		return true;
+	}
+
+	void VoxelBrickMap::Free(glm::ivec3 const& brick)
+	{
+		uint32_t& entry = m_Indirection[GetIndex(brick)];
+		if (entry == kEmpty)
+			return;
+
+		m_FreeSlots.push_back(entry);
+		entry = kEmpty;
+		m_NumAllocated--;
+		m_IndirectionDirty = true;
+	}
+
+	void VoxelBrickMap::FreeAll()
+	{
+		for (uint32_t& entry : m_Indirection)
+		{
+			if (entry == kEmpty)
+				continue;
+			m_FreeSlots.push_back(entry);
+			entry = kEmpty;
+		}
+		m_NumAllocated = 0;
+		m_IndirectionDirty = true;
+	}
+
+	bool VoxelBrickMap::GetIsAllocated(glm::ivec3 const& brick) const
+	{
+		return m_Indirection[GetIndex(brick)] != kEmpty;
+	}
+
+	void VoxelBrickMap::Upload()
+	{
+		if (!m_IndirectionDirty)
+			return;
+
+		glBindTexture(GL_TEXTURE_3D, m_IndirectionTexture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, m_NumBricksPerAxis, m_NumBricksPerAxis, m_NumBricksPerAxis, GL_RED_INTEGER, GL_UNSIGNED_INT, m_Indirection.data());
+		glBindTexture(GL_TEXTURE_3D, 0);
+		m_IndirectionDirty = false;
+	}
+
+	void VoxelBrickMap::GenerateMipmaps()
+	{
+		// bricks are aligned to the atlas, mips up to the brick size never mix bricks
+		glBindTexture(GL_TEXTURE_3D, m_PoolTexture);
+		glGenerateMipmap(GL_TEXTURE_3D);
+		glBindTexture(GL_TEXTURE_3D, 0);
+	}
+
+	size_t VoxelBrickMap::GetMemoryUsage() const
+	{
+		// rgba16f pool and coarse textures with mips, r32ui indirection
+		size_t const bricksPerAxis = m_NumBricksPerAxis;
+		size_t poolTexels{ 0 }, coarseTexels{ 0 };
+		for (unsigned int mip = 0; mip < GetNumMips(VXGI_BRICK_SIZE); mip++)
+			poolTexels += (size_t)GetCapacity() * (size_t)std::pow(VXGI_BRICK_SIZE >> mip, 3);
+		for (unsigned int mip = 0; mip < GetNumMips(m_NumBricksPerAxis); mip++)
+			coarseTexels += (size_t)std::pow(m_NumBricksPerAxis >> mip, 3);
+		return (poolTexels + coarseTexels) * 8 + bricksPerAxis * bricksPerAxis * bricksPerAxis * 4;
+	}
+
+	std::vector<glm::ivec3> VoxelBrickMap::GetAllocatedBricks() const
+	{
+		std::vector<glm::ivec3> bricks;
+		bricks.reserve(m_NumAllocated);
+		for (unsigned int z = 0; z < m_NumBricksPerAxis; z++)
+			for (unsigned int y = 0; y < m_NumBricksPerAxis; y++)
+				for (unsigned int x = 0; x < m_NumBricksPerAxis; x++)
+					if (m_Indirection[GetIndex(glm::ivec3(x, y, z))] != kEmpty)
+						bricks.push_back(glm::ivec3(x, y, z));
+		return bricks;
+	}
+
+	bool VoxelBrickMap::GrowPool()
+	{
+		if (m_PoolDepth >= VXGI_BRICK_POOL_MAX_DEPTH)
+		{
+			CHROMA_WARN("VOXEL BRICK MAP :: Pool full at {0} bricks, geometry will be missing from VXGI.", GetCapacity());
+			return false;
+		}
+
+		// copy every mip into a deeper atlas, slots keep their coordinates
+		unsigned int const poolDepth = std::min(m_PoolDepth * 2, (unsigned int)VXGI_BRICK_POOL_MAX_DEPTH);
+		unsigned int const poolTexture = CreatePoolTexture(poolDepth);
+		for (unsigned int mip = 0; mip < GetNumMips(VXGI_BRICK_SIZE); mip++)
+		{
+			unsigned int const brickSize = VXGI_BRICK_SIZE >> mip;
+			glCopyImageSubData(m_PoolTexture, GL_TEXTURE_3D, mip, 0, 0, 0, poolTexture, GL_TEXTURE_3D, mip, 0, 0, 0,
+				VXGI_BRICK_POOL_WIDTH * brickSize, VXGI_BRICK_POOL_WIDTH * brickSize, m_PoolDepth * brickSize);
+		}
+		glDeleteTextures(1, &m_PoolTexture);
+		m_PoolTexture = poolTexture;
+
+		AddFreeSlots(m_PoolDepth, poolDepth);
+		m_PoolDepth = poolDepth;
+		CHROMA_INFO("VOXEL BRICK MAP :: Pool grown to {0} bricks.", GetCapacity());
+		return true;
+	}
+
+	unsigned int VoxelBrickMap::CreatePoolTexture(unsigned int const& poolDepth)
+	{
+		unsigned int poolTexture;
+		glGenTextures(1, &poolTexture);
+		glBindTexture(GL_TEXTURE_3D, poolTexture);
+		// bricks are sampled clamped to their own texels
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexStorage3D(GL_TEXTURE_3D, GetNumMips(VXGI_BRICK_SIZE), GL_RGBA16F,
+			VXGI_BRICK_POOL_WIDTH * VXGI_BRICK_SIZE, VXGI_BRICK_POOL_WIDTH * VXGI_BRICK_SIZE, poolDepth * VXGI_BRICK_SIZE);
+		glBindTexture(GL_TEXTURE_3D, 0);
+		return poolTexture;
+	}
+
+	void VoxelBrickMap::AddFreeSlots(unsigned int const& firstLayer, unsigned int const& lastLayer)
+	{
+		// handed out front to back
+		for (unsigned int z = lastLayer; z-- > firstLayer;)
+			for (unsigned int y = VXGI_BRICK_POOL_WIDTH; y-- > 0;)
+				for (unsigned int x = VXGI_BRICK_POOL_WIDTH; x-- > 0;)
+					m_FreeSlots.push_back(PackSlot(glm::uvec3(x, y, z)));
+	}
+
+	unsigned int VoxelBrickMap::GetNumMips(unsigned int const& size)
+	{
+		unsigned int numMips{ 1 };
+		while ((size >> numMips) > 0)
+			numMips++;
+		return numMips;
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef _CHROMA_VOXEL_BRICK_MAP_
+#define _CHROMA_VOXEL_BRICK_MAP_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+
+namespace Chroma
+{
+	// Sparse voxel storage for a toroidally addressed grid.
+	// The grid is split into bricks of VXGI_BRICK_SIZE voxels, an indirection table maps each
+	// brick to a slot in a pool atlas or marks it empty, so only allocated bricks take memory.
+	// The pool grows when full. A coarse texture holds one averaged texel per brick, with its
+	// own mips, for lods past the brick size.
+	class VoxelBrickMap
+	{
+	public:
+		// Allocation, bricks in toroidal brick coordinates
+		bool Allocate(glm::ivec3 const& brick);
+		void Free(glm::ivec3 const& brick);
+		void FreeAll();
+		bool GetIsAllocated(glm::ivec3 const& brick) const;
+		// pushes indirection changes to the GPU, before voxelizing into new bricks
+		void Upload();
+
+		// Textures
+		inline unsigned int GetIndirectionTexture() const { return m_IndirectionTexture; }
+		inline unsigned int GetPoolTexture() const { return m_PoolTexture; }
+		inline unsigned int GetCoarseTexture() const { return m_CoarseTexture; }
+		void GenerateMipmaps();
+
+		// Stats
+		inline unsigned int GetNumBricksPerAxis() const { return m_NumBricksPerAxis; }
+		inline unsigned int GetNumAllocated() const { return m_NumAllocated; }
+		inline unsigned int GetCapacity() const { return VXGI_BRICK_POOL_WIDTH * VXGI_BRICK_POOL_WIDTH * m_PoolDepth; }
+		// GPU memory of the pool, coarse and indirection textures in bytes
+		size_t GetMemoryUsage() const;
+		// allocated bricks in toroidal brick coordinates
+		std::vector<glm::ivec3> GetAllocatedBricks() const;
+
+		// indirection entries, slots pack the atlas brick as 10 bits per axis
+		static const uint32_t kEmpty{ 0xFFFFFFFF };
+		static inline uint32_t PackSlot(glm::uvec3 const& slot) { return slot.x | (slot.y << 10) | (slot.z << 20); }
+		static inline glm::uvec3 UnpackSlot(uint32_t const& entry) { return glm::uvec3(entry & 0x3FF, (entry >> 10) & 0x3FF, (entry >> 20) & 0x3FF); }
+
+		VoxelBrickMap(unsigned int const& gridResolution);
+		~VoxelBrickMap();
+
+	private:
+		unsigned int m_NumBricksPerAxis{ 0 };
+		std::vector<uint32_t> m_Indirection;
+		std::vector<uint32_t> m_FreeSlots;
+		unsigned int m_NumAllocated{ 0 };
+		unsigned int m_PoolDepth{ VXGI_BRICK_POOL_INITIAL_DEPTH };
+		bool m_IndirectionDirty{ false };
+
+		unsigned int m_IndirectionTexture{ 0 };
+		unsigned int m_PoolTexture{ 0 };
+		unsigned int m_CoarseTexture{ 0 };
+
+		bool GrowPool();
+		unsigned int CreatePoolTexture(unsigned int const& poolDepth);
+		void AddFreeSlots(unsigned int const& firstLayer, unsigned int const& lastLayer);
+		inline unsigned int GetIndex(glm::ivec3 const& brick) const { return ((unsigned int)brick.z * m_NumBricksPerAxis + (unsigned int)brick.y) * m_NumBricksPerAxis + (unsigned int)brick.x; }
+		static unsigned int GetNumMips(unsigned int const& size);
+	};
+}
+
+#endif
@@ -16,12 +16,12 @@ namespace Chroma
 
 	}
 
-	void UniformBuffer::BindUniformBlockIndex(const Shader& shaderToBind)
+	void UniformBuffer::BindUniformBlockIndex(unsigned int const& programID)
 	{
 		// Shaders need to be aware of their Uniform Buffer Block Binding Index to read from
 		// We need to bind each shader to their respective UBO index
-		unsigned int uniformBufferBlockIndex = glGetUniformBlockIndex(shaderToBind.ShaderID, m_Name.c_str());
-		glUniformBlockBinding(shaderToBind.ShaderID, uniformBufferBlockIndex, m_BindingPointIndex);
+		unsigned int uniformBufferBlockIndex = glGetUniformBlockIndex(programID, m_Name.c_str());
+		glUniformBlockBinding(programID, uniformBufferBlockIndex, m_BindingPointIndex);
 	}
 }
 
@@ -12,7 +12,8 @@ namespace Chroma
 		UniformBuffer() { Init(); };
 		~UniformBuffer() {};
 
-		void BindUniformBlockIndex(const Shader& shaderToBind);
+		void BindUniformBlockIndex(const Shader& shaderToBind) { BindUniformBlockIndex(shaderToBind.ShaderID); };
+		void BindUniformBlockIndex(unsigned int const& programID);
 		virtual void OnUpdate() = 0;
 
 	protected:
@@ -4,15 +4,29 @@
 
 namespace Chroma
 {
+	// std140 offsets of the CameraUBO block
+	static const size_t CAMERA_UBO_PROJECTION_OFFSET{ 0 };
+	static const size_t CAMERA_UBO_VIEW_OFFSET{ sizeof(glm::mat4) };
+	static const size_t CAMERA_UBO_POSITION_OFFSET{ sizeof(glm::mat4) * 2 };
+	static const size_t CAMERA_UBO_INVERSE_PROJECTION_OFFSET{ sizeof(glm::mat4) * 2 + sizeof(glm::vec4) };
+	static const size_t CAMERA_UBO_INVERSE_VIEWPROJ_OFFSET{ sizeof(glm::mat4) * 3 + sizeof(glm::vec4) };
+
 	void UniformBufferCamera::OnUpdate()
 	{
+		Camera* renderCamera = Chroma::Scene::GetRenderCamera();
 		Bind();
 		// projection
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(Chroma::Scene::GetRenderCamera()->GetProjectionMatrix()));
+		glBufferSubData(GL_UNIFORM_BUFFER, CAMERA_UBO_PROJECTION_OFFSET, sizeof(glm::mat4), glm::value_ptr(renderCamera->GetProjectionMatrix()));
 		// view
-		glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(Chroma::Scene::GetRenderCamera()->GetViewMatrix()));
+		glBufferSubData(GL_UNIFORM_BUFFER, CAMERA_UBO_VIEW_OFFSET, sizeof(glm::mat4), glm::value_ptr(renderCamera->GetViewMatrix()));
 		// cameraPosition
-		glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4) * 2, sizeof(glm::vec3), &Chroma::Scene::GetRenderCamera()->GetPosition());
+		glm::vec3 cameraPosition = renderCamera->GetPosition();
+		glBufferSubData(GL_UNIFORM_BUFFER, CAMERA_UBO_POSITION_OFFSET, sizeof(glm::vec3), glm::value_ptr(cameraPosition));
+		// inverses, to reconstruct positions from depth
+		glm::mat4 inverseProjection = glm::inverse(renderCamera->GetProjectionMatrix());
+		glm::mat4 inverseViewProjection = glm::inverse(renderCamera->GetProjectionMatrix() * renderCamera->GetViewMatrix());
+		glBufferSubData(GL_UNIFORM_BUFFER, CAMERA_UBO_INVERSE_PROJECTION_OFFSET, sizeof(glm::mat4), glm::value_ptr(inverseProjection));
+		glBufferSubData(GL_UNIFORM_BUFFER, CAMERA_UBO_INVERSE_VIEWPROJ_OFFSET, sizeof(glm::mat4), glm::value_ptr(inverseViewProjection));
 		UnBind();
 	}
 
@@ -21,7 +35,8 @@ namespace Chroma
 		// Bind and allocate memory
 		Bind();
 		m_Size = 2 * sizeof(glm::mat4); // view , projection matrices
-		m_Size += sizeof(glm::vec3); // camera position
+		m_Size += sizeof(glm::vec4); // camera position, padded to the next matrix
+		m_Size += 2 * sizeof(glm::mat4); // inverse projection, inverse view projection
 		//glBufferData(GL_UNIFORM_BUFFER, m_Size, NULL, GL_STATIC_DRAW); // allocate m_Size bytes of memory
 		glBufferData(GL_UNIFORM_BUFFER, m_Size, NULL, GL_DYNAMIC_DRAW);
 		// Set to default uniform buffer
@@ -32,14 +47,7 @@ namespace Chroma
 		glBindBufferRange(GL_UNIFORM_BUFFER, m_BindingPointIndex, m_UBO, 0, m_Size);
 
 		// Now we've created a buffer with enough space we'll fill the buffer
-		Bind();
-		// projection
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(Chroma::Scene::GetRenderCamera()->GetProjectionMatrix()));
-		// view
-		glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(Chroma::Scene::GetRenderCamera()->GetViewMatrix()));
-		// cameraPosition
-		glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4)*2, sizeof(glm::vec3), &Chroma::Scene::GetRenderCamera()->GetPosition());
-		UnBind();
+		OnUpdate();
 		// Debug
 		CHROMA_INFO("Uniform Buffer Object : {} Setup.", m_Name);
 	}
@@ -0,0 +1,38 @@
+#include "UniformBufferIBL.h"
+#include <scene/Scene.h>
+
+namespace Chroma
+{
+	void UniformBufferIBL::OnUpdate()
+	{
+		if (!Chroma::Scene::GetIBL())
+			return;
+
+		// std140 pads each coefficient to a vec4
+		glm::vec4 irradianceSH[9];
+		glm::vec3 const* sceneSH = Chroma::Scene::GetIBL()->GetIrradianceSH();
+		for (unsigned int i = 0; i < 9; i++)
+			irradianceSH[i] = glm::vec4(sceneSH[i], 0.0f);
+
+		Bind();
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(irradianceSH), &irradianceSH);
+		UnBind();
+	}
+
+	void UniformBufferIBL::Setup()
+	{
+		// Bind and allocate memory
+		Bind();
+		m_Size = 9 * sizeof(glm::vec4); // irradiance SH coefficients
+		glBufferData(GL_UNIFORM_BUFFER, m_Size, NULL, GL_DYNAMIC_DRAW);
+		UnBind();
+
+		// We also ned to bind the uniform buffer object to the same binding point
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_BindingPointIndex, m_UBO, 0, m_Size);
+
+		// Now we've created a buffer with enough space we'll fill the buffer
+		OnUpdate();
+		// Debug
+		CHROMA_INFO("Uniform Buffer Object : {} Setup.", m_Name);
+	}
+}
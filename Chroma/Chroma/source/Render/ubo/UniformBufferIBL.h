@@ -0,0 +1,25 @@
+#ifndef CHROMA_UNIFORMBUFFER_IBL_H
+#define CHROMA_UNIFORMBUFFER_IBL_H
+
+#include <ubo/UniformBuffer.h>
+
+namespace Chroma
+{
+	// Irradiance SH of the scene IBL, read by the ambient lighting term
+	class UniformBufferIBL : public UniformBuffer
+	{
+	public:
+
+		UniformBufferIBL() { m_Name = "IBLUBO"; 	Setup(); };
+		~UniformBufferIBL() {};
+
+		void OnUpdate() override;
+
+	private:
+
+		void Setup() override;
+
+	};
+}
+
+#endif // CHROMA_UNIFORMBUFFER_IBL_H
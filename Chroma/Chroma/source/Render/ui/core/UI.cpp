@@ -1,5 +1,9 @@
 #include "UI.h"
 #include <render/Render.h>
+#include <quality/DynamicResolution.h>
+#include <quality/QualityGovernor.h>
+#include <graph/RenderGraph.h>
+#include <buffer/VXGIBuffer.h>
 #include <core/Application.h>
 
 
@@ -101,6 +105,26 @@ namespace Chroma
 		ImGui::Text("Delta Time : %f", DELTATIME);
 		ImGui::Text("Game Time : %f", GAMETIME);
 
+		// GPU Stats
+		ImGui::Separator();
+		ImGui::Text("GPU Stats");
+		ImGui::Separator();
+		ImGui::Text("GPU Frame Time : %f ms (target %f ms)", DynamicResolution::GetGPUFrameTime(), DynamicResolution::GetTargetFrameTime());
+		ImGui::Text("Render Resolution : %d x %d (scale %f)", Render::GetRenderWidth(), Render::GetRenderHeight(), DynamicResolution::GetRenderScale());
+		ImGui::Text("Quality Tier : %s (max %s)", RenderQuality::GetTierName(RenderQuality::GetTier()), RenderQuality::GetTierName(QualityGovernor::GetMaxTier()));
+		for (unsigned int i = 0; i < (unsigned int)RenderFeature::kNumFeatures; i++)
+			ImGui::Text("%f ms : %s", QualityGovernor::GetFeatureTime((RenderFeature)i), QualityGovernor::GetFeatureName((RenderFeature)i));
+		ImGui::Text("Render Graph : %d passes (%d culled), %d pooled targets (%f MB)", RenderGraph::GetNumPasses(), RenderGraph::GetNumCulledPasses(), RenderGraph::GetNumPooledTextures(), (float)RenderGraph::GetPooledBytes() / (1024.0f * 1024.0f));
+		if (VXGIBuffer* vxgiBuffer = static_cast<VXGIBuffer*>(Render::GetVXGIBuffer()))
+			ImGui::Text("VXGI Bricks : %d (%f MB)", vxgiBuffer->GetNumAllocatedBricks(), (float)vxgiBuffer->GetVoxelMemoryUsage() / (1024.0f * 1024.0f));
+
+		// Quality Governor Decisions
+		ImGui::Separator();
+		ImGui::Text("Quality Governor");
+		ImGui::Separator();
+		for (std::string const& decision : QualityGovernor::GetDecisions())
+			ImGui::TextWrapped("%s", decision.c_str());
+
 		// Func Calls
 		ImGui::Separator();
 		ImGui::Text("Func Calls");
@@ -6,14 +6,14 @@ namespace Chroma
 {
 	void Icon::SetIconTexture(std::string const& iconPath)
 	{
-		m_IconTexture.Destroy();
+		ReleaseIconTexture();
 		m_IconSourcePath = iconPath;
-		m_IconTexture = Texture(m_IconSourcePath);
+		m_IconTexture = Texture(m_IconSourcePath, false);
 	}
 
 	void Icon::SetIconTexture(Texture& newTexture)
 	{
-		m_IconTexture.Destroy();
+		ReleaseIconTexture();
 		m_IconSourcePath = newTexture.GetSourcePath();
 		m_IconTexture = newTexture;
 	}
@@ -47,7 +47,7 @@ namespace Chroma
 	Icon::Icon(std::string const& iconPath)
 	{
 		m_IconSourcePath = iconPath;
-		m_IconTexture = Texture(m_IconSourcePath);
+		m_IconTexture = Texture(m_IconSourcePath, false);
 
 		Init();
 	}
@@ -68,6 +68,13 @@ namespace Chroma
 		UpdateTransform();
 	}
 
+	void Icon::ReleaseIconTexture()
+	{
+		// textures shared with other icons or the editor are left to their owners
+		if (m_IconTexture.GetTextureData().use_count() == 1)
+			m_IconTexture.Destroy();
+	}
+
 	void Icon::UpdateTransform()
 	{
 		m_ModelMatrix = glm::mat4(1.0f);
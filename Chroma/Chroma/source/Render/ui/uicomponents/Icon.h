@@ -34,6 +34,7 @@ namespace Chroma
 	private :
 		void Init();
 		void UpdateTransform();
+		void ReleaseIconTexture();
 
 		void SetupQuad();
 		// vertex array / vertex buffer
@@ -43,7 +44,7 @@ namespace Chroma
 		float m_Scale{ 1.0f };
 		glm::vec3 m_Position{1.0f};
 		Shader m_IconShader{ "resources/shaders/ui/icon/frgIcon.glsl", "resources/shaders/ui/icon/vtxIcon.glsl" };
-		Texture m_IconTexture{ "resources/icons/light_icon.png" };
+		Texture m_IconTexture{ "resources/icons/light_icon.png", false };
 		bool m_IgnoreDepth{ false };
 	};
 }
@@ -0,0 +1,374 @@
+#include "Vegetation.h"
+#include <scene/Scene.h>
+#include <resources/ResourceManager.h>
+#include <geometry/StaticBatcher.h>
+#include <model/PackedVertex.h>
+#include <time/Time.h>
+#include <resources/TextureStreamer.h>
+
+namespace Chroma
+{
+	std::vector<VegetationSpecies*> Vegetation::s_Species;
+	std::vector<Vegetation::DrawElementsIndirectCommand> Vegetation::s_Commands;
+	unsigned int Vegetation::s_IndirectBuffer{ 0 };
+	Shader* Vegetation::s_Shader{ nullptr };
+	Shader* Vegetation::s_ShadowShader{ nullptr };
+	unsigned int Vegetation::s_NumDrawnInstances{ 0 };
+	unsigned int Vegetation::s_NumDrawnCells{ 0 };
+
+	void Vegetation::Init()
+	{
+		s_Shader = new Shader("resources/shaders/fragGBufferVegetation.glsl", "resources/shaders/vertexVegetationInstanced.glsl");
+		s_ShadowShader = new Shader("resources/shaders/fragVegetationShadow.glsl", "resources/shaders/vertexVegetationShadow.glsl");
+		glGenBuffers(1, &s_IndirectBuffer);
+	}
+
+	void Vegetation::Draw()
+	{
+		if (s_Species.empty())
+			return;
+
+		Camera& renderCam = *Chroma::Scene::GetRenderCamera();
+		std::vector<std::vector<std::pair<unsigned int, unsigned int>>> lodCommands;
+		GatherAllCommands(renderCam.GetViewProjMatrix(), true, lodCommands);
+		s_NumDrawnCells = (unsigned int)s_Commands.size();
+		s_NumDrawnInstances = 0;
+		for (DrawElementsIndirectCommand const& command : s_Commands)
+			s_NumDrawnInstances += command.instanceCount;
+		if (s_Commands.empty())
+			return;
+
+		// cards are double sided
+		glDisable(GL_CULL_FACE);
+		for (size_t i = 0; i < s_Species.size(); i++)
+		{
+			VegetationSpecies& species = *s_Species[i];
+			RequestMips(species, renderCam);
+			Shader& shader = s_Shader->GetVariant(species.material.GetShaderKeywords());
+			if (!shader.GetIsReady())
+				continue;
+
+			shader.Use();
+			species.material.SetMaterialUniforms(shader);
+			species.material.SetTextureUniforms(shader);
+			shader.SetUniform("scaleRange", species.settings.scaleRange);
+			shader.SetUniform("colorVariation", species.settings.colorVariation);
+			shader.SetUniform("windDirection", species.settings.windDirection);
+			shader.SetUniform("windStrength", species.settings.windStrength);
+			shader.SetUniform("gameTime", (float)GAMETIME);
+
+			// one submission per LOD
+			glBindVertexArray(species.VAO);
+			for (std::pair<unsigned int, unsigned int> const& commands : lodCommands[i])
+				if (commands.second > 0)
+					glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)((size_t)commands.first * sizeof(DrawElementsIndirectCommand)), commands.second, 0);
+		}
+		glEnable(GL_CULL_FACE);
+		glBindVertexArray(0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void Vegetation::DrawShadows(glm::mat4 const& lightSpaceMatrix)
+	{
+		if (s_Species.empty())
+			return;
+
+		// depth is clamped in the shadow pass, cells are only tested against the sides
+		std::vector<std::vector<std::pair<unsigned int, unsigned int>>> lodCommands;
+		GatherAllCommands(lightSpaceMatrix, false, lodCommands);
+		if (s_Commands.empty())
+			return;
+
+		glDisable(GL_CULL_FACE);
+		for (size_t i = 0; i < s_Species.size(); i++)
+		{
+			VegetationSpecies& species = *s_Species[i];
+			// only the albedo alpha matters for the cutout
+			Shader& shader = s_ShadowShader->GetVariant(species.material.GetShaderKeywords() & ShaderKeyword::kAlbedoMap);
+			if (!shader.GetIsReady())
+				continue;
+
+			shader.Use();
+			species.material.SetMaterialUniforms(shader);
+			species.material.SetTextureUniforms(shader);
+			shader.SetUniform("lightSpaceMatrix", lightSpaceMatrix);
+			shader.SetUniform("scaleRange", species.settings.scaleRange);
+			shader.SetUniform("windDirection", species.settings.windDirection);
+			shader.SetUniform("windStrength", species.settings.windStrength);
+			shader.SetUniform("gameTime", (float)GAMETIME);
+
+			glBindVertexArray(species.VAO);
+			for (std::pair<unsigned int, unsigned int> const& commands : lodCommands[i])
+				if (commands.second > 0)
+					glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)((size_t)commands.first * sizeof(DrawElementsIndirectCommand)), commands.second, 0);
+		}
+		glEnable(GL_CULL_FACE);
+		glBindVertexArray(0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	unsigned int Vegetation::AddSpecies(std::string const& sourcePath, Material const& material, VegetationSettings const& settings)
+	{
+		VegetationSpecies* species = new VegetationSpecies();
+		species->material = material;
+		species->settings = settings;
+		species->meshData = ResourceManager::LoadModel(sourcePath);
+		GenerateBuffers(*species);
+		s_Species.push_back(species);
+		return (unsigned int)s_Species.size() - 1;
+	}
+
+	void Vegetation::AddInstances(unsigned int const& species, std::vector<VegetationInstance> const& instances)
+	{
+		std::vector<VegetationInstance>& speciesInstances = s_Species[species]->instances;
+		speciesInstances.insert(speciesInstances.end(), instances.begin(), instances.end());
+		s_Species[species]->isDirty = true;
+	}
+
+	void Vegetation::Scatter(unsigned int const& species, glm::vec2 const& min, glm::vec2 const& max, float const& density,
+		std::function<float(glm::vec2 const&)> const& heightAt, uint32_t const& seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		glm::vec2 const extent = max - min;
+		unsigned int const numInstances = (unsigned int)(extent.x * extent.y * density);
+		std::vector<VegetationInstance> instances;
+		instances.reserve(numInstances);
+		for (unsigned int i = 0; i < numInstances; i++)
+		{
+			glm::vec2 const position = min + glm::vec2(unit(generator), unit(generator)) * extent;
+			float const rotation = unit(generator) * glm::two_pi<float>();
+			instances.push_back(PackInstance(glm::vec3(position.x, heightAt(position), position.y), rotation, unit(generator), (uint16_t)generator()));
+		}
+		AddInstances(species, instances);
+		CHROMA_INFO("VEGETATION :: Scattered {0} instances of : {1}", numInstances, s_Species[species]->meshData.sourcePath);
+	}
+
+	void Vegetation::Scatter(unsigned int const& species, VegetationScatter const& scatter)
+	{
+		float const height = scatter.height;
+		Scatter(species, scatter.min, scatter.max, scatter.density, [height](glm::vec2 const&) { return height; }, scatter.seed);
+		s_Species[species]->scatters.push_back(scatter);
+	}
+
+	void Vegetation::Clear()
+	{
+		for (VegetationSpecies* species : s_Species)
+		{
+			glDeleteBuffers(1, &species->VBO);
+			glDeleteBuffers(1, &species->EBO);
+			glDeleteBuffers(1, &species->instanceBuffer);
+			glDeleteVertexArrays(1, &species->VAO);
+			delete species;
+		}
+		s_Species.clear();
+	}
+
+	VegetationInstance Vegetation::PackInstance(glm::vec3 const& position, float const& rotation, float const& scale, uint16_t const& seed)
+	{
+		VegetationInstance instance;
+		instance.position = position;
+		uint32_t const packedRotation = (uint32_t)(glm::fract(rotation / glm::two_pi<float>()) * 255.0f + 0.5f);
+		uint32_t const packedScale = (uint32_t)(glm::clamp(scale, 0.0f, 1.0f) * 255.0f + 0.5f);
+		instance.packed = packedRotation | (packedScale << 8) | ((uint32_t)seed << 16);
+		return instance;
+	}
+
+	void Vegetation::BuildCells(VegetationSpecies& species)
+	{
+		// sort into cells, rows along z
+		auto getCell = [](VegetationInstance const& instance) {
+			return glm::ivec2(glm::floor(glm::vec2(instance.position.x, instance.position.z) / VEGETATION_CELL_SIZE));
+		};
+		std::sort(species.instances.begin(), species.instances.end(), [&getCell](VegetationInstance const& a, VegetationInstance const& b) {
+			glm::ivec2 const cellA = getCell(a), cellB = getCell(b);
+			return cellA.y != cellB.y ? cellA.y < cellB.y : cellA.x < cellB.x;
+		});
+
+		// instance bounds cover any rotation and scale
+		glm::vec2 const scaleRange = species.settings.scaleRange;
+		glm::vec3 const meshMin = species.meshData.bboxMin, meshMax = species.meshData.bboxMax;
+		float const radius = glm::max(glm::length(glm::vec2(meshMin.x, meshMin.z)), glm::length(glm::vec2(meshMax.x, meshMax.z))) * scaleRange.y;
+		glm::vec3 const instanceMin(-radius, glm::min(meshMin.y * scaleRange.x, meshMin.y * scaleRange.y), -radius);
+		glm::vec3 const instanceMax(radius, glm::max(meshMax.y * scaleRange.x, meshMax.y * scaleRange.y), radius);
+
+		species.cells.clear();
+		glm::ivec2 currentCell{ 0 };
+		for (unsigned int i = 0; i < species.instances.size(); i++)
+		{
+			glm::vec3 const& position = species.instances[i].position;
+			glm::ivec2 const cell = getCell(species.instances[i]);
+			if (species.cells.empty() || cell != currentCell)
+			{
+				VegetationCell newCell;
+				newCell.firstInstance = i;
+				newCell.bboxMin = position + instanceMin;
+				newCell.bboxMax = position + instanceMax;
+				species.cells.push_back(newCell);
+				currentCell = cell;
+			}
+			VegetationCell& current = species.cells.back();
+			current.bboxMin = glm::min(current.bboxMin, position + instanceMin);
+			current.bboxMax = glm::max(current.bboxMax, position + instanceMax);
+			current.numInstances++;
+		}
+
+		// shuffled so any prefix of a cell thins it evenly
+		std::mt19937 generator(0);
+		for (VegetationCell const& cell : species.cells)
+			std::shuffle(species.instances.begin() + cell.firstInstance, species.instances.begin() + cell.firstInstance + cell.numInstances, generator);
+	}
+
+	void Vegetation::UploadInstances(VegetationSpecies& species)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, species.instanceBuffer);
+		size_t const size = species.instances.size() * sizeof(VegetationInstance);
+		if (species.instances.size() > species.instanceCapacity)
+		{
+			glBufferData(GL_ARRAY_BUFFER, size, species.instances.data(), GL_STATIC_DRAW);
+			species.instanceCapacity = (unsigned int)species.instances.size();
+		}
+		else
+			glBufferSubData(GL_ARRAY_BUFFER, 0, size, species.instances.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void Vegetation::GenerateBuffers(VegetationSpecies& species)
+	{
+		// LOD0 then each simplified LOD, all indexing the same vertices
+		MeshData& meshData = species.meshData;
+		std::vector<unsigned int> indices = meshData.indices;
+		species.lodRanges.clear();
+		species.lodRanges.push_back({ 0, (unsigned int)meshData.indices.size() });
+		for (MeshLOD const& lod : meshData.lods)
+		{
+			species.lodRanges.push_back({ (unsigned int)indices.size(), (unsigned int)lod.indices.size() });
+			indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+		}
+		std::vector<ChromaPackedVertex> const vertices = VertexCompression::Pack(meshData.verts);
+
+		glGenVertexArrays(1, &species.VAO);
+		glGenBuffers(1, &species.VBO);
+		glGenBuffers(1, &species.EBO);
+		glGenBuffers(1, &species.instanceBuffer);
+
+		glBindVertexArray(species.VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, species.VBO);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ChromaPackedVertex), vertices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, species.EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+		// packed vertex layout, as the geometry pool
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChromaPackedVertex), (void*)0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_normal));
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_texCoords));
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_tangent));
+		glEnableVertexAttribArray(7);
+		glVertexAttribPointer(7, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ChromaPackedVertex), (void*)offsetof(ChromaPackedVertex, ChromaPackedVertex::m_color));
+
+		// instances, the base instance of each command selects its cell
+		glBindBuffer(GL_ARRAY_BUFFER, species.instanceBuffer);
+		glEnableVertexAttribArray(10);
+		glVertexAttribPointer(10, 3, GL_FLOAT, GL_FALSE, sizeof(VegetationInstance), (void*)0);
+		glVertexAttribDivisor(10, 1);
+		glEnableVertexAttribArray(11);
+		glVertexAttribIPointer(11, 1, GL_UNSIGNED_INT, sizeof(VegetationInstance), (void*)offsetof(VegetationInstance, packed));
+		glVertexAttribDivisor(11, 1);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// only the bounds are needed on the CPU from here
+		std::vector<ChromaVertex>().swap(meshData.verts);
+		std::vector<unsigned int>().swap(meshData.indices);
+		std::vector<MeshLOD>().swap(meshData.lods);
+		std::vector<Meshlet>().swap(meshData.meshlets);
+	}
+
+	void Vegetation::RequestMips(VegetationSpecies& species, Camera& renderCam)
+	{
+		// one instance at the nearest cell within the draw distance sets the detail
+		glm::vec3 const cameraPosition = renderCam.GetPosition();
+		glm::vec3 nearest{ 0.0f };
+		float nearestDistance{ FLT_MAX };
+		for (VegetationCell const& cell : species.cells)
+		{
+			glm::vec3 const point = glm::clamp(cameraPosition, cell.bboxMin, cell.bboxMax);
+			float const distance = glm::length(point - cameraPosition);
+			if (distance < nearestDistance)
+			{
+				nearest = point;
+				nearestDistance = distance;
+			}
+		}
+		if (nearestDistance > species.settings.drawDistance)
+			return;
+
+		float const radius = glm::length(species.meshData.bboxMax - species.meshData.bboxMin) * 0.5f * species.settings.scaleRange.y;
+		TextureStreamer::RequestMaterial(species.material, TextureStreamer::GetScreenSize(renderCam, nearest, radius));
+	}
+
+	void Vegetation::GatherAllCommands(glm::mat4 const& viewProjection, bool const& testDepth, std::vector<std::vector<std::pair<unsigned int, unsigned int>>>& lodCommands)
+	{
+		// cull cells and gather every species' commands into one upload
+		s_Commands.clear();
+		lodCommands.assign(s_Species.size(), {});
+		for (size_t i = 0; i < s_Species.size(); i++)
+		{
+			VegetationSpecies& species = *s_Species[i];
+			if (species.isDirty)
+			{
+				BuildCells(species);
+				UploadInstances(species);
+				species.isDirty = false;
+			}
+			GatherCommands(species, viewProjection, testDepth, lodCommands[i]);
+		}
+		if (s_Commands.empty())
+			return;
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_IndirectBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, s_Commands.size() * sizeof(DrawElementsIndirectCommand), s_Commands.data(), GL_STREAM_DRAW);
+	}
+
+	void Vegetation::GatherCommands(VegetationSpecies& species, glm::mat4 const& viewProjection, bool const& testDepth, std::vector<std::pair<unsigned int, unsigned int>>& lodCommands)
+	{
+		VegetationSettings const& settings = species.settings;
+		unsigned int const numLODs = (unsigned int)species.lodRanges.size();
+		std::vector<std::vector<DrawElementsIndirectCommand>> lodCells(numLODs);
+
+		// distance and LOD always follow the render camera, so shadows match the drawn instances
+		glm::vec3 const position = Chroma::Scene::GetRenderCamera()->GetPosition();
+		for (VegetationCell const& cell : species.cells)
+		{
+			float const distance = glm::distance(glm::clamp(position, cell.bboxMin, cell.bboxMax), position);
+			if (distance > settings.drawDistance || !StaticBatcher::GetIsInFrustum(viewProjection, cell.bboxMin, cell.bboxMax, testDepth))
+				continue;
+
+			// each LOD covers twice the distance of the last
+			unsigned int lod{ 0 };
+			while (lod + 1 < numLODs && distance > settings.lodDistance * (float)(1 << lod))
+				lod++;
+
+			DrawElementsIndirectCommand command;
+			command.count = species.lodRanges[lod].second;
+			command.instanceCount = glm::max(1u, (unsigned int)glm::ceil(cell.numInstances * glm::pow(settings.lodDensity, (float)lod)));
+			command.firstIndex = species.lodRanges[lod].first;
+			command.baseVertex = 0;
+			command.baseInstance = cell.firstInstance;
+			lodCells[lod].push_back(command);
+		}
+
+		// each LOD's commands are contiguous
+		for (std::vector<DrawElementsIndirectCommand> const& commands : lodCells)
+		{
+			lodCommands.push_back({ (unsigned int)s_Commands.size(), (unsigned int)commands.size() });
+			s_Commands.insert(s_Commands.end(), commands.begin(), commands.end());
+		}
+	}
+}
@@ -0,0 +1,135 @@
+#ifndef _CHROMA_VEGETATION_
+#define _CHROMA_VEGETATION_
+
+//common
+#include <common/PrecompiledHeader.h>
+// chroma
+#include <ChromaConfig.h>
+#include <shader/Shader.h>
+#include <camera/Camera.h>
+#include <material/Material.h>
+#include <model/MeshData.h>
+
+namespace Chroma
+{
+	// 16 bytes per instance, uploaded as is
+	struct VegetationInstance
+	{
+		glm::vec3 position{ 0.0f };
+		// rotation about up 8 bits, scale within the species range 8 bits, variation seed 16 bits
+		uint32_t packed{ 0 };
+	};
+
+	// Instances within one grid cell, a contiguous range of the species instances
+	struct VegetationCell
+	{
+		glm::vec3 bboxMin{ 0.0f }, bboxMax{ 0.0f };
+		unsigned int firstInstance{ 0 };
+		unsigned int numInstances{ 0 };
+	};
+
+	struct VegetationSettings
+	{
+		// instances pick a random scale in the range
+		glm::vec2 scaleRange{ 0.8f, 1.2f };
+		// cells closer than the distance use LOD0, each further LOD doubles it
+		float lodDistance{ 20.0f };
+		// cells further away are not drawn
+		float drawDistance{ 150.0f };
+		// fraction of a cell's instances kept per LOD step, instances within a cell are shuffled
+		float lodDensity{ 1.0f };
+		// brightness jitter from the seed
+		float colorVariation{ 0.15f };
+		// sway scaled by vertex color red, as the forward vegetation shader
+		glm::vec3 windDirection{ 1.0f, 0.0f, 0.0f };
+		float windStrength{ 0.1f };
+	};
+
+	// Random instances over a rectangle on flat ground, kept so the species can be saved with the scene
+	struct VegetationScatter
+	{
+		glm::vec2 min{ 0.0f }, max{ 0.0f };
+		float height{ 0.0f };
+		// instances per square unit
+		float density{ 1.0f };
+		uint32_t seed{ 0 };
+	};
+
+	// One mesh and material scattered many times, drawn with one indirect call per LOD
+	struct VegetationSpecies
+	{
+		Material material;
+		VegetationSettings settings;
+		MeshData meshData;
+		std::vector<VegetationInstance> instances;
+		// serialized scatters, instances added any other way are not saved
+		std::vector<VegetationScatter> scatters;
+		std::vector<VegetationCell> cells;
+		// instances added since the cells were built
+		bool isDirty{ false };
+
+		// LOD0 followed by the simplified LODs in one element buffer
+		std::vector<std::pair<unsigned int, unsigned int>> lodRanges;
+		unsigned int VAO{ 0 }, VBO{ 0 }, EBO{ 0 }, instanceBuffer{ 0 };
+		unsigned int instanceCapacity{ 0 };
+	};
+
+	// Scattered vegetation stored compactly in a spatial grid instead of as entities.
+	// Cells are culled and pick their LOD on the CPU, the visible cells of a species
+	// and LOD are submitted together with glMultiDrawElementsIndirect.
+	class Vegetation
+	{
+	public:
+		static void Init();
+		// geometry pass, gbuffer must be bound
+		static void Draw();
+		// depth only into the bound shadow cascade, cells within the render camera's draw distance
+		static void DrawShadows(glm::mat4 const& lightSpaceMatrix);
+
+		// species are owned by the vegetation system, returns the species index
+		static unsigned int AddSpecies(std::string const& sourcePath, Material const& material, VegetationSettings const& settings = VegetationSettings());
+		static void AddInstances(unsigned int const& species, std::vector<VegetationInstance> const& instances);
+		// random instances over a rectangle, density per square unit, heightAt places them on the ground
+		static void Scatter(unsigned int const& species, glm::vec2 const& min, glm::vec2 const& max, float const& density,
+			std::function<float(glm::vec2 const&)> const& heightAt, uint32_t const& seed = 0);
+		// flat scatter, recorded on the species for serialization
+		static void Scatter(unsigned int const& species, VegetationScatter const& scatter);
+		static void Clear();
+
+		static inline std::vector<VegetationSpecies*> const& GetSpecies() { return s_Species; }
+
+		// rotation in radians, scale 0-1 within the species scale range
+		static VegetationInstance PackInstance(glm::vec3 const& position, float const& rotation, float const& scale, uint16_t const& seed);
+
+		static inline unsigned int GetNumDrawnInstances() { return s_NumDrawnInstances; }
+		static inline unsigned int GetNumDrawnCells() { return s_NumDrawnCells; }
+
+	private:
+		// layout expected by GL_DRAW_INDIRECT_BUFFER
+		struct DrawElementsIndirectCommand
+		{
+			GLuint count;
+			GLuint instanceCount;
+			GLuint firstIndex;
+			GLint baseVertex;
+			GLuint baseInstance;
+		};
+
+		static void BuildCells(VegetationSpecies& species);
+		static void UploadInstances(VegetationSpecies& species);
+		static void GenerateBuffers(VegetationSpecies& species);
+		static void RequestMips(VegetationSpecies& species, Camera& renderCam);
+		// fills and uploads s_Commands, lodCommands holds each species' (first, count) per LOD
+		static void GatherAllCommands(glm::mat4 const& viewProjection, bool const& testDepth, std::vector<std::vector<std::pair<unsigned int, unsigned int>>>& lodCommands);
+		static void GatherCommands(VegetationSpecies& species, glm::mat4 const& viewProjection, bool const& testDepth, std::vector<std::pair<unsigned int, unsigned int>>& lodCommands);
+
+		static std::vector<VegetationSpecies*> s_Species;
+		static std::vector<DrawElementsIndirectCommand> s_Commands;
+		static unsigned int s_IndirectBuffer;
+		static Shader* s_Shader;
+		static Shader* s_ShadowShader;
+		static unsigned int s_NumDrawnInstances, s_NumDrawnCells;
+	};
+}
+
+#endif
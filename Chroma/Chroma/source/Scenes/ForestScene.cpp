@@ -67,7 +67,6 @@ int main6()
 	Shader PBRSkinShaderExperimental("resources/shaders/fragSSSS.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
 	Shader PBRSkinShader("resources/shaders/fragSSSS_backup.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
 	Shader PBRShader("resources/shaders/fragPBR.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
-	Shader ColoredShader("resources/shaders/fragBasic.glsl", "resources/shaders/vertexLitShadowsNormals.glsl");
 
 	// ____________________________________________________
 	// TEXTURES
@@ -147,6 +146,10 @@ int main6()
 	yellowFlowerMaterial.SetUsesGameTime(true);
 	//yellowFlowerMaterial.SetUVMultiply(glm::vec2(2.0));
 	yellowFlowerMaterial.SetShader(foliageShader);
+	yellowFlowerMaterial.AddUniform("windFrequency", glm::vec2(0.005));
+	yellowFlowerMaterial.AddUniform("windDirection", Sun->GetDirection());
+	yellowFlowerMaterial.AddUniform("windSpeed", 0.05f);
+	yellowFlowerMaterial.AddUniform("windStrength", 0.5f);
 	yellowFlowerMaterial.AddTexture(yellowFlowerAlbedo);
 	yellowFlowerMaterial.AddTexture(yellowFlowerNormal);
 	yellowFlowerMaterial.AddTexture(yellowFlowerMetRoughAO);
@@ -178,6 +181,10 @@ int main6()
 	cloverMaterial.SetUsesSceneNoise(true);
 	cloverMaterial.SetUsesGameTime(true);
 	cloverMaterial.SetShader(foliageShader);
+	cloverMaterial.AddUniform("windFrequency", glm::vec2(0.005));
+	cloverMaterial.AddUniform("windDirection", Sun->GetDirection());
+	cloverMaterial.AddUniform("windSpeed", 0.05f);
+	cloverMaterial.AddUniform("windStrength", 0.5f);
 	cloverMaterial.AddTexture(cloversAlbedo);
 	cloverMaterial.AddTexture(cloversNormal);
 	cloverMaterial.AddTexture(cloversMetRoughAO);
@@ -280,12 +287,6 @@ int main6()
 				static_cast<MeshComponent*>(Chroma::Scene::GetComponent(meshComp))->SetCastsShadows(false);
 			}
 		}
-		// Vegetation Uniforms
-		foliageShader.Use();
-		foliageShader.SetUniform("windFrequency", glm::vec2(0.005));
-		foliageShader.SetUniform("windDirection", Chroma::Scene::GetSunLight()->GetDirection());
-		foliageShader.SetUniform("windSpeed", 0.05f);
-		foliageShader.SetUniform("windStrength", 0.5f);
 		//Chroma::Render::GetDebugBuffer()->DrawGrid(50, glm::vec3(0.5));
 		// GAME TICK
 		Chroma::Engine::OnUpdate();